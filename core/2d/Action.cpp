@@ -39,7 +39,9 @@ namespace ax
 // Action Base Class
 //
 
-Action::Action() : _originalTarget(nullptr), _target(nullptr), _tag(Action::INVALID_TAG), _flags(0) {}
+Action::Action()
+    : _originalTarget(nullptr), _target(nullptr), _tag(Action::INVALID_TAG), _flags(0), _batched(false)
+{}
 
 Action::~Action()
 {
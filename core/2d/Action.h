@@ -163,6 +163,11 @@ public:
      */
     void setFlags(unsigned int flags) { _flags = flags; }
 
+    /** Whether the action is updated by the TweenBatch of its ActionManager instead of step.
+     * @since axmol-2.2
+     */
+    bool isBatched() const { return _batched; }
+
     Action();
     virtual ~Action();
 
@@ -179,6 +184,9 @@ protected:
     int _tag;
     /** The action flag field. To categorize action into certain groups.*/
     unsigned int _flags;
+    bool _batched;
+
+    friend class TweenBatch;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Action);
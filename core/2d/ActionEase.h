@@ -76,6 +76,8 @@ protected:
     /** The inner action */
     ActionInterval* _inner;
 
+    friend class TweenBatch;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ActionEase);
 };
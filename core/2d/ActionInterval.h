@@ -119,6 +119,8 @@ protected:
     bool _firstTick;
     bool _done;
 
+    friend class TweenBatch;
+
 protected:
     bool sendUpdateEventToScript(float dt, Action* actionObject);
 };
@@ -462,6 +464,8 @@ protected:
     Vec3 _startAngle;
     Vec3 _diffAngle;
 
+    friend class TweenBatch;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(RotateTo);
 };
@@ -527,6 +531,8 @@ protected:
     Vec3 _deltaAngle;
     Vec3 _startAngle;
 
+    friend class TweenBatch;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(RotateBy);
 };
@@ -582,6 +588,8 @@ protected:
     Vec3 _startPosition;
     Vec3 _previousPosition;
 
+    friend class TweenBatch;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(MoveBy);
 };
@@ -1068,6 +1076,8 @@ protected:
     float _deltaY;
     float _deltaZ;
 
+    friend class TweenBatch;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ScaleTo);
 };
@@ -1204,6 +1214,7 @@ protected:
     uint8_t _fromOpacity;
     friend class FadeOut;
     friend class FadeIn;
+    friend class TweenBatch;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(FadeTo);
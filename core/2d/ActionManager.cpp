@@ -68,6 +68,9 @@ void ActionManager::removeActionAtIndex(ssize_t index,
 {
     Action* action = static_cast<Action*>(element.actions[index]);
 
+    if (action->isBatched())
+        _tweenBatch.remove(action);
+
     if (action == element.currentAction && (!element.currentActionSalvaged))
     {
         element.currentAction->retain();
@@ -159,6 +162,9 @@ void ActionManager::addAction(Action* action, Node* target, bool paused)
     actionHandle.actions.pushBack(action);
 
     action->startWithTarget(target);
+
+    if (_tweenBatchingEnabled)
+        _tweenBatch.add(action, &actionHandle.paused);
 }
 
 // remove
@@ -185,6 +191,7 @@ void ActionManager::removeAllActionsFromTarget(Node* target)
 void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt)
 {
     auto& element = actionIt->second;
+    unbatchActions(element);
     if (element.actions.contains(element.currentAction) && !element.currentActionSalvaged)
     {
         element.currentAction->retain();
@@ -205,10 +212,30 @@ void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHan
 
 void ActionManager::eraseTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt)
 {
+    unbatchActions(actionIt->second);
     actionIt->first->release();
     actionIt = _targets.erase(actionIt);
 }
 
+void ActionManager::unbatchActions(ActionHandle& element)
+{
+    for (auto action : element.actions)
+    {
+        if (action->isBatched())
+            _tweenBatch.remove(action);
+    }
+}
+
+void ActionManager::setTweenBatchingEnabled(bool enabled)
+{
+    if (_tweenBatchingEnabled == enabled)
+        return;
+
+    _tweenBatchingEnabled = enabled;
+    if (!enabled)
+        _tweenBatch.clear();
+}
+
 void ActionManager::removeAction(Action* action)
 {
     // explicit null handling
@@ -392,6 +419,10 @@ ssize_t ActionManager::getNumberOfRunningActions() const
 // main loop
 void ActionManager::update(float dt)
 {
+    // the batched tweens are stepped all at once, the loop below only retires the finished ones
+    if (_tweenBatch.getTweenCount())
+        _tweenBatch.update(dt);
+
     for (auto actionIt = _targets.begin(); actionIt != _targets.end();)
     {
         auto elt               = &actionIt->second;
@@ -413,7 +444,8 @@ void ActionManager::update(float dt)
 
                 _currentTarget->currentActionSalvaged = false;
 
-                _currentTarget->currentAction->step(dt);
+                if (!_currentTarget->currentAction->isBatched())
+                    _currentTarget->currentAction->step(dt);
 
                 if (_currentTarget->currentActionSalvaged)
                 {
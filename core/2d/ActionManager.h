@@ -32,6 +32,7 @@ THE SOFTWARE.
 #define __ACTION_CCACTION_MANAGER_H__
 
 #include "2d/Action.h"
+#include "2d/TweenBatch.h"
 #include "base/Vector.h"
 #include "base/Object.h"
 
@@ -200,6 +201,19 @@ public:
      */
     virtual void update(float dt);
 
+    /** Enables the TweenBatch, which updates simple tweens in contiguous arrays instead of calling their step.
+     * Only the actions added while it is enabled are batched, disabling it hands the batched actions back to step.
+     * Batched tweens are updated before the other actions of the frame.
+     * @since axmol-2.2
+     */
+    void setTweenBatchingEnabled(bool enabled);
+    bool isTweenBatchingEnabled() const { return _tweenBatchingEnabled; }
+
+    /** The batch of simple tweens, see setTweenBatchingEnabled.
+     * @since axmol-2.2
+     */
+    const TweenBatch& getTweenBatch() const { return _tweenBatch; }
+
 protected:
     // declared in ActionManager.m
     void removeTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt);
@@ -212,10 +226,14 @@ protected:
 
     void eraseTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt);
 
+    void unbatchActions(ActionHandle& element);
+
 protected:
     std::unordered_map<Node*, ActionHandle> _targets;
     ActionHandle* _currentTarget;
     bool _currentTargetSalvaged;
+    TweenBatch _tweenBatch;
+    bool _tweenBatchingEnabled = false;
 };
 
 // end of actions group
@@ -43,6 +43,12 @@ namespace ax
 
 // AtlasNode - Creation & Init
 
+AtlasNode::AtlasNode()
+{
+    // QuadCommand shares its index buffer between all the commands
+    _parallelVisitSafe = false;
+}
+
 AtlasNode::~AtlasNode()
 {
     AX_SAFE_RELEASE(_textureAtlas);
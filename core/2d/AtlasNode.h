@@ -102,7 +102,7 @@ public:
 
     bool setProgramState(backend::ProgramState* programState, bool ownPS = false) override;
 
-    AtlasNode() = default;
+    AtlasNode();
     virtual ~AtlasNode();
 
     /** Initializes an AtlasNode  with an Atlas file the width and height of each item and the quantity of items to
@@ -36,7 +36,11 @@
 namespace ax
 {
 
-ClippingNode::ClippingNode() : _stencilStateManager(new StencilStateManager()) {}
+ClippingNode::ClippingNode() : _stencilStateManager(new StencilStateManager())
+{
+    // renders its stencil and children with group commands
+    _parallelVisitSafe = false;
+}
 
 ClippingNode::~ClippingNode()
 {
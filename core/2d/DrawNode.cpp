@@ -81,6 +81,9 @@ static V2F_C4B_T2F* expandBufferAndGetPointer(axstd::pod_vector<V2F_C4B_T2F>& bu
 
 DrawNode::DrawNode()
 {
+    // updates its vertex buffers in draw
+    _parallelVisitSafe = false;
+
     _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
 
     properties.setDefaultValues();
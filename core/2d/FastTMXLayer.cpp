@@ -113,7 +113,11 @@ bool FastTMXLayer::initWithTilesetInfo(TMXTilesetInfo* tilesetInfo, TMXLayerInfo
     return true;
 }
 
-FastTMXLayer::FastTMXLayer() {}
+FastTMXLayer::FastTMXLayer()
+{
+    // updates its index buffer in draw
+    _parallelVisitSafe = false;
+}
 
 FastTMXLayer::~FastTMXLayer()
 {
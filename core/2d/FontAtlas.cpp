@@ -31,12 +31,16 @@
 #    include "platform/android/jni/Java_dev_axmol_lib_AxmolEngine.h"
 #endif
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include "2d/FontFreeType.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventDispatcher.h"
 #include "base/EventType.h"
+#include "base/JobSystem.h"
 
 #include "simdjson/simdjson.h"
 #include "zlib.h"
@@ -44,6 +48,11 @@
 #include "base/ZipUtils.h"
 
 #include "base/PaddedString.h"
+#include "platform/FileUtils.h"
+#include "platform/MappedFile.h"
+#include "yasio/ibstream.hpp"
+#include "yasio/obstream.hpp"
+#include "freetype/freetype.h"
 
 namespace ax
 {
@@ -53,6 +62,57 @@ const int FontAtlas::CacheTextureHeight    = 512;
 const char* FontAtlas::CMD_PURGE_FONTATLAS = "__ax_PURGE_FONTATLAS";
 const char* FontAtlas::CMD_RESET_FONTATLAS = "__ax_RESET_FONTATLAS";
 
+static constexpr size_t GLYPH_BATCH_SIZE = 64;
+
+// binary cache, 'AXFC'
+static constexpr uint32_t FONTATLAS_CACHE_MAGIC      = 0x43465841;
+static constexpr uint32_t FONTATLAS_CACHE_VERSION    = 1;
+static constexpr uint32_t FONTATLAS_CACHE_FT_VERSION = FREETYPE_MAJOR * 10000 + FREETYPE_MINOR * 100 + FREETYPE_PATCH;
+
+static bool s_asyncGlyphRasterization = false;
+
+static FontAtlas::GlyphStats s_frameGlyphStats;
+static FontAtlas::GlyphStats s_lastFrameGlyphStats;
+static unsigned int s_glyphStatsFrame = 0;
+
+// the counters of the current frame, the previous frame ones are kept for getFrameGlyphStats
+static FontAtlas::GlyphStats& currentGlyphStats()
+{
+    auto frame = Director::getInstance()->getTotalFrames();
+    if (frame != s_glyphStatsFrame)
+    {
+        s_lastFrameGlyphStats = frame == s_glyphStatsFrame + 1 ? s_frameGlyphStats : FontAtlas::GlyphStats{};
+        s_frameGlyphStats     = {};
+        s_glyphStatsFrame     = frame;
+    }
+    return s_frameGlyphStats;
+}
+
+struct FontAtlas::GlyphQueue
+{
+    FontAtlas* owner = nullptr;  // axmol thread only, cleared when the atlas is destroyed
+    std::mutex mtx;
+    std::condition_variable cv;
+    int inflight = 0;
+    std::atomic<bool> cancelled{false};
+};
+
+void FontAtlas::setAsyncGlyphRasterizationEnabled(bool enabled)
+{
+    s_asyncGlyphRasterization = enabled;
+}
+
+bool FontAtlas::isAsyncGlyphRasterizationEnabled()
+{
+    return s_asyncGlyphRasterization;
+}
+
+FontAtlas::GlyphStats FontAtlas::getFrameGlyphStats()
+{
+    currentGlyphStats();
+    return s_lastFrameGlyphStats;
+}
+
 void FontAtlas::loadFontAtlas(std::string_view fontatlasFile, hlookup::string_map<FontAtlas*>& outAtlasMap)
 {
     using namespace simdjson;
@@ -183,6 +243,15 @@ void FontAtlas::reinit()
 
 FontAtlas::~FontAtlas()
 {
+    if (_glyphQueue)
+    {
+        // the workers render with our fonts, wait for them
+        _glyphQueue->cancelled = true;
+        std::unique_lock<std::mutex> lock(_glyphQueue->mtx);
+        _glyphQueue->cv.wait(lock, [this] { return _glyphQueue->inflight == 0; });
+        _glyphQueue->owner = nullptr;
+    }
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     if (_fontFreeType && _rendererRecreatedListener)
     {
@@ -254,6 +323,10 @@ void FontAtlas::reset()
     _currentPageOrigX = 0;
     _currentPageOrigY = 0;
     _letterDefinitions.clear();
+    _pendingGlyphs.clear();
+    ++_glyphEpoch;
+    _filledPages.clear();
+    _cacheDirty = false;
 
     reinit();
 }
@@ -330,7 +403,7 @@ void FontAtlas::findNewCharacters(const std::u32string& u32Text, std::unordered_
     }
 }
 
-bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
+bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text, bool waitForGlyphs)
 {
     if (_fontFreeType == nullptr)
     {
@@ -342,127 +415,367 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
 
     std::unordered_set<char32_t> charCodeSet;
     findNewCharacters(utf32Text, charCodeSet);
+
+    const bool async = !waitForGlyphs && s_asyncGlyphRasterization && Director::getInstance()->getJobSystem();
+    auto& stats      = currentGlyphStats();
+    bool tookPending = false;
+    if (!_pendingGlyphs.empty())
+    {
+        for (auto&& charCode : utf32Text)
+        {
+            if (_pendingGlyphs.find(charCode) == _pendingGlyphs.end())
+                continue;
+            if (async)
+            {
+                ++stats.misses;
+            }
+            else if (charCodeSet.insert(charCode).second)
+            {
+                // rasterize it right away, the worker result gets dropped
+                _pendingGlyphs.erase(charCode);
+                tookPending = true;
+            }
+        }
+    }
+
     if (charCodeSet.empty())
     {
         return false;
     }
 
-    int adjustForDistanceMap = _letterPadding / 2;
-    int adjustForExtend      = _letterEdgeExtend / 2;
-    int bitmapWidth          = 0;
-    int bitmapHeight         = 0;
-    int glyphHeight;
-    Rect tempRect;
-    FontLetterDefinition tempDef;
-
-    auto pixelFormat = _pixelFormat;
+    stats.misses += static_cast<unsigned int>(charCodeSet.size());
+    if (async)
+    {
+        queueGlyphs(charCodeSet);
+        return true;
+    }
 
     int startY = (int)_currentPageOrigY;
 
+    GlyphBitmap glyph;
     for (auto&& charCode : charCodeSet)
     {
-        auto missingIt             = _missingGlyphFallbackFonts.find(charCode);
-        uint8_t* bitmap            = nullptr;
-        FontFreeType* charRenderer = _fontFreeType;
-        if (missingIt == _missingGlyphFallbackFonts.end())
+        glyph          = GlyphBitmap{};
+        glyph.charCode = charCode;
+        rasterizeGlyph(glyph);
+        packGlyph(glyph, startY);
+    }
+    stats.rasterized += static_cast<unsigned int>(charCodeSet.size());
+
+    updateTextureContent(_pixelFormat, startY);
+
+    // other labels may be waiting for them
+    if (tookPending)
+        ++_glyphGeneration;
+
+    return true;
+}
+
+size_t FontAtlas::prewarmGlyphs(std::u32string_view charset)
+{
+    if (_fontFreeType == nullptr)
+        return 0;
+
+    if (!_currentPageData)
+        reinit();
+
+    std::unordered_set<char32_t> charCodeSet;
+    for (auto&& charCode : charset)
+        if (_letterDefinitions.find(charCode) == _letterDefinitions.end())
+            charCodeSet.insert(charCode);
+
+    if (charCodeSet.empty())
+        return 0;
+
+    if (Director::getInstance()->getJobSystem())
+    {
+        queueGlyphs(charCodeSet);
+    }
+    else
+    {
+        std::u32string utf32Text(charCodeSet.begin(), charCodeSet.end());
+        prepareLetterDefinitions(utf32Text, true);
+    }
+    return charCodeSet.size();
+}
+
+size_t FontAtlas::prewarmGlyphs(std::string_view utf8Charset)
+{
+    std::u32string utf32;
+    if (!StringUtils::UTF8ToUTF32(utf8Charset, utf32))
+        return 0;
+    return prewarmGlyphs(std::u32string_view{utf32});
+}
+
+bool FontAtlas::hasPendingGlyphs(const std::u32string& utf32Text) const
+{
+    if (_pendingGlyphs.empty())
+        return false;
+
+    for (auto&& charCode : utf32Text)
+        if (_pendingGlyphs.find(charCode) != _pendingGlyphs.end())
+            return true;
+    return false;
+}
+
+void FontAtlas::rasterizeGlyph(GlyphBitmap& glyph)
+{
+    auto charCode  = glyph.charCode;
+    auto missingIt = _missingGlyphFallbackFonts.find(charCode);
+    if (missingIt == _missingGlyphFallbackFonts.end())
+    {
+        FontFaceInfo* fallbackFaceInfo = nullptr;
+        glyph.renderer                 = _fontFreeType;
         {
-            FontFaceInfo* fallbackFaceInfo = nullptr;
-            bitmap = charRenderer->getGlyphBitmap(charCode, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance,
-                                                  &fallbackFaceInfo);
-            if (!bitmap && fallbackFaceInfo)
-            {
-                auto fallbackIt = _missingFallbackFonts.find(fallbackFaceInfo->family);
-                if (fallbackIt != _missingFallbackFonts.end())
-                {
-                    charRenderer = fallbackIt->second;
-                }
-                else
-                {
-                    charRenderer = FontFreeType::createWithFaceInfo(fallbackFaceInfo, _fontFreeType);
-                    if (charRenderer)
-                        _missingFallbackFonts.insert(fallbackFaceInfo->family, charRenderer);
-                }
+            std::lock_guard<std::mutex> lock(_fontFreeType->getFaceMutex());
+            auto bitmap = _fontFreeType->getGlyphBitmap(charCode, glyph.width, glyph.height, glyph.rect,
+                                                        glyph.xAdvance, &fallbackFaceInfo);
+            takeGlyphBitmap(glyph, bitmap);
+        }
 
+        if (!glyph.data && fallbackFaceInfo)
+        {
+            FontFreeType* charRenderer = nullptr;
+            auto fallbackIt            = _missingFallbackFonts.find(fallbackFaceInfo->family);
+            if (fallbackIt != _missingFallbackFonts.end())
+            {
+                charRenderer = fallbackIt->second;
+            }
+            else
+            {
+                charRenderer = FontFreeType::createWithFaceInfo(fallbackFaceInfo, _fontFreeType);
                 if (charRenderer)
-                {
-                    unsigned int glyphIndex = fallbackFaceInfo->currentGlyphIndex;
-                    bitmap =
-                        charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
-                    _missingGlyphFallbackFonts.emplace(charCode, std::make_pair(charRenderer, glyphIndex));
-                }
+                    _missingFallbackFonts.insert(fallbackFaceInfo->family, charRenderer);
             }
-        }
-        else
-        {  // found fallback font for missing charas, getGlyphBitmap without fallback
-            charRenderer = missingIt->second.first;
-            unsigned int glyphIndex = missingIt->second.second;
-            bitmap = charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
-        }
-        if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
-        {
-            tempDef.validDefinition = true;
-            tempDef.width           = tempRect.size.width + _letterPadding + _letterEdgeExtend;
-            tempDef.height          = tempRect.size.height + _letterPadding + _letterEdgeExtend;
-            tempDef.offsetX         = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
-            tempDef.offsetY         = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
 
-            if (_currentPageOrigX + tempDef.width > _width)
+            if (charRenderer)
             {
-                _currentPageOrigY += _currLineHeight;
-                _currLineHeight   = 0;
-                _currentPageOrigX = 0;
-                if (_currentPageOrigY + _lineHeight + _letterPadding + _letterEdgeExtend >= _height)
-                {
-                    updateTextureContent(pixelFormat, startY);
+                glyph.renderer   = charRenderer;
+                glyph.glyphIndex = fallbackFaceInfo->currentGlyphIndex;
+                _missingGlyphFallbackFonts.emplace(charCode, std::make_pair(charRenderer, glyph.glyphIndex));
+
+                std::lock_guard<std::mutex> lock(charRenderer->getFaceMutex());
+                auto bitmap = charRenderer->getGlyphBitmapByIndex(glyph.glyphIndex, glyph.width, glyph.height,
+                                                                  glyph.rect, glyph.xAdvance);
+                takeGlyphBitmap(glyph, bitmap);
+            }
+        }
+    }
+    else
+    {  // found fallback font for missing charas, getGlyphBitmap without fallback
+        glyph.renderer   = missingIt->second.first;
+        glyph.glyphIndex = missingIt->second.second;
+
+        std::lock_guard<std::mutex> lock(glyph.renderer->getFaceMutex());
+        auto bitmap = glyph.renderer->getGlyphBitmapByIndex(glyph.glyphIndex, glyph.width, glyph.height, glyph.rect,
+                                                            glyph.xAdvance);
+        takeGlyphBitmap(glyph, bitmap);
+    }
+}
 
-                    startY = 0;
+void FontAtlas::rasterizeGlyphAsync(GlyphBitmap& glyph)
+{
+    std::lock_guard<std::mutex> lock(glyph.renderer->getFaceMutex());
+    if (!glyph.glyphIndex)
+        glyph.glyphIndex = glyph.renderer->getGlyphIndex(glyph.charCode);
+    if (!glyph.glyphIndex)
+    {
+        // fallback font lookup and creation stay on the axmol thread
+        glyph.deferred = true;
+        return;
+    }
 
-                    addNewPage();
-                }
-            }
-            glyphHeight = static_cast<int>(bitmapHeight) + _letterPadding + _letterEdgeExtend;
-            if (glyphHeight > _currLineHeight)
+    auto bitmap = glyph.renderer->getGlyphBitmapByIndex(glyph.glyphIndex, glyph.width, glyph.height, glyph.rect,
+                                                        glyph.xAdvance);
+    takeGlyphBitmap(glyph, bitmap);
+}
+
+void FontAtlas::takeGlyphBitmap(GlyphBitmap& glyph, uint8_t* bitmap)
+{
+    // outlined bitmaps are allocated for the caller, the others live in the glyph slot of the face
+    const bool owned = glyph.renderer->getOutlineSize() > 0;
+    if (!bitmap || glyph.width <= 0 || glyph.height <= 0)
+    {
+        if (bitmap && owned)
+            delete[] bitmap;
+        glyph.data.reset();
+        return;
+    }
+
+    if (owned)
+    {
+        glyph.data.reset(bitmap);
+    }
+    else
+    {
+        const size_t size = static_cast<size_t>(glyph.width) * glyph.height;
+        glyph.data.reset(new uint8_t[size]);
+        memcpy(glyph.data.get(), bitmap, size);
+    }
+}
+
+void FontAtlas::packGlyph(GlyphBitmap& glyph, int& startY)
+{
+    int adjustForDistanceMap = _letterPadding / 2;
+    int adjustForExtend      = _letterEdgeExtend / 2;
+    FontLetterDefinition tempDef;
+    tempDef.xAdvance = glyph.xAdvance;
+
+    if (glyph.data)
+    {
+        auto& tempRect          = glyph.rect;
+        tempDef.validDefinition = true;
+        tempDef.width           = tempRect.size.width + _letterPadding + _letterEdgeExtend;
+        tempDef.height          = tempRect.size.height + _letterPadding + _letterEdgeExtend;
+        tempDef.offsetX         = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
+        tempDef.offsetY         = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
+
+        if (_currentPageOrigX + tempDef.width > _width)
+        {
+            _currentPageOrigY += _currLineHeight;
+            _currLineHeight   = 0;
+            _currentPageOrigX = 0;
+            if (_currentPageOrigY + _lineHeight + _letterPadding + _letterEdgeExtend >= _height)
             {
-                _currLineHeight = glyphHeight;
+                updateTextureContent(_pixelFormat, startY);
+
+                startY = 0;
+
+                addNewPage();
             }
-            charRenderer->renderCharAt(_currentPageData, (int)_currentPageOrigX + adjustForExtend,
-                                       (int)_currentPageOrigY + adjustForExtend, bitmap, bitmapWidth, bitmapHeight,
-                                        _width, _height);
-
-            tempDef.U         = _currentPageOrigX;
-            tempDef.V         = _currentPageOrigY;
-            tempDef.textureID = _currentPage;
-            _currentPageOrigX += tempDef.width + 1;
-            // take from pixels to points
-            tempDef.width   = tempDef.width / _scaleFactor;
-            tempDef.height  = tempDef.height / _scaleFactor;
-            tempDef.U       = tempDef.U / _scaleFactor;
-            tempDef.V       = tempDef.V / _scaleFactor;
-            tempDef.rotated = false;
         }
-        else
+        int glyphHeight = glyph.height + _letterPadding + _letterEdgeExtend;
+        if (glyphHeight > _currLineHeight)
+        {
+            _currLineHeight = glyphHeight;
+        }
+        // renderCharAt takes the ownership of outlined bitmaps
+        auto bitmap = glyph.renderer->getOutlineSize() > 0 ? glyph.data.release() : glyph.data.get();
+        glyph.renderer->renderCharAt(_currentPageData, (int)_currentPageOrigX + adjustForExtend,
+                                     (int)_currentPageOrigY + adjustForExtend, bitmap, glyph.width, glyph.height,
+                                     _width, _height);
+
+        tempDef.U         = _currentPageOrigX;
+        tempDef.V         = _currentPageOrigY;
+        tempDef.textureID = _currentPage;
+        _currentPageOrigX += tempDef.width + 1;
+        // take from pixels to points
+        tempDef.width   = tempDef.width / _scaleFactor;
+        tempDef.height  = tempDef.height / _scaleFactor;
+        tempDef.U       = tempDef.U / _scaleFactor;
+        tempDef.V       = tempDef.V / _scaleFactor;
+        tempDef.rotated = false;
+    }
+    else
+    {
+        tempDef.validDefinition = !!tempDef.xAdvance;
+        tempDef.width           = 0;
+        tempDef.height          = 0;
+        tempDef.U               = 0;
+        tempDef.V               = 0;
+        tempDef.offsetX         = 0;
+        tempDef.offsetY         = 0;
+        tempDef.textureID       = 0;
+        tempDef.rotated         = false;
+        _currentPageOrigX += 1;
+    }
+
+    _letterDefinitions[glyph.charCode] = tempDef;
+    _cacheDirty                        = true;
+}
+
+void FontAtlas::queueGlyphs(const std::unordered_set<char32_t>& charCodeSet)
+{
+    // laid out as an empty quad until the glyph is packed
+    FontLetterDefinition placeholder{};
+    placeholder.validDefinition = true;
+    placeholder.xAdvance        = _fontAscender;
+
+    std::vector<GlyphBitmap> glyphs;
+    glyphs.reserve(charCodeSet.size());
+    for (auto&& charCode : charCodeSet)
+    {
+        if (!_pendingGlyphs.insert(charCode).second)
+            continue;
+        _letterDefinitions[charCode] = placeholder;
+
+        auto& glyph    = glyphs.emplace_back();
+        glyph.charCode = charCode;
+        glyph.renderer = _fontFreeType;
+        auto missingIt = _missingGlyphFallbackFonts.find(charCode);
+        if (missingIt != _missingGlyphFallbackFonts.end())
         {
-            if (bitmap)
-                delete[] bitmap;
-
-            tempDef.validDefinition = !!tempDef.xAdvance;
-            tempDef.width           = 0;
-            tempDef.height          = 0;
-            tempDef.U               = 0;
-            tempDef.V               = 0;
-            tempDef.offsetX         = 0;
-            tempDef.offsetY         = 0;
-            tempDef.textureID       = 0;
-            tempDef.rotated         = false;
-            _currentPageOrigX += 1;
+            glyph.renderer   = missingIt->second.first;
+            glyph.glyphIndex = missingIt->second.second;
         }
+    }
 
-        _letterDefinitions[charCode] = tempDef;
+    if (!_glyphQueue)
+    {
+        _glyphQueue        = std::make_shared<GlyphQueue>();
+        _glyphQueue->owner = this;
+    }
+
+    // split large charsets so several workers share them, glyphs of a face are still rendered one at a time
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    for (size_t first = 0; first < glyphs.size(); first += GLYPH_BATCH_SIZE)
+    {
+        auto last  = (std::min)(first + GLYPH_BATCH_SIZE, glyphs.size());
+        auto batch = std::make_shared<std::vector<GlyphBitmap>>(std::make_move_iterator(glyphs.begin() + first),
+                                                                std::make_move_iterator(glyphs.begin() + last));
+        {
+            std::lock_guard<std::mutex> lock(_glyphQueue->mtx);
+            ++_glyphQueue->inflight;
+        }
+        jobSystem->enqueue(
+            [queue = _glyphQueue, batch] {
+                for (auto&& glyph : *batch)
+                {
+                    if (queue->cancelled.load(std::memory_order_relaxed))
+                        break;
+                    rasterizeGlyphAsync(glyph);
+                }
+                std::lock_guard<std::mutex> lock(queue->mtx);
+                --queue->inflight;
+                queue->cv.notify_all();
+            },
+            [queue = _glyphQueue, batch, epoch = _glyphEpoch] {
+                if (queue->owner)
+                    queue->owner->commitGlyphs(*batch, epoch);
+            });
     }
+}
 
-    updateTextureContent(pixelFormat, startY);
+void FontAtlas::commitGlyphs(std::vector<GlyphBitmap>& glyphs, unsigned int epoch)
+{
+    if (epoch != _glyphEpoch || !_currentPageData)
+        return;
 
-    return true;
+    int startY          = (int)_currentPageOrigY;
+    unsigned int packed = 0;
+    for (auto&& glyph : glyphs)
+    {
+        // already rasterized on the axmol thread by a label waiting for it
+        if (_pendingGlyphs.erase(glyph.charCode) == 0)
+            continue;
+
+        if (glyph.deferred)
+        {
+            auto charCode  = glyph.charCode;
+            glyph          = GlyphBitmap{};
+            glyph.charCode = charCode;
+            rasterizeGlyph(glyph);
+        }
+        packGlyph(glyph, startY);
+        ++packed;
+    }
+
+    if (packed)
+    {
+        updateTextureContent(_pixelFormat, startY);
+        currentGlyphStats().asyncRasterized += packed;
+        ++_glyphGeneration;
+    }
 }
 
 void FontAtlas::updateTextureContent(backend::PixelFormat format, int startY)
@@ -474,12 +787,206 @@ void FontAtlas::updateTextureContent(backend::PixelFormat format, int startY)
 
 void FontAtlas::addNewPage()
 {
+    // the texture of a filled page can't be read back, keep its pixels for the binary cache
+    if (!_cacheFile.empty() && _currentPage >= 0)
+    {
+        auto& page = _filledPages.emplace_back(new uint8_t[_currentPageDataSize]);
+        memcpy(page.get(), _currentPageData, _currentPageDataSize);
+    }
+
     memset(_currentPageData, 0, _currentPageDataSize);
     addNewPageWithData(_currentPageData, _currentPageDataSize);
 
     _currentPageOrigY = 0;
 }
 
+void FontAtlas::setCacheFile(std::string_view cacheFile, uint64_t fontHash)
+{
+    _cacheFile     = cacheFile;
+    _cacheFontHash = fontHash;
+}
+
+bool FontAtlas::loadCache()
+{
+    if (_cacheFile.empty() || !_fontFreeType || _currentPage >= 0)
+        return false;
+
+    auto mappedFile = FileUtils::getInstance()->mapFile(_cacheFile);
+    if (!mappedFile || mappedFile->empty())
+        return false;
+
+    std::vector<std::pair<char32_t, FontLetterDefinition>> letters;
+    std::vector<std::span<const uint8_t>> pages;
+    float pageX = 0, pageY = 0;
+    int lineHeight = 0;
+    try
+    {
+        yasio::ibstream_view ibs(mappedFile->data(), mappedFile->size());
+        if (ibs.read<uint32_t>() != FONTATLAS_CACHE_MAGIC || ibs.read<uint32_t>() != FONTATLAS_CACHE_VERSION)
+            return false;
+
+        // the settings the glyphs were rasterized with
+        bool matches = ibs.read<uint64_t>() == _cacheFontHash;
+        matches      = ibs.read<uint32_t>() == FONTATLAS_CACHE_FT_VERSION && matches;
+        matches      = ibs.read<uint8_t>() == FontFreeType::isNativeBytecodeHintingEnabled() && matches;
+        matches      = ibs.read<float>() == _fontFreeType->getOutlineSize() && matches;
+        matches      = ibs.read<uint8_t>() == _fontFreeType->isDistanceFieldEnabled() && matches;
+        matches      = ibs.read<int32_t>() == _fontFreeType->getFontMaxHeight() && matches;
+        matches      = ibs.read<float>() == _scaleFactor && matches;
+        matches      = ibs.read<int32_t>() == _width && matches;
+        matches      = ibs.read<int32_t>() == _height && matches;
+        matches      = ibs.read<int32_t>() == static_cast<int32_t>(_pixelFormat) && matches;
+        if (!matches)
+        {
+            AXLOGD("FontAtlas: the cache {} is out of date", _cacheFile);
+            return false;
+        }
+
+        pageX      = ibs.read<float>();
+        pageY      = ibs.read<float>();
+        lineHeight = ibs.read<int32_t>();
+
+        auto letterCount = ibs.read<uint32_t>();
+        letters.resize(letterCount);
+        for (auto&& [charCode, letterDef] : letters)
+        {
+            charCode                  = ibs.read<uint32_t>();
+            letterDef.U               = ibs.read<float>();
+            letterDef.V               = ibs.read<float>();
+            letterDef.width           = ibs.read<float>();
+            letterDef.height          = ibs.read<float>();
+            letterDef.offsetX         = ibs.read<float>();
+            letterDef.offsetY         = ibs.read<float>();
+            letterDef.textureID       = ibs.read<int32_t>();
+            letterDef.xAdvance        = ibs.read<int32_t>();
+            letterDef.validDefinition = !!ibs.read<uint8_t>();
+            letterDef.rotated         = false;
+        }
+
+        auto pageCount = ibs.read<uint32_t>();
+        for (uint32_t i = 0; i < pageCount; ++i)
+        {
+            auto bytes = ibs.read_v32();
+            pages.emplace_back(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        AXLOGW("FontAtlas: the cache {} is corrupted, {}", _cacheFile, ex.what());
+        return false;
+    }
+
+    if (pages.empty())
+        return false;
+
+    if (!_currentPageData)
+        _currentPageData = new uint8_t[_currentPageDataSize];
+
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        auto pixels = ZipUtils::decompressGZ(pages[i], _currentPageDataSize);
+        if (pixels.size() != static_cast<size_t>(_currentPageDataSize))
+        {
+            AXLOGW("FontAtlas: the cache {} is corrupted, bad page {}", _cacheFile, i);
+            reset();
+            return false;
+        }
+
+        addNewPageWithData(pixels.data(), pixels.size());
+        if (i + 1 < pages.size())
+        {
+            auto& page = _filledPages.emplace_back(new uint8_t[_currentPageDataSize]);
+            memcpy(page.get(), pixels.data(), _currentPageDataSize);
+        }
+        else
+        {
+            memcpy(_currentPageData, pixels.data(), _currentPageDataSize);
+        }
+    }
+
+    _currentPageOrigX = pageX;
+    _currentPageOrigY = pageY;
+    _currLineHeight   = lineHeight;
+    for (auto&& [charCode, letterDef] : letters)
+        _letterDefinitions.emplace(charCode, letterDef);
+    _cacheDirty = false;
+
+    return true;
+}
+
+bool FontAtlas::saveCache()
+{
+    if (_cacheFile.empty() || !_fontFreeType || _currentPage < 0 || !_currentPageData)
+        return false;
+
+    yasio::obstream obs;
+    obs.write<uint32_t>(FONTATLAS_CACHE_MAGIC);
+    obs.write<uint32_t>(FONTATLAS_CACHE_VERSION);
+
+    obs.write<uint64_t>(_cacheFontHash);
+    obs.write<uint32_t>(FONTATLAS_CACHE_FT_VERSION);
+    obs.write<uint8_t>(FontFreeType::isNativeBytecodeHintingEnabled());
+    obs.write<float>(_fontFreeType->getOutlineSize());
+    obs.write<uint8_t>(_fontFreeType->isDistanceFieldEnabled());
+    obs.write<int32_t>(_fontFreeType->getFontMaxHeight());
+    obs.write<float>(_scaleFactor);
+    obs.write<int32_t>(_width);
+    obs.write<int32_t>(_height);
+    obs.write<int32_t>(static_cast<int32_t>(_pixelFormat));
+
+    obs.write<float>(_currentPageOrigX);
+    obs.write<float>(_currentPageOrigY);
+    obs.write<int32_t>(_currLineHeight);
+
+    auto letterCountOffset = obs.length();
+    uint32_t letterCount   = 0;
+    obs.write<uint32_t>(letterCount);
+    for (auto&& [charCode, letterDef] : _letterDefinitions)
+    {
+        // placeholders of glyphs queued for workers
+        if (_pendingGlyphs.find(charCode) != _pendingGlyphs.end())
+            continue;
+
+        obs.write<uint32_t>(charCode);
+        obs.write<float>(letterDef.U);
+        obs.write<float>(letterDef.V);
+        obs.write<float>(letterDef.width);
+        obs.write<float>(letterDef.height);
+        obs.write<float>(letterDef.offsetX);
+        obs.write<float>(letterDef.offsetY);
+        obs.write<int32_t>(letterDef.textureID);
+        obs.write<int32_t>(letterDef.xAdvance);
+        obs.write<uint8_t>(letterDef.validDefinition);
+        ++letterCount;
+    }
+    obs.pwrite(letterCountOffset, letterCount);
+
+    obs.write<uint32_t>(static_cast<uint32_t>(_filledPages.size() + 1));
+    auto writePage = [&obs, this](const uint8_t* pixels) {
+        auto compressed = ZipUtils::compressGZ(pixels, _currentPageDataSize);
+        obs.write_v32(std::string_view{reinterpret_cast<const char*>(compressed.data()), compressed.size()});
+    };
+    for (auto&& page : _filledPages)
+        writePage(page.get());
+    writePage(_currentPageData);
+
+    auto fileUtils = FileUtils::getInstance();
+    auto slash     = _cacheFile.find_last_of('/');
+    if (slash != std::string::npos)
+        fileUtils->createDirectories(std::string_view{_cacheFile}.substr(0, slash + 1));
+
+    // write aside then rename, a cache mapped by another atlas stays valid
+    auto tempFile = _cacheFile + ".tmp"s;
+    if (!FileUtils::writeBinaryToFile(obs.data(), obs.length(), tempFile) || !fileUtils->renameFile(tempFile, _cacheFile))
+    {
+        AXLOGW("FontAtlas: write cache {} fail", _cacheFile);
+        return false;
+    }
+
+    _cacheDirty = false;
+    return true;
+}
+
 void FontAtlas::addNewPageWithData(const uint8_t* data, size_t size)
 {
     assert(_currentPageDataSize == size);
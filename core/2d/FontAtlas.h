@@ -32,6 +32,9 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <vector>
 
 #include "platform/PlatformMacros.h"
 #include "base/Object.h"
@@ -66,11 +69,34 @@ struct FontLetterDefinition
 class AX_DLL FontAtlas : public Object
 {
 public:
+    /** Glyph cache counters of one frame. */
+    struct GlyphStats
+    {
+        unsigned int misses          = 0;  // letters not ready in an atlas when text was laid out
+        unsigned int rasterized      = 0;  // glyphs rasterized on the axmol thread
+        unsigned int asyncRasterized = 0;  // glyphs rasterized by workers and packed into pages
+    };
+
     static const int CacheTextureWidth;
     static const int CacheTextureHeight;
     static const char* CMD_PURGE_FONTATLAS;
     static const char* CMD_RESET_FONTATLAS;
     static void loadFontAtlas(std::string_view fontatlasFile, hlookup::string_map<FontAtlas*>& outAtlasMap);
+
+    /**
+     * Whether missing glyphs are rasterized by the JobSystem workers, by default: disabled.
+     * While enabled, letters are laid out with empty quads until their glyphs are packed into
+     * the atlas on a later frame, unless prepareLetterDefinitions is asked to wait.
+     * @since axmol-2.2
+     */
+    static void setAsyncGlyphRasterizationEnabled(bool enabled);
+    static bool isAsyncGlyphRasterizationEnabled();
+
+    /**
+     * Gets the glyph cache counters of the last frame, summed over all atlases.
+     * @since axmol-2.2
+     */
+    static GlyphStats getFrameGlyphStats();
     /**
      * @js ctor
      */
@@ -85,7 +111,54 @@ public:
     void addLetterDefinition(char32_t utf32Char, const FontLetterDefinition& letterDefinition);
     bool getLetterDefinitionForChar(char32_t utf32Char, FontLetterDefinition& letterDefinition);
 
-    bool prepareLetterDefinitions(const std::u32string& utf16String);
+    /**
+     * Adds the letter definitions of the characters of utf32Text missing in the atlas.
+     *
+     * @param waitForGlyphs Whether to rasterize the missing glyphs on the calling thread even if
+     * async glyph rasterization is enabled, glyphs still queued for workers are rasterized too.
+     * @return true if letter definitions were added.
+     */
+    bool prepareLetterDefinitions(const std::u32string& utf32Text, bool waitForGlyphs = false);
+
+    /**
+     * Queues the glyphs of charset missing in the atlas to the JobSystem workers, usually at load
+     * time so text shows up without hitches later. Falls back to rasterizing them right away when
+     * there is no job system.
+     *
+     * @return The number of glyphs queued or rasterized.
+     * @since axmol-2.2
+     */
+    size_t prewarmGlyphs(std::u32string_view charset);
+    size_t prewarmGlyphs(std::string_view utf8Charset);
+
+    /** Gets the number of glyphs queued for rasterization and not packed yet. */
+    size_t getPendingGlyphCount() const { return _pendingGlyphs.size(); }
+
+    /** Whether some letters of utf32Text are waiting for their glyphs. */
+    bool hasPendingGlyphs(const std::u32string& utf32Text) const;
+
+    /** Increased whenever glyphs rasterized by workers are packed into the atlas. */
+    unsigned int getGlyphGeneration() const { return _glyphGeneration; }
+
+    /**
+     * Sets the binary cache file of a TTF atlas, see FontAtlasCache::setBinaryCacheEnabled.
+     * Must be called before any glyph is added, the atlas then keeps a copy of its filled pages
+     * so they can be written to the cache.
+     *
+     * @param fontHash The hash of the font file, the cache is ignored if it was built from another file.
+     * @since axmol-2.2
+     */
+    void setCacheFile(std::string_view cacheFile, uint64_t fontHash);
+    std::string_view getCacheFile() const { return _cacheFile; }
+
+    /** Loads the glyphs and pages of the cache file, fails if it doesn't match the font settings. */
+    bool loadCache();
+
+    /** Writes the glyphs and pages to the cache file, glyphs still queued for workers are skipped. */
+    bool saveCache();
+
+    /** Whether glyphs were added since the cache file was loaded or saved. */
+    bool isCacheDirty() const { return _cacheDirty; }
 
     const auto& getLetterDefinitions() const { return _letterDefinitions; }
 
@@ -128,6 +201,20 @@ public:
     void setAliasTexParameters();
 
 protected:
+    struct GlyphBitmap
+    {
+        char32_t charCode       = 0;
+        FontFreeType* renderer  = nullptr;
+        unsigned int glyphIndex = 0;  // 0: lookup by charCode
+        std::unique_ptr<uint8_t[]> data;
+        int width    = 0;
+        int height   = 0;
+        int xAdvance = 0;
+        Rect rect;
+        bool deferred = false;  // the worker couldn't render it without fallback fonts
+    };
+    struct GlyphQueue;
+
     void initWithSettings(void* opaque /*simdjson::ondemand::document*/);
 
     void reset();
@@ -147,6 +234,20 @@ protected:
 
     void updateTextureContent(backend::PixelFormat format, int startY);
 
+    /** Rasterizes a glyph on the axmol thread, looking up fallback fonts if needed. */
+    void rasterizeGlyph(GlyphBitmap& glyph);
+
+    /** Rasterizes a glyph on a worker, glyphs needing fallback fonts are only marked deferred. */
+    static void rasterizeGlyphAsync(GlyphBitmap& glyph);
+
+    static void takeGlyphBitmap(GlyphBitmap& glyph, uint8_t* bitmap);
+
+    /** Packs a rasterized glyph into the current page and updates its letter definition. */
+    void packGlyph(GlyphBitmap& glyph, int& startY);
+
+    void queueGlyphs(const std::unordered_set<char32_t>& charCodeSet);
+    void commitGlyphs(std::vector<GlyphBitmap>& glyphs, unsigned int epoch);
+
     std::unordered_map<unsigned int, Texture2D*> _atlasTextures;
     std::unordered_map<char32_t, FontLetterDefinition> _letterDefinitions;
 
@@ -179,6 +280,18 @@ protected:
     bool _antialiasEnabled                          = true;
     int _currLineHeight                             = 0;
 
+    // async glyph rasterization
+    std::shared_ptr<GlyphQueue> _glyphQueue;
+    std::unordered_set<char32_t> _pendingGlyphs;
+    unsigned int _glyphEpoch      = 0;  // increased by reset, drops glyphs queued before
+    unsigned int _glyphGeneration = 0;
+
+    // binary cache
+    std::string _cacheFile;
+    uint64_t _cacheFontHash = 0;
+    bool _cacheDirty        = false;
+    std::vector<std::unique_ptr<uint8_t[]>> _filledPages;  // pixels of the pages before the current one
+
     friend class Label;
 };
 
@@ -33,18 +33,30 @@
 #include "2d/FontCharMap.h"
 #include "2d/Label.h"
 #include "platform/FileUtils.h"
+#include "platform/MappedFile.h"
 #include "base/format.h"
+#include "xxhash/xxhash.h"
 
 namespace ax
 {
 
 hlookup::string_map<FontAtlas*> FontAtlasCache::_atlasMap;
+bool FontAtlasCache::_binaryCacheEnabled = false;
+
+// the hashes of the font files the binary caches are keyed by
+static hlookup::string_map<uint64_t> s_fontFileHashes;
+
+static std::string getBinaryCacheDir()
+{
+    return FileUtils::getInstance()->getWritablePath() + "fontatlas/"s;
+}
 
 void FontAtlasCache::purgeCachedData()
 {
     auto atlasMapCopy = _atlasMap;
     for (auto&& atlas : atlasMapCopy)
     {
+        saveBinaryCache(atlas.second);
         auto refCount = atlas.second->getReferenceCount();
         atlas.second->release();
         if (refCount != 1)
@@ -82,7 +94,25 @@ FontAtlas* FontAtlasCache::getFontAtlasTTF(_ttfConfig* config)
                                          useDistanceField, static_cast<float>(outlineSize));
         if (font)
         {
-            auto tempAtlas = font->newFontAtlas();
+            FontAtlas* tempAtlas = nullptr;
+            uint64_t fontHash    = 0;
+            std::string cacheFile;
+            if (_binaryCacheEnabled)
+                cacheFile = getBinaryCacheFile(realFontFilename, scaledFaceSize, outlineSize, useDistanceField, fontHash);
+            if (!cacheFile.empty())
+            {
+                tempAtlas = new FontAtlas(font);
+                tempAtlas->setCacheFile(cacheFile, fontHash);
+                tempAtlas->loadCache();
+
+                // the cache may miss some glyphs of the collection
+                std::u32string utf32;
+                if (StringUtils::UTF8ToUTF32(font->getGlyphCollection(), utf32) && !utf32.empty())
+                    tempAtlas->prepareLetterDefinitions(utf32, true);
+            }
+            else
+                tempAtlas = font->newFontAtlas();
+
             if (tempAtlas)
                 return _atlasMap.emplace(std::move(atlasName), tempAtlas).first->second;
         }
@@ -225,6 +255,7 @@ bool FontAtlasCache::releaseFontAtlas(FontAtlas* atlas)
     {
         if (atlas->getReferenceCount() == 1)
         {
+            saveBinaryCache(atlas);
             for (auto&& item : _atlasMap)
             {
                 if (item.second == atlas)
@@ -273,6 +304,7 @@ void FontAtlasCache::unloadFontAtlasTTF(std::string_view fontFileName)
     {
         if (iter->first.find(fontFileName) != std::string::npos)
         {
+            saveBinaryCache(iter->second);
             AX_SAFE_RELEASE_NULL(iter->second);
             iter = _atlasMap.erase(iter);
             continue;
@@ -281,4 +313,50 @@ void FontAtlasCache::unloadFontAtlasTTF(std::string_view fontFileName)
     }
 }
 
+void FontAtlasCache::setBinaryCacheEnabled(bool enabled)
+{
+    _binaryCacheEnabled = enabled;
+}
+
+void FontAtlasCache::saveBinaryCaches()
+{
+    for (auto&& item : _atlasMap)
+        saveBinaryCache(item.second);
+}
+
+void FontAtlasCache::removeBinaryCaches()
+{
+    FileUtils::getInstance()->removeDirectory(getBinaryCacheDir());
+}
+
+std::string FontAtlasCache::getBinaryCacheFile(std::string_view fontFilePath,
+                                               int faceSize,
+                                               int outlineSize,
+                                               bool distanceFieldEnabled,
+                                               uint64_t& fontHash)
+{
+    auto it = s_fontFileHashes.find(fontFilePath);
+    if (it != s_fontFileHashes.end())
+    {
+        fontHash = it->second;
+    }
+    else
+    {
+        auto mappedFile = FileUtils::getInstance()->mapFile(fontFilePath);
+        if (!mappedFile || mappedFile->empty())
+            return {};
+        fontHash = XXH3_64bits(mappedFile->data(), mappedFile->size());
+        s_fontFileHashes.emplace(fontFilePath, fontHash);
+    }
+
+    return fmt::format("{}{:016x}-{}-{}{}.axfc", getBinaryCacheDir(), fontHash, faceSize, outlineSize,
+                       distanceFieldEnabled ? "-df" : "");
+}
+
+void FontAtlasCache::saveBinaryCache(FontAtlas* atlas)
+{
+    if (atlas && atlas->isCacheDirty())
+        atlas->saveCache();
+}
+
 }
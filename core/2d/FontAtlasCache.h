@@ -84,8 +84,33 @@ public:
     */
     static void unloadFontAtlasTTF(std::string_view fontFileName);
 
+    /**
+     * Whether TTF atlases are persisted to binary caches in the writable path, by default: disabled.
+     * A cache holds the letter definitions and the compressed pages of an atlas, it's keyed by the
+     * font file hash, face size, outline size and distance field setting. Later launches map it
+     * instead of rasterizing the glyphs with FreeType again.
+     * Caches are written when an atlas is released or purged, and by saveBinaryCaches.
+     * @since axmol-2.2
+     */
+    static void setBinaryCacheEnabled(bool enabled);
+    static bool isBinaryCacheEnabled() { return _binaryCacheEnabled; }
+
+    /** Writes the binary caches of the atlases which got glyphs since loaded, e.g. when the app enters background. */
+    static void saveBinaryCaches();
+
+    /** Removes the binary caches of all fonts from the writable path. */
+    static void removeBinaryCaches();
+
 private:
+    static std::string getBinaryCacheFile(std::string_view fontFilePath,
+                                          int faceSize,
+                                          int outlineSize,
+                                          bool distanceFieldEnabled,
+                                          uint64_t& fontHash);
+    static void saveBinaryCache(FontAtlas* atlas);
+
     static hlookup::string_map<FontAtlas*> _atlasMap;
+    static bool _binaryCacheEnabled;
 };
 
 }
@@ -353,7 +353,7 @@ FontAtlas* FontFreeType::newFontAtlas()
         std::u32string utf32;
         if (StringUtils::UTF8ToUTF32(getGlyphCollection(), utf32))
         {
-            fontAtlas->prepareLetterDefinitions(utf32);
+            fontAtlas->prepareLetterDefinitions(utf32, true);
         }
     }
     return fontAtlas;
@@ -372,6 +372,7 @@ int* FontFreeType::getHorizontalKerningForTextUTF32(const std::u32string& text,
     int* sizes = new int[outNumLetters];
     memset(sizes, 0, outNumLetters * sizeof(int));
 
+    std::lock_guard<std::mutex> lock(_faceMutex);
     bool hasKerning = FT_HAS_KERNING(_fontFace) != 0;
     if (hasKerning)
     {
@@ -588,6 +589,11 @@ unsigned char* FontFreeType::getGlyphBitmapByIndex(unsigned int glyphIndex,
     return nullptr;
 }
 
+unsigned int FontFreeType::getGlyphIndex(char32_t charCode) const
+{
+    return FT_Get_Char_Index(_fontFace, static_cast<FT_ULong>(charCode));
+}
+
 unsigned char* FontFreeType::getGlyphBitmapWithOutline(unsigned int glyphIndex, FT_BBox& bbox)
 {
     unsigned char* ret = nullptr;
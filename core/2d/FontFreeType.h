@@ -29,6 +29,7 @@
 #include "2d/Font.h"
 #include "2d/IFontEngine.h"
 #include <string>
+#include <mutex>
 
 namespace ax
 {
@@ -131,6 +132,17 @@ public:
                                          Rect& outRect,
                                          int& xAdvance);
 
+    /** Gets the glyph index of charCode in the font face, 0 means the face doesn't contain it. */
+    unsigned int getGlyphIndex(char32_t charCode) const;
+
+    /**
+     * The mutex guarding the font face, FreeType faces can be used by one thread at a time.
+     * Hold it while calling getGlyphBitmap or getGlyphBitmapByIndex and using the returned bitmap
+     * off the axmol thread.
+     * @since axmol-2.2
+     */
+    std::mutex& getFaceMutex() const { return _faceMutex; }
+
     int getFontAscender() const;
     const char* getFontFamily() const;
     std::string_view getFontName() const { return _fontName; }
@@ -180,6 +192,8 @@ private:
 
     GlyphCollection _usedGlyphs;
     std::string _customGlyphs;
+
+    mutable std::mutex _faceMutex;
 };
 
 // end of _2d group
@@ -507,11 +507,17 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
     , _strikethroughEnabled(false)
     , _underlineEnabled(false)
 {
+    // updates its letters and font atlas textures in visit
+    _parallelVisitSafe = false;
+
     setAnchorPoint(Vec2::ANCHOR_MIDDLE);
     reset();
     _hAlignment = hAlignment;
     _vAlignment = vAlignment;
 
+    // the atlas dirty flag is forwarded in draw
+    _quadCommand.setDirtyTracking(true);
+
 #if AX_LABEL_DEBUG_DRAW
     _debugDrawNode = DrawNode::create();
     AX_SAFE_RETAIN(_debugDrawNode);
@@ -1024,6 +1030,16 @@ void Label::setLineBreakWithoutSpace(bool breakWithoutSpace)
     }
 }
 
+void Label::setWaitForGlyphs(bool waitForGlyphs)
+{
+    if (waitForGlyphs != _waitForGlyphs)
+    {
+        _waitForGlyphs = waitForGlyphs;
+        if (_waitForGlyphs && _hasPendingGlyphs)
+            _contentDirty = true;
+    }
+}
+
 void Label::updateLabelLetters()
 {
     if (!_letters.empty())
@@ -1084,6 +1100,7 @@ void Label::updateLabelLetters()
 
 bool Label::alignText()
 {
+    _hasPendingGlyphs = false;
     if (_fontAtlas == nullptr || _utf32Text.empty())
     {
         setContentSize(Vec2::ZERO);
@@ -1093,7 +1110,10 @@ bool Label::alignText()
     bool ret = true;
     do
     {
-        _fontAtlas->prepareLetterDefinitions(_utf32Text);
+        _fontAtlas->prepareLetterDefinitions(_utf32Text, _waitForGlyphs);
+        _hasPendingGlyphs = _fontAtlas->hasPendingGlyphs(_utf32Text);
+        if (_hasPendingGlyphs)
+            _pendingGlyphGeneration = _fontAtlas->getGlyphGeneration();
         auto& textures = _fontAtlas->getTextures();
         auto size      = textures.size();
         if (size > static_cast<size_t>(_batchNodes.size()))
@@ -2032,6 +2052,12 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
             if (!textureAtlas->getTotalQuads())
                 return;
 
+            if (textureAtlas->isDirty())
+            {
+                _quadCommand.markContentDirty();
+                textureAtlas->setDirty(false);
+            }
+
             auto texture       = textureAtlas->getTexture();
             auto& pipelineQuad = _quadCommand.getPipelineDescriptor();
             pipelineQuad.programState->setUniform(_mvpMatrixLocation, matrixProjection.m, sizeof(matrixProjection.m));
@@ -2103,6 +2129,10 @@ void Label::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t pare
         return;
     }
 
+    // relayout once the glyphs rasterized by workers were packed
+    if (_hasPendingGlyphs && _fontAtlas && _fontAtlas->getGlyphGeneration() != _pendingGlyphGeneration)
+        _contentDirty = true;
+
     if (_systemFontDirty || _contentDirty)
     {
         // Label overflow shrink fix #566
@@ -543,6 +543,14 @@ public:
      */
     void setLineBreakWithoutSpace(bool breakWithoutSpace);
 
+    /**
+     * Whether to rasterize missing glyphs right away while FontAtlas async glyph rasterization is
+     * enabled, instead of laying out empty letters until the glyphs are ready. By default: false.
+     * @since axmol-2.2
+     */
+    void setWaitForGlyphs(bool waitForGlyphs);
+    bool isWaitForGlyphs() const { return _waitForGlyphs; }
+
     /**
      * Makes the Label at most this line untransformed width.
      * The Label's max line width be used for force line breaks if the value not equal zero.
@@ -846,6 +854,9 @@ protected:
     bool _strikethroughEnabled;
     bool _underlineEnabled;
     bool _lineBreakWithoutSpaces;
+    bool _waitForGlyphs    = false;
+    bool _hasPendingGlyphs = false;
+    unsigned int _pendingGlyphGeneration = 0;  // atlas glyph generation when laid out with pending glyphs
     uint8_t _shadowOpacity;
 
     Color3B _shadowColor3B;
@@ -257,6 +257,7 @@ void LayerGradient::updateColor()
     _quad.tr.colors.g = (E.g + (S.g - E.g) * ((c - u.x - u.y) / (2.0f * c))) * 255;
     _quad.tr.colors.b = (E.b + (S.b - E.b) * ((c - u.x - u.y) / (2.0f * c))) * 255;
     _quad.tr.colors.a = (E.a + (S.a - E.a) * ((c - u.x - u.y) / (2.0f * c))) * 255;
+    _trianglesCommand.markContentDirty();
 
     // renders using batch node
     if (_renderMode == RenderMode::QUAD_BATCHNODE)
@@ -375,6 +376,9 @@ LayerRadialGradient* LayerRadialGradient::create()
 
 LayerRadialGradient::LayerRadialGradient()
 {
+    // updates its vertex buffer in draw
+    _parallelVisitSafe = false;
+
     auto& pipelinePS = _customCommand.getPipelineDescriptor().programState;
     auto* program    = backend::Program::getBuiltinProgram(backend::ProgramType::LAYER_RADIA_GRADIENT);
     //!!! LayerRadialGradient private programState don't want affect by Node::_programState, so store at _customCommand
@@ -39,6 +39,9 @@ namespace ax
 
 MotionStreak::MotionStreak()
 {
+    // updates its vertex buffer in draw
+    _parallelVisitSafe = false;
+
     _customCommand.setDrawType(CustomCommand::DrawType::ARRAY);
     _customCommand.setPrimitiveType(CustomCommand::PrimitiveType::TRIANGLE_STRIP);
 }
@@ -43,6 +43,9 @@ THE SOFTWARE.
 #include "2d/ActionManager.h"
 #include "2d/Scene.h"
 #include "2d/Component.h"
+#include "2d/TransformSystem.h"
+#include "renderer/Renderer.h"
+#include "renderer/RenderCommandList.h"
 #include "renderer/Material.h"
 #include "math/TransformUtils.h"
 #include "renderer/backend/ProgramManager.h"
@@ -161,6 +164,9 @@ Node::~Node()
 
     AX_SAFE_DELETE(_childrenIndexer);
 
+    if (isTransformSystemEnabled())
+        delete _transformSystem;
+
 #if AX_ENABLE_SCRIPT_BINDING
     if (_updateScriptHandler)
     {
@@ -675,6 +681,60 @@ void Node::setParent(Node* parent)
     _parent           = parent;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+
+    if (_transformSystem && _transformSystem->getRoot() != this)
+    {
+        _transformSystem->setHierarchyDirty();
+        TransformSystem::detach(this, _transformSystem);
+    }
+    if (parent && parent->_transformSystem)
+        parent->_transformSystem->setHierarchyDirty();
+}
+
+void Node::setTransformSystemEnabled(bool enabled)
+{
+    if (enabled == isTransformSystemEnabled())
+        return;
+
+    // leave or rejoin the system of the ancestors
+    if (_transformSystem)
+    {
+        if (enabled)
+        {
+            _transformSystem->setHierarchyDirty();
+            TransformSystem::detach(this, _transformSystem);
+        }
+        else
+            delete _transformSystem;
+    }
+    if (_parent && _parent->_transformSystem)
+        _parent->_transformSystem->setHierarchyDirty();
+
+    if (enabled)
+    {
+        _transformSystem = new TransformSystem(this);
+        _transformIndex  = 0;
+    }
+}
+
+bool Node::isTransformSystemEnabled() const
+{
+    return _transformSystem && _transformSystem->getRoot() == this;
+}
+
+void Node::setTransformSystemExcluded(bool excluded)
+{
+    if (excluded == _transformSystemExcluded)
+        return;
+
+    _transformSystemExcluded = excluded;
+    if (_transformSystem && _transformSystem->getRoot() != this)
+    {
+        _transformSystem->setHierarchyDirty();
+        TransformSystem::detach(this, _transformSystem);
+    }
+    if (_parent && _parent->_transformSystem)
+        _parent->_transformSystem->setHierarchyDirty();
 }
 
 /// isRelativeAnchorPoint getter
@@ -1231,6 +1291,21 @@ void Node::visit()
 
 uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
 {
+    if (_transformSystem)
+    {
+        if (_transformSystem->getRoot() == this)
+            return _transformSystem->update(parentTransform, parentFlags);
+
+        // already computed by the system, unless this node or its parent was transformed since then
+        if (!_transformUpdated && !_contentSizeDirty && !(_usingNormalizedPosition && _normalizedPositionDirty) &&
+            parentFlags == _parent->_transformSystemFlags && &parentTransform == &_parent->_modelViewTransform)
+            return _transformSystemFlags;
+
+        _transformSystem->setFullUpdate();
+        _transformUpdated = true;
+        parentFlags |= FLAGS_TRANSFORM_SYSTEM_BYPASS;
+    }
+
     if (_usingNormalizedPosition)
     {
         AXASSERT(_parent, "setPositionNormalized() doesn't work with orphan nodes");
@@ -1281,9 +1356,14 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
 
     // IMPORTANT:
     // To ease the migration to v3.0, we still support the Mat4 stack,
-    // but it is deprecated and your code should not rely on it
-    _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    // but it is deprecated and your code should not rely on it.
+    // Nodes managed by a TransformSystem don't use it.
+    const bool useMatrixStack = !_transformSystem;
+    if (useMatrixStack)
+    {
+        _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
 
     bool visibleByCamera = isVisitableByVisitingCamera();
 
@@ -1292,29 +1372,44 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
     if (!_children.empty())
     {
         sortAllChildren();
-        // draw children zOrder < 0
-        for (auto size = _children.size(); i < size; ++i)
+        if (_parallelVisitEnabled && renderer && renderer->getParallelVisit() && !RenderCommandList::getCurrent())
         {
-            auto node = _children.at(i);
-
-            if (node && node->_localZOrder < 0)
-                node->visit(renderer, _modelViewTransform, flags);
-            else
-                break;
+            const auto size = _children.size();
+            while (i < size && _children.at(i)->_localZOrder < 0)
+                ++i;
+
+            renderer->visitParallel(_children, 0, i, _modelViewTransform, flags);
+            if (visibleByCamera)
+                this->draw(renderer, _modelViewTransform, flags);
+            renderer->visitParallel(_children, i, size, _modelViewTransform, flags);
         }
-        // self draw
-        if (visibleByCamera)
-            this->draw(renderer, _modelViewTransform, flags);
+        else
+        {
+            // draw children zOrder < 0
+            for (auto size = _children.size(); i < size; ++i)
+            {
+                auto node = _children.at(i);
+
+                if (node && node->_localZOrder < 0)
+                    visitChild(node, renderer, flags);
+                else
+                    break;
+            }
+            // self draw
+            if (visibleByCamera)
+                this->draw(renderer, _modelViewTransform, flags);
 
-        for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
-            (*it)->visit(renderer, _modelViewTransform, flags);
+            for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
+                visitChild(*it, renderer, flags);
+        }
     }
     else if (visibleByCamera)
     {
         this->draw(renderer, _modelViewTransform, flags);
     }
 
-    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (useMatrixStack)
+        _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
@@ -1322,6 +1417,16 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
     // _orderOfArrival = 0;
 }
 
+bool Node::deferParallelVisit(const Mat4& parentTransform, uint32_t parentFlags)
+{
+    auto commandList = RenderCommandList::getCurrent();
+    if (!commandList)
+        return false;
+
+    commandList->deferVisit(this, parentTransform, parentFlags);
+    return true;
+}
+
 Mat4 Node::transform(const Mat4& parentTransform)
 {
     return parentTransform * this->getNodeToParentTransform();
@@ -63,6 +63,7 @@ class Director;
 class Material;
 class Camera;
 class PhysicsBody;
+class TransformSystem;
 
 namespace backend
 {
@@ -126,6 +127,8 @@ public:
         FLAGS_TRANSFORM_DIRTY    = (1 << 0),
         FLAGS_CONTENT_SIZE_DIRTY = (1 << 1),
         FLAGS_RENDER_AS_3D       = (1 << 3),
+        /** internal, set when a node managed by a TransformSystem was transformed outside of it */
+        FLAGS_TRANSFORM_SYSTEM_BYPASS = (1 << 4),
 
         FLAGS_DIRTY_MASK = (FLAGS_TRANSFORM_DIRTY | FLAGS_CONTENT_SIZE_DIRTY),
     };
@@ -868,6 +871,34 @@ public:
     virtual Node* getParent() { return _parent; }
     virtual const Node* getParent() const { return _parent; }
 
+    /**
+     * Makes this node the root of a TransformSystem computing the transforms of its subtree.
+     *
+     * The model view transforms of the subtree are stored in contiguous arrays and only the dirty ones are
+     * recomputed each frame. The nodes of the subtree don't push their transform on the deprecated
+     * MATRIX_STACK_MODELVIEW in visit, so code relying on that stack must be excluded with
+     * setTransformSystemExcluded.
+     *
+     * @param enabled Whether this node owns a TransformSystem.
+     * @since axmol-2.2
+     */
+    void setTransformSystemEnabled(bool enabled);
+    bool isTransformSystemEnabled() const;
+
+    /**
+     * Returns the TransformSystem owning or managing this node, nullptr otherwise.
+     * @since axmol-2.2
+     */
+    TransformSystem* getTransformSystem() const { return _transformSystem; }
+
+    /**
+     * Keeps this node and its subtree out of the TransformSystem of its ancestors.
+     * Needed by nodes that rewrite their model view transform in visit, like BillBoard.
+     * @since axmol-2.2
+     */
+    void setTransformSystemExcluded(bool excluded);
+    bool isTransformSystemExcluded() const { return _transformSystemExcluded; }
+
     ////// REMOVES //////
 
     /**
@@ -1142,6 +1173,40 @@ public:
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit();
 
+    /**
+     * Visits the children of this node on the job system set with Renderer::setParallelVisit.
+     *
+     * Every child subtree records its render commands into a RenderCommandList on a worker, the lists are
+     * then replayed in children order, so the rendering is the same as with a serial visit. The subtrees
+     * must not depend on each other during the visit, and don't use the deprecated matrix stack.
+     * Ignored when this node itself is visited on a worker.
+     *
+     * @param enabled Whether the children are visited in parallel.
+     * @since axmol-2.2
+     */
+    void setParallelVisitEnabled(bool enabled) { _parallelVisitEnabled = enabled; }
+    bool isParallelVisitEnabled() const { return _parallelVisitEnabled; }
+
+    /**
+     * Sets whether this node can be visited on a job system worker, true by default.
+     *
+     * Nodes touching shared state in visit or draw, such as GPU buffers, group or callback commands,
+     * scripts or user callbacks, must opt out. They are visited with their subtree on the axmol thread,
+     * at their place in the replayed commands.
+     * @since axmol-2.2
+     */
+    void setParallelVisitSafe(bool safe) { _parallelVisitSafe = safe; }
+    bool isParallelVisitSafe() const { return _parallelVisitSafe; }
+
+    /**
+     * Defers the visit of this node to the axmol thread when called during a parallel visit.
+     * Used by the nodes which are only unsafe in some states, at the beginning of their visit.
+     *
+     * @return true if the visit was deferred.
+     * @since axmol-2.2
+     */
+    bool deferParallelVisit(const Mat4& parentTransform, uint32_t parentFlags);
+
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
      This function recursively calls parent->getScene() until parent is a Scene object. The results are not cached. It
@@ -1885,6 +1950,13 @@ protected:
     virtual void disableCascadeColor();
     virtual void updateColor() {}
 
+    /// visits child, or defers it when it's not safe to visit during a parallel visit
+    void visitChild(Node* child, Renderer* renderer, uint32_t flags)
+    {
+        if (child->_parallelVisitSafe || !child->deferParallelVisit(_modelViewTransform, flags))
+            child->visit(renderer, _modelViewTransform, flags);
+    }
+
     bool doEnumerate(std::string name, std::function<bool(Node*)> callback) const;
     bool doEnumerateRecursive(const Node* node, std::string_view name, std::function<bool(Node*)> callback) const;
 
@@ -2000,6 +2072,13 @@ protected:
     bool _usingNormalizedPosition;
     bool _normalizedPositionDirty;
 
+    bool _parallelVisitEnabled        = false;
+    bool _parallelVisitSafe           = true;
+    bool _transformSystemExcluded     = false;
+    int _transformIndex               = -1;  ///< index in the arrays of _transformSystem
+    uint32_t _transformSystemFlags    = 0;   ///< flags computed by _transformSystem for this frame
+    TransformSystem* _transformSystem = nullptr;
+
     bool _childFollowCameraMask;
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
@@ -2044,6 +2123,10 @@ public:
     friend class PhysicsBody;
 #endif
 
+    friend class TransformSystem;
+    friend class SpatialNode;
+    friend class EventDispatcher;
+
     static int __attachedNodeCount;
 
 private:
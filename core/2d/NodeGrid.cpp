@@ -53,7 +53,13 @@ NodeGrid* NodeGrid::create(const ax::Rect& rect)
     return ret;
 }
 
-NodeGrid::NodeGrid() {}
+NodeGrid::NodeGrid()
+{
+    // computes its own transform and flags in visit
+    _transformSystemExcluded = true;
+    // renders its target with group commands
+    _parallelVisitSafe = false;
+}
 
 void NodeGrid::setTarget(Node* target)
 {
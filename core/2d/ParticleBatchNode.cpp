@@ -49,6 +49,9 @@ namespace ax
 
 ParticleBatchNode::ParticleBatchNode()
 {
+    // updates its buffers in draw
+    _parallelVisitSafe = false;
+
     auto& pipelinePS = _customCommand.getPipelineDescriptor().programState;
     auto* program    = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR);
     //!!! ParticleBatchNode private programState don't want affect by Node::_programState, so store at _customCommand
@@ -426,7 +429,7 @@ void ParticleBatchNode::removeAllChildrenWithCleanup(bool doCleanup)
 
 void ParticleBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    AX_PROFILER_START("CCParticleBatchNode - draw");
+    AX_PROFILE_ZONE("ParticleBatchNode::draw");
 
     if (_textureAtlas->getTotalQuads() == 0)
         return;
@@ -454,8 +457,6 @@ void ParticleBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t
     }
 
     renderer->addCommand(&_customCommand);
-
-    AX_PROFILER_STOP("CCParticleBatchNode - draw");
 }
 
 void ParticleBatchNode::increaseAtlasCapacityTo(ssize_t quantity)
@@ -0,0 +1,582 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "2d/ParticleKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "2d/ParticleSystem.h"
+#include "2d/TweenFunction.h"
+#include "base/Types.h"
+
+// The NEON path relies on aarch64 horizontal ops, 32-bit arm keeps the scalar kernels
+#if defined(AX_SSE_INTRINSICS) || (defined(AX_NEON_INTRINSICS) && AX_64BITS)
+#    define AX_PARTICLE_SIMD 1
+#endif
+
+namespace ax
+{
+
+namespace
+{
+bool s_simdEnabled = true;
+
+inline float degreesToRadians(float degrees)
+{
+    return AX_DEGREES_TO_RADIANS(degrees);
+}
+
+// Four-wide helpers over the SSE and NEON types, so every kernel is written once
+#if defined(AX_SSE_INTRINSICS)
+using vfloat = __m128;
+using vint   = __m128i;
+using vmask  = __m128;
+
+inline vfloat vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, vfloat v) { _mm_storeu_ps(p, v); }
+inline void vstore(uint32_t* p, vint v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+inline vfloat vset1(float s) { return _mm_set1_ps(s); }
+inline vfloat vadd(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+inline vfloat vsub(vfloat a, vfloat b) { return _mm_sub_ps(a, b); }
+inline vfloat vmul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+inline vfloat vdiv(vfloat a, vfloat b) { return _mm_div_ps(a, b); }
+inline vfloat vmin(vfloat a, vfloat b) { return _mm_min_ps(a, b); }
+inline vfloat vmax(vfloat a, vfloat b) { return _mm_max_ps(a, b); }
+inline vfloat vsqrt(vfloat a) { return _mm_sqrt_ps(a); }
+inline vfloat vneg(vfloat a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+inline vfloat vabs(vfloat a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+inline vmask vle(vfloat a, vfloat b) { return _mm_cmple_ps(a, b); }
+inline vmask vlt(vfloat a, vfloat b) { return _mm_cmplt_ps(a, b); }
+inline vmask vge(vfloat a, vfloat b) { return _mm_cmpge_ps(a, b); }
+inline vmask vneq(vfloat a, vfloat b) { return _mm_cmpneq_ps(a, b); }
+inline vmask vand(vmask a, vmask b) { return _mm_and_ps(a, b); }
+inline vmask vxor(vmask a, vmask b) { return _mm_xor_ps(a, b); }
+inline vfloat vselect(vmask m, vfloat a, vfloat b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+inline bool vany(vmask m) { return _mm_movemask_ps(m) != 0; }
+inline vint vtrunc(vfloat a) { return _mm_cvttps_epi32(a); }
+inline vfloat vtofloat(vint a) { return _mm_cvtepi32_ps(a); }
+inline vint viset1(int s) { return _mm_set1_epi32(s); }
+inline vint viadd(vint a, vint b) { return _mm_add_epi32(a, b); }
+inline vint visub(vint a, vint b) { return _mm_sub_epi32(a, b); }
+inline vint viand(vint a, vint b) { return _mm_and_si128(a, b); }
+inline vint vior(vint a, vint b) { return _mm_or_si128(a, b); }
+template <int N>
+inline vint vishl(vint a) { return _mm_slli_epi32(a, N); }
+inline vmask vieq0(vint a) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, _mm_setzero_si128())); }
+#elif defined(AX_PARTICLE_SIMD)
+using vfloat = float32x4_t;
+using vint   = int32x4_t;
+using vmask  = uint32x4_t;
+
+inline vfloat vload(const float* p) { return vld1q_f32(p); }
+inline void vstore(float* p, vfloat v) { vst1q_f32(p, v); }
+inline void vstore(uint32_t* p, vint v) { vst1q_u32(p, vreinterpretq_u32_s32(v)); }
+inline vfloat vset1(float s) { return vdupq_n_f32(s); }
+inline vfloat vadd(vfloat a, vfloat b) { return vaddq_f32(a, b); }
+inline vfloat vsub(vfloat a, vfloat b) { return vsubq_f32(a, b); }
+inline vfloat vmul(vfloat a, vfloat b) { return vmulq_f32(a, b); }
+inline vfloat vdiv(vfloat a, vfloat b) { return vdivq_f32(a, b); }
+inline vfloat vmin(vfloat a, vfloat b) { return vminq_f32(a, b); }
+inline vfloat vmax(vfloat a, vfloat b) { return vmaxq_f32(a, b); }
+inline vfloat vsqrt(vfloat a) { return vsqrtq_f32(a); }
+inline vfloat vneg(vfloat a) { return vnegq_f32(a); }
+inline vfloat vabs(vfloat a) { return vabsq_f32(a); }
+inline vmask vle(vfloat a, vfloat b) { return vcleq_f32(a, b); }
+inline vmask vlt(vfloat a, vfloat b) { return vcltq_f32(a, b); }
+inline vmask vge(vfloat a, vfloat b) { return vcgeq_f32(a, b); }
+inline vmask vneq(vfloat a, vfloat b) { return vmvnq_u32(vceqq_f32(a, b)); }
+inline vmask vand(vmask a, vmask b) { return vandq_u32(a, b); }
+inline vmask vxor(vmask a, vmask b) { return veorq_u32(a, b); }
+inline vfloat vselect(vmask m, vfloat a, vfloat b) { return vbslq_f32(m, a, b); }
+inline bool vany(vmask m) { return vmaxvq_u32(m) != 0; }
+inline vint vtrunc(vfloat a) { return vcvtq_s32_f32(a); }
+inline vfloat vtofloat(vint a) { return vcvtq_f32_s32(a); }
+inline vint viset1(int s) { return vdupq_n_s32(s); }
+inline vint viadd(vint a, vint b) { return vaddq_s32(a, b); }
+inline vint visub(vint a, vint b) { return vsubq_s32(a, b); }
+inline vint viand(vint a, vint b) { return vandq_s32(a, b); }
+inline vint vior(vint a, vint b) { return vorrq_s32(a, b); }
+template <int N>
+inline vint vishl(vint a) { return vshlq_n_s32(a, N); }
+inline vmask vieq0(vint a) { return vceqq_s32(a, vdupq_n_s32(0)); }
+#endif
+
+#if defined(AX_PARTICLE_SIMD)
+/**
+ * sin and cos of four angles in radians, the Cephes single precision polynomials:
+ * the angle is reduced to [-pi/4, pi/4] around the nearest multiple of pi/4 and the octant
+ * picks the polynomial and the signs. Accurate to about 1e-7 for |x| < 8192.
+ */
+inline void vsincos(vfloat x, vfloat& s, vfloat& c)
+{
+    vfloat ax = vabs(x);
+
+    // octant, rounded to even so the reduced angle stays within [-pi/4, pi/4]
+    vint j   = vtrunc(vmul(ax, vset1(1.27323954473516f)));  // 4 / pi
+    j        = viand(viadd(j, viset1(1)), viset1(~1));
+    vfloat y = vtofloat(j);
+
+    // extended precision reduction: ax - y * pi / 4
+    ax = vadd(vadd(vadd(ax, vmul(y, vset1(-0.78515625f))), vmul(y, vset1(-2.4187564849853515625e-4f))),
+              vmul(y, vset1(-3.77489497744594108e-8f)));
+
+    vfloat z = vmul(ax, ax);
+
+    vfloat cosp = vadd(vmul(vset1(2.443315711809948e-5f), z), vset1(-1.388731625493765e-3f));
+    cosp        = vadd(vmul(cosp, z), vset1(4.166664568298827e-2f));
+    cosp        = vadd(vsub(vmul(vmul(cosp, z), z), vmul(z, vset1(0.5f))), vset1(1.0f));
+
+    vfloat sinp = vadd(vmul(vset1(-1.9515295891e-4f), z), vset1(8.3321608736e-3f));
+    sinp        = vadd(vmul(sinp, z), vset1(-1.6666654611e-1f));
+    sinp        = vadd(vmul(vmul(sinp, z), ax), ax);
+
+    // octants 2, 3, 6, 7 swap the polynomials
+    vmask keep = vieq0(viand(j, viset1(2)));
+    s          = vselect(keep, sinp, cosp);
+    c          = vselect(keep, cosp, sinp);
+
+    // sin is negative in octants 4..7 of |x|, mirrored for negative x
+    vmask sinPositive = vxor(vieq0(viand(j, viset1(4))), vlt(x, vset1(0.0f)));
+    s                 = vselect(sinPositive, s, vneg(s));
+
+    // cos is negative in octants 2..5
+    vmask cosNegative = vieq0(viand(visub(j, viset1(2)), viset1(4)));
+    c                 = vselect(cosNegative, vneg(c), c);
+}
+#endif
+
+inline void updateQuadVertex(V3F_C4B_T2F_Quad* quad,
+                             float x,
+                             float y,
+                             float size,
+                             float scaleIn,
+                             float rotation,
+                             float staticRotation)
+{
+    float half = size * 0.5f * scaleIn;
+
+    float r  = -degreesToRadians(rotation + staticRotation);
+    float hc = half * cosf(r);
+    float hs = half * sinf(r);
+
+    quad->bl.vertices.x = x - hc + hs;
+    quad->bl.vertices.y = y - hs - hc;
+    quad->br.vertices.x = x + hc + hs;
+    quad->br.vertices.y = y + hs - hc;
+    quad->tl.vertices.x = x - hc - hs;
+    quad->tl.vertices.y = y - hs + hc;
+    quad->tr.vertices.x = x + hc - hs;
+    quad->tr.vertices.y = y + hs + hc;
+}
+
+inline void setQuadColor(V3F_C4B_T2F_Quad* quad, uint32_t rgba)
+{
+    static_assert(sizeof(Color4B) == sizeof(uint32_t));
+    memcpy(&quad->bl.colors, &rgba, sizeof(rgba));
+    memcpy(&quad->br.colors, &rgba, sizeof(rgba));
+    memcpy(&quad->tl.colors, &rgba, sizeof(rgba));
+    memcpy(&quad->tr.colors, &rgba, sizeof(rgba));
+}
+
+inline void setQuadColor(V3F_C4B_T2F_Quad* quad, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    quad->bl.colors.set(r, g, b, a);
+    quad->br.colors.set(r, g, b, a);
+    quad->tl.colors.set(r, g, b, a);
+    quad->tr.colors.set(r, g, b, a);
+}
+
+}  // namespace
+
+bool ParticleKernels::isSimdSupported()
+{
+#if defined(AX_PARTICLE_SIMD)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ParticleKernels::setSimdEnabled(bool enabled)
+{
+    s_simdEnabled = enabled;
+}
+
+bool ParticleKernels::isSimdEnabled()
+{
+    return s_simdEnabled && isSimdSupported();
+}
+
+void ParticleKernels::addScalar(float* v, float s, int count)
+{
+    int i = 0;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        const vfloat vs = vset1(s);
+        for (; i + 4 <= count; i += 4)
+            vstore(v + i, vadd(vload(v + i), vs));
+    }
+#endif
+    for (; i < count; ++i)
+        v[i] += s;
+}
+
+void ParticleKernels::integrate(float* v, const float* delta, float dt, int count)
+{
+    int i = 0;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        const vfloat vdt = vset1(dt);
+        for (; i + 4 <= count; i += 4)
+            vstore(v + i, vadd(vload(v + i), vmul(vload(delta + i), vdt)));
+    }
+#endif
+    for (; i < count; ++i)
+        v[i] += delta[i] * dt;
+}
+
+void ParticleKernels::integrateNonNegative(float* v, const float* delta, float dt, int count)
+{
+    int i = 0;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        const vfloat vdt  = vset1(dt);
+        const vfloat zero = vset1(0.0f);
+        for (; i + 4 <= count; i += 4)
+            vstore(v + i, vmax(vadd(vload(v + i), vmul(vload(delta + i), vdt)), zero));
+    }
+#endif
+    for (; i < count; ++i)
+        v[i] = std::max(v[i] + delta[i] * dt, 0.0f);
+}
+
+void ParticleKernels::advanceClamped(float* v, const float* limit, float dt, int count)
+{
+    int i = 0;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        const vfloat vdt = vset1(dt);
+        for (; i + 4 <= count; i += 4)
+            vstore(v + i, vmin(vadd(vload(v + i), vdt), vload(limit + i)));
+    }
+#endif
+    for (; i < count; ++i)
+        v[i] = std::min(v[i] + dt, limit[i]);
+}
+
+void ParticleKernels::integrateGravity(ParticleData& data,
+                                       float gravityX,
+                                       float gravityY,
+                                       float dt,
+                                       float yFlip,
+                                       int count)
+{
+    float* posx            = data.posx;
+    float* posy            = data.posy;
+    float* dirX            = data.modeA.dirX;
+    float* dirY            = data.modeA.dirY;
+    const float* radial    = data.modeA.radialAccel;
+    const float* tangent   = data.modeA.tangentialAccel;
+
+    int i = 0;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        const vfloat vdt   = vset1(dt);
+        const vfloat vflip = vset1(yFlip);
+        const vfloat gx    = vset1(gravityX);
+        const vfloat gy    = vset1(gravityY);
+        const vfloat one   = vset1(1.0f);
+        const vfloat zero  = vset1(0.0f);
+        const vfloat tol   = vset1(MATH_TOLERANCE);
+        for (; i + 4 <= count; i += 4)
+        {
+            vfloat x = vload(posx + i);
+            vfloat y = vload(posy + i);
+
+            // radial direction, left at zero for unit or degenerate positions like normalize_point does
+            vfloat len2  = vadd(vmul(x, x), vmul(y, y));
+            vfloat len   = vsqrt(len2);
+            vmask valid  = vand(vneq(len2, one), vge(len, tol));
+            vfloat inv   = vdiv(one, len);
+            vfloat rx    = vselect(valid, vmul(x, inv), zero);
+            vfloat ry    = vselect(valid, vmul(y, inv), zero);
+            vfloat ra    = vload(radial + i);
+            vfloat ta    = vload(tangent + i);
+
+            // (gravity + radial + tangential) * dt
+            vfloat ax = vmul(vadd(vadd(vmul(rx, ra), vmul(ry, vneg(ta))), gx), vdt);
+            vfloat ay = vmul(vadd(vadd(vmul(ry, ra), vmul(rx, ta)), gy), vdt);
+
+            vfloat dx = vadd(vload(dirX + i), ax);
+            vfloat dy = vadd(vload(dirY + i), ay);
+            vstore(dirX + i, dx);
+            vstore(dirY + i, dy);
+
+            vstore(posx + i, vadd(x, vmul(vmul(dx, vdt), vflip)));
+            vstore(posy + i, vadd(y, vmul(vmul(dy, vdt), vflip)));
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float rx = 0.0f, ry = 0.0f;
+        float len2 = posx[i] * posx[i] + posy[i] * posy[i];
+        if (len2 != 1.0f)
+        {
+            float len = sqrtf(len2);
+            if (len >= MATH_TOLERANCE)
+            {
+                float inv = 1.0f / len;
+                rx        = posx[i] * inv;
+                ry        = posy[i] * inv;
+            }
+        }
+
+        float ax = (rx * radial[i] + ry * -tangent[i] + gravityX) * dt;
+        float ay = (ry * radial[i] + rx * tangent[i] + gravityY) * dt;
+
+        dirX[i] += ax;
+        dirY[i] += ay;
+
+        posx[i] += dirX[i] * dt * yFlip;
+        posy[i] += dirY[i] * dt * yFlip;
+    }
+}
+
+void ParticleKernels::integrateRadius(ParticleData& data, float dt, float yFlip, int count)
+{
+    integrate(data.modeB.angle, data.modeB.degreesPerSecond, dt, count);
+    integrate(data.modeB.radius, data.modeB.deltaRadius, dt, count);
+
+    float* posx         = data.posx;
+    float* posy         = data.posy;
+    const float* angle  = data.modeB.angle;
+    const float* radius = data.modeB.radius;
+
+    int i = 0;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        const vfloat vflip = vset1(yFlip);
+        for (; i + 4 <= count; i += 4)
+        {
+            vfloat s, c;
+            vsincos(vload(angle + i), s, c);
+            vfloat r = vload(radius + i);
+            vstore(posx + i, vmul(vneg(c), r));
+            vstore(posy + i, vmul(vmul(vneg(s), r), vflip));
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        posx[i] = -cosf(angle[i]) * radius[i];
+        posy[i] = -sinf(angle[i]) * radius[i] * yFlip;
+    }
+}
+
+int ParticleKernels::findExpired(const float* timeToLive, int first, int count)
+{
+    int i = first;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        // most particles are alive, skip them four at a time
+        const vfloat zero = vset1(0.0f);
+        while (i + 4 <= count && !vany(vle(vload(timeToLive + i), zero)))
+            i += 4;
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        if (timeToLive[i] <= 0.0f)
+            return i;
+    }
+    return count;
+}
+
+int ParticleKernels::planSwapRemove(const float* timeToLive, int count, std::vector<std::pair<int, int>>& moves)
+{
+    int i = findExpired(timeToLive, 0, count);
+    while (i < count)
+    {
+        // drop the expired tail, the hole is then refilled by the last live particle
+        while (count > i && timeToLive[count - 1] <= 0.0f)
+            --count;
+        if (i >= count)
+            break;
+
+        --count;
+        moves.emplace_back(i, count);
+        i = findExpired(timeToLive, i + 1, count);
+    }
+    return count;
+}
+
+void ParticleKernels::updateQuadVertices(V3F_C4B_T2F_Quad* quads,
+                                         const ParticleData& data,
+                                         const float transform[6],
+                                         bool scaleIn,
+                                         int count)
+{
+    const float* posx   = data.posx;
+    const float* posy   = data.posy;
+    const float* startX = data.startPosX;
+    const float* startY = data.startPosY;
+    const float* size   = data.size;
+    const float* rot    = data.rotation;
+    const float* srot   = data.staticRotation;
+    const float* sid    = data.scaleInDelta;
+    const float* sil    = data.scaleInLength;
+
+    int i = 0;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        const vfloat t0      = vset1(transform[0]);
+        const vfloat t1      = vset1(transform[1]);
+        const vfloat t2      = vset1(transform[2]);
+        const vfloat t3      = vset1(transform[3]);
+        const vfloat t4      = vset1(transform[4]);
+        const vfloat t5      = vset1(transform[5]);
+        const vfloat half    = vset1(0.5f);
+        const vfloat toRad   = vset1(-0.01745329252f);
+        alignas(16) float scales[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        alignas(16) float out[8][4];
+        for (; i + 4 <= count; i += 4)
+        {
+            vfloat sx = vload(startX + i);
+            vfloat sy = vload(startY + i);
+            vfloat x  = vadd(vadd(vadd(vload(posx + i), vmul(t0, sx)), vmul(t1, sy)), t2);
+            vfloat y  = vadd(vadd(vadd(vload(posy + i), vmul(t3, sx)), vmul(t4, sy)), t5);
+
+            if (scaleIn)
+            {
+                // the exponential tween stays scalar
+                for (int k = 0; k < 4; ++k)
+                    scales[k] = tweenfunc::expoEaseOut(sid[i + k] / sil[i + k]);
+            }
+            vfloat h = vmul(vmul(vload(size + i), half), vload(scales));
+
+            vfloat s, c;
+            vsincos(vmul(vadd(vload(rot + i), vload(srot + i)), toRad), s, c);
+            vfloat hc = vmul(h, c);
+            vfloat hs = vmul(h, s);
+
+            vstore(out[0], vadd(vsub(x, hc), hs));  // bl
+            vstore(out[1], vsub(vsub(y, hs), hc));
+            vstore(out[2], vadd(vadd(x, hc), hs));  // br
+            vstore(out[3], vsub(vadd(y, hs), hc));
+            vstore(out[4], vsub(vsub(x, hc), hs));  // tl
+            vstore(out[5], vadd(vsub(y, hs), hc));
+            vstore(out[6], vsub(vadd(x, hc), hs));  // tr
+            vstore(out[7], vadd(vadd(y, hs), hc));
+
+            for (int k = 0; k < 4; ++k)
+            {
+                auto quad           = quads + i + k;
+                quad->bl.vertices.x = out[0][k];
+                quad->bl.vertices.y = out[1][k];
+                quad->br.vertices.x = out[2][k];
+                quad->br.vertices.y = out[3][k];
+                quad->tl.vertices.x = out[4][k];
+                quad->tl.vertices.y = out[5][k];
+                quad->tr.vertices.x = out[6][k];
+                quad->tr.vertices.y = out[7][k];
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float x     = posx[i] + transform[0] * startX[i] + transform[1] * startY[i] + transform[2];
+        float y     = posy[i] + transform[3] * startX[i] + transform[4] * startY[i] + transform[5];
+        float scale = scaleIn ? tweenfunc::expoEaseOut(sid[i] / sil[i]) : 1.0f;
+        updateQuadVertex(quads + i, x, y, size[i], scale, rot[i], srot[i]);
+    }
+}
+
+void ParticleKernels::updateQuadColors(V3F_C4B_T2F_Quad* quads,
+                                       const ParticleData& data,
+                                       bool fadeIn,
+                                       bool premultiplied,
+                                       int count)
+{
+    const float* r      = data.colorR;
+    const float* g      = data.colorG;
+    const float* b      = data.colorB;
+    const float* a      = data.colorA;
+    const float* fadeDt = data.opacityFadeInDelta;
+    const float* fadeLn = data.opacityFadeInLength;
+
+    int i = 0;
+#if defined(AX_PARTICLE_SIMD)
+    if (s_simdEnabled)
+    {
+        const vfloat scale = vset1(255.0f);
+        const vfloat zero  = vset1(0.0f);
+        const vfloat one   = vset1(1.0f);
+        alignas(16) uint32_t rgba[4];
+
+        // clamped to [0, 255] before truncating, which matches the scalar conversion for in-range colors
+        auto toByte = [&](vfloat v) { return vtrunc(vmin(vmax(vmul(v, scale), zero), scale)); };
+        for (; i + 4 <= count; i += 4)
+        {
+            vfloat va   = vload(a + i);
+            vfloat fade = fadeIn ? vdiv(vload(fadeDt + i), vload(fadeLn + i)) : one;
+            vfloat vr   = vload(r + i);
+            vfloat vg   = vload(g + i);
+            vfloat vb   = vload(b + i);
+            if (premultiplied)
+            {
+                vr = vmul(vr, va);
+                vg = vmul(vg, va);
+                vb = vmul(vb, va);
+            }
+
+            // Color4B is laid out r, g, b, a
+            vint packed = vior(vior(toByte(vr), vishl<8>(toByte(vg))),
+                               vior(vishl<16>(toByte(vb)), vishl<24>(toByte(vmul(va, fade)))));
+            vstore(rgba, packed);
+
+            for (int k = 0; k < 4; ++k)
+                setQuadColor(quads + i + k, rgba[k]);
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float fade = fadeIn ? fadeDt[i] / fadeLn[i] : 1.0f;
+        float pm   = premultiplied ? a[i] : 1.0f;
+        setQuadColor(quads + i, static_cast<uint8_t>(r[i] * pm * 255), static_cast<uint8_t>(g[i] * pm * 255),
+                     static_cast<uint8_t>(b[i] * pm * 255), static_cast<uint8_t>(a[i] * fade * 255));
+    }
+}
+
+}  // namespace ax
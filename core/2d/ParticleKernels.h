@@ -0,0 +1,108 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+class ParticleData;
+struct V3F_C4B_T2F_Quad;
+
+/**
+ * Update kernels working on the SoA arrays of ParticleData.
+ *
+ * Every kernel processes one property for a whole range of particles, four at a time with SSE or
+ * NEON (aarch64) intrinsics when available and one at a time otherwise. The SIMD path computes
+ * sin/cos with a polynomial approximation, results may differ from the scalar path in the last bits.
+ * @since axmol-2.2
+ */
+class AX_DLL ParticleKernels
+{
+public:
+    /** Whether the SIMD kernels are compiled in for the target ISA. */
+    static bool isSimdSupported();
+
+    /** Switches between the SIMD and the scalar kernels, mostly useful to benchmark them. */
+    static void setSimdEnabled(bool enabled);
+    static bool isSimdEnabled();
+
+    /** v[i] += s */
+    static void addScalar(float* v, float s, int count);
+
+    /** v[i] += delta[i] * dt */
+    static void integrate(float* v, const float* delta, float dt, int count);
+
+    /** v[i] = max(v[i] + delta[i] * dt, 0) */
+    static void integrateNonNegative(float* v, const float* delta, float dt, int count);
+
+    /** v[i] = min(v[i] + dt, limit[i]) */
+    static void advanceClamped(float* v, const float* limit, float dt, int count);
+
+    /** Gravity mode: applies gravity, radial and tangential acceleration to the directions, then moves. */
+    static void integrateGravity(ParticleData& data, float gravityX, float gravityY, float dt, float yFlip, int count);
+
+    /** Radius mode: advances angle and radius, then places the particles on their circle. */
+    static void integrateRadius(ParticleData& data, float dt, float yFlip, int count);
+
+    /** Returns the index of the first particle in [first, count) with timeToLive <= 0, or count. */
+    static int findExpired(const float* timeToLive, int first, int count);
+
+    /**
+     * Plans the swap-remove of expired particles: every expired particle below the new count is
+     * refilled by the last live one. Appends the (dst, src) pairs to moves and returns the new count.
+     */
+    static int planSwapRemove(const float* timeToLive, int count, std::vector<std::pair<int, int>>& moves);
+
+    /**
+     * Writes the vertex positions of count quads.
+     * The particle position is offset by its start position through an affine transform:
+     * center.x = posx + t[0] * startPosX + t[1] * startPosY + t[2]
+     * center.y = posy + t[3] * startPosX + t[4] * startPosY + t[5]
+     *
+     * @param scaleIn Whether to scale the quads with the scale-in tween.
+     */
+    static void updateQuadVertices(V3F_C4B_T2F_Quad* quads,
+                                   const ParticleData& data,
+                                   const float transform[6],
+                                   bool scaleIn,
+                                   int count);
+
+    /**
+     * Writes the vertex colors of count quads.
+     *
+     * @param fadeIn Whether to fade the alpha with the opacity fade-in.
+     * @param premultiplied Whether to premultiply the rgb components with the alpha.
+     */
+    static void updateQuadColors(V3F_C4B_T2F_Quad* quads,
+                                 const ParticleData& data,
+                                 bool fadeIn,
+                                 bool premultiplied,
+                                 int count);
+};
+
+}  // namespace ax
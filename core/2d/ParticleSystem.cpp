@@ -49,6 +49,7 @@ THE SOFTWARE.
 #include <string>
 
 #include "2d/ParticleBatchNode.h"
+#include "2d/ParticleKernels.h"
 #include "renderer/TextureAtlas.h"
 #include "base/ZipUtils.h"
 #include "base/Director.h"
@@ -80,23 +81,6 @@ namespace ax
 //  cocos2d uses a another approach, but the results are almost identical.
 //
 
-inline void normalize_point(float x, float y, particle_point* out)
-{
-    float n = x * x + y * y;
-    // Already normalized.
-    if (n == 1.0f)
-        return;
-
-    n = sqrt(n);
-    // Too close to zero.
-    if (n < MATH_TOLERANCE)
-        return;
-
-    n      = 1.0f / n;
-    out->x = x * n;
-    out->y = y * n;
-}
-
 ParticleData::ParticleData()
 {
     memset(this, 0, sizeof(ParticleData));
@@ -145,6 +129,75 @@ bool ParticleData::init(int count)
            modeB.radius;
 }
 
+void ParticleData::moveParticles(const std::pair<int, int>* moves, size_t count)
+{
+    auto move = [moves, count](auto* values) {
+        for (size_t i = 0; i < count; ++i)
+            values[moves[i].first] = values[moves[i].second];
+    };
+
+    move(posx);
+    move(posy);
+    move(startPosX);
+    move(startPosY);
+
+    move(colorR);
+    move(colorG);
+    move(colorB);
+    move(colorA);
+
+    move(deltaColorR);
+    move(deltaColorG);
+    move(deltaColorB);
+    move(deltaColorA);
+
+    if (hue && sat && val)
+    {
+        move(hue);
+        move(sat);
+        move(val);
+    }
+
+    if (opacityFadeInDelta && opacityFadeInLength)
+    {
+        move(opacityFadeInDelta);
+        move(opacityFadeInLength);
+    }
+
+    if (scaleInDelta && scaleInLength)
+    {
+        move(scaleInDelta);
+        move(scaleInLength);
+    }
+
+    move(size);
+    move(deltaSize);
+    move(rotation);
+    move(staticRotation);
+    move(deltaRotation);
+
+    move(totalTimeToLive);
+    move(timeToLive);
+
+    if (animTimeDelta && animTimeLength && animIndex && animCellIndex)
+    {
+        move(animTimeDelta);
+        move(animTimeLength);
+        move(animIndex);
+        move(animCellIndex);
+    }
+
+    move(modeA.dirX);
+    move(modeA.dirY);
+    move(modeA.radialAccel);
+    move(modeA.tangentialAccel);
+
+    move(modeB.angle);
+    move(modeB.degreesPerSecond);
+    move(modeB.radius);
+    move(modeB.deltaRadius);
+}
+
 void ParticleData::release()
 {
     AX_SAFE_FREE(posx);
@@ -254,6 +307,9 @@ ParticleSystem::ParticleSystem()
     , _fixedFPSDelta(0)
     , _sourcePositionCompatible(true)  // In the furture this member's default value maybe false or be removed.
 {
+    // QuadCommand shares its index buffer between all the commands
+    _parallelVisitSafe = false;
+
     modeA.gravity.setZero();
     modeA.speed              = 0;
     modeA.speedVar           = 0;
@@ -1555,7 +1611,7 @@ void ParticleSystem::update(float dt)
     if (!_visible)
         return;
 
-    AX_PROFILER_START_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+    AX_PROFILE_ZONE("ParticleSystem::update");
 
     if (_componentContainer && !_componentContainer->isEmpty())
     {
@@ -1569,7 +1625,6 @@ void ParticleSystem::update(float dt)
         {
             updateParticleQuads();
             _transformSystemDirty = false;
-            AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
             return;
         }
         dt             = _fixedFPSDelta;
@@ -1610,29 +1665,20 @@ void ParticleSystem::update(float dt)
     // And wether if every property's memory of the particle system is continuous,
     // for the purpose of improving cache hit rate, we should process only one property in one for-loop.
     // It was proved to be effective especially for low-end devices.
+    // The same layout lets ParticleKernels process four particles per instruction where SIMD is available.
     {
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.timeToLive[i] -= dt;
-        }
+        ParticleKernels::addScalar(_particleData.timeToLive, -dt, _particleCount);
 
         if (_isOpacityFadeInAllocated)
         {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.opacityFadeInDelta[i] += dt;
-                _particleData.opacityFadeInDelta[i] =
-                    MIN(_particleData.opacityFadeInDelta[i], _particleData.opacityFadeInLength[i]);
-            }
+            ParticleKernels::advanceClamped(_particleData.opacityFadeInDelta, _particleData.opacityFadeInLength, dt,
+                                            _particleCount);
         }
 
         if (_isScaleInAllocated)
         {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.scaleInDelta[i] += dt;
-                _particleData.scaleInDelta[i] = MIN(_particleData.scaleInDelta[i], _particleData.scaleInLength[i]);
-            }
+            ParticleKernels::advanceClamped(_particleData.scaleInDelta, _particleData.scaleInLength, dt,
+                                            _particleCount);
         }
 
         if (_isLifeAnimated || _isEmitterAnimated || _isLoopAnimated)
@@ -1702,128 +1748,48 @@ void ParticleSystem::update(float dt)
                 std::fill_n(_particleData.animTimeDelta, _particleCount, 0.f);
         }
 
-        for (int i = 0; i < _particleCount; ++i)
+        // swap-remove the expired particles, holes are refilled from the end
+        _particleMoves.clear();
+        const int aliveCount = ParticleKernels::planSwapRemove(_particleData.timeToLive, _particleCount, _particleMoves);
+        if (aliveCount != _particleCount)
         {
-            if (_particleData.timeToLive[i] <= 0.0f)
+            _particleData.moveParticles(_particleMoves.data(), _particleMoves.size());
+            for (auto&& [dst, src] : _particleMoves)
             {
-                int j = _particleCount - 1;
-                while (j > 0 && _particleData.timeToLive[j] <= 0)
-                {
-                    _particleCount--;
-                    j--;
-                }
-                _particleData.copyParticle(i, _particleCount - 1);
+                // the moved particle takes over the atlas slot of the expired one, which is disabled
                 if (_batchNode)
-                {
-                    // disable the switched particle
-                    int currentIndex = _particleData.atlasIndex[i];
-                    _batchNode->disableParticle(_atlasIndex + currentIndex);
-                    // switch indexes
-                    _particleData.atlasIndex[_particleCount - 1] = currentIndex;
-                }
-                --_particleCount;
-                if (_particleCount == 0 && _isAutoRemoveOnFinish)
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
-            }
-        }
-
-        if (_emitterMode == Mode::GRAVITY)
-        {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                particle_point tmp, radial = {0.0f, 0.0f}, tangential;
-
-                // radial acceleration
-                if (_particleData.posx[i] || _particleData.posy[i])
-                {
-                    normalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
-                }
-                tangential = radial;
-                radial.x *= _particleData.modeA.radialAccel[i];
-                radial.y *= _particleData.modeA.radialAccel[i];
-
-                // tangential acceleration
-                std::swap(tangential.x, tangential.y);
-                tangential.x *= -_particleData.modeA.tangentialAccel[i];
-                tangential.y *= _particleData.modeA.tangentialAccel[i];
-
-                // (gravity + radial + tangential) * dt
-                tmp.x = radial.x + tangential.x + modeA.gravity.x;
-                tmp.y = radial.y + tangential.y + modeA.gravity.y;
-                tmp.x *= dt;
-                tmp.y *= dt;
-
-                _particleData.modeA.dirX[i] += tmp.x;
-                _particleData.modeA.dirY[i] += tmp.y;
-
-                // this is cocos2d-x v3.0
-                // if (_configName.length()>0 && _yCoordFlipped != -1)
-
-                // this is cocos2d-x v3.0
-                tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
-                tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
-                _particleData.posx[i] += tmp.x;
-                _particleData.posy[i] += tmp.y;
-            }
-        }
-        else
-        {
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
+                    _batchNode->disableParticle(_atlasIndex + _particleData.atlasIndex[dst]);
+                std::swap(_particleData.atlasIndex[dst], _particleData.atlasIndex[src]);
             }
 
-            for (int i = 0; i < _particleCount; ++i)
+            _particleCount = aliveCount;
+            if (_particleCount == 0 && _isAutoRemoveOnFinish)
             {
-                _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
-            }
-
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.posx[i] = -cosf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i];
-            }
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.posy[i] =
-                    -sinf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i] * _yCoordFlipped;
+                this->unscheduleUpdate();
+                _parent->removeChild(this, true);
+                return;
             }
         }
 
-        // color r,g,b,a
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
-        }
-
-        for (int i = 0; i < _particleCount; ++i)
+        if (_emitterMode == Mode::GRAVITY)
         {
-            _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
+            ParticleKernels::integrateGravity(_particleData, modeA.gravity.x, modeA.gravity.y, dt, _yCoordFlipped,
+                                              _particleCount);
         }
-
-        for (int i = 0; i < _particleCount; ++i)
+        else
         {
-            _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
+            ParticleKernels::integrateRadius(_particleData, dt, _yCoordFlipped, _particleCount);
         }
 
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
-        }
+        // color r,g,b,a
+        ParticleKernels::integrate(_particleData.colorR, _particleData.deltaColorR, dt, _particleCount);
+        ParticleKernels::integrate(_particleData.colorG, _particleData.deltaColorG, dt, _particleCount);
+        ParticleKernels::integrate(_particleData.colorB, _particleData.deltaColorB, dt, _particleCount);
+        ParticleKernels::integrate(_particleData.colorA, _particleData.deltaColorA, dt, _particleCount);
         // size
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.size[i] += (_particleData.deltaSize[i] * dt);
-            _particleData.size[i] = MAX(0, _particleData.size[i]);
-        }
+        ParticleKernels::integrateNonNegative(_particleData.size, _particleData.deltaSize, dt, _particleCount);
         // angle
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
-        }
+        ParticleKernels::integrate(_particleData.rotation, _particleData.deltaRotation, dt, _particleCount);
 
         updateParticleQuads();
         _transformSystemDirty = false;
@@ -1834,8 +1800,6 @@ void ParticleSystem::update(float dt)
     {
         postStep();
     }
-
-    AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
 }
 
 void ParticleSystem::updateWithNoTime()
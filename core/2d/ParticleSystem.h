@@ -234,6 +234,12 @@ public:
         modeB.radius[p1]           = modeB.radius[p2];
         modeB.deltaRadius[p1]      = modeB.deltaRadius[p2];
     }
+
+    /**
+     * Applies copyParticle(dst, src) for every move, one property array at a time.
+     * atlasIndex is left alone, the caller decides how batched particles swap their atlas slots.
+     */
+    void moveParticles(const std::pair<int, int>* moves, size_t count);
 };
 
 /**
@@ -1526,6 +1532,9 @@ protected:
     // particle data
     ParticleData _particleData;
 
+    // (dst, src) pairs of the expired particles being swap-removed, reused every update
+    std::vector<std::pair<int, int>> _particleMoves;
+
     // Emitter name
     std::string _configName;
 
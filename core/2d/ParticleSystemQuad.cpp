@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "base/Types.h"
 #include "2d/SpriteFrame.h"
 #include "2d/ParticleBatchNode.h"
+#include "2d/ParticleKernels.h"
 #include "renderer/TextureAtlas.h"
 #include "renderer/Renderer.h"
 #include "base/Director.h"
@@ -260,52 +261,6 @@ void ParticleSystemQuad::initIndices()
     }
 }
 
-inline void updatePosWithParticle(V3F_C4B_T2F_Quad* quad,
-                                  const Vec2& newPosition,
-                                  float size,
-                                  float scaleInSize,
-                                  float rotation,
-                                  float staticRotation)
-{
-    // vertices
-    float size_2 = size / 2;
-    float x1     = -size_2 * scaleInSize;
-    float y1     = -size_2 * scaleInSize;
-
-    float x2 = size_2 * scaleInSize;
-    float y2 = size_2 * scaleInSize;
-    float x  = newPosition.x;
-    float y  = newPosition.y;
-
-    float r  = (float)-AX_DEGREES_TO_RADIANS(rotation + staticRotation);
-    float cr = cosf(r);
-    float sr = sinf(r);
-    float ax = x1 * cr - y1 * sr + x;
-    float ay = x1 * sr + y1 * cr + y;
-    float bx = x2 * cr - y1 * sr + x;
-    float by = x2 * sr + y1 * cr + y;
-    float cx = x2 * cr - y2 * sr + x;
-    float cy = x2 * sr + y2 * cr + y;
-    float dx = x1 * cr - y2 * sr + x;
-    float dy = x1 * sr + y2 * cr + y;
-
-    // bottom-left
-    quad->bl.vertices.x = ax;
-    quad->bl.vertices.y = ay;
-
-    // bottom-right vertex:
-    quad->br.vertices.x = bx;
-    quad->br.vertices.y = by;
-
-    // top-left vertex:
-    quad->tl.vertices.x = dx;
-    quad->tl.vertices.y = dy;
-
-    // top-right vertex:
-    quad->tr.vertices.x = cx;
-    quad->tr.vertices.y = cy;
-}
-
 void ParticleSystemQuad::updateParticleQuads()
 {
     if (_particleCount <= 0)
@@ -336,119 +291,31 @@ void ParticleSystemQuad::updateParticleQuads()
         startQuad = &(_quads[0]);
     }
 
+    // quad center = p + transform * startPos, see ParticleKernels::updateQuadVertices
+    float transform[6] = {0.0f, 0.0f, pos.x, 0.0f, 0.0f, pos.y};
     if (_positionType == PositionType::FREE)
     {
+        // p + pos - (p1 - worldToNode * startPos)
         Vec3 p1(currentPosition.x, currentPosition.y, 0);
         Mat4 worldToNodeTM = getWorldToNodeTransform();
         worldToNodeTM.transformPoint(&p1);
-        Vec3 p2;
-        Vec2 newPos;
-        float* startX               = _particleData.startPosX;
-        float* startY               = _particleData.startPosY;
-        float* x                    = _particleData.posx;
-        float* y                    = _particleData.posy;
-        float* s                    = _particleData.size;
-        float* r                    = _particleData.rotation;
-        float* sr                   = _particleData.staticRotation;
-        float* sid                  = _particleData.scaleInDelta;
-        float* sil                  = _particleData.scaleInLength;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        if (_isScaleInAllocated)
-        {
-            for (int i = 0; i < _particleCount;
-                 ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r, ++sr, ++sid, ++sil)
-            {
-                p2.set(*startX, *startY, 0);
-                worldToNodeTM.transformPoint(&p2);
-                newPos.set(*x, *y);
-                p2 = p1 - p2;
-                newPos.x -= p2.x - pos.x;
-                newPos.y -= p2.y - pos.y;
-                updatePosWithParticle(quadStart, newPos, *s, tweenfunc::expoEaseOut(*sid / *sil), *r, *sr);
-            }
-        }
-        else
-        {
-            for (int i = 0; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r, ++sr)
-            {
-                p2.set(*startX, *startY, 0);
-                worldToNodeTM.transformPoint(&p2);
-                newPos.set(*x, *y);
-                p2 = p1 - p2;
-                newPos.x -= p2.x - pos.x;
-                newPos.y -= p2.y - pos.y;
-                updatePosWithParticle(quadStart, newPos, *s, 1.0F, *r, *sr);
-            }
-        }
+        const float* m = worldToNodeTM.m;
+        transform[0]   = m[0];
+        transform[1]   = m[4];
+        transform[2]   = m[12] - p1.x + pos.x;
+        transform[3]   = m[1];
+        transform[4]   = m[5];
+        transform[5]   = m[13] - p1.y + pos.y;
     }
     else if (_positionType == PositionType::RELATIVE)
     {
-        Vec2 newPos;
-        float* startX               = _particleData.startPosX;
-        float* startY               = _particleData.startPosY;
-        float* x                    = _particleData.posx;
-        float* y                    = _particleData.posy;
-        float* s                    = _particleData.size;
-        float* r                    = _particleData.rotation;
-        float* sr                   = _particleData.staticRotation;
-        float* sid                  = _particleData.scaleInDelta;
-        float* sil                  = _particleData.scaleInLength;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        if (_isScaleInAllocated)
-        {
-            for (int i = 0; i < _particleCount;
-                 ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r, ++sr, ++sid, ++sil)
-            {
-                newPos.set(*x, *y);
-                newPos.x = *x - (currentPosition.x - *startX);
-                newPos.y = *y - (currentPosition.y - *startY);
-                newPos += pos;
-                updatePosWithParticle(quadStart, newPos, *s, tweenfunc::expoEaseOut(*sid / *sil), *r, *sr);
-            }
-        }
-        else
-        {
-            for (int i = 0; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r, ++sr)
-            {
-                newPos.set(*x, *y);
-                newPos.x = *x - (currentPosition.x - *startX);
-                newPos.y = *y - (currentPosition.y - *startY);
-                newPos += pos;
-                updatePosWithParticle(quadStart, newPos, *s, 1.0F, *r, *sr);
-            }
-        }
-    }
-    else
-    {
-        Vec2 newPos;
-        float* startX               = _particleData.startPosX;
-        float* startY               = _particleData.startPosY;
-        float* x                    = _particleData.posx;
-        float* y                    = _particleData.posy;
-        float* s                    = _particleData.size;
-        float* r                    = _particleData.rotation;
-        float* sr                   = _particleData.staticRotation;
-        float* sid                  = _particleData.scaleInDelta;
-        float* sil                  = _particleData.scaleInLength;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        if (_isScaleInAllocated)
-        {
-            for (int i = 0; i < _particleCount;
-                 ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r, ++sr, ++sid, ++sil)
-            {
-                newPos.set(*x + pos.x, *y + pos.y);
-                updatePosWithParticle(quadStart, newPos, *s, tweenfunc::expoEaseOut(*sid / *sil), *r, *sr);
-            }
-        }
-        else
-        {
-            for (int i = 0; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r, ++sr)
-            {
-                newPos.set(*x + pos.x, *y + pos.y);
-                updatePosWithParticle(quadStart, newPos, *s, 1.0F, *r, *sr);
-            }
-        }
+        // p + pos - (currentPosition - startPos)
+        transform[0] = 1.0f;
+        transform[2] = pos.x - currentPosition.x;
+        transform[4] = 1.0f;
+        transform[5] = pos.y - currentPosition.y;
     }
+    ParticleKernels::updateQuadVertices(startQuad, _particleData, transform, _isScaleInAllocated, _particleCount);
 
     V3F_C4B_T2F_Quad* quad = startQuad;
     float* r               = _particleData.colorR;
@@ -509,35 +376,7 @@ void ParticleSystemQuad::updateParticleQuads()
         }
         else
         {
-            // set color
-            if (_opacityModifyRGB)
-            {
-                for (int i = 0; i < _particleCount; ++i, ++quad, ++r, ++g, ++b, ++a, ++fadeDt, ++fadeLn)
-                {
-                    uint8_t colorR = *r * *a * 255;
-                    uint8_t colorG = *g * *a * 255;
-                    uint8_t colorB = *b * *a * 255;
-                    uint8_t colorA = *a * (*fadeDt / *fadeLn) * 255;
-                    quad->bl.colors.set(colorR, colorG, colorB, colorA);
-                    quad->br.colors.set(colorR, colorG, colorB, colorA);
-                    quad->tl.colors.set(colorR, colorG, colorB, colorA);
-                    quad->tr.colors.set(colorR, colorG, colorB, colorA);
-                }
-            }
-            else
-            {
-                for (int i = 0; i < _particleCount; ++i, ++quad, ++r, ++g, ++b, ++a, ++fadeDt, ++fadeLn)
-                {
-                    uint8_t colorR = *r * 255;
-                    uint8_t colorG = *g * 255;
-                    uint8_t colorB = *b * 255;
-                    uint8_t colorA = *a * (*fadeDt / *fadeLn) * 255;
-                    quad->bl.colors.set(colorR, colorG, colorB, colorA);
-                    quad->br.colors.set(colorR, colorG, colorB, colorA);
-                    quad->tl.colors.set(colorR, colorG, colorB, colorA);
-                    quad->tr.colors.set(colorR, colorG, colorB, colorA);
-                }
-            }
+            ParticleKernels::updateQuadColors(startQuad, _particleData, true, _opacityModifyRGB, _particleCount);
         }
     }
     else
@@ -588,35 +427,7 @@ void ParticleSystemQuad::updateParticleQuads()
         }
         else
         {
-            // set color
-            if (_opacityModifyRGB)
-            {
-                for (int i = 0; i < _particleCount; ++i, ++quad, ++r, ++g, ++b, ++a)
-                {
-                    uint8_t colorR = *r * *a * 255;
-                    uint8_t colorG = *g * *a * 255;
-                    uint8_t colorB = *b * *a * 255;
-                    uint8_t colorA = *a * 255;
-                    quad->bl.colors.set(colorR, colorG, colorB, colorA);
-                    quad->br.colors.set(colorR, colorG, colorB, colorA);
-                    quad->tl.colors.set(colorR, colorG, colorB, colorA);
-                    quad->tr.colors.set(colorR, colorG, colorB, colorA);
-                }
-            }
-            else
-            {
-                for (int i = 0; i < _particleCount; ++i, ++quad, ++r, ++g, ++b, ++a)
-                {
-                    uint8_t colorR = *r * 255;
-                    uint8_t colorG = *g * 255;
-                    uint8_t colorB = *b * 255;
-                    uint8_t colorA = *a * 255;
-                    quad->bl.colors.set(colorR, colorG, colorB, colorA);
-                    quad->br.colors.set(colorR, colorG, colorB, colorA);
-                    quad->tl.colors.set(colorR, colorG, colorB, colorA);
-                    quad->tr.colors.set(colorR, colorG, colorB, colorA);
-                }
-            }
+            ParticleKernels::updateQuadColors(startQuad, _particleData, false, _opacityModifyRGB, _particleCount);
         }
     }
 
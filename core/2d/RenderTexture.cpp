@@ -50,6 +50,9 @@ namespace ax
 // implementation RenderTexture
 RenderTexture::RenderTexture()
 {
+    // renders with group and callback commands
+    _parallelVisitSafe = false;
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     // Listen this event to save render texture before come to background.
     // Then it can be restored after coming to foreground on Android.
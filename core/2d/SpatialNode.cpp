@@ -0,0 +1,485 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/SpatialNode.h"
+#include "base/Director.h"
+
+#include <algorithm>
+#include <float.h>
+
+namespace ax
+{
+
+// entries covering more cells than this are kept apart and tested on every query
+static const int MAX_ENTRY_CELLS = 64;
+
+SpatialNode* SpatialNode::create(float cellSize)
+{
+    SpatialNode* ret = new SpatialNode();
+    if (ret->init(cellSize))
+    {
+        ret->autorelease();
+    }
+    else
+    {
+        AX_SAFE_DELETE(ret);
+    }
+    return ret;
+}
+
+SpatialNode::SpatialNode() {}
+
+SpatialNode::~SpatialNode() {}
+
+bool SpatialNode::init(float cellSize)
+{
+    if (!Node::init())
+        return false;
+
+    AXASSERT(cellSize > 0, "Invalid cell size");
+    _cellSize = cellSize;
+    return true;
+}
+
+void SpatialNode::setCellSize(float cellSize)
+{
+    AXASSERT(cellSize > 0, "Invalid cell size");
+    if (cellSize == _cellSize)
+        return;
+
+    _cellSize = cellSize;
+    for (uint32_t slot = 0; slot < _entries.size(); ++slot)
+    {
+        if (_entries[slot].node)
+            unplaceEntry(slot);
+    }
+    for (uint32_t slot = 0; slot < _entries.size(); ++slot)
+    {
+        if (_entries[slot].node)
+            placeEntry(slot, _entries[slot].bounds);
+    }
+}
+
+void SpatialNode::setCullingMargin(float margin)
+{
+    if (margin == _cullingMargin)
+        return;
+
+    _cullingMargin = margin;
+    for (uint32_t slot = 0; slot < _entries.size(); ++slot)
+    {
+        if (auto node = _entries[slot].node)
+        {
+            unplaceEntry(slot);
+            placeEntry(slot, computeBounds(node));
+        }
+    }
+}
+
+void SpatialNode::updateChildBounds(Node* child)
+{
+    auto it = _slots.find(child);
+    if (it == _slots.end())
+        return;
+
+    auto bounds = computeBounds(child);
+    if (!bounds.equals(_entries[it->second].bounds))
+    {
+        unplaceEntry(it->second);
+        placeEntry(it->second, bounds);
+    }
+}
+
+void SpatialNode::queryRect(const Rect& rect, std::vector<Node*>& result)
+{
+    refreshBounds(false);
+    collect(rect);
+    for (auto slot : _querySlots)
+        result.emplace_back(_entries[slot].node);
+}
+
+void SpatialNode::queryPoint(const Vec2& point, std::vector<Node*>& result)
+{
+    refreshBounds(false);
+    collect(Rect(point.x, point.y, 0, 0));
+    for (auto slot : _querySlots)
+    {
+        auto& entry = _entries[slot];
+        if (entry.bounds.containsPoint(point))
+            result.emplace_back(entry.node);
+    }
+}
+
+void SpatialNode::addChild(Node* child, int localZOrder, int tag)
+{
+    Node::addChild(child, localZOrder, tag);
+    insertEntry(child);
+}
+
+void SpatialNode::addChild(Node* child, int localZOrder, std::string_view name)
+{
+    Node::addChild(child, localZOrder, name);
+    insertEntry(child);
+}
+
+void SpatialNode::removeChild(Node* child, bool cleanup)
+{
+    // the child may be released by Node::removeChild
+    removeEntry(child);
+    Node::removeChild(child, cleanup);
+}
+
+void SpatialNode::removeAllChildrenWithCleanup(bool cleanup)
+{
+    _entries.clear();
+    _freeSlots.clear();
+    _slots.clear();
+    _cells.clear();
+    _largeSlots.clear();
+    Node::removeAllChildrenWithCleanup(cleanup);
+}
+
+void SpatialNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (!_visible)
+    {
+        return;
+    }
+
+    if (!_cullingEnabled)
+    {
+        Node::visit(renderer, parentTransform, parentFlags);
+        _visitedCount = _children.size();
+        _culledCount  = 0;
+        return;
+    }
+
+    uint32_t flags = processParentFlags(parentTransform, parentFlags);
+    if (flags & FLAGS_DIRTY_MASK)
+        ++_dirtyEpoch;
+
+    // IMPORTANT:
+    // To ease the migration to v3.0, we still support the Mat4 stack,
+    // but it is deprecated and your code should not rely on it
+    const bool useMatrixStack = !_transformSystem;
+    if (useMatrixStack)
+    {
+        _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
+
+    const bool reordered = _reorderChildDirty;
+    sortAllChildren();
+    if (reordered || _orderDirty)
+        refreshOrder();
+    refreshBounds(true);
+
+    const bool visibleByCamera = isVisitableByVisitingCamera();
+
+    Rect view;
+    if (computeViewRect(view))
+    {
+        collect(view);
+        std::sort(_querySlots.begin(), _querySlots.end(),
+                  [this](uint32_t a, uint32_t b) { return _entries[a].order < _entries[b].order; });
+
+        size_t i = 0;
+        const size_t count = _querySlots.size();
+        for (; i < count; ++i)
+        {
+            auto& entry = _entries[_querySlots[i]];
+            if (entry.node->_localZOrder >= 0)
+                break;
+            visitEntry(entry, renderer, flags);
+        }
+        if (visibleByCamera)
+            this->draw(renderer, _modelViewTransform, flags);
+        for (; i < count; ++i)
+            visitEntry(_entries[_querySlots[i]], renderer, flags);
+
+        _visitedCount = count;
+        _culledCount  = _children.size() - count;
+    }
+    else
+    {
+        // the plane of this node is not facing the camera, nothing can be culled
+        size_t i = 0;
+        const size_t count = _children.size();
+        for (; i < count && _children.at(i)->_localZOrder < 0; ++i)
+            visitChild(_children.at(i), renderer, flags);
+        if (visibleByCamera)
+            this->draw(renderer, _modelViewTransform, flags);
+        for (; i < count; ++i)
+            visitChild(_children.at(i), renderer, flags);
+
+        _visitedCount = count;
+        _culledCount  = 0;
+    }
+
+    if (useMatrixStack)
+        _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+}
+
+void SpatialNode::visitEntry(Entry& entry, Renderer* renderer, uint32_t flags)
+{
+    // a culled child missed the dirty flags of the visits since its last one, e.g. this node moved meanwhile
+    if (entry.dirtyEpoch != _dirtyEpoch)
+    {
+        flags |= FLAGS_DIRTY_MASK;
+        entry.dirtyEpoch = _dirtyEpoch;
+    }
+    visitChild(entry.node, renderer, flags);
+}
+
+void SpatialNode::insertEntry(Node* child)
+{
+    uint32_t slot;
+    if (!_freeSlots.empty())
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(_entries.size());
+        _entries.emplace_back();
+    }
+
+    _entries[slot].node       = child;
+    _entries[slot].dirtyEpoch = _dirtyEpoch;
+    _slots[child]             = slot;
+    placeEntry(slot, computeBounds(child));
+    _orderDirty = true;
+}
+
+void SpatialNode::removeEntry(Node* child)
+{
+    auto it = _slots.find(child);
+    if (it == _slots.end())
+        return;
+
+    const auto slot = it->second;
+    unplaceEntry(slot);
+    _entries[slot] = Entry{};
+    _freeSlots.emplace_back(slot);
+    _slots.erase(it);
+    _orderDirty = true;
+}
+
+void SpatialNode::placeEntry(uint32_t slot, const Rect& bounds)
+{
+    auto& entry    = _entries[slot];
+    entry.bounds   = bounds;
+    entry.cellMinX = static_cast<int>(std::floor(bounds.getMinX() / _cellSize));
+    entry.cellMinY = static_cast<int>(std::floor(bounds.getMinY() / _cellSize));
+    entry.cellMaxX = static_cast<int>(std::floor(bounds.getMaxX() / _cellSize));
+    entry.cellMaxY = static_cast<int>(std::floor(bounds.getMaxY() / _cellSize));
+
+    const int64_t cells = int64_t(entry.cellMaxX - entry.cellMinX + 1) * (entry.cellMaxY - entry.cellMinY + 1);
+    if (cells > MAX_ENTRY_CELLS)
+    {
+        _largeSlots.emplace_back(slot);
+        return;
+    }
+
+    for (int y = entry.cellMinY; y <= entry.cellMaxY; ++y)
+        for (int x = entry.cellMinX; x <= entry.cellMaxX; ++x)
+            _cells[cellKey(x, y)].emplace_back(slot);
+}
+
+void SpatialNode::unplaceEntry(uint32_t slot)
+{
+    auto& entry = _entries[slot];
+
+    auto removeSlot = [slot](std::vector<uint32_t>& slots) {
+        auto it = std::find(slots.begin(), slots.end(), slot);
+        if (it != slots.end())
+        {
+            *it = slots.back();
+            slots.pop_back();
+        }
+    };
+
+    const int64_t cells = int64_t(entry.cellMaxX - entry.cellMinX + 1) * (entry.cellMaxY - entry.cellMinY + 1);
+    if (cells > MAX_ENTRY_CELLS)
+    {
+        removeSlot(_largeSlots);
+        return;
+    }
+
+    for (int y = entry.cellMinY; y <= entry.cellMaxY; ++y)
+    {
+        for (int x = entry.cellMinX; x <= entry.cellMaxX; ++x)
+        {
+            auto it = _cells.find(cellKey(x, y));
+            if (it == _cells.end())
+                continue;
+            removeSlot(it->second);
+            if (it->second.empty())
+                _cells.erase(it);
+        }
+    }
+}
+
+Rect SpatialNode::computeBounds(Node* child) const
+{
+    auto bounds = child->getBoundingBox();
+    bounds.origin.x -= _cullingMargin;
+    bounds.origin.y -= _cullingMargin;
+    bounds.size.width += _cullingMargin * 2;
+    bounds.size.height += _cullingMargin * 2;
+    return bounds;
+}
+
+void SpatialNode::refreshBounds(bool force)
+{
+    const auto frame = _director->getTotalFrames();
+    if (!force && frame == _boundsFrame)
+        return;
+    _boundsFrame = frame;
+
+    if (!_autoUpdateEnabled)
+        return;
+
+    for (uint32_t slot = 0, count = static_cast<uint32_t>(_entries.size()); slot < count; ++slot)
+    {
+        auto node = _entries[slot].node;
+        // culled children keep their dirty flags until they are visited again
+        if (node && (node->_transformUpdated || node->_contentSizeDirty))
+        {
+            auto bounds = computeBounds(node);
+            if (!bounds.equals(_entries[slot].bounds))
+            {
+                unplaceEntry(slot);
+                placeEntry(slot, bounds);
+            }
+        }
+    }
+}
+
+void SpatialNode::refreshOrder()
+{
+    for (uint32_t i = 0, count = static_cast<uint32_t>(_children.size()); i < count; ++i)
+    {
+        auto it = _slots.find(_children.at(i));
+        if (it != _slots.end())
+            _entries[it->second].order = i;
+    }
+    _orderDirty = false;
+}
+
+bool SpatialNode::computeViewRect(Rect& rect) const
+{
+    // the corners of the clip space volume, projected on the z = 0 plane of this node
+    Mat4 clipToLocal = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION) * _modelViewTransform;
+    clipToLocal.inverse();
+
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    static const float corners[4][2] = {{-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+    for (auto&& corner : corners)
+    {
+        Vec4 nearPoint, farPoint;
+        clipToLocal.transformVector(Vec4(corner[0], corner[1], -1, 1), &nearPoint);
+        clipToLocal.transformVector(Vec4(corner[0], corner[1], 1, 1), &farPoint);
+        if (nearPoint.w == 0 || farPoint.w == 0)
+            return false;
+
+        Vec3 a(nearPoint.x / nearPoint.w, nearPoint.y / nearPoint.w, nearPoint.z / nearPoint.w);
+        Vec3 b(farPoint.x / farPoint.w, farPoint.y / farPoint.w, farPoint.z / farPoint.w);
+        const float dz = a.z - b.z;
+        if (std::abs(dz) < FLT_EPSILON)
+            return false;
+
+        const float t = a.z / dz;
+        if (t < 0 || t > 1)
+            return false;
+
+        const float x = a.x + (b.x - a.x) * t;
+        const float y = a.y + (b.y - a.y) * t;
+        minX = (std::min)(minX, x);
+        minY = (std::min)(minY, y);
+        maxX = (std::max)(maxX, x);
+        maxY = (std::max)(maxY, y);
+    }
+
+    rect.setRect(minX, minY, maxX - minX, maxY - minY);
+    return true;
+}
+
+void SpatialNode::collect(const Rect& rect)
+{
+    _querySlots.clear();
+    if (++_queryStamp == 0)
+    {
+        for (auto&& entry : _entries)
+            entry.stamp = 0;
+        _queryStamp = 1;
+    }
+
+    auto test = [this, &rect](uint32_t slot) {
+        auto& entry = _entries[slot];
+        if (entry.stamp != _queryStamp && entry.bounds.intersectsRect(rect))
+        {
+            entry.stamp = _queryStamp;
+            _querySlots.emplace_back(slot);
+        }
+    };
+
+    const int minX      = static_cast<int>(std::floor(rect.getMinX() / _cellSize));
+    const int minY      = static_cast<int>(std::floor(rect.getMinY() / _cellSize));
+    const int maxX      = static_cast<int>(std::floor(rect.getMaxX() / _cellSize));
+    const int maxY      = static_cast<int>(std::floor(rect.getMaxY() / _cellSize));
+    const int64_t cells = int64_t(maxX - minX + 1) * (maxY - minY + 1);
+
+    if (cells > static_cast<int64_t>(_cells.size()))
+    {
+        // zoomed out, testing the occupied cells is cheaper
+        for (auto&& cell : _cells)
+        {
+            const int x = static_cast<int32_t>(cell.first >> 32);
+            const int y = static_cast<int32_t>(cell.first & 0xffffffff);
+            if (x >= minX && x <= maxX && y >= minY && y <= maxY)
+                for (auto slot : cell.second)
+                    test(slot);
+        }
+    }
+    else
+    {
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int x = minX; x <= maxX; ++x)
+            {
+                auto it = _cells.find(cellKey(x, y));
+                if (it != _cells.end())
+                    for (auto slot : it->second)
+                        test(slot);
+            }
+        }
+    }
+
+    for (auto slot : _largeSlots)
+        test(slot);
+}
+
+}  // namespace ax
@@ -0,0 +1,164 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "2d/Node.h"
+
+namespace ax
+{
+
+/**
+ *  @addtogroup _2d
+ *  @{
+ */
+
+/**
+ * @brief A container node keeping its children in a uniform grid.
+ *
+ * Before visiting, the viewport of the visiting camera is projected on the plane of the node, and only the
+ * children whose bounds overlap it are visited, so off-screen subtrees are neither sorted, transformed nor drawn.
+ * The bounds of a child are its bounding box in the space of this node, enlarged by the culling margin, so the
+ * descendants of a child must stay within the margin around it.
+ *
+ * The grid is also queried by queryRect and queryPoint.
+ * @since axmol-2.2
+ */
+class AX_DLL SpatialNode : public Node
+{
+public:
+    /** Creates a spatial node.
+     *
+     * @param cellSize The size of the grid cells, in the space of this node.
+     * @return An autorelease SpatialNode.
+     */
+    static SpatialNode* create(float cellSize = 256.0f);
+
+    /** Sets the size of the grid cells, which rebuilds the grid. */
+    void setCellSize(float cellSize);
+    float getCellSize() const { return _cellSize; }
+
+    /** Whether the children outside of the viewport are skipped, true by default. */
+    void setCullingEnabled(bool enabled) { _cullingEnabled = enabled; }
+    bool isCullingEnabled() const { return _cullingEnabled; }
+
+    /** Enlarges the bounds of the children, for children whose descendants or effects exceed their content. */
+    void setCullingMargin(float margin);
+    float getCullingMargin() const { return _cullingMargin; }
+
+    /**
+     * Whether the bounds of the moved children are refreshed automatically, true by default.
+     * It checks the dirty flags of every child once per frame, static worlds may disable it and call
+     * updateChildBounds after moving a child.
+     */
+    void setAutoUpdateEnabled(bool enabled) { _autoUpdateEnabled = enabled; }
+    bool isAutoUpdateEnabled() const { return _autoUpdateEnabled; }
+
+    /** Refreshes the bounds of child in the grid. */
+    void updateChildBounds(Node* child);
+
+    /**
+     * Appends the children whose bounds overlap rect to result, in no particular order.
+     *
+     * @param rect A rectangle in the space of this node.
+     */
+    void queryRect(const Rect& rect, std::vector<Node*>& result);
+
+    /**
+     * Appends the children whose bounds contain point to result, in no particular order.
+     *
+     * @param point A point in the space of this node.
+     */
+    void queryPoint(const Vec2& point, std::vector<Node*>& result);
+
+    /** The number of children visited by the last visit. */
+    size_t getVisitedCount() const { return _visitedCount; }
+
+    /** The number of children skipped by the last visit. */
+    size_t getCulledCount() const { return _culledCount; }
+
+    // Overrides
+    using Node::addChild;
+    void addChild(Node* child, int localZOrder, int tag) override;
+    void addChild(Node* child, int localZOrder, std::string_view name) override;
+    void removeChild(Node* child, bool cleanup = true) override;
+    void removeAllChildrenWithCleanup(bool cleanup) override;
+    void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
+
+    SpatialNode();
+    ~SpatialNode() override;
+
+    bool init(float cellSize);
+
+protected:
+    struct Entry
+    {
+        Node* node = nullptr;
+        Rect bounds;
+        int cellMinX = 0, cellMinY = 0, cellMaxX = -1, cellMaxY = -1;
+        uint32_t order = 0;  ///< index in _children
+        uint32_t stamp = 0;  ///< last query which reported the entry
+        uint32_t dirtyEpoch = 0;  ///< _dirtyEpoch when the child was last visited
+    };
+
+    static uint64_t cellKey(int x, int y) { return (uint64_t(uint32_t(x)) << 32) | uint32_t(y); }
+
+    void insertEntry(Node* child);
+    void removeEntry(Node* child);
+    void placeEntry(uint32_t slot, const Rect& bounds);
+    void unplaceEntry(uint32_t slot);
+    Rect computeBounds(Node* child) const;
+    void refreshBounds(bool force);
+    void refreshOrder();
+    bool computeViewRect(Rect& rect) const;
+    /// collects the slots of the entries overlapping rect into _querySlots
+    void collect(const Rect& rect);
+    void visitEntry(Entry& entry, Renderer* renderer, uint32_t flags);
+
+    float _cellSize         = 256.0f;
+    float _cullingMargin    = 0.0f;
+    bool _cullingEnabled    = true;
+    bool _autoUpdateEnabled = true;
+    bool _orderDirty        = false;
+
+    std::vector<Entry> _entries;
+    std::vector<uint32_t> _freeSlots;
+    std::unordered_map<Node*, uint32_t> _slots;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> _cells;
+    std::vector<uint32_t> _largeSlots;  ///< entries covering too many cells
+
+    std::vector<uint32_t> _querySlots;
+    uint32_t _queryStamp      = 0;
+    unsigned int _boundsFrame = 0;
+    uint32_t _dirtyEpoch      = 0;  ///< bumped by the visits passing dirty flags to the children
+
+    size_t _visitedCount = 0;
+    size_t _culledCount  = 0;
+};
+
+// end of _2d group
+/// @}
+
+}  // namespace ax
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "2d/Sprite.h"
 #include <algorithm>
 #include <stddef.h>  // offsetof
+#include <typeinfo>
 #include "base/Types.h"
 #include "2d/SpriteBatchNode.h"
 #include "2d/AnimationCache.h"
@@ -266,6 +267,7 @@ bool Sprite::initWithPolygon(const ax::PolygonInfo& info)
     {
         _polyInfo   = info;
         _renderMode = RenderMode::POLYGON;
+        _trianglesCommand.markContentDirty();
         Node::setContentSize(_polyInfo.getRect().size / _director->getContentScaleFactor());
         ret = true;
     }
@@ -308,6 +310,10 @@ bool Sprite::initWithTexture(Texture2D* texture, const Rect& rect, bool rotated)
         // by default use "Self Render".
         // if the sprite is added to a batchnode, then it will automatically switch to "batchnode Render"
         setBatchNode(nullptr);
+
+        // every in place modification of _quad or _polyInfo must call _trianglesCommand.markContentDirty(),
+        // subclasses may not, so they're hashed by the batch cache unless they enable it themselves
+        _trianglesCommand.setDirtyTracking(typeid(*this) == typeid(Sprite));
         result = true;
     }
 
@@ -701,6 +707,8 @@ void Sprite::updatePoly()
         // to avoid memcpy'ing stuff
         _polyInfo.setTriangles(triangles);
     }
+
+    _trianglesCommand.markContentDirty();
 }
 
 void Sprite::setCenterRectNormalized(const ax::Rect& rectTopLeft)
@@ -806,6 +814,7 @@ void Sprite::setVertexRect(const Rect& rect)
 void Sprite::setTextureCoords(const Rect& rectInPoints)
 {
     setTextureCoords(rectInPoints, &_quad);
+    _trianglesCommand.markContentDirty();
 }
 
 void Sprite::setTextureCoords(const Rect& rectInPoints, V3F_C4B_T2F_Quad* outQuad)
@@ -1470,6 +1479,7 @@ void Sprite::flipX()
             auto& v = _polyInfo.triangles.verts[i].vertices;
             v.x     = _contentSize.width - v.x;
         }
+        _trianglesCommand.markContentDirty();
     }
     else
         // RenderMode:: Quad or Slice9
@@ -1487,6 +1497,7 @@ void Sprite::flipY()
             auto& v = _polyInfo.triangles.verts[i].vertices;
             v.y     = _contentSize.height - v.y;
         }
+        _trianglesCommand.markContentDirty();
     }
     else
         // RenderMode:: Quad or Slice9
@@ -1516,6 +1527,7 @@ void Sprite::updateColor()
     // when switching from Quad to Slice9, the color will be obtained from _quad
     // so it is important to update _quad colors as well.
     _quad.bl.colors = _quad.tl.colors = _quad.br.colors = _quad.tr.colors = color4;
+    _trianglesCommand.markContentDirty();
 
     // renders using batch node
     if (_renderMode == RenderMode::QUAD_BATCHNODE)
@@ -1662,6 +1674,7 @@ void Sprite::setBatchNode(SpriteBatchNode* spriteBatchNode)
         _quad.br.vertices.set(x2, y1, 0);
         _quad.tl.vertices.set(x1, y2, 0);
         _quad.tr.vertices.set(x2, y2, 0);
+        _trianglesCommand.markContentDirty();
     }
     else
     {
@@ -1716,6 +1729,7 @@ void Sprite::setPolygonInfo(const PolygonInfo& info)
 {
     _polyInfo   = info;
     _renderMode = RenderMode::POLYGON;
+    _trianglesCommand.markContentDirty();
 }
 
 void Sprite::setMVPMatrixUniform()
@@ -690,6 +690,8 @@ protected:
     BlendFunc _blendFunc;                 /// It's required for TextureProtocol inheritance
     Texture2D* _texture       = nullptr;  /// Texture2D object that is used to render the sprite
     SpriteFrame* _spriteFrame = nullptr;
+    /// Dirty tracking is only enabled for Sprite itself. Subclasses calling `_trianglesCommand.markContentDirty()`
+    /// after each in place modification of _quad or _polyInfo can enable it after initWithTexture.
     TrianglesCommand _trianglesCommand;
 
     backend::UniformLocation _mvpMatrixLocation;
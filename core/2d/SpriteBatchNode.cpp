@@ -160,7 +160,11 @@ bool SpriteBatchNode::initWithFile(std::string_view fileImage, ssize_t capacity
     return initWithTexture(texture2D, capacity);
 }
 
-SpriteBatchNode::SpriteBatchNode() {}
+SpriteBatchNode::SpriteBatchNode()
+{
+    // the children are transformed by updateTransform, not by visit
+    _transformSystemExcluded = true;
+}
 
 SpriteBatchNode::~SpriteBatchNode()
 {
@@ -171,8 +175,6 @@ SpriteBatchNode::~SpriteBatchNode()
 // don't call visit on it's children
 void SpriteBatchNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
 {
-    AX_PROFILER_START_CATEGORY(kProfilerCategoryBatchSprite, "CCSpriteBatchNode - visit");
-
     // CAREFUL:
     // This visit is almost identical to CocosNode#visit
     // with the exception that it doesn't call visit on it's children
@@ -185,6 +187,8 @@ void SpriteBatchNode::visit(Renderer* renderer, const Mat4& parentTransform, uin
         return;
     }
 
+    AX_PROFILE_ZONE("SpriteBatchNode::visit");
+
     sortAllChildren();
 
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
@@ -203,8 +207,6 @@ void SpriteBatchNode::visit(Renderer* renderer, const Mat4& parentTransform, uin
         // FIX ME: Why need to set _orderOfArrival to 0??
         // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
         //    setOrderOfArrival(0);
-
-        AX_PROFILER_STOP_CATEGORY(kProfilerCategoryBatchSprite, "CCSpriteBatchNode - visit");
     }
 }
 
@@ -0,0 +1,177 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/TransformSystem.h"
+#include "2d/Node.h"
+#include "2d/Camera.h"
+
+#include <string.h>
+
+namespace ax
+{
+
+TransformSystem::TransformSystem(Node* root) : _root(root) {}
+
+TransformSystem::~TransformSystem()
+{
+    detach(_root, this);
+}
+
+void TransformSystem::detach(Node* node, TransformSystem* system)
+{
+    if (node->_transformSystem != system)
+        return;
+
+    node->_transformSystem      = nullptr;
+    node->_transformIndex       = -1;
+    node->_transformSystemFlags = 0;
+
+    for (auto&& child : node->_children)
+        detach(child, system);
+}
+
+void TransformSystem::rebuild()
+{
+    _nodes.clear();
+    _parents.clear();
+    _ends.clear();
+
+    collect(_root, -1);
+
+    const auto count = _nodes.size();
+    _locals.resize(count);
+    _worlds.resize(count);
+    _flags.resize(count);
+
+    // the nodes kept their model view transforms, so only the dirty ones have to be recomputed
+    for (size_t i = 0; i < count; ++i)
+    {
+        _worlds[i] = _nodes[i]->_modelViewTransform;
+        _flags[i]  = 0;
+    }
+
+    _hierarchyDirty = false;
+    ++_rebuildCount;
+}
+
+void TransformSystem::collect(Node* node, int parentIndex)
+{
+    const int index = static_cast<int>(_nodes.size());
+
+    node->_transformSystem = this;
+    node->_transformIndex  = index;
+    _nodes.emplace_back(node);
+    _parents.emplace_back(parentIndex);
+    _ends.emplace_back(index + 1);
+
+    for (auto&& child : node->_children)
+    {
+        // excluded nodes and the roots of nested systems keep their subtrees to themselves
+        if (child->_transformSystemExcluded ||
+            (child->_transformSystem && child->_transformSystem->_root == child))
+            continue;
+        collect(child, index);
+    }
+
+    _ends[index] = static_cast<int>(_nodes.size());
+}
+
+uint32_t TransformSystem::update(const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (_hierarchyDirty)
+        rebuild();
+
+    if (_fullUpdate || memcmp(_parentTransform.m, parentTransform.m, sizeof(_parentTransform.m)) != 0)
+    {
+        _parentTransform = parentTransform;
+        _fullUpdate      = false;
+        parentFlags |= Node::FLAGS_TRANSFORM_DIRTY;
+    }
+
+    auto camera                     = Camera::getVisitingCamera();
+    const unsigned short cameraFlag = camera ? (unsigned short)camera->getCameraFlag() : 0xffff;
+
+    const int count = static_cast<int>(_nodes.size());
+    size_t updated  = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto node = _nodes[i];
+
+        // invisible subtrees are not visited, their nodes stay dirty until they are shown, like Node::visit does
+        if (!node->_visible && i != 0)
+        {
+            i = _ends[i] - 1;
+            continue;
+        }
+
+        const int parent        = _parents[i];
+        uint32_t flags          = parent < 0 ? parentFlags : _flags[parent];
+        const Mat4& parentWorld = parent < 0 ? parentTransform : _worlds[parent];
+
+        if (node->_usingNormalizedPosition)
+        {
+            AXASSERT(node->_parent, "setPositionNormalized() doesn't work with orphan nodes");
+            if ((flags & Node::FLAGS_CONTENT_SIZE_DIRTY) || node->_normalizedPositionDirty)
+            {
+                auto& s                 = node->_parent->getContentSize();
+                node->_position.x       = node->_normalizedPosition.x * s.width;
+                node->_position.y       = node->_normalizedPosition.y * s.height;
+                node->_transformUpdated = node->_transformDirty = node->_inverseDirty = true;
+                node->_normalizedPositionDirty = false;
+            }
+        }
+
+        // same as Node::isVisitableByVisitingCamera
+        if ((node->_cameraMask & cameraFlag) == 0)
+        {
+            _worlds[i]                  = node->_modelViewTransform;
+            _flags[i]                   = flags;
+            node->_transformSystemFlags = flags;
+            continue;
+        }
+
+        flags |= (node->_transformUpdated ? Node::FLAGS_TRANSFORM_DIRTY : 0);
+        flags |= (node->_contentSizeDirty ? Node::FLAGS_CONTENT_SIZE_DIRTY : 0);
+
+        if (flags & Node::FLAGS_DIRTY_MASK)
+        {
+            _locals[i] = node->getNodeToParentTransform();
+            Mat4::multiply(parentWorld, _locals[i], &_worlds[i]);
+            node->_modelViewTransform = _worlds[i];
+            ++updated;
+        }
+
+        node->_transformUpdated     = false;
+        node->_contentSizeDirty     = false;
+        _flags[i]                   = flags;
+        node->_transformSystemFlags = flags;
+    }
+
+    _updatedCount = updated;
+
+    return _flags.empty() ? parentFlags : _flags[0];
+}
+
+}  // namespace ax
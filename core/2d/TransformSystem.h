@@ -0,0 +1,100 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <vector>
+#include "math/Mat4.h"
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+class Node;
+
+/**
+ * Computes the model view transforms of a node subtree from contiguous, hierarchy-ordered arrays.
+ *
+ * The nodes of the subtree are stored in pre-order, so a parent is always stored before its children and a
+ * single forward pass over the arrays updates the whole subtree. Only the nodes whose transform, content size
+ * or ancestors changed are recomputed. Nodes managed by a system skip the deprecated MATRIX_STACK_MODELVIEW
+ * in Node::visit.
+ *
+ * A system is owned by its root node, see Node::setTransformSystemEnabled.
+ * @since axmol-2.2
+ */
+class AX_DLL TransformSystem
+{
+public:
+    explicit TransformSystem(Node* root);
+    ~TransformSystem();
+
+    /** The node owning the system. */
+    Node* getRoot() const { return _root; }
+
+    /** Requests a rebuild of the arrays before the next update, called when the hierarchy changes. */
+    void setHierarchyDirty() { _hierarchyDirty = true; }
+    bool isHierarchyDirty() const { return _hierarchyDirty; }
+
+    /** Recomputes every transform on the next update, called when a node was transformed outside of the system. */
+    void setFullUpdate() { _fullUpdate = true; }
+
+    /**
+     * Updates the transforms of the subtree, called by the root in Node::processParentFlags.
+     *
+     * @return The flags of the root, as Node::processParentFlags would return them.
+     */
+    uint32_t update(const Mat4& parentTransform, uint32_t parentFlags);
+
+    /** The number of nodes managed by the system. */
+    size_t getNodeCount() const { return _nodes.size(); }
+
+    /** The number of transforms recomputed by the last update. */
+    size_t getUpdatedCount() const { return _updatedCount; }
+
+    /** The number of times the arrays were rebuilt. */
+    unsigned int getRebuildCount() const { return _rebuildCount; }
+
+    /** Detaches node and its managed descendants from system. */
+    static void detach(Node* node, TransformSystem* system);
+
+protected:
+    void rebuild();
+    void collect(Node* node, int parentIndex);
+
+    Node* _root;
+    std::vector<Node*> _nodes;
+    std::vector<int> _parents;
+    std::vector<int> _ends;  ///< one past the last descendant
+    std::vector<Mat4> _locals;
+    std::vector<Mat4> _worlds;
+    std::vector<uint32_t> _flags;
+
+    Mat4 _parentTransform;
+    size_t _updatedCount       = 0;
+    unsigned int _rebuildCount = 0;
+    bool _hierarchyDirty       = true;
+    bool _fullUpdate           = true;
+};
+
+}  // namespace ax
@@ -0,0 +1,504 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/TweenBatch.h"
+#include "2d/ActionEase.h"
+#include "2d/Node.h"
+#include "base/Config.h"
+
+#include <algorithm>
+#include <typeindex>
+
+namespace ax
+{
+
+enum TweenFlags : uint8_t
+{
+    FIRST_TICK       = 1 << 0,
+    ACTIVE           = 1 << 1,  ///< not paused during the current update
+    UNIFORM_ROTATION = 1 << 2,  ///< rotates with setRotation, like RotateBy/RotateTo with physics enabled
+};
+
+// the easing actions whose update is _inner->update(func(time))
+static const std::unordered_map<std::type_index, float (*)(float)>& getEaseFunctions()
+{
+    static const std::unordered_map<std::type_index, float (*)(float)> functions = {
+        {typeid(EaseExponentialIn), tweenfunc::expoEaseIn},
+        {typeid(EaseExponentialOut), tweenfunc::expoEaseOut},
+        {typeid(EaseExponentialInOut), tweenfunc::expoEaseInOut},
+        {typeid(EaseSineIn), tweenfunc::sineEaseIn},
+        {typeid(EaseSineOut), tweenfunc::sineEaseOut},
+        {typeid(EaseSineInOut), tweenfunc::sineEaseInOut},
+        {typeid(EaseBounceIn), tweenfunc::bounceEaseIn},
+        {typeid(EaseBounceOut), tweenfunc::bounceEaseOut},
+        {typeid(EaseBounceInOut), tweenfunc::bounceEaseInOut},
+        {typeid(EaseBackIn), tweenfunc::backEaseIn},
+        {typeid(EaseBackOut), tweenfunc::backEaseOut},
+        {typeid(EaseBackInOut), tweenfunc::backEaseInOut},
+        {typeid(EaseQuadraticActionIn), tweenfunc::quadraticIn},
+        {typeid(EaseQuadraticActionOut), tweenfunc::quadraticOut},
+        {typeid(EaseQuadraticActionInOut), tweenfunc::quadraticInOut},
+        {typeid(EaseQuarticActionIn), tweenfunc::quartEaseIn},
+        {typeid(EaseQuarticActionOut), tweenfunc::quartEaseOut},
+        {typeid(EaseQuarticActionInOut), tweenfunc::quartEaseInOut},
+        {typeid(EaseQuinticActionIn), tweenfunc::quintEaseIn},
+        {typeid(EaseQuinticActionOut), tweenfunc::quintEaseOut},
+        {typeid(EaseQuinticActionInOut), tweenfunc::quintEaseInOut},
+        {typeid(EaseCircleActionIn), tweenfunc::circEaseIn},
+        {typeid(EaseCircleActionOut), tweenfunc::circEaseOut},
+        {typeid(EaseCircleActionInOut), tweenfunc::circEaseInOut},
+        {typeid(EaseCubicActionIn), tweenfunc::cubicEaseIn},
+        {typeid(EaseCubicActionOut), tweenfunc::cubicEaseOut},
+        {typeid(EaseCubicActionInOut), tweenfunc::cubicEaseInOut},
+    };
+    return functions;
+}
+
+TweenBatch::TweenBatch() {}
+
+TweenBatch::~TweenBatch()
+{
+    clear();
+}
+
+bool TweenBatch::add(Action* action, const bool* paused)
+{
+    AXASSERT(!action->_batched, "action already batched");
+
+    auto interval = dynamic_cast<ActionInterval*>(action);
+    if (!interval || interval->_done)
+        return false;
+
+    EaseFunc ease = nullptr;
+    auto tween    = interval;
+    auto& eases   = getEaseFunctions();
+    auto easeIt   = eases.find(typeid(*interval));
+    if (easeIt != eases.end())
+    {
+        ease  = easeIt->second;
+        tween = static_cast<ActionEase*>(interval)->_inner;
+        if (!tween)
+            return false;
+    }
+
+    Property property;
+    Values values;
+    const auto& type = typeid(*tween);
+    if (type == typeid(MoveBy) || type == typeid(MoveTo))
+    {
+        auto move = static_cast<MoveBy*>(tween);
+        property  = Property::Position;
+        for (int c = 0; c < 3; ++c)
+        {
+            values.start[c]    = (&move->_startPosition.x)[c];
+            values.delta[c]    = (&move->_positionDelta.x)[c];
+            values.previous[c] = (&move->_previousPosition.x)[c];
+        }
+    }
+    else if (type == typeid(RotateTo))
+    {
+        auto rotate = static_cast<RotateTo*>(tween);
+        if (rotate->_is3D)
+            return false;
+        property        = Property::Rotation;
+        values.start[0] = rotate->_startAngle.x;
+        values.start[1] = rotate->_startAngle.y;
+        values.delta[0] = rotate->_diffAngle.x;
+        values.delta[1] = rotate->_diffAngle.y;
+    }
+    else if (type == typeid(RotateBy))
+    {
+        auto rotate = static_cast<RotateBy*>(tween);
+        if (rotate->_is3D)
+            return false;
+        property        = Property::Rotation;
+        values.start[0] = rotate->_startAngle.x;
+        values.start[1] = rotate->_startAngle.y;
+        values.delta[0] = rotate->_deltaAngle.x;
+        values.delta[1] = rotate->_deltaAngle.y;
+    }
+    else if (type == typeid(ScaleTo) || type == typeid(ScaleBy))
+    {
+        auto scale      = static_cast<ScaleTo*>(tween);
+        property        = Property::Scale;
+        values.start[0] = scale->_startScaleX;
+        values.start[1] = scale->_startScaleY;
+        values.start[2] = scale->_startScaleZ;
+        values.delta[0] = scale->_deltaX;
+        values.delta[1] = scale->_deltaY;
+        values.delta[2] = scale->_deltaZ;
+    }
+    else if (type == typeid(FadeTo) || type == typeid(FadeIn) || type == typeid(FadeOut))
+    {
+        auto fade       = static_cast<FadeTo*>(tween);
+        property        = Property::Opacity;
+        values.start[0] = fade->_fromOpacity;
+        values.delta[0] = static_cast<float>(fade->_toOpacity - fade->_fromOpacity);
+    }
+    else
+    {
+        return false;
+    }
+
+    if (!interval->_target || !tween->_target)
+        return false;
+
+#if defined(AX_ENABLE_PHYSICS)
+    if (property == Property::Rotation && values.start[0] == values.start[1] && values.delta[0] == values.delta[1])
+        values.flags |= UNIFORM_ROTATION;
+#endif
+    if (interval->_firstTick)
+        values.flags |= FIRST_TICK;
+
+    if (_updating)
+    {
+        // the lanes are being iterated, the action is batched at the end of the update
+        _pending.emplace_back(action, paused);
+        return true;
+    }
+
+    push(getLane(property, ease), interval, tween, paused, values);
+    return true;
+}
+
+void TweenBatch::remove(Action* action)
+{
+    if (!action->_batched)
+    {
+        auto it = std::find_if(_pending.begin(), _pending.end(), [action](auto& p) { return p.first == action; });
+        if (it != _pending.end())
+            _pending.erase(it);
+        return;
+    }
+
+    auto it = _index.find(action);
+    AXASSERT(it != _index.end(), "batched action not found");
+    const auto [laneIndex, slot] = it->second;
+    _index.erase(it);
+
+    auto& lane = _lanes[laneIndex];
+    writeBack(lane, slot);
+    if (_updating)
+    {
+        // the slot may not be applied yet, its target could be gone by then
+        lane.actions[slot] = nullptr;
+        lane.flags[slot] &= ~ACTIVE;
+        _needCompact = true;
+    }
+    else
+    {
+        erase(laneIndex, slot);
+    }
+}
+
+void TweenBatch::clear()
+{
+    AXASSERT(!_updating, "can't clear the tween batch during its update");
+
+    for (auto&& lane : _lanes)
+    {
+        for (uint32_t slot = 0; slot < lane.size(); ++slot)
+        {
+            if (lane.actions[slot])
+                writeBack(lane, slot);
+        }
+    }
+    _lanes.clear();
+    _index.clear();
+    _pending.clear();
+    _needCompact = false;
+}
+
+void TweenBatch::update(float dt)
+{
+    _updating = true;
+    // the setters may run actions, which are deferred, so no lane is added while iterating
+    for (auto&& lane : _lanes)
+    {
+        if (lane.size())
+        {
+            advance(lane, dt);
+            apply(lane);
+        }
+    }
+    _updating = false;
+
+    if (_needCompact)
+        compact();
+
+    if (!_pending.empty())
+    {
+        auto pending = std::move(_pending);
+        _pending.clear();
+        for (auto&& [action, paused] : pending)
+            add(action, paused);
+    }
+}
+
+uint32_t TweenBatch::getLane(Property property, EaseFunc ease)
+{
+    for (uint32_t i = 0; i < _lanes.size(); ++i)
+    {
+        if (_lanes[i].property == property && _lanes[i].ease == ease)
+            return i;
+    }
+
+    auto& lane    = _lanes.emplace_back();
+    lane.property = property;
+    lane.ease     = ease;
+    return static_cast<uint32_t>(_lanes.size() - 1);
+}
+
+void TweenBatch::push(uint32_t laneIndex,
+                      ActionInterval* action,
+                      ActionInterval* tween,
+                      const bool* paused,
+                      const Values& values)
+{
+    auto& lane = _lanes[laneIndex];
+    _index.emplace(action, std::make_pair(laneIndex, static_cast<uint32_t>(lane.size())));
+    static_cast<Action*>(action)->_batched = true;
+
+    lane.actions.emplace_back(action);
+    lane.tweens.emplace_back(tween);
+    lane.targets.emplace_back(tween->_target);
+    lane.paused.emplace_back(paused);
+    lane.flags.emplace_back(values.flags);
+    lane.elapsed.emplace_back(action->_elapsed);
+    lane.duration.emplace_back(action->_duration);
+    for (int c = 0; c < 3; ++c)
+    {
+        lane.start[c].emplace_back(values.start[c]);
+        lane.delta[c].emplace_back(values.delta[c]);
+        lane.previous[c].emplace_back(values.previous[c]);
+    }
+    lane.progress.emplace_back(0.0f);
+    for (auto&& v : lane.values)
+        v.emplace_back(0.0f);
+}
+
+void TweenBatch::erase(uint32_t laneIndex, uint32_t slot)
+{
+    auto& lane = _lanes[laneIndex];
+    auto last  = static_cast<uint32_t>(lane.size() - 1);
+    if (slot != last)
+    {
+        if (auto moved = lane.actions[last])
+            _index[moved].second = slot;
+
+        lane.actions[slot]  = lane.actions[last];
+        lane.tweens[slot]   = lane.tweens[last];
+        lane.targets[slot]  = lane.targets[last];
+        lane.paused[slot]   = lane.paused[last];
+        lane.flags[slot]    = lane.flags[last];
+        lane.elapsed[slot]  = lane.elapsed[last];
+        lane.duration[slot] = lane.duration[last];
+        for (int c = 0; c < 3; ++c)
+        {
+            lane.start[c][slot]    = lane.start[c][last];
+            lane.delta[c][slot]    = lane.delta[c][last];
+            lane.previous[c][slot] = lane.previous[c][last];
+        }
+    }
+
+    lane.actions.pop_back();
+    lane.tweens.pop_back();
+    lane.targets.pop_back();
+    lane.paused.pop_back();
+    lane.flags.pop_back();
+    lane.elapsed.pop_back();
+    lane.duration.pop_back();
+    for (int c = 0; c < 3; ++c)
+    {
+        lane.start[c].pop_back();
+        lane.delta[c].pop_back();
+        lane.previous[c].pop_back();
+        lane.values[c].pop_back();
+    }
+    lane.progress.pop_back();
+}
+
+void TweenBatch::writeBack(Lane& lane, uint32_t slot)
+{
+    auto action        = lane.actions[slot];
+    const bool started = !(lane.flags[slot] & FIRST_TICK);
+
+    action->_elapsed   = lane.elapsed[slot];
+    action->_firstTick = !started;
+    action->_done      = started && lane.elapsed[slot] >= lane.duration[slot];
+    static_cast<Action*>(action)->_batched = false;
+
+    if (lane.property == Property::Position)
+    {
+        auto move               = static_cast<MoveBy*>(lane.tweens[slot]);
+        move->_startPosition    = Vec3(lane.start[0][slot], lane.start[1][slot], lane.start[2][slot]);
+        move->_previousPosition = Vec3(lane.previous[0][slot], lane.previous[1][slot], lane.previous[2][slot]);
+    }
+}
+
+void TweenBatch::compact()
+{
+    for (uint32_t laneIndex = 0; laneIndex < _lanes.size(); ++laneIndex)
+    {
+        auto& lane = _lanes[laneIndex];
+        for (auto slot = static_cast<uint32_t>(lane.size()); slot-- > 0;)
+        {
+            if (!lane.actions[slot])
+                erase(laneIndex, slot);
+        }
+    }
+    _needCompact = false;
+}
+
+void TweenBatch::advance(Lane& lane, float dt)
+{
+    const size_t count = lane.size();
+
+    auto flags   = lane.flags.data();
+    auto elapsed = lane.elapsed.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!lane.actions[i] || *lane.paused[i])
+        {
+            flags[i] &= ~ACTIVE;
+            continue;
+        }
+
+        flags[i] |= ACTIVE;
+        if (flags[i] & FIRST_TICK)
+        {
+            flags[i] &= ~FIRST_TICK;
+            elapsed[i] = 0;
+        }
+        else
+        {
+            elapsed[i] += dt;
+        }
+    }
+
+    // the same expression as ActionInterval::step, elapsed could be negative
+    auto duration = lane.duration.data();
+    auto progress = lane.progress.data();
+    for (size_t i = 0; i < count; ++i)
+        progress[i] = std::max(0.0f, std::min(1.0f, elapsed[i] / duration[i]));
+
+    // the common polynomial easings are inlined, the others go through their tween function
+    if (lane.ease == tweenfunc::cubicEaseIn)
+    {
+        for (size_t i = 0; i < count; ++i)
+            progress[i] = progress[i] * progress[i] * progress[i];
+    }
+    else if (lane.ease == tweenfunc::cubicEaseOut)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float t = progress[i] - 1;
+            progress[i]   = t * t * t + 1;
+        }
+    }
+    else if (lane.ease == tweenfunc::quadraticOut)
+    {
+        for (size_t i = 0; i < count; ++i)
+            progress[i] = -progress[i] * (progress[i] - 2);
+    }
+    else if (lane.ease)
+    {
+        for (size_t i = 0; i < count; ++i)
+            progress[i] = lane.ease(progress[i]);
+    }
+
+    const int channels = lane.property == Property::Opacity ? 1 : lane.property == Property::Rotation ? 2 : 3;
+    for (int c = 0; c < channels; ++c)
+    {
+        auto start = lane.start[c].data();
+        auto delta = lane.delta[c].data();
+        auto value = lane.values[c].data();
+        for (size_t i = 0; i < count; ++i)
+            value[i] = start[i] + delta[i] * progress[i];
+    }
+}
+
+void TweenBatch::apply(Lane& lane)
+{
+    const size_t count = lane.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!(lane.flags[i] & ACTIVE))
+            continue;
+
+        auto target = lane.targets[i];
+        switch (lane.property)
+        {
+        case Property::Position:
+        {
+            Vec3 position(lane.values[0][i], lane.values[1][i], lane.values[2][i]);
+#if AX_ENABLE_STACKABLE_ACTIONS
+            // moves made by others since the last update are added to the start position, see MoveBy::update,
+            // this includes the earlier slots of the lane moving the same target in this update
+            const Vec3 current = target->getPosition3D();
+            for (int c = 0; c < 3; ++c)
+            {
+                const float moved = (&current.x)[c] - lane.previous[c][i];
+                lane.start[c][i] += moved;
+                (&position.x)[c] += moved;
+            }
+#endif
+            target->setPosition3D(position);
+            lane.previous[0][i] = position.x;
+            lane.previous[1][i] = position.y;
+            lane.previous[2][i] = position.z;
+            break;
+        }
+        case Property::Rotation:
+            if (lane.flags[i] & UNIFORM_ROTATION)
+            {
+                target->setRotation(lane.values[0][i]);
+            }
+            else
+            {
+                target->setRotationSkewX(lane.values[0][i]);
+                target->setRotationSkewY(lane.values[1][i]);
+            }
+            break;
+        case Property::Scale:
+            target->setScaleX(lane.values[0][i]);
+            target->setScaleY(lane.values[1][i]);
+            target->setScaleZ(lane.values[2][i]);
+            break;
+        case Property::Opacity:
+            target->setOpacity(static_cast<uint8_t>(lane.values[0][i]));
+            break;
+        }
+
+        // the setter may have stopped the action
+        if (auto action = lane.actions[i])
+        {
+            action->_elapsed   = lane.elapsed[i];
+            action->_firstTick = false;
+            action->_done      = lane.elapsed[i] >= lane.duration[i];
+        }
+    }
+}
+
+}  // namespace ax
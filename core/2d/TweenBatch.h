@@ -0,0 +1,150 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+class Action;
+class ActionInterval;
+class Node;
+
+/**
+ * @addtogroup actions
+ * @{
+ */
+
+/**
+ * @brief Updates simple property tweens in contiguous arrays, on behalf of ActionManager.
+ *
+ * MoveBy, MoveTo, 2D RotateBy and RotateTo, ScaleBy, ScaleTo, FadeIn, FadeOut and FadeTo actions run directly on a
+ * target are batchable, alone or wrapped in one of the parameterless easing actions (EaseSineIn, EaseCubicActionOut...).
+ * Subclasses are not, since they may override update.
+ *
+ * The tweens are grouped in lanes by property and easing function. A lane stores the timing, start and delta values
+ * of its tweens in separate arrays, so progress, easing and interpolation run as branch free loops the compiler
+ * vectorizes, then the values are written to the targets in a single pass.
+ *
+ * A batched action still belongs to its target, so tags, flags, getActionByTag and stopAction work as usual: its
+ * elapsed time and done state are kept up to date, only step is not called.
+ * @since axmol-2.2
+ */
+class AX_DLL TweenBatch
+{
+public:
+    TweenBatch();
+    ~TweenBatch();
+
+    /**
+     * Batches a started action if it is supported.
+     *
+     * @param action An action on which startWithTarget was called.
+     * @param paused The pause state of the target, read on each update.
+     * @return Whether the action was batched.
+     */
+    bool add(Action* action, const bool* paused);
+
+    /** Stops batching action, its state is written back so that it can continue with step. */
+    void remove(Action* action);
+
+    /** Stops batching all actions. */
+    void clear();
+
+    /** Advances the batched tweens and updates their targets. */
+    void update(float dt);
+
+    /** The number of batched actions. */
+    size_t getTweenCount() const { return _index.size(); }
+
+    /** The number of lanes, ie property and easing pairs in use. */
+    size_t getLaneCount() const { return _lanes.size(); }
+
+protected:
+    enum class Property
+    {
+        Position,
+        Rotation,
+        Scale,
+        Opacity,
+    };
+
+    using EaseFunc = float (*)(float);
+
+    /// the state of a tween, read from the action when it is batched
+    struct Values
+    {
+        float start[3]    = {};
+        float delta[3]    = {};
+        float previous[3] = {};
+        uint8_t flags     = 0;
+    };
+
+    struct Lane
+    {
+        Property property;
+        EaseFunc ease;
+
+        std::vector<ActionInterval*> actions;  ///< the batched action, nullptr once removed during an update
+        std::vector<ActionInterval*> tweens;   ///< the tween itself, the inner action of an easing action
+        std::vector<Node*> targets;
+        std::vector<const bool*> paused;
+        std::vector<uint8_t> flags;
+        std::vector<float> elapsed;
+        std::vector<float> duration;
+        std::vector<float> start[3];
+        std::vector<float> delta[3];
+        std::vector<float> previous[3];  ///< the last written position, to stack moves
+
+        // scratch
+        std::vector<float> progress;
+        std::vector<float> values[3];
+
+        size_t size() const { return actions.size(); }
+    };
+
+    uint32_t getLane(Property property, EaseFunc ease);
+    void push(uint32_t laneIndex, ActionInterval* action, ActionInterval* tween, const bool* paused, const Values& values);
+    void erase(uint32_t laneIndex, uint32_t slot);
+    void writeBack(Lane& lane, uint32_t slot);
+    void compact();
+
+    void advance(Lane& lane, float dt);
+    void apply(Lane& lane);
+
+    std::vector<Lane> _lanes;
+    std::unordered_map<Action*, std::pair<uint32_t, uint32_t>> _index;  ///< action to lane and slot
+
+    bool _updating    = false;
+    bool _needCompact = false;
+    std::vector<std::pair<Action*, const bool*>> _pending;  ///< added during an update
+};
+
+// end of actions group
+/// @}
+
+}  // namespace ax
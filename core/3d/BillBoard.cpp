@@ -37,6 +37,8 @@ BillBoard::BillBoard() : _mode(Mode::VIEW_POINT_ORIENTED), _modeDirty(false)
     _trianglesCommand.setTransparent(true);
     _trianglesCommand.set3D(true);
     Node::setAnchorPoint(Vec2(0.5f, 0.5f));
+    // rewrites its model view transform in visit
+    _transformSystemExcluded = true;
 }
 
 BillBoard::~BillBoard() {}
@@ -161,7 +161,7 @@ void Bundle3D::clear()
 {
     if (_isBinary)
     {
-        _binaryBuffer.clear();
+        _binaryBuffer.reset();
         AX_SAFE_DELETE_ARRAY(_references);
     }
     else
@@ -1089,9 +1089,8 @@ bool Bundle3D::loadBinary(std::string_view path)
     clear();
 
     // get file data
-    _binaryBuffer.clear();
-    _binaryBuffer = FileUtils::getInstance()->getDataFromFile(path);
-    if (_binaryBuffer.isNull())
+    _binaryBuffer = FileUtils::getInstance()->mapFile(path);
+    if (!_binaryBuffer || _binaryBuffer->empty())
     {
         clear();
         AXLOGW("warning: Failed to read file: {}", path);
@@ -1099,7 +1098,7 @@ bool Bundle3D::loadBinary(std::string_view path)
     }
 
     // Initialise bundle reader
-    _binaryReader.init((char*)_binaryBuffer.getBytes(), _binaryBuffer.getSize());
+    _binaryReader.init((char*)_binaryBuffer->data(), _binaryBuffer->size());
 
     // Read identifier info
     char identifier[] = {'C', '3', 'B', '\0'};
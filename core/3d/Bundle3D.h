@@ -30,6 +30,7 @@
 #include "base/Data.h"
 #include "3d/Bundle3DData.h"
 #include "3d/BundleReader.h"
+#include "platform/MappedFile.h"
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/document.h"
 
@@ -193,8 +194,8 @@ protected:
     std::string _jsonBuffer;
     rapidjson::Document _jsonReader;
 
-    // for binary reading
-    Data _binaryBuffer;
+    // for binary reading, a read-only view of the .c3b file
+    std::shared_ptr<MappedFile> _binaryBuffer;
     BundleReader _binaryReader;
     unsigned int _referenceCount;
     Reference* _references;
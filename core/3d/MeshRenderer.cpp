@@ -275,7 +275,10 @@ MeshRenderer::MeshRenderer()
     , _usingAutogeneratedGLProgram(true)
     , _transparentMaterialHint(false)
     , _meshTextureHint(0)
-{}
+{
+    // meshes may update their instance buffers in draw
+    _parallelVisitSafe = false;
+}
 
 MeshRenderer::~MeshRenderer()
 {
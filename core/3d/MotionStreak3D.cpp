@@ -51,7 +51,10 @@ MotionStreak3D::MotionStreak3D()
     , _maxPoints(0)
     , _nuPoints(0)
     , _previousNuPoints(0)
-{}
+{
+    // updates its vertex buffer in draw
+    _parallelVisitSafe = false;
+}
 
 MotionStreak3D::~MotionStreak3D()
 {
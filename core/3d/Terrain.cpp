@@ -261,6 +261,9 @@ Terrain::Terrain()
     , _backToForegroundListener(nullptr)
 #endif
 {
+    // chunks create and update their LOD index buffers in draw
+    _parallelVisitSafe = false;
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     _backToForegroundListener =
         EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) { reload(); });
@@ -30,11 +30,13 @@
 
 #include "audio/AudioCache.h"
 #include <thread>
+#include "base/Data.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
 
 #include "audio/AudioDecoderManager.h"
 #include "audio/AudioDecoder.h"
+#include "platform/FileUtils.h"
 
 namespace
 {
@@ -54,6 +56,14 @@ AudioCache::AudioCache()
     , _duration(0.0f)
     , _alBufferId(INVALID_AL_BUFFER_ID)
     , _queBufferFrames(0)
+    , _queBufferCount(QUEUEBUFFER_NUM)
+    , _queBufferDuration(QUEUEBUFFER_TIME_STEP)
+    , _keepCompressed(false)
+    , _pcmBytes(0)
+    , _decodeTime(0.0f)
+    , _hits(0)
+    , _lastUse(0)
+    , _pinCount(0)
     , _state(State::INITIAL)
     , _isDestroyed(std::make_shared<bool>(false))
     , _id(++__idIndex)
@@ -61,7 +71,7 @@ AudioCache::AudioCache()
     , _isSkipReadDataTask(false)
 {
     AXLOGV("AudioCache() {}, id={}", fmt::ptr(this), _id);
-    for (int i = 0; i < QUEUEBUFFER_NUM; ++i)
+    for (int i = 0; i < QUEUEBUFFER_MAX_NUM; ++i)
     {
         _queBuffers[i]    = nullptr;
         _queBufferSize[i] = 0;
@@ -101,11 +111,16 @@ AudioCache::~AudioCache()
 
     if (_queBufferFrames > 0)
     {
-        for (int index = 0; index < QUEUEBUFFER_NUM; ++index)
+        for (int index = 0; index < _queBufferCount; ++index)
         {
             free(_queBuffers[index]);
         }
     }
+
+    if (_compressedData)
+    {
+        AudioDecoderManager::removeResidentData(_fileFullPath, _compressedData);
+    }
     AXLOGV("~AudioCache() {}, id={}, end", fmt::ptr(this), _id);
     _readDataTaskMutex.unlock();
 }
@@ -118,6 +133,19 @@ void AudioCache::readDataTask(unsigned int selfId)
     _readDataTaskMutex.lock();
     _state = State::LOADING;
 
+    const auto startTime = std::chrono::steady_clock::now();
+
+    if (_keepCompressed && AudioDecoderManager::canKeepCompressed(_fileFullPath))
+    {
+        // the decoders read the encoded bytes from memory from now on, the pcm is streamed at play time
+        auto data = std::make_shared<Data>(FileUtils::getInstance()->getDataFromFile(_fileFullPath));
+        if (!data->isNull())
+        {
+            _compressedData = data;
+            AudioDecoderManager::addResidentData(_fileFullPath, std::move(data));
+        }
+    }
+
     AudioDecoder* decoder = AudioDecoderManager::createDecoder(_fileFullPath);
     do
     {
@@ -169,7 +197,15 @@ void AudioCache::readDataTask(unsigned int selfId)
         _duration    = 1.0f * totalFrames / sampleRate;
         _totalFrames = totalFrames;
 
-        if (dataSize <= PCMDATA_CACHEMAXSIZE)
+        if (_compressedData &&
+            totalFrames <= static_cast<uint32_t>(sampleRate * _queBufferDuration * _queBufferCount))
+        {
+            // fits in the preloaded queue buffers, streaming it would only add a silent tail
+            AudioDecoderManager::removeResidentData(_fileFullPath, _compressedData);
+            _compressedData.reset();
+        }
+
+        if (dataSize <= PCMDATA_CACHEMAXSIZE && !_compressedData)
         {
             uint32_t framesRead = 0;
             const uint32_t framesToReadOnce =
@@ -285,16 +321,17 @@ void AudioCache::readDataTask(unsigned int selfId)
                 break;
             }
 
-            _state = State::READY;
+            _pcmBytes = dataSize;
+            _state    = State::READY;
         }
         else
         {
-            _queBufferFrames = sampleRate * QUEUEBUFFER_TIME_STEP;
+            _queBufferFrames = sampleRate * _queBufferDuration;
             BREAK_IF_ERR_LOG(_queBufferFrames == 0, "_queBufferFrames == 0");
 
             const uint32_t queBufferBytes = decoder->framesToBytes(_queBufferFrames);
 
-            for (int index = 0; index < QUEUEBUFFER_NUM; ++index)
+            for (int index = 0; index < _queBufferCount; ++index)
             {
                 _queBuffers[index]    = (char*)malloc(queBufferBytes);
                 _queBufferSize[index] = queBufferBytes;
@@ -302,7 +339,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                 decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
             }
 
-            _state = State::READY;
+            _pcmBytes = queBufferBytes * _queBufferCount;
+            _state    = State::READY;
         }
 
     } while (false);
@@ -318,8 +356,15 @@ void AudioCache::readDataTask(unsigned int selfId)
             alDeleteBuffers(1, &_alBufferId);
             _alBufferId = INVALID_AL_BUFFER_ID;
         }
+        if (_compressedData)
+        {
+            AudioDecoderManager::removeResidentData(_fileFullPath, _compressedData);
+            _compressedData.reset();
+        }
     }
 
+    _decodeTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
     // Set before invokingPlayCallbacks, otherwise, may cause dead-lock
     _isLoadingFinished = true;
 
@@ -366,6 +411,11 @@ void AudioCache::invokingPlayCallbacks()
     _playCallbacks.clear();
 }
 
+size_t AudioCache::getResidentBytes() const
+{
+    return _pcmBytes + (_compressedData ? static_cast<size_t>(_compressedData->getSize()) : 0);
+}
+
 void AudioCache::addLoadCallback(const std::function<void(bool)>& callback)
 {
     switch (_state)
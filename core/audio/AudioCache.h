@@ -42,6 +42,7 @@ namespace ax
 
 class AudioEngineImpl;
 class AudioPlayer;
+class Data;
 
 class AX_DLL AudioCache
 {
@@ -61,6 +62,9 @@ public:
 
     void addLoadCallback(const std::function<void(bool)>& callback);
 
+    /** The pcm and encoded bytes held by the cache. @since axmol-2.2 */
+    size_t getResidentBytes() const;
+
 protected:
     void setSkipReadDataTask(bool isSkip) { _isSkipReadDataTask = isSkip; };
     void readDataTask(unsigned int selfId);
@@ -84,9 +88,22 @@ protected:
     /*Queue buffer related stuff
      *  Streaming in OpenAL when sizeInBytes greater then PCMDATA_CACHEMAXSIZE
      */
-    char* _queBuffers[QUEUEBUFFER_NUM];
-    ALsizei _queBufferSize[QUEUEBUFFER_NUM];
+    char* _queBuffers[QUEUEBUFFER_MAX_NUM];
+    ALsizei _queBufferSize[QUEUEBUFFER_MAX_NUM];
     uint32_t _queBufferFrames;
+    int _queBufferCount;
+    float _queBufferDuration;
+
+    /* Memory budget related stuff
+     * The encoded bytes are kept in memory and streamed when _keepCompressed is set for ogg and mp3
+     */
+    bool _keepCompressed;
+    std::shared_ptr<const Data> _compressedData;
+    uint32_t _pcmBytes;
+    float _decodeTime;  // milliseconds spent in readDataTask
+    unsigned int _hits;
+    uint64_t _lastUse;  // AudioEngineImpl use counter, orders the caches for eviction
+    int _pinCount;      // pinned caches are never evicted, see AudioEngine::preloadGroup
 
     std::mutex _playCallbackMutex;
     std::vector<std::function<void()>> _playCallbacks;
@@ -68,6 +68,22 @@ uint32_t AudioDecoder::readFixedFrames(uint32_t framesToRead, char* pcmBuf)
     return framesRead;
 }
 
+uint32_t AudioDecoder::readLoopedFrames(uint32_t framesToRead, char* pcmBuf, bool loop)
+{
+    uint32_t framesRead = readFixedFrames(framesToRead, pcmBuf);
+    while (framesRead < framesToRead && loop)
+    {
+        seek(0);
+        const uint32_t framesReadOnce = readFixedFrames(framesToRead - framesRead, pcmBuf + framesToBytes(framesRead));
+        if (framesReadOnce == 0)
+        {
+            break;
+        }
+        framesRead += framesReadOnce;
+    }
+    return framesRead;
+}
+
 uint32_t AudioDecoder::getTotalFrames() const
 {
     return _totalFrames;
@@ -99,6 +99,18 @@ public:
      */
     virtual uint32_t readFixedFrames(uint32_t framesToRead, char* pcmBuf);
 
+    /**
+     * @brief Reads fixed audio frames of PCM format, seeking back to the first frame when the end is reached and
+     * |loop| is set.
+     * @param framesToRead The number of frames excepted to be read.
+     * @param pcmBuf The buffer to hold the frames to be read, its size should be >= framesToBytes(|framesToRead|).
+     * @param loop Whether reading wraps around at the end of file.
+     * @return The number of frames actually read, it's less than |framesToRead| only if the end of file was reached
+     * without |loop|, or the audio has no frames at all. The remaining buffer is set with silence data (0x00).
+     * @since axmol-2.2
+     */
+    uint32_t readLoopedFrames(uint32_t framesToRead, char* pcmBuf, bool loop);
+
     /**
      * @brief Sets frame offest to be read.
      * @param frameOffset The frame offest to be set.
@@ -30,7 +30,11 @@ THE SOFTWARE.
 #include "audio/AudioDecoderOgg.h"
 #include "audio/AudioMacros.h"
 #include "platform/FileUtils.h"
+#include "base/Data.h"
 #include "base/Logging.h"
+#include "base/hlookup.h"
+
+#include <mutex>
 
 #if !defined(__APPLE__)
 #    include "audio/AudioDecoderMp3.h"
@@ -44,6 +48,70 @@ THE SOFTWARE.
 namespace ax
 {
 
+namespace
+{
+// Reads the encoded bytes of a file kept in memory, shares them with the other decoders of the same file
+class ResidentStream : public IFileStream
+{
+public:
+    explicit ResidentStream(std::shared_ptr<const Data> data) : _data(std::move(data)) {}
+
+    bool open(std::string_view /*path*/, IFileStream::Mode /*mode*/) override { return false; }
+
+    int close() override
+    {
+        _data.reset();
+        return 0;
+    }
+
+    int64_t seek(int64_t offset, int origin) const override
+    {
+        if (!_data)
+            return -1;
+
+        int64_t base = 0;
+        if (origin == SEEK_CUR)
+            base = _offset;
+        else if (origin == SEEK_END)
+            base = size();
+
+        const int64_t offsetFromBeginning = base + offset;
+        if (offsetFromBeginning < 0 || offsetFromBeginning > size())
+            return -1;
+
+        _offset = offsetFromBeginning;
+        return _offset;
+    }
+
+    int read(void* buf, unsigned int size) const override
+    {
+        if (!_data)
+            return -1;
+
+        const int64_t available = this->size() - _offset;
+        const auto bytesToRead  = static_cast<unsigned int>((std::min)(static_cast<int64_t>(size), available));
+        memcpy(buf, _data->getBytes() + _offset, bytesToRead);
+        _offset += bytesToRead;
+        return static_cast<int>(bytesToRead);
+    }
+
+    int write(const void* /*buf*/, unsigned int /*size*/) const override { return -1; }
+
+    int64_t tell() const override { return _data ? _offset : -1; }
+
+    int64_t size() const override { return _data ? _data->getSize() : -1; }
+
+    bool isOpen() const override { return _data != nullptr; }
+
+private:
+    std::shared_ptr<const Data> _data;
+    mutable int64_t _offset = 0;
+};
+
+std::mutex s_residentDataMutex;
+hlookup::string_map<std::shared_ptr<const Data>> s_residentData;
+}  // namespace
+
 bool AudioDecoderManager::init()
 {
 #if !defined(__APPLE__)
@@ -91,6 +159,41 @@ void AudioDecoderManager::destroyDecoder(AudioDecoder* decoder)
     delete decoder;
 }
 
+bool AudioDecoderManager::canKeepCompressed(std::string_view path)
+{
+#if !defined(__APPLE__)
+    if (cxx20::ic::ends_with(path, ".mp3"))
+        return true;
+#endif
+    // the decoders of the other formats on apple platforms read through ExtAudioFile
+    return cxx20::ic::ends_with(path, ".ogg");
+}
+
+void AudioDecoderManager::addResidentData(std::string_view fullPath, std::shared_ptr<const Data> data)
+{
+    std::lock_guard<std::mutex> lck(s_residentDataMutex);
+    s_residentData[std::string{fullPath}] = std::move(data);
+}
+
+void AudioDecoderManager::removeResidentData(std::string_view fullPath, const std::shared_ptr<const Data>& data)
+{
+    std::lock_guard<std::mutex> lck(s_residentDataMutex);
+    auto it = s_residentData.find(fullPath);
+    if (it != s_residentData.end() && it->second == data)
+        s_residentData.erase(it);
+}
+
+std::unique_ptr<IFileStream> AudioDecoderManager::openStream(std::string_view fullPath)
+{
+    {
+        std::lock_guard<std::mutex> lck(s_residentDataMutex);
+        auto it = s_residentData.find(fullPath);
+        if (it != s_residentData.end())
+            return std::make_unique<ResidentStream>(it->second);
+    }
+    return FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+}
+
 }  // namespace ax
 
 #undef LOG_TAG
@@ -25,14 +25,17 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #pragma once
+#include <memory>
 #include <string>
 
 #include "platform/PlatformMacros.h"
+#include "platform/IFileStream.h"
 
 namespace ax
 {
 
 class AudioDecoder;
+class Data;
 
 class AudioDecoderManager
 {
@@ -41,6 +44,27 @@ public:
     static void destroy();
     static AudioDecoder* createDecoder(std::string_view path);
     static void destroyDecoder(AudioDecoder* decoder);
+
+    /**
+     * Whether path is a compressed format (ogg, mp3) whose decoder can read the encoded bytes from memory.
+     * @since axmol-2.2
+     */
+    static bool canKeepCompressed(std::string_view path);
+
+    /**
+     * Keeps the encoded bytes of a file resident, the decoders opened afterwards read them instead of the file.
+     * @since axmol-2.2
+     */
+    static void addResidentData(std::string_view fullPath, std::shared_ptr<const Data> data);
+
+    /** Drops the resident bytes of a file, unless they were replaced by other ones meanwhile. @since axmol-2.2 */
+    static void removeResidentData(std::string_view fullPath, const std::shared_ptr<const Data>& data);
+
+    /**
+     * Opens a file for decoding, from its resident bytes if any, from the file system otherwise.
+     * @since axmol-2.2
+     */
+    static std::unique_ptr<IFileStream> openStream(std::string_view fullPath);
 };
 
 }  // namespace ax
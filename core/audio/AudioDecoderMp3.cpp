@@ -26,6 +26,7 @@
 
 #define LOG_TAG "AudioDecoderMp3"
 #include "audio/AudioDecoderMp3.h"
+#include "audio/AudioDecoderManager.h"
 #include "audio/AudioMacros.h"
 #include "platform/FileUtils.h"
 
@@ -131,7 +132,7 @@ bool AudioDecoderMp3::open(std::string_view fullPath)
 #if !AX_USE_MPG123
     do
     {
-        _fileStream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+        _fileStream = AudioDecoderManager::openStream(fullPath);
         if (!_fileStream)
         {
             AXLOGE("Trouble with minimp3(1): {}\n", strerror(errno));
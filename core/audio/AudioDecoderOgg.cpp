@@ -27,6 +27,7 @@
 #define LOG_TAG "AudioDecoderOgg"
 
 #include "audio/AudioDecoderOgg.h"
+#include "audio/AudioDecoderManager.h"
 #include "audio/AudioMacros.h"
 #include "platform/FileUtils.h"
 
@@ -72,7 +73,7 @@ AudioDecoderOgg::~AudioDecoderOgg()
 
 bool AudioDecoderOgg::open(std::string_view fullPath)
 {
-    auto fs = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ).release();
+    auto fs = AudioDecoderManager::openStream(fullPath).release();
     if (!fs)
     {
         AXLOGE("Trouble with ogg(1): {}\n", strerror(errno));
@@ -27,6 +27,7 @@
 #include <stddef.h>
 #include <assert.h>
 #include "audio/AudioDecoderWav.h"
+#include "audio/AudioDecoderManager.h"
 #include "audio/AudioMacros.h"
 #include "platform/FileUtils.h"
 
@@ -81,7 +82,7 @@ static bool wav_scan_chunk(WAV_FILE* wavf, uint32_t chunkID, void* header, void*
 }
 static bool wav_open(std::string_view fullPath, WAV_FILE* wavf)
 {
-    wavf->Stream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+    wavf->Stream = AudioDecoderManager::openStream(fullPath);
     if (!wavf->Stream)
         return false;
 
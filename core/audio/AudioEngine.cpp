@@ -51,6 +51,11 @@ hlookup::string_map<std::list<AUDIO_ID>> AudioEngine::_audioPathIDMap;
 // profileName,ProfileHelper
 hlookup::string_map<AudioEngine::ProfileHelper> AudioEngine::_audioPathProfileHelperMap;
 unsigned int AudioEngine::_maxInstances                        = MAX_AUDIOINSTANCES;
+int AudioEngine::_streamingBufferCount                         = QUEUEBUFFER_NUM;
+float AudioEngine::_streamingBufferDuration                    = QUEUEBUFFER_TIME_STEP;
+size_t AudioEngine::_cacheBudget                               = 0;
+bool AudioEngine::_keepCompressed                              = false;
+hlookup::string_map<std::vector<std::string>> AudioEngine::_preloadGroups;
 AudioEngine::ProfileHelper* AudioEngine::_defaultProfileHelper = nullptr;
 std::unordered_map<AUDIO_ID, AudioEngine::AudioInfo> AudioEngine::_audioIDInfoMap;
 AudioEngineImpl* AudioEngine::_audioEngineImpl = nullptr;
@@ -68,6 +73,7 @@ void AudioEngine::end()
     // make sure everythings cleanup before delete audio engine
     // fix #127
     uncacheAll();
+    _preloadGroups.clear();
 
     delete _audioEngineImpl;
     _audioEngineImpl = nullptr;
@@ -429,6 +435,18 @@ bool AudioEngine::setMaxAudioInstance(int maxInstances)
     return false;
 }
 
+bool AudioEngine::setStreamingBuffers(int count, float duration)
+{
+    if (count >= 2 && count <= QUEUEBUFFER_MAX_NUM && duration >= 0.01f && duration <= 1.0f)
+    {
+        _streamingBufferCount    = count;
+        _streamingBufferDuration = duration;
+        return true;
+    }
+
+    return false;
+}
+
 bool AudioEngine::isLoop(AUDIO_ID audioID)
 {
     auto tmpIterator = _audioIDInfoMap.find(audioID);
@@ -523,6 +541,99 @@ void AudioEngine::preload(std::string_view filePath, std::function<void(bool isS
     }
 }
 
+void AudioEngine::preloadGroup(std::string_view groupName,
+                               const std::vector<std::string>& filePaths,
+                               std::function<void(bool isSuccess)> callback)
+{
+    if (!isEnabled() || !lazyInit())
+    {
+        if (callback)
+        {
+            callback(false);
+        }
+        return;
+    }
+
+    struct GroupLoad
+    {
+        size_t pending;
+        bool isSuccess;
+        std::function<void(bool)> callback;
+    };
+    auto groupLoad = std::make_shared<GroupLoad>(GroupLoad{filePaths.size(), true, std::move(callback)});
+
+    // pin the new files before releasing the previous ones, so the files in both stay cached
+    for (auto&& filePath : filePaths)
+    {
+        preload(filePath, [groupLoad](bool isSuccess) {
+            groupLoad->isSuccess = groupLoad->isSuccess && isSuccess;
+            if (--groupLoad->pending == 0 && groupLoad->callback)
+            {
+                groupLoad->callback(groupLoad->isSuccess);
+            }
+        });
+        _audioEngineImpl->pinCache(filePath);
+    }
+
+    uncacheGroup(groupName);
+    _preloadGroups.emplace(groupName, filePaths);
+
+    if (filePaths.empty() && groupLoad->callback)
+    {
+        groupLoad->callback(true);
+    }
+}
+
+void AudioEngine::uncacheGroup(std::string_view groupName)
+{
+    auto it = _preloadGroups.find(groupName);
+    if (it == _preloadGroups.end())
+    {
+        return;
+    }
+
+    auto filePaths = std::move(it.value());
+    _preloadGroups.erase(it);
+
+    for (auto&& filePath : filePaths)
+    {
+        if (_audioEngineImpl && _audioEngineImpl->unpinCache(filePath))
+        {
+            uncache(filePath);
+        }
+    }
+}
+
+void AudioEngine::setCacheBudget(size_t bytes)
+{
+    _cacheBudget = bytes;
+    if (_audioEngineImpl)
+    {
+        _audioEngineImpl->trimCaches(nullptr);
+    }
+}
+
+AudioCacheStats AudioEngine::getCacheStats()
+{
+    AudioCacheStats stats;
+    if (_audioEngineImpl)
+    {
+        _audioEngineImpl->getCacheStats(stats);
+    }
+    stats.budget = _cacheBudget;
+    return stats;
+}
+
+AudioSoundStats AudioEngine::getSoundStats(std::string_view filePath)
+{
+    AudioSoundStats stats;
+    if (_audioEngineImpl)
+    {
+        _audioEngineImpl->getSoundStats(filePath, stats);
+    }
+    return stats;
+}
+
 void AudioEngine::addTask(const std::function<void()>& task)
 {
     lazyInit();
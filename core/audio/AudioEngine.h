@@ -33,6 +33,7 @@
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #ifdef ERROR
 #    undef ERROR
@@ -84,6 +85,41 @@ public:
     AudioProfile() : maxInstances(0), minDelay(0.0) {}
 };
 
+/**
+ * @struct AudioCacheStats
+ *
+ * @brief Statistics of the decoded audio caches, see AudioEngine::getCacheStats.
+ * @since axmol-2.2
+ * @js NA
+ */
+struct AX_DLL AudioCacheStats
+{
+    unsigned int hits      = 0;  // preload and play2d calls served by an existing cache
+    unsigned int misses    = 0;  // preload and play2d calls which had to load the file
+    unsigned int evictions = 0;  // caches dropped to stay within the budget
+    size_t bytesResident   = 0;  // pcm and encoded bytes held by all the caches
+    size_t compressedBytes = 0;  // encoded bytes, part of bytesResident
+    size_t budget          = 0;
+
+    float getHitRate() const { return hits + misses > 0 ? static_cast<float>(hits) / (hits + misses) : 0.0f; }
+};
+
+/**
+ * @struct AudioSoundStats
+ *
+ * @brief Statistics of the cache of one audio file, see AudioEngine::getSoundStats.
+ * @since axmol-2.2
+ * @js NA
+ */
+struct AX_DLL AudioSoundStats
+{
+    bool cached          = false;
+    bool compressed      = false;  // whether the encoded bytes are kept and decoded at play time
+    size_t bytesResident = 0;
+    float decodeTime     = 0.0f;  // milliseconds spent loading the file
+    unsigned int hits    = 0;
+};
+
 class AudioEngineImpl;
 
 /**
@@ -288,6 +324,24 @@ public:
      */
     static bool setMaxAudioInstance(int maxInstances);
 
+    /**
+     * Sets how large audio files are streamed: every playing instance queues count buffers of duration seconds.
+     * More or longer buffers survive longer stalls of the streaming thread at the cost of memory and latency of
+     * setCurrentTime. Only applies to audio files preloaded afterwards.
+     *
+     * @param count The number of queued buffers per instance, in [2, 8], 3 by default.
+     * @param duration The duration of one buffer in seconds, in [0.01, 1], 0.05 by default.
+     * @return Whether the values are in range and were applied.
+     * @since axmol-2.2
+     */
+    static bool setStreamingBuffers(int count, float duration);
+
+    /** Gets the number of queued buffers per streamed instance. @since axmol-2.2 */
+    static int getStreamingBufferCount() { return _streamingBufferCount; }
+
+    /** Gets the duration in seconds of one buffer of a streamed instance. @since axmol-2.2 */
+    static float getStreamingBufferDuration() { return _streamingBufferDuration; }
+
     /**
      * Uncache the audio data from internal buffer.
      * AudioEngine cache audio data on ios,mac, and win32 platform.
@@ -333,6 +387,54 @@ public:
      */
     static void preload(std::string_view filePath, std::function<void(bool isSuccess)> callback);
 
+    /**
+     * Preloads a group of audio files and keeps them cached until uncacheGroup, whatever the cache budget.
+     * Preloading a group again replaces its files.
+     *
+     * @param groupName A name of the group, e.g. a level name.
+     * @param filePaths The file paths of the audios.
+     * @param callback A callback which will be called once all the files are loaded, with whether all succeeded.
+     * @since axmol-2.2
+     */
+    static void preloadGroup(std::string_view groupName,
+                             const std::vector<std::string>& filePaths,
+                             std::function<void(bool isSuccess)> callback = nullptr);
+
+    /**
+     * Uncaches the files of a preload group which aren't part of another group.
+     *
+     * @warning Like uncache, this stops the related audios first.
+     * @param groupName A name of the group.
+     * @since axmol-2.2
+     */
+    static void uncacheGroup(std::string_view groupName);
+
+    /**
+     * Sets the memory budget of the audio caches. When it's exceeded, the least recently used caches which aren't
+     * playing nor part of a preload group are uncached. The budget is enforced on preload, play2d and here.
+     *
+     * @param bytes The budget in bytes, 0 (the default) means unlimited.
+     * @since axmol-2.2
+     */
+    static void setCacheBudget(size_t bytes);
+
+    /** Gets the memory budget of the audio caches. @since axmol-2.2 */
+    static size_t getCacheBudget() { return _cacheBudget; }
+
+    /**
+     * Whether to keep ogg and mp3 files encoded in memory and decode them on the streaming thread at play time,
+     * instead of caching the whole pcm. Trades cpu for memory, only applies to audio files preloaded afterwards.
+     * @since axmol-2.2
+     */
+    static void setKeepCompressed(bool keepCompressed) { _keepCompressed = keepCompressed; }
+    static bool isKeepCompressed() { return _keepCompressed; }
+
+    /** Gets the hit rate and resident bytes of the audio caches. @since axmol-2.2 */
+    static AudioCacheStats getCacheStats();
+
+    /** Gets the resident bytes and load time of the cache of an audio file. @since axmol-2.2 */
+    static AudioSoundStats getSoundStats(std::string_view filePath);
+
     /**
      * Gets playing audio count.
      */
@@ -396,6 +498,15 @@ protected:
 
     static unsigned int _maxInstances;
 
+    static int _streamingBufferCount;
+    static float _streamingBufferDuration;
+
+    static size_t _cacheBudget;
+    static bool _keepCompressed;
+
+    // group name, file paths
+    static hlookup::string_map<std::vector<std::string>> _preloadGroups;
+
     static ProfileHelper* _defaultProfileHelper;
 
     static AudioEngineImpl* _audioEngineImpl;
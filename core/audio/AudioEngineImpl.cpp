@@ -29,6 +29,10 @@
 
 #include "audio/AudioEngineImpl.h"
 #include "audio/AudioDecoderManager.h"
+#include "audio/AudioStreamer.h"
+
+#include <algorithm>
+#include <unordered_set>
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS || AX_TARGET_PLATFORM == AX_PLATFORM_MAC
 #    import <AVFoundation/AVFoundation.h>
@@ -36,6 +40,7 @@
 
 #include "audio/AudioEngine.h"
 #include "platform/FileUtils.h"
+#include "base/Data.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
 #include "base/Utils.h"
@@ -315,7 +320,7 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
         player = e.second;
         if (player->_alSource == sid && player->_streamingSource)
         {
-            player->wakeupRotateThread();
+            s_instance->_streamer->wakeup(player);
         }
     }
     s_instance->_threadMutex.unlock();
@@ -325,7 +330,15 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
 namespace ax
 {
 
-AudioEngineImpl::AudioEngineImpl() : _scheduled(false), _currentAudioID(0), _scheduler(nullptr)
+AudioEngineImpl::AudioEngineImpl()
+    : _streamer(new AudioStreamer())
+    , _cacheUseCounter(0)
+    , _cacheHits(0)
+    , _cacheMisses(0)
+    , _cacheEvictions(0)
+    , _scheduled(false)
+    , _currentAudioID(0)
+    , _scheduler(nullptr)
 {
     s_instance = this;
 }
@@ -337,6 +350,9 @@ AudioEngineImpl::~AudioEngineImpl()
         _scheduler->unschedule(AX_SCHEDULE_SELECTOR(AudioEngineImpl::update), this);
     }
 
+    // stop streaming before the sources go away
+    AX_SAFE_DELETE(_streamer);
+
     if (s_ALContext)
     {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
@@ -502,11 +518,15 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     auto it = _audioCaches.find(filePath);
     if (it == _audioCaches.end())
     {
+        ++_cacheMisses;
         audioCache = new AudioCache();  // hlookup_second(it);
         _audioCaches.emplace(filePath, std::unique_ptr<AudioCache>(audioCache));
-        audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-        unsigned int cacheId      = audioCache->_id;
-        auto isCacheDestroyed     = audioCache->_isDestroyed;
+        audioCache->_fileFullPath      = FileUtils::getInstance()->fullPathForFilename(filePath);
+        audioCache->_queBufferCount    = AudioEngine::getStreamingBufferCount();
+        audioCache->_queBufferDuration = AudioEngine::getStreamingBufferDuration();
+        audioCache->_keepCompressed    = AudioEngine::isKeepCompressed();
+        unsigned int cacheId           = audioCache->_id;
+        auto isCacheDestroyed          = audioCache->_isDestroyed;
         AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
             if (*isCacheDestroyed)
             {
@@ -520,8 +540,13 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     else
     {
         audioCache = it->second.get();
+        ++audioCache->_hits;
+        ++_cacheHits;
     }
 
+    audioCache->_lastUse = ++_cacheUseCounter;
+    trimCaches(audioCache);
+
     if (audioCache && callback)
     {
         audioCache->addLoadCallback(callback);
@@ -529,6 +554,102 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     return audioCache;
 }
 
+void AudioEngineImpl::trimCaches(AudioCache* inUse)
+{
+    const size_t budget = AudioEngine::getCacheBudget();
+    if (budget == 0)
+        return;
+
+    std::unordered_set<AudioCache*> playing;
+    _threadMutex.lock();
+    for (auto&& player : _audioPlayers)
+        playing.insert(player.second->_audioCache);
+    _threadMutex.unlock();
+
+    size_t bytesResident = 0;
+    std::vector<std::pair<uint64_t, std::string>> evictables;  // last use, file path
+    for (auto&& item : _audioCaches)
+    {
+        auto audioCache = item.second.get();
+        if (!audioCache->_isLoadingFinished)
+            continue;
+
+        bytesResident += audioCache->getResidentBytes();
+        if (audioCache != inUse && audioCache->_pinCount == 0 && playing.find(audioCache) == playing.end())
+            evictables.emplace_back(audioCache->_lastUse, item.first);
+    }
+
+    if (bytesResident <= budget)
+        return;
+
+    std::sort(evictables.begin(), evictables.end());
+    for (auto&& evictable : evictables)
+    {
+        if (bytesResident <= budget)
+            break;
+
+        auto it = _audioCaches.find(evictable.second);
+        bytesResident -= it->second->getResidentBytes();
+        AXLOGD("AudioEngineImpl::trimCaches, uncache {}, resident bytes: {}, budget: {}", evictable.second,
+               bytesResident, budget);
+        _audioCaches.erase(it);
+        ++_cacheEvictions;
+    }
+}
+
+void AudioEngineImpl::pinCache(std::string_view filePath)
+{
+    auto it = _audioCaches.find(filePath);
+    if (it != _audioCaches.end())
+        ++it->second->_pinCount;
+}
+
+bool AudioEngineImpl::unpinCache(std::string_view filePath)
+{
+    auto it = _audioCaches.find(filePath);
+    if (it == _audioCaches.end())
+        return false;
+
+    auto audioCache = it->second.get();
+    if (audioCache->_pinCount > 0)
+        --audioCache->_pinCount;
+    return audioCache->_pinCount == 0;
+}
+
+void AudioEngineImpl::getCacheStats(AudioCacheStats& stats)
+{
+    stats.hits      = _cacheHits;
+    stats.misses    = _cacheMisses;
+    stats.evictions = _cacheEvictions;
+    for (auto&& item : _audioCaches)
+    {
+        auto audioCache = item.second.get();
+        if (!audioCache->_isLoadingFinished)
+            continue;
+
+        stats.bytesResident += audioCache->getResidentBytes();
+        if (audioCache->_compressedData)
+            stats.compressedBytes += audioCache->_compressedData->getSize();
+    }
+}
+
+void AudioEngineImpl::getSoundStats(std::string_view filePath, AudioSoundStats& stats)
+{
+    auto it = _audioCaches.find(filePath);
+    if (it == _audioCaches.end())
+        return;
+
+    auto audioCache = it->second.get();
+    stats.cached    = true;
+    stats.hits      = audioCache->_hits;
+    if (audioCache->_isLoadingFinished)
+    {
+        stats.compressed    = audioCache->_compressedData != nullptr;
+        stats.bytesResident = audioCache->getResidentBytes();
+        stats.decodeTime    = audioCache->_decodeTime;
+    }
+}
+
 AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time)
 {
     if (s_ALDevice == nullptr)
@@ -566,6 +687,7 @@ AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float vol
     }
 
     player->setCache(audioCache);
+    player->_streamer = _streamer;
     _threadMutex.lock();
     _audioPlayers.emplace(++_currentAudioID, player);
     _threadMutex.unlock();
@@ -41,6 +41,9 @@ namespace ax
 {
 
 class Scheduler;
+class AudioStreamer;
+struct AudioCacheStats;
+struct AudioSoundStats;
 
 class AX_DLL AudioEngineImpl : public ax::Object
 {
@@ -67,6 +70,14 @@ public:
     AudioCache* preload(std::string_view filePath, std::function<void(bool)> callback);
     void update(float dt);
 
+    // uncaches the least recently used caches over the budget, except inUse
+    void trimCaches(AudioCache* inUse);
+    void pinCache(std::string_view filePath);
+    // returns whether the cache exists and isn't pinned anymore
+    bool unpinCache(std::string_view filePath);
+    void getCacheStats(AudioCacheStats& stats);
+    void getSoundStats(std::string_view filePath, AudioSoundStats& stats);
+
 private:
     // query players state per frame and dispatch finish callback if possible
     void _updatePlayers(bool forStop);
@@ -91,6 +102,15 @@ private:
     // finish callbacks
     std::vector<std::function<void()>> _finishCallbacks;
 
+    // refills the buffer queues of all the streamed players
+    AudioStreamer* _streamer;
+
+    // cache usage, see AudioEngine::getCacheStats
+    uint64_t _cacheUseCounter;
+    unsigned int _cacheHits;
+    unsigned int _cacheMisses;
+    unsigned int _cacheEvictions;
+
     bool _scheduled;
 
     AUDIO_ID _currentAudioID;
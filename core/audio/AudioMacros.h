@@ -30,8 +30,10 @@
 
 #include <functional>
 
+// default buffer count and duration of a streamed source, see AudioEngine::setStreamingBuffers
 #define QUEUEBUFFER_NUM (3)
 #define QUEUEBUFFER_TIME_STEP (0.05f)
+#define QUEUEBUFFER_MAX_NUM (8)
 
 #define QUOTEME_(x) #x
 #define QUOTEME(x) QUOTEME_(x)
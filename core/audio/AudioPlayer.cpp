@@ -32,8 +32,7 @@
 #include "platform/FileUtils.h"
 #include "audio/AudioDecoder.h"
 #include "audio/AudioDecoderManager.h"
-
-#include "yasio/thread_name.hpp"
+#include "audio/AudioStreamer.h"
 
 namespace ax
 {
@@ -51,12 +50,13 @@ AudioPlayer::AudioPlayer()
     , _ready(false)
     , _currTime(0.0f)
     , _streamingSource(false)
-    , _rotateBufferThread(nullptr)
+    , _bufferCount(0)
+    , _streamer(nullptr)
+    , _streamDecoder(nullptr)
+    , _streamOffsetFrame(0)
+    , _streamEOF(false)
+    , _streamFinished(false)
     , _timeDirty(false)
-    , _isRotateThreadExited(false)
-#if defined(__APPLE__)
-    , _needWakeupRotateThread(false)
-#endif
     , _id(++__playerIdIndex)
 {
     memset(_bufferIds, 0, sizeof(_bufferIds));
@@ -69,7 +69,7 @@ AudioPlayer::~AudioPlayer()
 
     if (_streamingSource)
     {
-        alDeleteBuffers(QUEUEBUFFER_NUM, _bufferIds);
+        alDeleteBuffers(_bufferCount, _bufferIds);
     }
 }
 
@@ -101,22 +101,10 @@ void AudioPlayer::destroy()
 
         if (_streamingSource)
         {
-            if (_rotateBufferThread != nullptr)
+            if (_streamer != nullptr)
             {
-                while (!_isRotateThreadExited)
-                {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable())
-                {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                AXLOGV("{}", "rotateBufferThread exited!");
+                _streamer->removeStream(this);
+                AXLOGV("{}", "stream removed!");
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS
                 // some specific OpenAL implement defects existed on iOS platform
@@ -127,17 +115,20 @@ void AudioPlayer::destroy()
                 if (sourceState == AL_PLAYING)
                 {
                     alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                    while (bufferProcessed < QUEUEBUFFER_NUM)
+                    while (bufferProcessed < _bufferCount)
                     {
                         std::this_thread::sleep_for(std::chrono::milliseconds(2));
                         alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
                     }
-                    alSourceUnqueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+                    alSourceUnqueueBuffers(_alSource, _bufferCount, _bufferIds);
                     CHECK_AL_ERROR_DEBUG();
                 }
                 AXLOGV("{}", "UnqueueBuffers Before alSourceStop");
 #endif
             }
+
+            AudioDecoderManager::destroyDecoder(_streamDecoder);
+            _streamDecoder = nullptr;
         }
     } while (false);
 
@@ -198,12 +189,13 @@ bool AudioPlayer::play2d()
         }
         else
         {
-            alGenBuffers(QUEUEBUFFER_NUM, _bufferIds);
+            _bufferCount = _audioCache->_queBufferCount;
+            alGenBuffers(_bufferCount, _bufferIds);
 
             auto alError = alGetError();
             if (alError == AL_NO_ERROR)
             {
-                for (int index = 0; index < QUEUEBUFFER_NUM; ++index)
+                for (int index = 0; index < _bufferCount; ++index)
                 {
                     alBufferData(_bufferIds[index], _audioCache->_format, _audioCache->_queBuffers[index],
                                  _audioCache->_queBufferSize[index], _audioCache->_sampleRate);
@@ -218,28 +210,20 @@ bool AudioPlayer::play2d()
             _streamingSource = true;
         }
 
+        if (_streamingSource)
         {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed)
-                break;
-
-            if (_streamingSource)
-            {
-                // To continuously stream audio from a source without interruption, buffer queuing is required.
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = new std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                      _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            }
-            else
-            {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
-            }
-
-            alSourcePlay(_alSource);
+            // To continuously stream audio from a source without interruption, buffer queuing is required.
+            alSourceQueueBuffers(_alSource, _bufferCount, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+        }
+        else
+        {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
         }
 
+        alSourcePlay(_alSource);
+
         auto alError = alGetError();
         if (alError != AL_NO_ERROR)
         {
@@ -263,6 +247,13 @@ bool AudioPlayer::play2d()
             CHECK_AL_ERROR_DEBUG();
         }
 
+        if (_streamingSource)
+        {
+            // the preloaded buffers are queued, the streaming thread decodes from there
+            _streamOffsetFrame = _audioCache->_queBufferFrames * _bufferCount;
+            _streamer->addStream(this);
+        }
+
         _ready = true;
         ret    = true;
     } while (false);
@@ -275,159 +266,137 @@ bool AudioPlayer::play2d()
     return ret;
 }
 
-// rotateBufferThread is used to rotate alBufferData for _alSource when playing big audio file
-void AudioPlayer::rotateBufferThread(int offsetFrame)
+// refillStream is called by the streaming thread to rotate alBufferData for _alSource when playing big audio file
+float AudioPlayer::refillStream(std::vector<char>& decodeBuffer)
 {
-    yasio::set_thread_name("axmol-audio");
-
-    char* tmpBuffer           = nullptr;
-    auto& fullPath            = _audioCache->_fileFullPath;
-    AudioDecoder* decoder     = AudioDecoderManager::createDecoder(fullPath);
-    long long rotateSleepTime = static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2;
-    do
+    auto& fullPath = _audioCache->_fileFullPath;
+    if (_streamDecoder == nullptr)
     {
-        BREAK_IF(decoder == nullptr || !decoder->open(fullPath));
-
-        uint32_t framesRead         = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize   = decoder->framesToBytes(framesToRead);
-#if AX_USE_ALSOFT
-        const auto sourceFormat = decoder->getSourceFormat();
-#endif
-        tmpBuffer = (char*)malloc(bufferSize);
-        memset(tmpBuffer, 0, bufferSize);
+        _streamDecoder = AudioDecoderManager::createDecoder(fullPath);
+        if (_streamDecoder == nullptr || !_streamDecoder->open(fullPath))
+        {
+            AXLOGE("AudioPlayer::refillStream, open {} fail, player id={}", fullPath, _id);
+            finishStream();
+            return -1.0f;
+        }
 
-        if (offsetFrame != 0)
+        if (_streamOffsetFrame >= _streamDecoder->getTotalFrames())
+        {
+            _streamEOF = !_loop;
+        }
+        else if (_streamOffsetFrame != 0)
         {
-            decoder->seek(offsetFrame);
+            _streamDecoder->seek(_streamOffsetFrame);
         }
+    }
 
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
+    auto decoder                   = _streamDecoder;
+    const uint32_t framesPerBuffer = _audioCache->_queBufferFrames;
+    const float bufferTime         = static_cast<float>(framesPerBuffer) / decoder->getSampleRate();
 
-        while (!_isDestroyed)
+    ALint sourceState;
+    alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
+    if (sourceState == AL_PLAYING)
+    {
+        ALint bufferProcessed = 0;
+        alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+        if (bufferProcessed > 0 && !_streamEOF)
         {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING)
+            if (_timeDirty)
             {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0)
+                _timeDirty           = false;
+                uint32_t offsetFrame = _currTime * decoder->getSampleRate() * decoder->getChannelCount();
+                decoder->seek(offsetFrame);
+            }
+            else
+            {
+                _currTime += bufferTime * bufferProcessed;
+                if (_currTime > _audioCache->_duration)
                 {
-                    bufferProcessed--;
-                    if (_timeDirty)
+                    if (_loop)
                     {
-                        _timeDirty  = false;
-                        offsetFrame = _currTime * decoder->getSampleRate() * decoder->getChannelCount();
-                        decoder->seek(offsetFrame);
+                        _currTime = 0.0f;
                     }
                     else
                     {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration)
-                        {
-                            if (_loop)
-                            {
-                                _currTime = 0.0f;
-                            }
-                            else
-                            {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
+                        _currTime = _audioCache->_duration;
                     }
-
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-
-                    if (framesRead == 0)
-                    {
-                        if (_loop)
-                        {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        }
-                        else
-                        {
-                            needToExitThread = true;
-                            break;
-                        }
-                    }
-                    /*
-                     While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
-                     already played. Those buffers can then be filled with new data or discarded. New or refilled
-                     buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
-                     always a new buffer to play in the queue, the source will continue to play.
-                     */
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-#if AX_USE_ALSOFT
-                    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
-                        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-#endif
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, decoder->framesToBytes(framesRead),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
                 }
             }
-            /* Make sure the source hasn't underrun */
-            else if (sourceState != AL_PAUSED)
-            {
-                ALint queued;
 
-                /* If no buffers are queued, playback is finished */
-                alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
-                if (queued == 0)
-                {
-                    needToExitThread = true;
-                }
-                else
-                {
-                    alSourcePlay(_alSource);
-                    if (alGetError() != AL_NO_ERROR)
-                    {
-                        AXLOGE("{}", "Error restarting playback!");
-                        needToExitThread = true;
-                    }
-                }
+            // decode all the processed buffers at once, wrapping around for looped sources
+            const uint32_t framesToRead = framesPerBuffer * bufferProcessed;
+            const uint32_t bytesToRead  = decoder->framesToBytes(framesToRead);
+            if (decodeBuffer.size() < bytesToRead)
+            {
+                decodeBuffer.resize(bytesToRead);
             }
 
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread)
+            const uint32_t framesRead = decoder->readLoopedFrames(framesToRead, decodeBuffer.data(), _loop);
+            if (framesRead < framesToRead)
             {
-                break;
+                // let the queued buffers drain, the source stops after the last one
+                _streamEOF = true;
             }
-#if defined(__APPLE__)
-            if (!_needWakeupRotateThread)
+#if AX_USE_ALSOFT
+            const auto sourceFormat = decoder->getSourceFormat();
+#endif
+            for (uint32_t offset = 0; offset < framesRead; offset += framesPerBuffer)
             {
-                _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
+                const uint32_t frames = std::min(framesPerBuffer, framesRead - offset);
+                /*
+                 While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
+                 already played. Those buffers can then be filled with new data or discarded. New or refilled
+                 buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
+                 always a new buffer to play in the queue, the source will continue to play.
+                 */
+                ALuint bid;
+                alSourceUnqueueBuffers(_alSource, 1, &bid);
+#if AX_USE_ALSOFT
+                if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
+                    alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
+#endif
+                alBufferData(bid, _audioCache->_format, decodeBuffer.data() + decoder->framesToBytes(offset),
+                             decoder->framesToBytes(frames), decoder->getSampleRate());
+                alSourceQueueBuffers(_alSource, 1, &bid);
             }
+        }
+    }
+    /* Make sure the source hasn't underrun */
+    else if (sourceState != AL_PAUSED)
+    {
+        ALint queued;
 
-            _needWakeupRotateThread = false;
-#else
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
-#endif
+        /* If no buffers are queued or the end was queued already, playback is finished */
+        alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
+        if (queued == 0 || _streamEOF)
+        {
+            finishStream();
+            return -1.0f;
         }
 
-    } while (false);
+        alSourcePlay(_alSource);
+        if (alGetError() != AL_NO_ERROR)
+        {
+            AXLOGE("{}", "Error restarting playback!");
+            finishStream();
+            return -1.0f;
+        }
+    }
 
-    AXLOGV("{}", "Exit rotate buffer thread ...");
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
+    return bufferTime / 2;
 }
 
-#if defined(__APPLE__)
-void AudioPlayer::wakeupRotateThread()
+void AudioPlayer::finishStream()
 {
-    _needWakeupRotateThread = true;
-    _sleepCondition.notify_all();
+    AXLOGV("AudioPlayer::finishStream, player id={}", _id);
+    _streamFinished = true;
 }
-#endif
 
 bool AudioPlayer::isFinished() const
 {
     if (_streamingSource)
-        return _isRotateThreadExited;
+        return _streamFinished;
     else
     {
         ALint sourceState;
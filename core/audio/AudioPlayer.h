@@ -29,9 +29,9 @@
 #include "platform/PlatformConfig.h"
 
 #include <string>
-#include <condition_variable>
+#include <atomic>
 #include <mutex>
-#include <thread>
+#include <vector>
 
 #include "audio/AudioMacros.h"
 #include "platform/PlatformMacros.h"
@@ -41,11 +41,14 @@ namespace ax
 {
 
 class AudioCache;
+class AudioDecoder;
 class AudioEngineImpl;
+class AudioStreamer;
 
 class AX_DLL AudioPlayer
 {
     friend class AudioEngineImpl;
+    friend class AudioStreamer;
 
 public:
     AudioPlayer();
@@ -62,11 +65,11 @@ public:
 
 protected:
     void setCache(AudioCache* cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
-#if defined(__APPLE__)
-    void wakeupRotateThread();
-#endif
+
+    // called by the streaming thread, returns the delay in seconds until the next refill or -1 once finished
+    float refillStream(std::vector<char>& decodeBuffer);
+    void finishStream();
 
     AudioCache* _audioCache;
 
@@ -83,15 +86,14 @@ protected:
     // play by circular buffer
     float _currTime;
     bool _streamingSource;
-    ALuint _bufferIds[QUEUEBUFFER_NUM];
-    std::thread* _rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
+    int _bufferCount;
+    ALuint _bufferIds[QUEUEBUFFER_MAX_NUM];
+    AudioStreamer* _streamer;
+    AudioDecoder* _streamDecoder;
+    uint32_t _streamOffsetFrame;
+    bool _streamEOF;
+    std::atomic_bool _streamFinished;
     bool _timeDirty;
-    bool _isRotateThreadExited;
-#if defined(__APPLE__)
-    std::atomic_bool _needWakeupRotateThread;
-#endif
 
     std::mutex _play2dMutex;
 
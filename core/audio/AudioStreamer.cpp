@@ -0,0 +1,141 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "audio/AudioStreamer.h"
+#include "audio/AudioPlayer.h"
+
+#include "yasio/thread_name.hpp"
+
+namespace ax
+{
+
+AudioStreamer::AudioStreamer()
+    : _refill([](AudioPlayer* player, std::vector<char>& decodeBuffer) { return player->refillStream(decodeBuffer); })
+{}
+
+AudioStreamer::AudioStreamer(RefillFunc refill) : _refill(std::move(refill)) {}
+
+AudioStreamer::~AudioStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        _stop = true;
+    }
+    _wakeup.notify_one();
+    if (_thread.joinable())
+        _thread.join();
+}
+
+void AudioStreamer::addStream(AudioPlayer* player)
+{
+    std::lock_guard<std::mutex> lck(_mutex);
+    auto& stream  = _streams[player];
+    stream.serial = ++_nextSerial;
+    schedule(player, stream, clock_type::now());
+
+    if (!_thread.joinable())
+        _thread = std::thread(&AudioStreamer::run, this);
+}
+
+void AudioStreamer::removeStream(AudioPlayer* player)
+{
+    std::unique_lock<std::mutex> lck(_mutex);
+    _streams.erase(player);
+    _serviced.wait(lck, [this, player] { return _servicing != player; });
+}
+
+void AudioStreamer::wakeup(AudioPlayer* player)
+{
+    std::lock_guard<std::mutex> lck(_mutex);
+    auto it = _streams.find(player);
+    if (it != _streams.end())
+        schedule(player, it->second, clock_type::now());
+}
+
+size_t AudioStreamer::getStreamCount() const
+{
+    std::lock_guard<std::mutex> lck(_mutex);
+    return _streams.size();
+}
+
+void AudioStreamer::schedule(AudioPlayer* player, Stream& stream, clock_type::time_point time)
+{
+    stream.deadline = time;
+    if (_deadlines.empty() || time < _deadlines.top().time)
+        _wakeup.notify_one();
+    _deadlines.push(Deadline{time, player, stream.serial});
+}
+
+void AudioStreamer::run()
+{
+    yasio::set_thread_name("axmol-audio");
+
+    std::unique_lock<std::mutex> lck(_mutex);
+    while (!_stop)
+    {
+        if (_deadlines.empty())
+        {
+            _wakeup.wait(lck);
+            continue;
+        }
+
+        auto next = _deadlines.top();
+        auto it   = _streams.find(next.player);
+        if (it == _streams.end() || it->second.serial != next.serial || it->second.deadline != next.time)
+        {
+            _deadlines.pop();
+            continue;
+        }
+
+        if (next.time > clock_type::now())
+        {
+            _wakeup.wait_until(lck, next.time);
+            continue;
+        }
+
+        _deadlines.pop();
+        _servicing = next.player;
+        lck.unlock();
+
+        const float delay = _refill(next.player, _decodeBuffer);
+
+        lck.lock();
+        _servicing = nullptr;
+        _serviced.notify_all();
+
+        // the stream may have been removed or woken up meanwhile
+        it = _streams.find(next.player);
+        if (it == _streams.end() || it->second.serial != next.serial)
+            continue;
+
+        if (delay < 0)
+            _streams.erase(it);
+        else if (it->second.deadline == next.time)
+            schedule(next.player, it->second,
+                     clock_type::now() + std::chrono::duration_cast<clock_type::duration>(
+                                             std::chrono::duration<float>(delay)));
+    }
+}
+
+}  // namespace ax
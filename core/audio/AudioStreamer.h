@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include "platform/PlatformConfig.h"
+
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+class AudioPlayer;
+
+/**
+ * Refills the OpenAL buffer queues of all the streamed players from a single thread.
+ *
+ * Each stream is serviced when its deadline is reached, the earliest deadline first; a service
+ * decodes all the buffers the source has processed in one read and schedules the next deadline
+ * half a buffer later. The thread is started with the first stream.
+ * @since axmol-2.2
+ */
+class AX_DLL AudioStreamer
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** Refills the buffers of a player, returns the delay in seconds until the next service, < 0 to stop. */
+    using RefillFunc = std::function<float(AudioPlayer*, std::vector<char>& decodeBuffer)>;
+
+    /** Services the streams with AudioPlayer::refillStream. */
+    AudioStreamer();
+
+    /** Services the streams with a custom refill, e.g. to drive the scheduling without an audio device. */
+    explicit AudioStreamer(RefillFunc refill);
+    ~AudioStreamer();
+
+    /** Starts refilling the buffers of a playing streamed player. */
+    void addStream(AudioPlayer* player);
+
+    /** Stops refilling, blocks while the player is being serviced. */
+    void removeStream(AudioPlayer* player);
+
+    /** Services the player as soon as possible, e.g. when its source notified processed buffers. */
+    void wakeup(AudioPlayer* player);
+
+    size_t getStreamCount() const;
+
+private:
+    struct Stream
+    {
+        uint64_t serial;
+        clock_type::time_point deadline;
+    };
+
+    struct Deadline
+    {
+        clock_type::time_point time;
+        AudioPlayer* player;
+        uint64_t serial;
+
+        bool operator>(const Deadline& other) const { return time > other.time; }
+    };
+
+    void run();
+    void schedule(AudioPlayer* player, Stream& stream, clock_type::time_point time);
+
+    RefillFunc _refill;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::condition_variable _serviced;
+
+    // may hold stale entries of removed or rescheduled streams, skipped when popped
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> _deadlines;
+    std::unordered_map<AudioPlayer*, Stream> _streams;
+    uint64_t _nextSerial{0};
+    AudioPlayer* _servicing{nullptr};
+
+    std::vector<char> _decodeBuffer;  // shared by all streams, only touched by the streaming thread
+    std::thread _thread;
+    bool _stop{false};
+};
+
+}  // namespace ax
@@ -136,6 +136,7 @@ THE SOFTWARE.
 #include "2d/ProtectedNode.h"
 #include "2d/RenderTexture.h"
 #include "2d/Scene.h"
+#include "2d/SpatialNode.h"
 #include "2d/Transition.h"
 #include "2d/TransitionPageTurn.h"
 #include "2d/TransitionProgress.h"
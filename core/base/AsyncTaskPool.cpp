@@ -46,7 +46,12 @@ void AsyncTaskPool::destroyInstance()
     s_asyncTaskPool = nullptr;
 }
 
-AsyncTaskPool::AsyncTaskPool() {}
+AsyncTaskPool::AsyncTaskPool()
+{
+    // keep blocking reads and downloads off the JobSystem workers, frames may wait on those
+    _threadTasks[(int)TaskType::TASK_IO].setBlocking(true);
+    _threadTasks[(int)TaskType::TASK_NETWORK].setBlocking(true);
+}
 
 AsyncTaskPool::~AsyncTaskPool() {}
 
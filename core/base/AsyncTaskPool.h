@@ -32,10 +32,9 @@ THE SOFTWARE.
 #include <vector>
 #include <queue>
 #include <memory>
-#include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <future>
+#include <thread>
 #include <functional>
 #include <stdexcept>
 
@@ -84,7 +83,8 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others, tasks of the same type run in order. IO and network
+     * tasks run on a thread per type since they may block, other tasks run on the JobSystem and must be cpu bound.
      * @param callback callback when the task is finished. The callback is called in the main thread instead of task
      * thread.
      * @param callbackParam parameter used by the callback.
@@ -96,7 +96,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others, tasks of the same type run in order.
      * @param task: task can be lambda function to be performed off thread.
      * @lua NA
      */
@@ -106,7 +106,8 @@ public:
     ~AsyncTaskPool();
 
 protected:
-    // thread tasks internally used
+    // serial task queue internally used. Blocking queues own a thread, the others run on the shared JobSystem
+    // workers one task at a time, since the main thread may wait on those workers.
     class ThreadTasks
     {
         struct AsyncTaskCallBack
@@ -116,30 +117,7 @@ protected:
         };
 
     public:
-        ThreadTasks() : _stop(false)
-        {
-            _thread = std::thread([this] {
-                for (;;)
-                {
-                    std::function<void()> task;
-                    AsyncTaskCallBack callback;
-                    {
-                        std::unique_lock<std::mutex> lock(this->_queueMutex);
-                        this->_condition.wait(lock, [this] { return this->_stop || !this->_tasks.empty(); });
-                        if (this->_stop && this->_tasks.empty())
-                            return;
-                        task     = std::move(this->_tasks.front());
-                        callback = std::move(this->_taskCallBacks.front());
-                        this->_tasks.pop();
-                        this->_taskCallBacks.pop();
-                    }
-
-                    task();
-                    Director::getInstance()->getScheduler()->runOnAxmolThread(
-                        std::bind(callback.callback, callback.callbackParam));
-                }
-            });
-        }
+        ThreadTasks() : _stop(false), _running(false), _blocking(false) {}
         ~ThreadTasks()
         {
             {
@@ -150,10 +128,22 @@ protected:
                     _tasks.pop();
                 while (_taskCallBacks.size())
                     _taskCallBacks.pop();
+
+                // wait for the task in progress, the drain job references this queue
+                if (!_blocking)
+                    _condition.wait(lock, [this] { return !_running; });
+            }
+
+            if (_thread.joinable())
+            {
+                _condition.notify_all();
+                _thread.join();
             }
-            _condition.notify_all();
-            _thread.join();
         }
+
+        // must be set before the first enqueue
+        void setBlocking(bool blocking) { _blocking = blocking; }
+
         void clear()
         {
             std::unique_lock<std::mutex> lock(_queueMutex);
@@ -181,12 +171,74 @@ protected:
 
                 _tasks.push(std::move(task));
                 _taskCallBacks.push(std::move(taskCallBack));
+
+                if (_blocking)
+                {
+                    // the thread is started with the first task, most apps never use some task types
+                    if (!_thread.joinable())
+                        _thread = std::thread([this] { loop(); });
+                    _condition.notify_one();
+                    return;
+                }
+
+                if (_running)
+                    return;
+                _running = true;
             }
-            _condition.notify_one();
+            Director::getInstance()->getJobSystem()->enqueue([this] { drain(); });
         }
 
     private:
-        // need to keep track of thread so we can join them
+        void loop()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                AsyncTaskCallBack callback;
+                {
+                    std::unique_lock<std::mutex> lock(_queueMutex);
+                    _condition.wait(lock, [this] { return _stop || !_tasks.empty(); });
+                    if (_stop && _tasks.empty())
+                        return;
+                    task     = std::move(_tasks.front());
+                    callback = std::move(_taskCallBacks.front());
+                    _tasks.pop();
+                    _taskCallBacks.pop();
+                }
+
+                task();
+                Director::getInstance()->getScheduler()->runOnAxmolThread(
+                    std::bind(callback.callback, callback.callbackParam));
+            }
+        }
+
+        void drain()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                AsyncTaskCallBack callback;
+                {
+                    std::unique_lock<std::mutex> lock(_queueMutex);
+                    if (_tasks.empty())
+                    {
+                        _running = false;
+                        _condition.notify_all();
+                        return;
+                    }
+                    task     = std::move(_tasks.front());
+                    callback = std::move(_taskCallBacks.front());
+                    _tasks.pop();
+                    _taskCallBacks.pop();
+                }
+
+                task();
+                Director::getInstance()->getScheduler()->runOnAxmolThread(
+                    std::bind(callback.callback, callback.callbackParam));
+            }
+        }
+
+        // the thread of a blocking queue
         std::thread _thread;
         // the task queue
         std::queue<std::function<void()>> _tasks;
@@ -196,6 +248,8 @@ protected:
         std::mutex _queueMutex;
         std::condition_variable _condition;
         bool _stop;
+        bool _running;
+        bool _blocking;
     };
 
     // tasks
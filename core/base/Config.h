@@ -238,13 +238,12 @@ THE SOFTWARE.
 #endif
 
 /** @def AX_ENABLE_PROFILERS
- * If enabled, will activate various profilers within cocos2d. This statistical data will be output to the console
- * once per second showing average time (in milliseconds) required to execute the specific routine(s).
- * Useful for debugging purposes only. It is recommended to leave it disabled.
- * To enable set it to a value different than 0. Disabled by default.
+ * If enabled, compiles in the profiler zones and counters (see ax::Profiler). Recording itself is started and
+ * stopped at runtime, an idle zone costs one atomic load.
+ * To compile them out set it to 0. Enabled by default.
  */
 #ifndef AX_ENABLE_PROFILERS
-#    define AX_ENABLE_PROFILERS 0
+#    define AX_ENABLE_PROFILERS 1
 #endif
 
 /** Enable Lua engine debug log. */
@@ -343,6 +342,15 @@ THE SOFTWARE.
 #    define AX_META_TEXTURES 2
 #endif
 
+/** @def AX_ENABLE_PROGRAM_CACHE
+ * Whether the linked programs are cached on disk, in the "program-cache" folder of the writable path,
+ * so later launches don't compile the shaders again. Only supported by the GL backend on GL 4.1+/ES 3.
+ * @since axmol-2.2
+ */
+#ifndef AX_ENABLE_PROGRAM_CACHE
+#    define AX_ENABLE_PROGRAM_CACHE 1
+#endif
+
 /// @name namespace ax
 /// @{
 #ifdef __cplusplus
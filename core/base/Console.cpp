@@ -47,6 +47,7 @@
 #include "base/Scheduler.h"
 #include "platform/PlatformConfig.h"
 #include "base/Configuration.h"
+#include "base/Profiling.h"
 #include "2d/Scene.h"
 #include "platform/FileUtils.h"
 #include "renderer/TextureCache.h"
@@ -363,6 +364,7 @@ Console::Console()
     createCommandFileUtils();
     createCommandFps();
     createCommandHelp();
+    createCommandProfiler();
     createCommandProjection();
     createCommandResolution();
     createCommandSceneGraph();
@@ -909,6 +911,20 @@ void Console::createCommandHelp()
     addCommand({"help", "Print this message. Args: [ ]", AX_CALLBACK_2(Console::commandHelp, this)});
 }
 
+void Console::createCommandProfiler()
+{
+    addCommand({"profiler", "Record the profiler zones and counters. Args: [-h | help | start | stop | save [path] | ]",
+                AX_CALLBACK_2(Console::commandProfiler, this)});
+    addSubCommand("profiler", {"start", "Discard the previous recording and start recording.",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandStart, this)});
+    addSubCommand("profiler",
+                  {"stop", "Stop recording.", AX_CALLBACK_2(Console::commandProfilerSubCommandStop, this)});
+    addSubCommand("profiler", {"save",
+                               "Save the recording as a Chrome trace, open it in chrome://tracing or "
+                               "ui.perfetto.dev. Relative paths are in the writable path.",
+                               AX_CALLBACK_2(Console::commandProfilerSubCommandSave, this)});
+}
+
 void Console::createCommandProjection()
 {
     addCommand({"projection", "Change or print the current projection. Args: [-h | help | 2d | 3d | ]",
@@ -1062,6 +1078,40 @@ void Console::commandHelp(socket_native_type fd, std::string_view /*args*/)
     sendHelp(fd, _commands, "\nAvailable commands:\n");
 }
 
+void Console::commandProfiler(socket_native_type fd, std::string_view /*args*/)
+{
+    auto profiler = Profiler::getInstance();
+    Console::Utility::mydprintf(fd, "Profiler is %s: %d events, %d dropped\n",
+                                Profiler::isRecording() ? "recording" : "stopped",
+                                static_cast<int>(profiler->getEventCount()),
+                                static_cast<int>(profiler->getDroppedEventCount()));
+}
+
+void Console::commandProfilerSubCommandStart(socket_native_type /*fd*/, std::string_view /*args*/)
+{
+    Profiler::getInstance()->start();
+}
+
+void Console::commandProfilerSubCommandStop(socket_native_type /*fd*/, std::string_view /*args*/)
+{
+    Profiler::getInstance()->stop();
+}
+
+void Console::commandProfilerSubCommandSave(socket_native_type fd, std::string_view args)
+{
+    auto argv = Console::Utility::split(args, ' ');
+
+    auto fileUtils = FileUtils::getInstance();
+    std::string path{argv.size() > 1 ? argv[1] : "axmol_trace.json"};
+    if (!fileUtils->isAbsolutePath(path))
+        path.insert(0, fileUtils->getWritablePath());
+
+    if (Profiler::getInstance()->saveChromeTrace(path))
+        Console::Utility::mydprintf(fd, "Trace saved to %s\n", path.c_str());
+    else
+        Console::Utility::mydprintf(fd, "profiler: can't write %s\n", path.c_str());
+}
+
 void Console::commandProjection(socket_native_type fd, std::string_view /*args*/)
 {
     auto director = Director::getInstance();
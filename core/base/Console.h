@@ -221,6 +221,7 @@ protected:
     void createCommandFileUtils();
     void createCommandFps();
     void createCommandHelp();
+    void createCommandProfiler();
     void createCommandProjection();
     void createCommandResolution();
     void createCommandSceneGraph();
@@ -245,6 +246,10 @@ protected:
     void commandFps(socket_native_type fd, std::string_view args);
     void commandFpsSubCommandOnOff(socket_native_type fd, std::string_view args);
     void commandHelp(socket_native_type fd, std::string_view args);
+    void commandProfiler(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandStart(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandStop(socket_native_type fd, std::string_view args);
+    void commandProfilerSubCommandSave(socket_native_type fd, std::string_view args);
     void commandProjection(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand2d(socket_native_type fd, std::string_view args);
     void commandProjectionSubCommand3d(socket_native_type fd, std::string_view args);
@@ -44,6 +44,7 @@ THE SOFTWARE.
 #include "2d/FontFreeType.h"
 #include "2d/LabelAtlas.h"
 #include "renderer/TextureCache.h"
+#include "renderer/Texture2D.h"
 #include "renderer/Renderer.h"
 #include "renderer/RenderState.h"
 #include "2d/Camera.h"
@@ -57,6 +58,7 @@ THE SOFTWARE.
 #include "base/Logging.h"
 #include "base/AutoreleasePool.h"
 #include "base/Configuration.h"
+#include "base/Profiling.h"
 #ifndef AX_CORE_PROFILE
 #    include "base/AsyncTaskPool.h"
 #endif
@@ -119,6 +121,8 @@ bool Director::init()
     // FPS
     _lastUpdate = std::chrono::steady_clock::now();
 
+    Profiler::getInstance()->setThreadName("Main thread");
+
     auto concurrency = Configuration::getInstance()->getValue("axmol.concurrency", Value{-1}).asInt();
     _jobSystem = new JobSystem(concurrency);
 
@@ -160,6 +164,7 @@ bool Director::init()
     // listen the event that renderer was recreated on Android/WP8
     _rendererRecreatedListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
         _isStatusLabelUpdated = true;  // Force recreation of textures
+        _renderer->invalidateBatchCache();  // Cached vertices are lost with the buffers
     });
 
     _eventDispatcher->addEventListenerWithFixedPriority(_rendererRecreatedListener, -1);
@@ -274,6 +279,8 @@ void Director::setGLDefaultValues()
 // Draw the Scene
 void Director::drawScene()
 {
+    AX_PROFILE_ZONE("Director::drawScene");
+
     _renderer->beginFrame();
 
     // calculate "global" dt
@@ -339,6 +346,18 @@ void Director::drawScene()
 
     _renderer->render();
 
+#if AX_ENABLE_PROFILERS
+    auto textureUploads = Texture2D::getUploadCount();
+    if (Profiler::isRecording())
+    {
+        auto profiler = Profiler::getInstance();
+        profiler->recordCounter("draw calls", _renderer->getDrawnBatches());
+        profiler->recordCounter("vertices", _renderer->getDrawnVertices());
+        profiler->recordCounter("texture uploads", textureUploads - _lastTextureUploads);
+    }
+    _lastTextureUploads = textureUploads;
+#endif
+
     _eventDispatcher->dispatchEvent(_eventAfterDraw);
 
     popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
@@ -497,6 +516,9 @@ void Director::resetMatrixStack()
 
 void Director::popMatrix(MATRIX_STACK_TYPE type)
 {
+    if (RenderCommandList::getCurrent())
+        return;
+
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
         _modelViewMatrixStack.pop();
@@ -517,6 +539,9 @@ void Director::popMatrix(MATRIX_STACK_TYPE type)
 
 void Director::loadIdentityMatrix(MATRIX_STACK_TYPE type)
 {
+    if (RenderCommandList::getCurrent())
+        return;
+
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
         _modelViewMatrixStack.top() = Mat4::IDENTITY;
@@ -537,6 +562,9 @@ void Director::loadIdentityMatrix(MATRIX_STACK_TYPE type)
 
 void Director::loadMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
+    if (RenderCommandList::getCurrent())
+        return;
+
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
         _modelViewMatrixStack.top() = mat;
@@ -557,6 +585,9 @@ void Director::loadMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 
 void Director::multiplyMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
+    if (RenderCommandList::getCurrent())
+        return;
+
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
         _modelViewMatrixStack.top() *= mat;
@@ -577,6 +608,10 @@ void Director::multiplyMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 
 void Director::pushMatrix(MATRIX_STACK_TYPE type)
 {
+    // the matrix stacks are not shared with the threads of a parallel visit
+    if (RenderCommandList::getCurrent())
+        return;
+
     if (type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
         _modelViewMatrixStack.push(_modelViewMatrixStack.top());
@@ -1127,6 +1162,7 @@ void Director::restartDirector()
     // listen the event that renderer was recreated on Android/WP8
     _rendererRecreatedListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
         _isStatusLabelUpdated = true;  // Force recreation of textures
+        _renderer->invalidateBatchCache();  // Cached vertices are lost with the buffers
     });
 
     _eventDispatcher->addEventListenerWithFixedPriority(_rendererRecreatedListener, -1);
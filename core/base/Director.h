@@ -628,6 +628,9 @@ protected:
     unsigned int _frames      = 0;
     float _secondsPerFrame    = 1.f;
 
+    /* Texture2D::getUploadCount() at the end of the previous frame */
+    uint32_t _lastTextureUploads = 0;
+
     /* The running scene */
     Scene* _runningScene = nullptr;
 
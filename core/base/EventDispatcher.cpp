@@ -25,6 +25,7 @@
  ****************************************************************************/
 #include "base/EventDispatcher.h"
 #include <algorithm>
+#include <float.h>
 
 #include "base/EventCustom.h"
 #include "base/EventListenerTouch.h"
@@ -908,7 +909,9 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
             // second, for all camera call all listeners
             // get a copy of cameras, prevent it's been modified in listener callback
             // if camera's depth is greater, process it earlier
-            auto cameras = scene->getCameras();
+            auto cameras           = scene->getCameras();
+            auto previousView      = _hitTestView;
+            auto previousHitCamera = _hitTestCamera;
             for (auto rit = cameras.rbegin(), ritRend = cameras.rend(); rit != ritRend; ++rit)
             {
                 Camera* camera = *rit;
@@ -919,6 +922,8 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
 
                 Camera::_visitingCamera = camera;
                 auto cameraFlag         = (unsigned short)camera->getCameraFlag();
+                _hitTestCamera          = camera;
+                _hitTestView            = getHitTestView(camera);
                 for (auto&& l : sceneListeners)
                 {
                     if (nullptr == l->getAssociatedNode() ||
@@ -938,6 +943,8 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
                 }
             }
             Camera::_visitingCamera = nullptr;
+            _hitTestView            = previousView;
+            _hitTestCamera          = previousHitCamera;
         }
     }
 
@@ -990,7 +997,18 @@ void EventDispatcher::dispatchEvent(Event* event, bool forced)
     {
         auto listeners = iter->second;
 
-        auto onEvent = [&event](EventListener* listener) -> bool {
+        auto onEvent = [this, &event](EventListener* listener) -> bool {
+            if (event->getType() == Event::Type::MOUSE && listener->_hitTestBoundsEnabled)
+            {
+                // only the events aimed at a location are filtered, moves and releases may concern a pressed node
+                auto mouseEvent = static_cast<EventMouse*>(event);
+                auto type       = mouseEvent->getMouseEventType();
+                if ((type == EventMouse::MouseEventType::MOUSE_DOWN ||
+                     type == EventMouse::MouseEventType::MOUSE_SCROLL) &&
+                    !hitTestBounds(listener, mouseEvent->getLocation()))
+                    return false;
+            }
+
             event->setCurrentTarget(listener->getAssociatedNode());
             listener->_onEvent(event);
             return event->isStopped();
@@ -1014,6 +1032,93 @@ bool EventDispatcher::hasEventListener(std::string_view listenerID) const
     return getListeners(listenerID) != nullptr;
 }
 
+uint32_t EventDispatcher::getHitTestView(Camera* camera)
+{
+    const auto& viewProjection = camera->getViewProjectionMatrix();
+    for (auto&& view : _hitTestViews)
+    {
+        if (view.camera == camera)
+        {
+            if (memcmp(&view.viewProjection, &viewProjection, sizeof(Mat4)) != 0)
+            {
+                view.viewProjection = viewProjection;
+                view.id             = ++_hitTestViewCounter;
+            }
+            return view.id;
+        }
+    }
+
+    // the cameras are not tracked, forget the ones which may have been released once in a while
+    if (_hitTestViews.size() >= 8)
+        _hitTestViews.clear();
+    _hitTestViews.emplace_back(HitTestView{camera, viewProjection, ++_hitTestViewCounter});
+    return _hitTestViewCounter;
+}
+
+bool EventDispatcher::hitTestBounds(EventListener* listener, const Vec2& location)
+{
+    auto node = listener->_node;
+    if (!_hitTestView || !listener->_hitTestBoundsEnabled || !node)
+        return true;
+
+    // the transform of the last visit is up to date unless the node or an ancestor changed since
+    const Mat4* transform = &node->_modelViewTransform;
+    Mat4 nodeToWorld;
+    for (auto n = node; n; n = n->_parent)
+    {
+        if (n->_transformUpdated)
+        {
+            nodeToWorld = node->getNodeToWorldTransform();
+            transform   = &nodeToWorld;
+            break;
+        }
+    }
+
+    const auto& size = node->getContentSize();
+    if (listener->_hitTestView != _hitTestView || !listener->_hitTestSize.equals(size) ||
+        memcmp(&listener->_hitTestTransform, transform, sizeof(Mat4)) != 0)
+    {
+        listener->_hitTestView      = _hitTestView;
+        listener->_hitTestSize      = size;
+        listener->_hitTestTransform = *transform;
+        listener->_hitTestUnbounded = false;
+        listener->_hitTestRect      = Rect::ZERO;
+
+        if (size.width > 0 && size.height > 0)
+        {
+            // the screen bounding box of the projected content rect
+            Mat4 mvp         = _hitTestCamera->getViewProjectionMatrix() * (*transform);
+            const auto& win  = Director::getInstance()->getWinSize();
+            float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+            const Vec2 corners[4] = {Vec2::ZERO, Vec2(size.width, 0), Vec2(0, size.height), Vec2(size.width, size.height)};
+            for (auto&& corner : corners)
+            {
+                Vec4 clip;
+                mvp.transformVector(Vec4(corner.x, corner.y, 0, 1), &clip);
+                if (clip.w <= 0)
+                {
+                    listener->_hitTestUnbounded = true;
+                    break;
+                }
+                const float x = (clip.x / clip.w + 1.0f) * 0.5f * win.width;
+                const float y = (clip.y / clip.w + 1.0f) * 0.5f * win.height;
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+
+            // a point of margin for the rounding errors of the projection
+            if (!listener->_hitTestUnbounded)
+                listener->_hitTestRect.setRect(minX - 1, minY - 1, maxX - minX + 2, maxY - minY + 2);
+        }
+    }
+
+    if (listener->_hitTestUnbounded)
+        return true;
+    return listener->_hitTestRect.size.width > 0 && listener->_hitTestRect.containsPoint(location);
+}
+
 void EventDispatcher::dispatchTouchEvent(EventTouch* event)
 {
     sortEventListeners(EventListenerTouchOneByOne::LISTENER_ID);
@@ -1058,7 +1163,7 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
 
                 if (eventCode == EventTouch::EventCode::BEGAN)
                 {
-                    if (listener->onTouchBegan)
+                    if (listener->onTouchBegan && hitTestBounds(listener, touches->getLocation()))
                     {
                         isClaimed = listener->onTouchBegan(touches, event);
                         if (isClaimed && listener->_isRegistered)
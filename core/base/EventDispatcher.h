@@ -49,6 +49,7 @@ namespace ax
 class Event;
 class EventTouch;
 class Node;
+class Camera;
 class EventCustom;
 class EventListenerCustom;
 
@@ -305,6 +306,12 @@ protected:
 
     void releaseListener(EventListener* listener);
 
+    /** Returns an id identifying the camera and its current view projection, for the hit test bounds of listeners */
+    uint32_t getHitTestView(Camera* camera);
+
+    /** Whether location may be in the hit test bounds of listener, always true without hit test bounds */
+    bool hitTestBounds(EventListener* listener, const Vec2& location);
+
     /// Priority dirty flag
     enum class DirtyFlag
     {
@@ -357,6 +364,18 @@ protected:
     int _nodePriorityIndex;
 
     std::set<std::string> _internalCustomListenerIDs;
+
+    struct HitTestView
+    {
+        Camera* camera;
+        Mat4 viewProjection;
+        uint32_t id;
+    };
+    std::vector<HitTestView> _hitTestViews;
+    uint32_t _hitTestViewCounter = 0;
+    /** The view of the camera touch and mouse events are dispatched for, 0 outside of the camera loop */
+    uint32_t _hitTestView = 0;
+    Camera* _hitTestCamera = nullptr;
 };
 
 }
@@ -33,6 +33,8 @@
 
 #include "platform/PlatformMacros.h"
 #include "base/Object.h"
+#include "math/Mat4.h"
+#include "math/Rect.h"
 
 /**
  * @addtogroup base
@@ -114,6 +116,16 @@ public:
      */
     bool isEnabled() const { return _isEnabled; }
 
+    /** Lets EventDispatcher skip this listener for touch began, mouse down and mouse scroll events located outside
+     * the content rect of its node, as seen by the dispatching camera.
+     * @note Only for scene graph priority listeners which ignore such events anyway, the screen bounds of the node are
+     *       cached and only recomputed when the node, one of its ancestors or the camera moved, which is far cheaper
+     *       than calling the listener. ui::Widget enables it with Widget::setHitTestBoundsEnabled.
+     * @since axmol-2.2
+     */
+    void setHitTestBoundsEnabled(bool enabled) { _hitTestBoundsEnabled = enabled; }
+    bool isHitTestBoundsEnabled() const { return _hitTestBoundsEnabled; }
+
 protected:
     /** Sets paused state for the listener
      *  The paused state is only used for scene graph priority listeners.
@@ -178,6 +190,14 @@ protected:
     Node* _node;         // scene graph based priority
     bool _paused;        // Whether the listener is paused
     bool _isEnabled;     // Whether the listener is enabled
+
+    // hit test bounds, maintained by EventDispatcher::hitTestBounds
+    bool _hitTestBoundsEnabled = false;
+    bool _hitTestUnbounded     = false;  // the node crosses the near plane of the camera
+    uint32_t _hitTestView      = 0;      // the camera and view projection the bounds were computed for
+    Mat4 _hitTestTransform;              // the node to world transform the bounds were computed with
+    Size _hitTestSize;
+    Rect _hitTestRect;                   // in GL screen coordinates
     friend class EventDispatcher;
 };
 
@@ -60,6 +60,7 @@ EventListenerMouse* EventListenerMouse::clone()
         ret->onMouseDown   = onMouseDown;
         ret->onMouseMove   = onMouseMove;
         ret->onMouseScroll = onMouseScroll;
+        ret->_hitTestBoundsEnabled = _hitTestBoundsEnabled;
     }
     else
     {
@@ -110,6 +110,7 @@ EventListenerTouchOneByOne* EventListenerTouchOneByOne::clone()
 
         ret->_claimedTouches = _claimedTouches;
         ret->_needSwallow    = _needSwallow;
+        ret->_hitTestBoundsEnabled = _hitTestBoundsEnabled;
     }
     else
     {
@@ -130,6 +130,12 @@ public:
      * @js getButton
      */
     MouseButton getMouseButton() const { return _mouseButton; }
+    /** Get mouse event type.
+     *
+     * @return The type of the mouse event.
+     * @since axmol-2.2
+     */
+    MouseEventType getMouseEventType() const { return _mouseEventType; }
     /** Get the cursor position of x axis.
      *
      * @return The x coordinate of cursor position.
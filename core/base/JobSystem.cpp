@@ -25,13 +25,13 @@
 
 #include "base/JobSystem.h"
 #include "base/Director.h"
+#include "base/Profiling.h"
 #include "yasio/thread_name.hpp"
 
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <future>
 #include <functional>
 #include <stdexcept>
 
@@ -43,94 +43,160 @@ namespace ax
 {
 
 #pragma region JobExecutor
+/*
+ * Work-stealing executor: every worker owns a deque, jobs spawned by a worker are pushed to the
+ * back of its own deque and popped back LIFO (hot in cache), idle workers steal from the front of
+ * other workers' deques. Jobs submitted from non-worker threads are spread round-robin.
+ */
 class JobExecutor
 {
+    using Task = std::function<void(JobThreadData*)>;
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
 public:
     explicit JobExecutor(std::span<std::shared_ptr<JobThreadData>> tdds) : stop(false)
     {
-        for (auto thread_data : tdds)
-            workers.emplace_back([this, thread_data] {
+        for (size_t i = 0; i < tdds.size(); ++i)
+            workers.emplace_back(std::make_unique<Worker>());
+
+        for (size_t i = 0; i < tdds.size(); ++i)
+        {
+            workers[i]->thread = std::thread([this, index = static_cast<int>(i), thread_data = tdds[i]] {
                 thread_data->init();
                 yasio::set_thread_name(thread_data->name());
+                Profiler::getInstance()->setThreadName(fmt::format("{} worker {}", thread_data->name(), index));
+                t_executor   = this;
+                t_workerIndex = index;
+                t_threadData  = thread_data.get();
                 for (;;)
                 {
-                    std::function<void(JobThreadData*)> task;
+                    Task task;
+                    if (this->pop(index, task))
                     {
-                        std::unique_lock<std::mutex> lock(this->queue_mutex);
-                        this->condition.wait(lock, [this] { return this->stop || !this->tasks.empty(); });
-                        if (this->stop && this->tasks.empty())
-                            break;
-                        task = std::move(this->tasks.front());
-                        this->tasks.pop();
+                        AX_PROFILE_ZONE("JobSystem::task");
+                        task(thread_data.get());
+                        continue;
                     }
 
-                    task(thread_data.get());
+                    std::unique_lock<std::mutex> lock(this->sleep_mutex);
+                    this->condition.wait(lock, [this] { return this->stop || this->pending.load() > 0; });
+                    if (this->stop && this->pending.load() == 0)
+                        break;
                 }
+                t_executor = nullptr;
                 thread_data->finz();
             });
+        }
     }
+
     template <class F, class... Args>
-    auto enqueue(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F(Args...)>::type>
+    void enqueue_v(F&& f, Args&&... args)
     {
-        using return_type = typename std::invoke_result<F(Args...)>::type;
-
-        auto task = std::make_shared<std::packaged_task<return_type(size_t)>>(
-            std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...));
+        push(std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...));
+    }
 
-        std::future<return_type> res = task->get_future();
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+    /** Runs one pending job on the calling worker thread, returns false if there was none. */
+    bool runPending()
+    {
+        if (t_executor != this)
+            return false;
+        Task task;
+        if (!pop(t_workerIndex, task))
+            return false;
+        AX_PROFILE_ZONE("JobSystem::task");
+        task(t_threadData);
+        return true;
+    }
 
-            // don't allow enqueueing after stopping the pool
-            if (stop)
-                throw std::runtime_error("enqueue on stopped executor");
+    bool isWorkerThread() const { return t_executor == this; }
 
-            tasks.emplace([task](JobThreadData* thread_data) { (*task)(thread_data); });
+    ~JobExecutor()
+    {
+        {
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            stop = true;
         }
-        condition.notify_one();
-        return res;
+        condition.notify_all();
+        for (auto& worker : workers)
+            worker->thread.join();
     }
 
-    template <class F, class... Args>
-    void enqueue_v(F&& f, Args&&... args)
+private:
+    void push(Task task)
     {
-        auto task = std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...);
+        // don't allow enqueueing after stopping the pool
+        if (stop.load(std::memory_order_relaxed))
+            throw std::runtime_error("enqueue on stopped executor");
 
+        auto index = t_executor == this ? t_workerIndex
+                                         : static_cast<int>(next_worker.fetch_add(1, std::memory_order_relaxed) %
+                                                            workers.size());
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-
-            // don't allow enqueueing after stopping the pool
-            if (stop)
-                throw std::runtime_error("enqueue on stopped executor");
-
-            tasks.emplace(std::move(task));
+            auto& worker = *workers[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.tasks.emplace_back(std::move(task));
         }
+        pending.fetch_add(1);
+
+        // lock the sleep mutex briefly so the wakeup can't slip between a worker's predicate check and its wait
+        { std::lock_guard<std::mutex> lock(sleep_mutex); }
         condition.notify_one();
     }
-    ~JobExecutor()
+
+    bool pop(int index, Task& task)
     {
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            stop = true;
+            auto& own = *workers[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                pending.fetch_sub(1);
+                return true;
+            }
         }
-        condition.notify_all();
-        for (std::thread& worker : workers)
-            worker.join();
-    }
 
-private:
-    // need to keep track of threads so we can join them
-    std::vector<std::thread> workers;
+        const auto count = static_cast<int>(workers.size());
+        for (int i = 1; i < count; ++i)
+        {
+            auto& victim = *workers[(index + i) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
 
-    // the task queue
-    std::queue<std::function<void(JobThreadData*)>> tasks;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<unsigned int> next_worker{0};
+    std::atomic<int> pending{0};
 
     // synchronization
-    std::mutex queue_mutex;
+    std::mutex sleep_mutex;
     std::condition_variable condition;
-    bool stop;
+    std::atomic<bool> stop;
+
+    static thread_local JobExecutor* t_executor;
+    static thread_local int t_workerIndex;
+    static thread_local JobThreadData* t_threadData;
 };
 
+thread_local JobExecutor* JobExecutor::t_executor      = nullptr;
+thread_local int JobExecutor::t_workerIndex            = 0;
+thread_local JobThreadData* JobExecutor::t_threadData = nullptr;
+
 #pragma endregion
 
 #pragma region JobSystem
@@ -185,6 +251,7 @@ void JobSystem::init(const std::span<std::shared_ptr<JobThreadData>>& tdds)
     _mainThreadData = new MainThreadData();
     if (!tdds.empty())
         _executor = new JobExecutor(tdds);
+    _threadCount = static_cast<int>(tdds.size());
 }
 
 JobSystem::~JobSystem()
@@ -242,6 +309,127 @@ void JobSystem::enqueue(std::function<void()> task, std::function<void()> done)
         taskw(_mainThreadData);
 }
 
+JobHandle JobSystem::schedule(std::function<void()> task, std::span<const JobHandle> deps)
+{
+    auto node   = std::make_shared<JobNode>();
+    node->_task = std::move(task);
+    link(node, deps);
+    return node;
+}
+
+JobHandle JobSystem::then(const JobHandle& dep, std::function<void()> task)
+{
+    return schedule(std::move(task), std::span<const JobHandle>{&dep, 1});
+}
+
+JobHandle JobSystem::thenOnAxmolThread(const JobHandle& dep, std::function<void()> task)
+{
+    auto node               = std::make_shared<JobNode>();
+    node->_task             = std::move(task);
+    node->_runOnAxmolThread = true;
+    link(node, std::span<const JobHandle>{&dep, 1});
+    return node;
+}
+
+JobHandle JobSystem::when_all(std::span<const JobHandle> deps)
+{
+    return schedule(nullptr, deps);
+}
+
+JobHandle JobSystem::parallel_for(size_t count, size_t grain, std::function<void(size_t, size_t)> func)
+{
+    if (grain == 0)
+        grain = 1;
+
+    std::vector<JobHandle> chunks;
+    chunks.reserve((count + grain - 1) / grain);
+    auto shared = std::make_shared<std::function<void(size_t, size_t)>>(std::move(func));
+    for (size_t first = 0; first < count; first += grain)
+    {
+        auto last = (std::min)(first + grain, count);
+        chunks.emplace_back(schedule([shared, first, last] { (*shared)(first, last); }));
+    }
+    return when_all(chunks);
+}
+
+void JobSystem::wait(const JobHandle& handle)
+{
+    if (!handle)
+        return;
+
+    if (_executor && _executor->isWorkerThread())
+    {
+        // help the pool instead of blocking a worker which may be needed by the job we wait for
+        while (!handle->isDone())
+        {
+            if (!_executor->runPending())
+                std::this_thread::yield();
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(handle->_mutex);
+    handle->_condition.wait(lock, [&handle] { return handle->isDone(); });
+}
+
+void JobSystem::link(const JobHandle& node, std::span<const JobHandle> deps)
+{
+    for (auto& dep : deps)
+    {
+        if (!dep)
+            continue;
+        std::lock_guard<std::mutex> lock(dep->_mutex);
+        if (!dep->isDone())
+        {
+            node->_pendingDeps.fetch_add(1, std::memory_order_relaxed);
+            dep->_successors.emplace_back(node);
+        }
+    }
+    release(node);
+}
+
+void JobSystem::release(const JobHandle& node)
+{
+    if (node->_pendingDeps.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        dispatch(node);
+}
+
+void JobSystem::dispatch(const JobHandle& node)
+{
+    if (!node->_task)
+    {
+        complete(node);
+        return;
+    }
+
+    auto run = [this, node] {
+        node->_task();
+        node->_task = nullptr;
+        complete(node);
+    };
+
+    if (node->_runOnAxmolThread)
+        Director::getInstance()->getScheduler()->runOnAxmolThread(std::move(run));
+    else if (_executor)
+        _executor->enqueue_v([run = std::move(run)](JobThreadData*) { run(); });
+    else
+        run();
+}
+
+void JobSystem::complete(const JobHandle& node)
+{
+    std::vector<JobHandle> successors;
+    {
+        std::lock_guard<std::mutex> lock(node->_mutex);
+        node->_done.store(true, std::memory_order_release);
+        successors.swap(node->_successors);
+    }
+    node->_condition.notify_all();
+
+    for (auto& successor : successors)
+        release(successor);
+}
+
 #pragma endregion
 
 }  // namespace ax
@@ -39,6 +39,10 @@ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
 #include <memory>
 #include <string>
 #include <span>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 #include "base/Config.h"
 #include "platform/PlatformDefine.h"
 
@@ -89,6 +93,42 @@ protected:
     JobThreadData* _threadData{nullptr};
 };
 
+class JobNode;
+
+/**
+ * A handle to a job scheduled on the JobSystem, used to express dependencies between jobs.
+ * An empty handle is treated as already completed.
+ */
+using JobHandle = std::shared_ptr<JobNode>;
+
+class AX_API JobNode
+{
+    friend class JobSystem;
+
+public:
+    JobNode() = default;
+
+    /** Whether the job and every job it depended on have finished. */
+    bool isDone() const { return _done.load(std::memory_order_acquire); }
+
+private:
+    std::function<void()> _task;
+    std::atomic<int> _pendingDeps{1};  // starts at 1, released once all dependencies are linked
+    std::atomic<bool> _done{false};
+    bool _runOnAxmolThread{false};
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<JobHandle> _successors;
+};
+
+/**
+ * The shared worker pool of the engine.
+ *
+ * Jobs must be cpu bound: the axmol thread waits on the workers (e.g. parallel_for), and without worker threads
+ * (emscripten) jobs run synchronously on the axmol thread. Blocking IO and network work goes to the TASK_IO and
+ * TASK_NETWORK queues of AsyncTaskPool instead, which own their threads.
+ */
 class AX_API JobSystem
 {
 public:
@@ -102,12 +142,52 @@ public:
     void enqueue(std::function<void()> task, std::function<void()> done);
     void enqueue(std::shared_ptr<JobThreadTask> task);
 
+    /**
+     * Schedules a job which runs on a worker once all of deps have completed.
+     * The returned handle can be used as a dependency of further jobs.
+     */
+    JobHandle schedule(std::function<void()> task, std::span<const JobHandle> deps = {});
+
+    /** Schedules a continuation which runs on a worker after dep completed. */
+    JobHandle then(const JobHandle& dep, std::function<void()> task);
+
+    /**
+     * Schedules a continuation which runs on the axmol thread after dep completed, it's
+     * posted through Scheduler::runOnAxmolThread and executed on the next Scheduler::update.
+     */
+    JobHandle thenOnAxmolThread(const JobHandle& dep, std::function<void()> task);
+
+    /** Returns a handle which completes when all of deps have completed. */
+    JobHandle when_all(std::span<const JobHandle> deps);
+
+    /**
+     * Splits [0, count) into chunks of at most grain items and runs func(first, last) for each
+     * chunk in parallel. The returned handle completes when every chunk has completed.
+     */
+    JobHandle parallel_for(size_t count, size_t grain, std::function<void(size_t first, size_t last)> func);
+
+    /**
+     * Blocks until the job completed. When called from a worker thread, pending jobs are executed
+     * while waiting so nested waits can't starve the pool.
+     * Never wait on a job depending on a thenOnAxmolThread continuation from the axmol thread.
+     */
+    void wait(const JobHandle& handle);
+
+    /** Gets the number of worker threads, 0 means tasks run on the calling thread. */
+    int getThreadCount() const { return _threadCount; }
+
  protected:
     void init(const std::span<std::shared_ptr<JobThreadData>>& tdds);
 
+    void link(const JobHandle& node, std::span<const JobHandle> deps);
+    void release(const JobHandle& node);
+    void dispatch(const JobHandle& node);
+    void complete(const JobHandle& node);
+
 private:
     JobExecutor* _executor{nullptr};
     JobThreadData* _mainThreadData{nullptr};
+    int _threadCount{0};
 };
 
 }
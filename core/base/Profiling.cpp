@@ -26,144 +26,199 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "base/Profiling.h"
+#include "base/JsonWriter.h"
+#include "platform/FileUtils.h"
 
-using namespace std;
+#include <chrono>
+#include <algorithm>
+#include "fmt/format.h"
 
 namespace ax
 {
 
-// Profiling Categories
-/* set to false the categories that you don't want to profile */
-bool kProfilerCategorySprite      = false;
-bool kProfilerCategoryBatchSprite = false;
-bool kProfilerCategoryParticles   = false;
+static thread_local std::string t_threadName;
 
-static Profiler* g_sSharedProfiler = nullptr;
+std::atomic<bool> Profiler::_recording{false};
+
+Profiler::ThreadBuffer::ThreadBuffer(uint32_t id_, size_t capacity)
+    : events(new Event[capacity]), mask(capacity - 1), id(id_)
+{}
 
 Profiler* Profiler::getInstance()
 {
-    if (!g_sSharedProfiler)
-    {
-        g_sSharedProfiler = new Profiler();
-        g_sSharedProfiler->init();
-    }
-
-    return g_sSharedProfiler;
+    // never deleted: worker threads may still record while the process exits
+    static Profiler* s_sharedProfiler = new Profiler();
+    return s_sharedProfiler;
 }
 
-ProfilingTimer* Profiler::createAndAddTimerWithName(const char* timerName)
+int64_t Profiler::now()
 {
-    ProfilingTimer* t = new ProfilingTimer();
-    t->initWithName(timerName);
-    _activeTimers.insert(timerName, t);
-    t->release();
-
-    return t;
+    static const auto s_origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_origin).count();
 }
 
-void Profiler::releaseTimer(const char* timerName)
+void Profiler::start()
 {
-    _activeTimers.erase(timerName);
-}
+    now();  // pins the clock origin before the first event
 
-void Profiler::releaseAllTimers()
-{
-    _activeTimers.clear();
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto& buffer : _buffers)
+        buffer->base.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+    _recording.store(true, std::memory_order_release);
 }
 
-bool Profiler::init()
+void Profiler::stop()
 {
-    return true;
+    _recording.store(false, std::memory_order_release);
 }
 
-Profiler::~Profiler() {}
-
-void Profiler::displayTimers()
+Profiler::ThreadBuffer* Profiler::getThreadBuffer(bool create)
 {
-    for (auto&& iter : _activeTimers)
+    // buffers are owned by the profiler, a thread which exits leaves its events for the export
+    static thread_local ThreadBuffer* t_buffer = nullptr;
+    if (!t_buffer && create)
     {
-        ProfilingTimer* timer = iter.second;
-        AXLOGI("{}", timer->getDescription());
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        auto id      = static_cast<uint32_t>(_buffers.size() + 1);
+        auto buffer  = std::make_unique<ThreadBuffer>(id, _threadCapacity);
+        buffer->name = t_threadName.empty() ? fmt::format("Thread {}", id) : t_threadName;
+        t_buffer = buffer.get();
+        _buffers.emplace_back(std::move(buffer));
     }
+    return t_buffer;
 }
 
-// implementation of ProfilingTimer
-
-ProfilingTimer::ProfilingTimer()
-    : _averageTime1(0), _averageTime2(0), minTime(100000000), maxTime(0), totalTime(0), numberOfCalls(0)
-{}
-
-bool ProfilingTimer::initWithName(const char* timerName)
+void Profiler::push(const Event& event)
 {
-    _nameStr = timerName;
-    return true;
+    auto buffer = getThreadBuffer(true);
+    auto head   = buffer->head.load(std::memory_order_relaxed);
+    buffer->events[head & buffer->mask] = event;
+    buffer->head.store(head + 1, std::memory_order_release);
 }
 
-ProfilingTimer::~ProfilingTimer() {}
-
-std::string ProfilingTimer::getDescription() const
+void Profiler::recordZone(const char* name, int64_t start, int64_t end)
 {
-    static char s_description[512] = {0};
-
-    snprintf(s_description, sizeof(s_description), "%s ::\tavg1: %u,\tavg2: %u,\tmin: %u,\tmax: %u,\ttotal: %.2fs,\tnr calls: %d",
-            _nameStr.c_str(), _averageTime1, _averageTime2, minTime, maxTime, totalTime / 1000000., numberOfCalls);
-    return s_description;
+    push(Event{name, start, end, EventType::Zone});
 }
 
-void ProfilingTimer::reset()
+void Profiler::recordCounter(const char* name, int64_t value)
 {
-    numberOfCalls = 0;
-    _averageTime1 = 0;
-    _averageTime2 = 0;
-    totalTime     = 0;
-    minTime       = 100000000;
-    maxTime       = 0;
-    _startTime    = chrono::high_resolution_clock::now();
+    push(Event{name, now(), value, EventType::Counter});
 }
 
-void ProfilingBeginTimingBlock(const char* timerName)
+void Profiler::setThreadName(std::string_view name)
 {
-    Profiler* p           = Profiler::getInstance();
-    ProfilingTimer* timer = p->_activeTimers.at(timerName);
-    if (!timer)
+    t_threadName = name;
+    if (auto buffer = getThreadBuffer(false))
     {
-        timer = p->createAndAddTimerWithName(timerName);
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        buffer->name = t_threadName;
     }
-
-    timer->numberOfCalls++;
-
-    // should be the last instruction in order to be more reliable
-    timer->_startTime = chrono::high_resolution_clock::now();
 }
 
-void ProfilingEndTimingBlock(const char* timerName)
+void Profiler::setThreadBufferCapacity(size_t capacity)
 {
-    // should be the 1st instruction in order to be more reliable
-    auto now = chrono::high_resolution_clock::now();
-
-    Profiler* p           = Profiler::getInstance();
-    ProfilingTimer* timer = p->_activeTimers.at(timerName);
+    size_t roundedCapacity = 1;
+    while (roundedCapacity < capacity)
+        roundedCapacity <<= 1;
 
-    AXASSERT(timer, "CCProfilingTimer  not found");
-
-    int32_t duration =
-        static_cast<int32_t>(chrono::duration_cast<chrono::microseconds>(now - timer->_startTime).count());
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    _threadCapacity = roundedCapacity;
+}
 
-    timer->totalTime += duration;
-    timer->_averageTime1 = (timer->_averageTime1 + duration) / 2.0f;
-    timer->_averageTime2 = timer->totalTime / timer->numberOfCalls;
-    timer->maxTime       = MAX(timer->maxTime, duration);
-    timer->minTime       = MIN(timer->minTime, duration);
+size_t Profiler::getEventCount() const
+{
+    size_t count = 0;
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto& buffer : _buffers)
+    {
+        auto recorded = buffer->head.load(std::memory_order_acquire) - buffer->base.load(std::memory_order_acquire);
+        count += static_cast<size_t>((std::min)(recorded, static_cast<uint64_t>(buffer->mask + 1)));
+    }
+    return count;
 }
 
-void ProfilingResetTimingBlock(const char* timerName)
+size_t Profiler::getDroppedEventCount() const
 {
-    Profiler* p           = Profiler::getInstance();
-    ProfilingTimer* timer = p->_activeTimers.at(timerName);
+    size_t count = 0;
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto& buffer : _buffers)
+    {
+        auto recorded = buffer->head.load(std::memory_order_acquire) - buffer->base.load(std::memory_order_acquire);
+        if (recorded > buffer->mask + 1)
+            count += static_cast<size_t>(recorded - (buffer->mask + 1));
+    }
+    return count;
+}
 
-    AXASSERT(timer, "CCProfilingTimer not found");
+std::string Profiler::toChromeTrace() const
+{
+    JsonWriter<false> writer;
+    writer.writeStartObject();
+    writer.writeString("displayTimeUnit", "ns");
+    writer.writeStartArray("traceEvents");
+
+    std::vector<Event> events;
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto& buffer : _buffers)
+    {
+        const auto tid      = static_cast<int>(buffer->id);
+        const auto capacity = static_cast<uint64_t>(buffer->mask + 1);
+
+        writer.writeStartObject();
+        writer.writeString("name", "thread_name");
+        writer.writeString("ph", "M");
+        writer.writeNumber("pid", 1);
+        writer.writeNumber("tid", tid);
+        writer.writeStartObject("args");
+        writer.writeString("name", buffer->name);
+        writer.writeEndObject();
+        writer.writeEndObject();
+
+        // copy first, the owner thread keeps writing while we format
+        auto head  = buffer->head.load(std::memory_order_acquire);
+        auto first = (std::max)(buffer->base.load(std::memory_order_acquire), head > capacity ? head - capacity : 0);
+        events.clear();
+        for (auto index = first; index < head; ++index)
+            events.push_back(buffer->events[index & buffer->mask]);
+
+        // slots the writer may have wrapped onto during the copy are unreliable
+        auto newHead = buffer->head.load(std::memory_order_acquire);
+        if (newHead > first + capacity)
+            events.erase(events.begin(), events.begin() + (std::min)(events.size(), size_t(newHead - first - capacity)));
+
+        for (auto& event : events)
+        {
+            writer.writeStartObject();
+            writer.writeString("name", event.name);
+            writer.writeNumber("pid", 1);
+            writer.writeNumber("tid", tid);
+            writer.writeNumber("ts", event.start / 1000.0);
+            if (event.type == EventType::Zone)
+            {
+                writer.writeString("cat", "axmol");
+                writer.writeString("ph", "X");
+                writer.writeNumber("dur", (event.value - event.start) / 1000.0);
+            }
+            else
+            {
+                writer.writeString("ph", "C");
+                writer.writeStartObject("args");
+                writer.writeNumber("value", static_cast<long long>(event.value));
+                writer.writeEndObject();
+            }
+            writer.writeEndObject();
+        }
+    }
 
-    timer->reset();
+    writer.writeEndArray();
+    writer.writeEndObject();
+    return std::string{static_cast<std::string_view>(writer)};
 }
 
+bool Profiler::saveChromeTrace(std::string_view path) const
+{
+    return FileUtils::getInstance()->writeStringToFile(toChromeTrace(), path);
 }
+
+}  // namespace ax
@@ -25,16 +25,17 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
+#pragma once
 
-#ifndef __SUPPORT_CCPROFILING_H__
-#define __SUPPORT_CCPROFILING_H__
-/// @cond DO_NOT_SHOW
-
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <chrono>
+#include <string_view>
+#include <vector>
+#include "platform/PlatformMacros.h"
 #include "base/Config.h"
-#include "base/Object.h"
-#include "base/Map.h"
 
 namespace ax
 {
@@ -44,121 +45,156 @@ namespace ax
  * @{
  */
 
-class ProfilingTimer;
-
-/** Profiler
- cocos2d builtin profiler.
-
- To use it, enable set the AX_ENABLE_PROFILERS=1 in the ccConfig.h file
+/**
+ * Scoped-zone profiler.
+ *
+ * Zones and counters are appended to a lock-free ring buffer owned by the recording thread, so
+ * instrumented code never takes a lock once its thread has recorded its first event. Timestamps are
+ * nanoseconds of a monotonic clock; zones are stored as complete events, nested zones on one thread
+ * show up as a call stack when the recording is opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Recording is off by default and is toggled at runtime with start()/stop() or the `profiler`
+ * console command, the instrumentation costs one relaxed atomic load while it is off.
+ * Define AX_ENABLE_PROFILERS to 0 to compile it out entirely.
+ *
+ * Zone and counter names are not copied, they must point to strings with static storage duration.
+ * @since axmol-2.2
  */
-
 class AX_DLL Profiler
 {
 public:
-    /**
-     * @js NA
-     * @lua NA
-     */
-    ~Profiler();
-    /** display the timers
-     * @js NA
-     * @lua NA
-     */
-    void displayTimers();
-    /**
-     * @js NA
-     * @lua NA
-     */
-    bool init();
+    /** Default number of events kept per thread, older events are overwritten. */
+    static constexpr size_t DEFAULT_THREAD_CAPACITY = 16384;
 
-public:
-    /** returns the singleton
-     * @js NA
-     * @lua NA
-     */
     static Profiler* getInstance();
 
-    /** Creates and adds a new timer
-     * @js NA
-     * @lua NA
-     */
-    ProfilingTimer* createAndAddTimerWithName(const char* timerName);
-    /** releases a timer
-     * @js NA
-     * @lua NA
-     */
-    void releaseTimer(const char* timerName);
-    /** releases all timers
-     * @js NA
-     * @lua NA
-     */
-    void releaseAllTimers();
+    /** Nanoseconds elapsed since the profiler clock origin. */
+    static int64_t now();
 
-    Map<std::string, ProfilingTimer*> _activeTimers;
-};
+    static bool isRecording() { return _recording.load(std::memory_order_relaxed); }
+
+    /** Starts recording, events recorded before are discarded. */
+    void start();
+    void stop();
+
+    /** Records a zone which started and ended at the given now() timestamps. */
+    void recordZone(const char* name, int64_t start, int64_t end);
+
+    /** Records a sample of a counter. */
+    void recordCounter(const char* name, int64_t value);
 
-class ProfilingTimer : public Object
-{
-public:
-    /**
-     * @js NA
-     * @lua NA
-     */
-    ProfilingTimer();
-    /**
-     * @js NA
-     * @lua NA
-     */
-    ~ProfilingTimer();
-    /**
-     * @js NA
-     * @lua NA
-     */
-    bool initWithName(const char* timerName);
     /**
-     * @js NA
-     * @lua NA
+     * Names the calling thread in the exported trace.
+     * Threads which never named themselves are exported as "Thread <id>".
      */
-    virtual std::string getDescription() const;
+    void setThreadName(std::string_view name);
+
     /**
-     * @js NA
-     * @lua NA
+     * Sets how many events the ring buffer of a thread keeps, rounded up to a power of 2.
+     * Only affects the threads which record their first event afterwards.
      */
-    const std::chrono::high_resolution_clock::time_point& getStartTime() { return _startTime; }
+    void setThreadBufferCapacity(size_t capacity);
+    size_t getThreadBufferCapacity() const { return _threadCapacity; }
 
-    /** resets the timer properties
-     * @js NA
-     * @lua NA
-     */
-    void reset();
-
-    std::string _nameStr;
-    std::chrono::high_resolution_clock::time_point _startTime;
-    int32_t _averageTime1;
-    int32_t _averageTime2;
-    int32_t minTime;
-    int32_t maxTime;
-    int32_t totalTime;
-    int32_t numberOfCalls;
-};
+    /** Number of events recorded since start() and still held by the ring buffers. */
+    size_t getEventCount() const;
 
-extern void AX_DLL ProfilingBeginTimingBlock(const char* timerName);
-extern void AX_DLL ProfilingEndTimingBlock(const char* timerName);
-extern void AX_DLL ProfilingResetTimingBlock(const char* timerName);
+    /** Number of events recorded since start() which were overwritten by newer ones. */
+    size_t getDroppedEventCount() const;
 
-/*
- * cocos2d profiling categories
- * used to enable / disable profilers with granularity
- */
+    /**
+     * Exports the recording in the Chrome trace event format (JSON object format).
+     * It can be called while recording, events overwritten during the export are skipped.
+     */
+    std::string toChromeTrace() const;
+
+    /** Writes toChromeTrace() to a file, returns false if it can't be written. */
+    bool saveChromeTrace(std::string_view path) const;
+
+private:
+    enum class EventType : uint8_t
+    {
+        Zone,
+        Counter,
+    };
+
+    struct Event
+    {
+        const char* name;
+        int64_t start;
+        int64_t value;  // end timestamp of a zone, sample of a counter
+        EventType type;
+    };
+
+    struct ThreadBuffer
+    {
+        ThreadBuffer(uint32_t id, size_t capacity);
+
+        std::unique_ptr<Event[]> events;
+        size_t mask;
+        std::atomic<uint64_t> head{0};  // written by the owner thread only
+        std::atomic<uint64_t> base{0};  // head when the recording started
+        uint32_t id;
+        std::string name;  // guarded by _buffersMutex
+    };
+
+    Profiler() = default;
+
+    /** Returns the ring buffer of the calling thread, creates it on the first call when create is true. */
+    ThreadBuffer* getThreadBuffer(bool create);
+    void push(const Event& event);
+
+    static std::atomic<bool> _recording;
+
+    mutable std::mutex _buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+    size_t _threadCapacity = DEFAULT_THREAD_CAPACITY;
+};
 
-extern bool kProfilerCategorySprite;
-extern bool kProfilerCategoryBatchSprite;
-extern bool kProfilerCategoryParticles;
+/** Records the lifetime of a scope as a zone when the profiler was recording at construction. */
+class ProfilerZone
+{
+public:
+    explicit ProfilerZone(const char* name) : _name(name), _start(Profiler::isRecording() ? Profiler::now() : -1) {}
+    ~ProfilerZone()
+    {
+        if (_start >= 0)
+            Profiler::getInstance()->recordZone(_name, _start, Profiler::now());
+    }
+
+    ProfilerZone(const ProfilerZone&)            = delete;
+    ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+private:
+    const char* _name;
+    int64_t _start;
+};
 
 // end of global group
 /// @}
 
-}
-
-/// @endcond
-#endif  // __SUPPORT_CCPROFILING_H__
+}  // namespace ax
+
+#define AX_PROFILE_CONCAT_(a, b) a##b
+#define AX_PROFILE_CONCAT(a, b)  AX_PROFILE_CONCAT_(a, b)
+
+#if AX_ENABLE_PROFILERS
+/** Profiles the enclosing scope, name must be a string literal. */
+#    define AX_PROFILE_ZONE(name) ax::ProfilerZone AX_PROFILE_CONCAT(__axProfilerZone, __LINE__)(name)
+/** Records a counter sample while the profiler is recording, name must be a string literal. */
+#    define AX_PROFILE_COUNTER(name, value)                                  \
+        do                                                                   \
+        {                                                                    \
+            if (ax::Profiler::isRecording())                                 \
+                ax::Profiler::getInstance()->recordCounter(name, (value)); \
+        } while (0)
+#else
+#    define AX_PROFILE_ZONE(name) \
+        do                        \
+        {                         \
+        } while (0)
+#    define AX_PROFILE_COUNTER(name, value) \
+        do                                  \
+        {                                   \
+        } while (0)
+#endif
@@ -31,10 +31,22 @@ THE SOFTWARE.
 #include "base/Macros.h"
 #include "base/Director.h"
 #include "base/ScriptSupport.h"
+#include "base/Profiling.h"
 
 namespace ax
 {
 
+namespace
+{
+// 4 levels of 64 slots with 1/128s ticks cover about 36 hours, later timers are parked in the last level
+constexpr int TIMER_WHEEL_BITS      = 6;
+constexpr int TIMER_WHEEL_SLOTS     = 1 << TIMER_WHEEL_BITS;
+constexpr uint64_t TIMER_WHEEL_MASK = TIMER_WHEEL_SLOTS - 1;
+constexpr int TIMER_WHEEL_LEVELS    = 4;
+constexpr uint64_t TIMER_WHEEL_SPAN = uint64_t{1} << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS);
+constexpr double TIMER_WHEEL_TICK   = 1.0 / 128;
+}  // namespace
+
 // implementation Timer
 
 Timer::Timer()
@@ -47,6 +59,10 @@ Timer::Timer()
     , _delay(0.0f)
     , _interval(0.0f)
     , _aborted(false)
+    , _syncTime(0.0)
+    , _dueTime(0.0)
+    , _wheelSlot(WHEEL_DISARMED)
+    , _wheelIndex(0)
 {}
 
 void Timer::setupTimerWithInterval(float seconds, unsigned int repeat, float delay)
@@ -218,15 +234,17 @@ const int Scheduler::PRIORITY_NON_SYSTEM_MIN = PRIORITY_SYSTEM + 1;
 
 Scheduler::Scheduler()
     : _timeScale(1.0f)
-    , _currentTarget(nullptr)
-    , _currentTargetSalvaged(false)
     , _indexMapLocked(false)
+    , _timerWheel(TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS)
+    , _wheelTick(0)
+    , _timerClock(0.0)
 #if AX_ENABLE_SCRIPT_BINDING
     , _scriptHandlerEntries(20)
 #endif
 {
     // I don't expect to have more than 30 functions to all per frame
     _actionsToPerform.reserve(30);
+    _actionsPerforming.reserve(30);
 }
 
 Scheduler::~Scheduler()
@@ -260,14 +278,16 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
         timerIt = _timersMap.emplace(target, TimerHandle{}).first;
 
         // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        timerIt->second.paused = paused;
+        timerIt->second.paused     = paused;
+        timerIt->second.pausedTime = _timerClock;
     }
     else
     {
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused!");
     }
 
-    auto& timers = timerIt->second.timers;
+    auto& timerHandle = timerIt->second;
+    auto& timers      = timerHandle.timers;
     if (timers.empty())
     {
         timers.reserve(10);
@@ -283,13 +303,15 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4f}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
             (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            if (!timerHandle.paused)
+                armTimer(*timerIt);
             return;
         }
     }
 
     TimerTargetCallback* timer = new TimerTargetCallback();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
-    timers.pushBack(timer);
+    addTimer(timerHandle, timer);
     timer->release();
 }
 
@@ -311,30 +333,12 @@ void Scheduler::unschedule(std::string_view key, void* target)
 
             if (timer && key == timer->getKey())
             {
-                if (timer == timerHandle.currentTimer && (!timer->isAborted()))
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
+                removeTimer(timer);
                 timerHandle.timers.erase(i);
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
                 if (timerHandle.timers.empty())
                 {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
+                    _timersMap.erase(timerIt);
                 }
 
                 return;
@@ -563,22 +567,12 @@ void Scheduler::unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::i
 {
     auto const target = timerIt->first;
     auto& timerHandle = timerIt->second;
-    if (timerHandle.timers.contains(timerHandle.currentTimer) && (!timerHandle.currentTimer->isAborted()))
+    for (auto timer : timerHandle.timers)
     {
-        timerHandle.currentTimer->retain();
-        timerHandle.currentTimer->setAborted();
+        removeTimer(timer);
     }
-    timerHandle.timers.clear();
 
-    if (_currentTarget == &timerHandle)
-    {
-        _currentTargetSalvaged = true;
-        ++timerIt;
-    }
-    else
-    {
-        timerIt = _timersMap.erase(timerIt);
-    }
+    timerIt = _timersMap.erase(timerIt);
 
     unscheduleUpdate(target);
 }
@@ -612,9 +606,10 @@ void Scheduler::resumeTarget(void* target)
 
     // custom selectors
     auto timerIt = _timersMap.find(target);
-    if (timerIt != _timersMap.end())
+    if (timerIt != _timersMap.end() && timerIt->second.paused)
     {
         timerIt->second.paused = false;
+        resumeTimers(timerIt->second);
     }
 
     // update selector
@@ -631,9 +626,10 @@ void Scheduler::pauseTarget(void* target)
 
     // custom selectors
     auto timerIt = _timersMap.find(target);
-    if (timerIt != _timersMap.end())
+    if (timerIt != _timersMap.end() && !timerIt->second.paused)
     {
         timerIt->second.paused = true;
+        pauseTimers(timerIt->second);
     }
 
     // update selector
@@ -677,7 +673,11 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     // Custom Selectors
     for (auto& [target, timerHandle] : _timersMap)
     {
-        timerHandle.paused = true;
+        if (!timerHandle.paused)
+        {
+            timerHandle.paused = true;
+            pauseTimers(timerHandle);
+        }
         idsWithSelectors.insert(target);
     }
 
@@ -723,21 +723,230 @@ void Scheduler::resumeTargets(const std::set<void*>& targetsToResume)
     }
 }
 
+// timer wheel
+
+void Scheduler::addTimer(TimerHandle& timerHandle, Timer* timer)
+{
+    timerHandle.timers.pushBack(timer);
+    if (!timerHandle.paused)
+        armTimer(timer);
+}
+
+void Scheduler::removeTimer(Timer* timer)
+{
+    // the timer may be unscheduled from its own callback, the flag stops Timer::update from triggering again
+    timer->setAborted();
+    disarmTimer(timer);
+}
+
+void Scheduler::linkTimer(axstd::pod_vector<Timer*>& list, Timer* timer, int slot)
+{
+    timer->_wheelSlot  = slot;
+    timer->_wheelIndex = static_cast<unsigned int>(list.size());
+    list.push_back(timer);
+}
+
+void Scheduler::unlinkTimer(axstd::pod_vector<Timer*>& list, unsigned int index)
+{
+    auto last = list.back();
+    list.pop_back();
+    if (index < list.size())
+    {
+        list[index]       = last;
+        last->_wheelIndex = index;
+    }
+}
+
+void Scheduler::armTimer(Timer* timer)
+{
+    disarmTimer(timer);
+
+    if (timer->_elapsed == -1 || (!timer->_useDelay && timer->_interval <= 0))
+    {
+        // first update after scheduling, or triggered every frame
+        timer->_dueTime = _timerClock;
+        linkTimer(_timersPending, timer, Timer::WHEEL_PENDING);
+        return;
+    }
+
+    const float remaining = (timer->_useDelay ? timer->_delay : timer->_interval) - timer->_elapsed;
+    timer->_dueTime       = timer->_syncTime + remaining;
+
+    const auto dueTick = timer->_dueTime > _timerClock ? static_cast<uint64_t>(timer->_dueTime / TIMER_WHEEL_TICK) : 0;
+    if (dueTick < _wheelTick)
+        linkTimer(_timersPending, timer, Timer::WHEEL_PENDING);
+    else
+        wheelInsert(timer, dueTick);
+}
+
+void Scheduler::disarmTimer(Timer* timer)
+{
+    switch (timer->_wheelSlot)
+    {
+    case Timer::WHEEL_DISARMED:
+        break;
+    case Timer::WHEEL_FIRING:
+        // still referenced by _timersFiring, which skips disarmed timers
+        timer->_wheelSlot = Timer::WHEEL_DISARMED;
+        break;
+    case Timer::WHEEL_PENDING:
+        unlinkTimer(_timersPending, timer->_wheelIndex);
+        timer->_wheelSlot = Timer::WHEEL_DISARMED;
+        break;
+    default:
+        unlinkTimer(_timerWheel[timer->_wheelSlot], timer->_wheelIndex);
+        timer->_wheelSlot = Timer::WHEEL_DISARMED;
+        break;
+    }
+}
+
+void Scheduler::wheelInsert(Timer* timer, uint64_t dueTick)
+{
+    const auto delta = dueTick - _wheelTick;
+
+    int level = 0;
+    if (delta >= TIMER_WHEEL_SPAN)
+    {
+        // beyond the wheel, park in the farthest slot, the cascade inserts it again
+        dueTick = _wheelTick + TIMER_WHEEL_SPAN - 1;
+        level   = TIMER_WHEEL_LEVELS - 1;
+    }
+    else
+    {
+        while (delta >> (TIMER_WHEEL_BITS * (level + 1)))
+            ++level;
+    }
+
+    const int slot = level * TIMER_WHEEL_SLOTS + static_cast<int>((dueTick >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK);
+    linkTimer(_timerWheel[slot], timer, slot);
+}
+
+void Scheduler::wheelCascade(int level)
+{
+    auto& bucket =
+        _timerWheel[level * TIMER_WHEEL_SLOTS + ((_wheelTick >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK)];
+
+    // no entry lands back in the bucket being cascaded, so it is stable while iterating
+    for (auto timer : bucket)
+    {
+        const auto dueTick = static_cast<uint64_t>(timer->_dueTime / TIMER_WHEEL_TICK);
+        wheelInsert(timer, (std::max)(dueTick, _wheelTick));
+    }
+    bucket.clear();
+}
+
+void Scheduler::pauseTimers(TimerHandle& timerHandle)
+{
+    timerHandle.pausedTime = _timerClock;
+    for (auto timer : timerHandle.timers)
+    {
+        disarmTimer(timer);
+    }
+}
+
+void Scheduler::resumeTimers(TimerHandle& timerHandle)
+{
+    // the time spent paused doesn't count towards the timers
+    const auto pausedDuration = _timerClock - timerHandle.pausedTime;
+    for (auto timer : timerHandle.timers)
+    {
+        timer->_syncTime += pausedDuration;
+        armTimer(timer);
+    }
+}
+
+void Scheduler::updateTimers(float dt)
+{
+    _timerClock += dt;
+
+    // collect the timers of the elapsed ticks, the ones due later in the current tick wait in the pending list
+    const auto currentTick = static_cast<uint64_t>(_timerClock / TIMER_WHEEL_TICK);
+    for (; _wheelTick <= currentTick; ++_wheelTick)
+    {
+        if ((_wheelTick & TIMER_WHEEL_MASK) == 0)
+        {
+            for (int level = 1; level < TIMER_WHEEL_LEVELS; ++level)
+            {
+                wheelCascade(level);
+                if ((_wheelTick >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK)
+                    break;
+            }
+        }
+
+        auto& bucket = _timerWheel[_wheelTick & TIMER_WHEEL_MASK];
+        for (auto timer : bucket)
+        {
+            if (timer->_dueTime <= _timerClock)
+            {
+                timer->retain();
+                timer->_wheelSlot = Timer::WHEEL_FIRING;
+                _timersFiring.push_back(timer);
+            }
+            else
+                linkTimer(_timersPending, timer, Timer::WHEEL_PENDING);
+        }
+        bucket.clear();
+    }
+
+    for (unsigned int i = 0; i < _timersPending.size();)
+    {
+        auto timer = _timersPending[i];
+        if (timer->_dueTime <= _timerClock)
+        {
+            unlinkTimer(_timersPending, i);
+            timer->retain();
+            timer->_wheelSlot = Timer::WHEEL_FIRING;
+            _timersFiring.push_back(timer);
+        }
+        else
+            ++i;
+    }
+
+    // The callbacks may unschedule, pause or reschedule any timer, which takes it out of the firing state.
+    // _timersFiring holds a reference until the loop is over.
+    for (auto timer : _timersFiring)
+    {
+        if (timer->_wheelSlot != Timer::WHEEL_FIRING)
+            continue;
+
+        AXASSERT(!timer->isAborted(), "An aborted timer should not be updated");
+        timer->update(timer->_elapsed == -1 ? 0.0f : static_cast<float>(_timerClock - timer->_syncTime));
+        timer->_syncTime = _timerClock;
+
+        if (timer->_wheelSlot == Timer::WHEEL_FIRING)
+        {
+            timer->_wheelSlot = Timer::WHEEL_DISARMED;
+            if (!timer->isAborted() && !timer->isExhausted())
+                armTimer(timer);
+        }
+    }
+
+    for (auto timer : _timersFiring)
+    {
+        timer->release();
+    }
+    _timersFiring.clear();
+}
+
 void Scheduler::runOnAxmolThread(std::function<void()> action)
 {
     std::lock_guard<std::mutex> lock(_performMutex);
     _actionsToPerform.emplace_back(std::move(action));
+    _hasActionsToPerform.store(true, std::memory_order_release);
 }
 
 void Scheduler::removeAllPendingActions()
 {
-    std::unique_lock<std::mutex> lock(_performMutex);
+    std::lock_guard<std::mutex> lock(_performMutex);
     _actionsToPerform.clear();
+    _hasActionsToPerform.store(false, std::memory_order_relaxed);
 }
 
 // main loop
 void Scheduler::update(float dt)
 {
+    AX_PROFILE_ZONE("Scheduler::update");
+
     // active waitlist
     if (!_waitList.empty())
         activeWaitList();
@@ -781,43 +990,8 @@ void Scheduler::update(float dt)
         }
     }
 
-    // Iterate over all the custom selectors
-    for (auto it = _timersMap.begin(); it != _timersMap.end();)
-    {
-        auto elt               = &it->second;
-        _currentTarget         = elt;
-        _currentTargetSalvaged = false;
-
-        if (!_currentTarget->paused)
-        {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers.size(); ++(elt->timerIndex))
-            {
-                elt->currentTimer = elt->timers[elt->timerIndex];
-                AXASSERT(!elt->currentTimer->isAborted(), "An aborted timer should not be updated");
-
-                elt->currentTimer->update(dt);
-
-                if (elt->currentTimer->isAborted())
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
-
-                elt->currentTimer = nullptr;
-            }
-        }
-
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty())
-        {
-            it = _timersMap.erase(it);
-        }
-        else
-            ++it;
-    }
+    // Iterate over the custom selectors that came due
+    updateTimers(dt);
 
     // delete all updates that are removed in update
     for (auto&& sched : _updateDeleteVector)
@@ -829,7 +1003,6 @@ void Scheduler::update(float dt)
     _updateDeleteVector.clear();
 
     _indexMapLocked = false;
-    _currentTarget  = nullptr;
 
 #if AX_ENABLE_SCRIPT_BINDING
     //
@@ -857,20 +1030,24 @@ void Scheduler::update(float dt)
     // Functions allocated from another thread
     //
 
-    // Testing size is faster than locking / unlocking.
+    // Testing the flag is faster than locking.
     // And almost never there will be functions scheduled to be called.
-    if (!_actionsToPerform.empty())
+    if (_hasActionsToPerform.load(std::memory_order_acquire))
     {
-        _performMutex.lock();
         // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if
         // new functions are added in callback, it will cause thread deadlock.
-        auto temp = std::move(_actionsToPerform);
-        _performMutex.unlock();
+        {
+            std::lock_guard<std::mutex> lock(_performMutex);
+            _actionsPerforming.swap(_actionsToPerform);
+            _hasActionsToPerform.store(false, std::memory_order_relaxed);
+        }
 
-        for (const auto& function : temp)
+        for (auto& action : _actionsPerforming)
         {
+            auto function = std::move(action);
             function();
         }
+        _actionsPerforming.clear();
     }
 }
 
@@ -890,14 +1067,16 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
         timerIt = _timersMap.emplace(target, TimerHandle{}).first;
 
         // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        timerIt->second.paused = paused;
+        timerIt->second.paused     = paused;
+        timerIt->second.pausedTime = _timerClock;
     }
     else
     {
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused.");
     }
 
-    auto&& timers = timerIt->second.timers;
+    auto& timerHandle = timerIt->second;
+    auto&& timers     = timerHandle.timers;
     if (timers.empty())
     {
         timers.reserve(10);
@@ -913,13 +1092,15 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
             (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            if (!timerHandle.paused)
+                armTimer(*timerIt);
             return;
         }
     }
 
     TimerTargetSelector* timer = new TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
-    timers.pushBack(timer);
+    addTimer(timerHandle, timer);
     timer->release();
 }
 
@@ -968,30 +1149,12 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Object* target)
 
             if (timer && selector == timer->getSelector())
             {
-                if (timer == timerHandle.currentTimer && !timer->isAborted())
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
+                removeTimer(timer);
                 timers.erase(i);
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
                 if (timers.empty())
                 {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
+                    _timersMap.erase(timerIt);
                 }
 
                 return;
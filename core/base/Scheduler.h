@@ -29,6 +29,7 @@ THE SOFTWARE.
 #ifndef __CCSCHEDULER_H__
 #define __CCSCHEDULER_H__
 
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <set>
@@ -48,6 +49,8 @@ typedef std::function<void(float)> ccSchedulerFunc;
  */
 class AX_DLL Timer : public Object
 {
+    friend class Scheduler;
+
 protected:
     Timer();
 
@@ -64,6 +67,13 @@ public:
     void update(float dt);
 
 protected:
+    enum WheelState : int
+    {
+        WHEEL_DISARMED = -1,  // not scheduled or paused target
+        WHEEL_PENDING  = -2,  // checked every frame
+        WHEEL_FIRING   = -3,  // collected by the current frame
+    };
+
     Scheduler* _scheduler;  // weak ref
     float _elapsed;
     bool _runForever;
@@ -73,6 +83,12 @@ protected:
     float _delay;
     float _interval;
     bool _aborted;
+
+    // timer wheel bookkeeping, owned by the scheduler
+    double _syncTime;  // scheduler clock at which _elapsed was last brought up to date
+    double _dueTime;   // scheduler clock at which the next trigger is due
+    int _wheelSlot;    // wheel slot holding the timer, or a WheelState
+    unsigned int _wheelIndex;
 };
 
 class AX_DLL TimerTargetSelector : public Timer
@@ -172,9 +188,8 @@ struct SchedHandle
 struct TimerHandle
 {
     Vector<Timer*> timers;
-    int timerIndex;
-    Timer* currentTimer;
     bool paused;
+    double pausedTime;  // scheduler clock when the target was paused
 };
 
 #if AX_ENABLE_SCRIPT_BINDING
@@ -192,6 +207,9 @@ There are 2 different types of callbacks (selectors):
 The 'custom selectors' should be avoided when possible. It is faster, and consumes less memory to use the 'update
 selector'.
 
+Custom selectors with an interval or a delay are kept in a hierarchical timer wheel, a frame only visits the timers
+that come due, so large numbers of idle timers are cheap.
+
 */
 class AX_DLL Scheduler : public Object
 {
@@ -513,6 +531,20 @@ protected:
 
     void unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt);
 
+    // timer wheel
+
+    void addTimer(TimerHandle& timerHandle, Timer* timer);
+    void removeTimer(Timer* timer);
+    void armTimer(Timer* timer);
+    void disarmTimer(Timer* timer);
+    void linkTimer(axstd::pod_vector<Timer*>& list, Timer* timer, int slot);
+    void unlinkTimer(axstd::pod_vector<Timer*>& list, unsigned int index);
+    void wheelInsert(Timer* timer, uint64_t dueTick);
+    void wheelCascade(int level);
+    void pauseTimers(TimerHandle& timerHandle);
+    void resumeTimers(TimerHandle& timerHandle);
+    void updateTimers(float dt);
+
     float _timeScale;
 
     axstd::pod_vector<SchedHandle*> _waitList; // list wait active
@@ -531,8 +563,14 @@ protected:
 
     // Used for "selectors with interval"
     std::unordered_map<void*, TimerHandle> _timersMap;
-    struct TimerHandle* _currentTarget;
-    bool _currentTargetSalvaged;
+
+    // Hierarchical timer wheel driving the timers of _timersMap. Only timers that come due are visited
+    // each frame, idle timers cost nothing until their tick is reached.
+    std::vector<axstd::pod_vector<Timer*>> _timerWheel;
+    axstd::pod_vector<Timer*> _timersPending;  // checked every frame: new, interval 0 or due within the tick
+    axstd::pod_vector<Timer*> _timersFiring;   // retained while triggered
+    uint64_t _wheelTick;                       // next tick to process
+    double _timerClock;                        // scaled time accumulated by update, in seconds
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _indexMapLocked;
 
@@ -540,9 +578,12 @@ protected:
     Vector<SchedulerScriptHandlerEntry*> _scriptHandlerEntries;
 #endif
 
-    // Used for "perform action"
+    // Used for "perform action", run in the order they were posted from any thread. The flag spares update
+    // the lock on the frames without any.
     std::vector<std::function<void()>> _actionsToPerform;
+    std::vector<std::function<void()>> _actionsPerforming;
     std::mutex _performMutex;
+    std::atomic<bool> _hasActionsToPerform{false};
 };
 
 // end of base group
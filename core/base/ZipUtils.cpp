@@ -45,6 +45,7 @@
 #include "base/Data.h"
 #include "base/Macros.h"
 #include "platform/FileUtils.h"
+#include "platform/MappedFile.h"
 #include <map>
 #include <mutex>
 
@@ -837,6 +838,56 @@ bool ZipFile::getFileData(std::string_view fileName, ResizableBuffer* buffer)
     return res;
 }
 
+std::shared_ptr<MappedFile> ZipFile::mapFile(std::string_view fileName)
+{
+    do
+    {
+        AX_BREAK_IF(!_data->zipFile);
+        AX_BREAK_IF(fileName.empty());
+
+        auto it = _data->fileList.find(fileName);
+        AX_BREAK_IF(it == _data->fileList.end());
+
+        // archives opened from memory have nothing to map
+        if (_data->memfs)
+            break;
+
+        unz_file_info64 fileInfo;
+        {
+            std::unique_lock<std::mutex> lck(_data->zipFileMtx);
+            AX_BREAK_IF(UNZ_OK != unzGoToFilePos(_data->zipFile, &it->second.pos));
+            AX_BREAK_IF(UNZ_OK != unzGetCurrentFileInfo64(_data->zipFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0));
+        }
+
+        // only stored entries without encryption can be used in place
+        if (fileInfo.compression_method != 0 || (fileInfo.flag & 1) || fileInfo.uncompressed_size == 0)
+            break;
+
+        FileStream fileStream;
+        if (!fileStream.open(_data->zipFileName, IFileStream::Mode::READ))
+            break;
+
+        // the data follows the local file header and its variable fields
+        uint8_t header[30];
+        if (fileStream.seek(static_cast<int64_t>(fileInfo.disk_offset), SEEK_SET) < 0 ||
+            fileStream.read(header, sizeof(header)) != sizeof(header))
+            break;
+        auto readLE16 = [&header](int offset) { return header[offset] | (header[offset + 1] << 8); };
+        if (readLE16(0) != 0x4b50 || readLE16(2) != 0x0403)
+            break;
+
+        auto dataOffset = static_cast<int64_t>(fileInfo.disk_offset) + sizeof(header) + readLE16(26) + readLE16(28);
+        if (auto mapping = MappedFile::create(fileStream, dataOffset, static_cast<size_t>(fileInfo.uncompressed_size)))
+            return mapping;
+    } while (false);
+
+    Data data;
+    ResizableBufferAdapter<Data> buffer(&data);
+    if (!getFileData(fileName, &buffer))
+        return nullptr;
+    return MappedFile::create(std::move(data));
+}
+
 std::string ZipFile::getFirstFilename()
 {
     if (unzGoToFirstFile(_data->zipFile) != UNZ_OK)
@@ -297,6 +297,15 @@ public:
      */
     bool getFileData(std::string_view fileName, ResizableBuffer* buffer);
 
+    /**
+     * Get a read-only view of a file in the zip file.
+     * Entries stored without compression are memory mapped from the archive, others are inflated
+     * into memory like getFileData.
+     * @param fileName File name
+     * @return The view, nullptr if the file doesn't exist or can't be read.
+     */
+    std::shared_ptr<MappedFile> mapFile(std::string_view fileName);
+
     std::string getFirstFilename();
     std::string getNextFilename();
 
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "base/Director.h"
 #include "platform/SAXParser.h"
 #include "platform/FileStream.h"
+#include "platform/MappedFile.h"
 
 #ifdef MINIZIP_FROM_SYSTEM
 #    include <minizip/unzip.h>
@@ -50,6 +51,8 @@ THE SOFTWARE.
 #endif
 
 #include "pugixml/pugixml.hpp"
+#include "yasio/ibstream.hpp"
+#include "yasio/obstream.hpp"
 
 #include "base/filesystem.h"
 
@@ -481,7 +484,10 @@ std::string FileUtils::s_exeDir;
 
 FileUtils::FileUtils() : _writablePath() {}
 
-FileUtils::~FileUtils() {}
+FileUtils::~FileUtils()
+{
+    delete _pathIndex.exchange(nullptr, std::memory_order_acq_rel);
+}
 
 bool FileUtils::writeStringToFile(std::string_view dataStr, std::string_view fullPath) const
 {
@@ -543,6 +549,216 @@ void FileUtils::purgeCachedEntries()
     _fullPathCacheDir.clear();
 }
 
+size_t FileUtils::PathCache::shardIndex(size_t hash)
+{
+    // robin_map picks buckets from the low bits, so take the shard from the high bits of a mixed hash
+    return (static_cast<uint32_t>(hash) * 0x9E3779B9u) >> 28;
+}
+
+bool FileUtils::PathCache::find(std::string_view key, std::string& value) const
+{
+    const auto hash   = hlookup::string_hash{}(key);
+    const auto& shard = _shards[shardIndex(hash)];
+
+    std::shared_lock<std::shared_mutex> lck(shard.mutex);
+    auto it = shard.entries.find(key, hash);
+    if (it == shard.entries.end())
+        return false;
+    value = it->second;
+    return true;
+}
+
+void FileUtils::PathCache::emplace(std::string_view key, std::string_view value)
+{
+    const auto hash = hlookup::string_hash{}(key);
+    auto& shard     = _shards[shardIndex(hash)];
+
+    std::unique_lock<std::shared_mutex> lck(shard.mutex);
+    shard.entries.emplace(key, value);
+}
+
+void FileUtils::PathCache::clear()
+{
+    for (auto& shard : _shards)
+    {
+        std::unique_lock<std::shared_mutex> lck(shard.mutex);
+        shard.entries.clear();
+    }
+}
+
+hlookup::string_map<std::string> FileUtils::PathCache::snapshot() const
+{
+    hlookup::string_map<std::string> ret;
+    for (auto& shard : _shards)
+    {
+        std::shared_lock<std::shared_mutex> lck(shard.mutex);
+        ret.insert(shard.entries.begin(), shard.entries.end());
+    }
+    return ret;
+}
+
+size_t FileUtils::buildPathIndex()
+{
+    auto index         = std::make_unique<PathIndex>();
+    index->searchPaths = _searchPathArray;
+
+    std::vector<std::string> entries;
+    for (const auto& searchPath : _searchPathArray)
+    {
+        if (searchPath.empty() || !isAbsolutePath(searchPath))
+            continue;
+
+        entries.clear();
+        listFilesRecursively(searchPath, &entries);
+        for (auto& fullPath : entries)
+        {
+            if (fullPath.size() <= searchPath.size() || fullPath.compare(0, searchPath.size(), searchPath) != 0)
+                continue;
+
+            // The first search path containing a name wins, as with probing
+            auto relative = std::string_view{fullPath}.substr(searchPath.size());
+            if (relative.back() == '/')
+                index->dirs.emplace(relative.substr(0, relative.size() - 1), fullPath);
+            else
+                index->files.emplace(relative, fullPath);
+        }
+    }
+
+    const auto count = index->files.size();
+    AXLOGD("FileUtils: indexed {} files and {} directories in {} search paths", count, index->dirs.size(),
+           index->searchPaths.size());
+    setPathIndex(std::move(index));
+    return count;
+}
+
+static constexpr uint32_t PATH_INDEX_MAGIC   = 0x49505841;  // 'AXPI'
+static constexpr uint16_t PATH_INDEX_VERSION = 1;
+
+bool FileUtils::savePathIndex(std::string_view fullPath) const
+{
+    auto index = _pathIndex.load(std::memory_order_acquire);
+    if (!index)
+        return false;
+
+    yasio::obstream obs;
+    obs.write<uint32_t>(PATH_INDEX_MAGIC);
+    obs.write<uint16_t>(PATH_INDEX_VERSION);
+    obs.write<uint32_t>(static_cast<uint32_t>(index->searchPaths.size()));
+    for (auto& searchPath : index->searchPaths)
+        obs.write_v(searchPath);
+
+    // Entries are stored relative to the search path they were found in
+    auto writeEntries = [&](const hlookup::string_map<std::string>& entries, bool isDir) {
+        obs.write<uint32_t>(static_cast<uint32_t>(entries.size()));
+        for (auto& entry : entries)
+        {
+            // full path is searchPath + relative, plus the trailing '/' of directories
+            auto prefix = std::string_view{entry.second}.substr(
+                0, entry.second.size() - entry.first.size() - (isDir ? 1 : 0));
+            auto it = std::find(index->searchPaths.begin(), index->searchPaths.end(), prefix);
+            obs.write<uint16_t>(static_cast<uint16_t>(it - index->searchPaths.begin()));
+            obs.write_v(entry.first);
+        }
+    };
+    writeEntries(index->files, false);
+    writeEntries(index->dirs, true);
+
+    return writeBinaryToFile(obs.data(), obs.length(), fullPath);
+}
+
+bool FileUtils::loadPathIndex(std::string_view fullPath)
+{
+    // magic + version
+    constexpr size_t headerSize = sizeof(uint32_t) + sizeof(uint16_t);
+
+    auto data = getDataFromFile(fullPath);
+    if (data.getSize() < headerSize)
+        return false;
+
+    auto index = std::make_unique<PathIndex>();
+    yasio::ibstream_view ibs(data.getBytes(), static_cast<int>(data.getSize()));
+    try
+    {
+        if (ibs.read<uint32_t>() != PATH_INDEX_MAGIC || ibs.read<uint16_t>() != PATH_INDEX_VERSION)
+        {
+            AXLOGW("FileUtils: {} isn't a path index manifest", fullPath);
+            return false;
+        }
+
+        const auto searchPathCount = ibs.read<uint32_t>();
+        for (uint32_t i = 0; i < searchPathCount; ++i)
+            index->searchPaths.emplace_back(ibs.read_v());
+        if (index->searchPaths != _searchPathArray)
+        {
+            AXLOGD("FileUtils: path index manifest {} was saved with other search paths", fullPath);
+            return false;
+        }
+
+        auto readEntries = [&](hlookup::string_map<std::string>& entries, bool isDir) {
+            const auto count = ibs.read<uint32_t>();
+            entries.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const auto searchPathIndex = ibs.read<uint16_t>();
+                const auto relative        = ibs.read_v();
+                if (searchPathIndex >= index->searchPaths.size())
+                    return false;
+
+                std::string entryPath = index->searchPaths[searchPathIndex];
+                entryPath.append(relative);
+                if (isDir)
+                    entryPath += '/';
+                entries.emplace(relative, std::move(entryPath));
+            }
+            return true;
+        };
+        if (!readEntries(index->files, false) || !readEntries(index->dirs, true))
+        {
+            AXLOGW("FileUtils: path index manifest {} is corrupted", fullPath);
+            return false;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        AXLOGW("FileUtils: failed to read path index manifest {}: {}", fullPath, ex.what());
+        return false;
+    }
+
+    setPathIndex(std::move(index));
+    return true;
+}
+
+bool FileUtils::findInPathIndex(std::string_view name, bool isDir, std::string& fullPath) const
+{
+    auto index = _pathIndex.load(std::memory_order_acquire);
+    if (!index)
+        return false;
+
+    auto& entries = isDir ? index->dirs : index->files;
+    if (isDir && name.back() == '/')
+        name.remove_suffix(1);
+    auto it = entries.find(name);
+    if (it == entries.end())
+        return false;
+    fullPath = it->second;
+    return true;
+}
+
+void FileUtils::purgePathIndex()
+{
+    setPathIndex(nullptr);
+}
+
+void FileUtils::setPathIndex(std::unique_ptr<PathIndex> index)
+{
+    if (!index && !_pathIndex.load(std::memory_order_relaxed))
+        return;
+
+    auto retired = _pathIndex.exchange(index.release(), std::memory_order_acq_rel);
+    if (retired)
+        _retiredPathIndexes.emplace_back(const_cast<PathIndex*>(retired));
+}
+
 std::string FileUtils::getStringFromFile(std::string_view filename) const
 {
     std::string s;
@@ -610,6 +826,45 @@ FileUtils::Status FileUtils::getContents(std::string_view filename, ResizableBuf
 
     return Status::OK;
 }
+std::shared_ptr<MappedFile> FileUtils::mapFile(std::string_view filename) const
+{
+    if (filename.empty())
+        return nullptr;
+
+    if (!_fileMappingEnabled)
+    {
+        // read through the overridable path, which may transform the content
+        Data data = getDataFromFile(filename);
+        if (data.isNull() && !isFileExist(filename))
+            return nullptr;
+        return MappedFile::create(std::move(data));
+    }
+
+    const auto fullPath = fullPathForFilename(filename);
+
+    FileStream fileStream;
+    fileStream.open(fullPath, IFileStream::Mode::READ);
+    if (!fileStream)
+        return nullptr;
+
+    if (fileStream.size() > 0)
+    {
+        if (auto mapping = MappedFile::create(fileStream))
+            return mapping;
+    }
+
+    // not mappable (package asset, empty file...), read it into memory
+    const auto size = fileStream.size();
+    if (size < 0 || size > ULONG_MAX)
+        return nullptr;
+
+    Data data;
+    data.resize(static_cast<ssize_t>(size));
+    if (fileStream.read(data.getBytes(), static_cast<unsigned int>(size)) < size)
+        return nullptr;
+    return MappedFile::create(std::move(data));
+}
+
 #ifndef AX_CORE_PROFILE
 void FileUtils::writeValueMapToFile(ValueMap dict, std::string_view fullPath, std::function<void(bool)> callback) const
 {
@@ -665,25 +920,22 @@ std::string FileUtils::fullPathForFilename(std::string_view filename) const
     }
 
     /*
-     * As we know, this function 'fullPathForFilename' will be calling when load any file, how to ensure this thread
-     * safe Step: a. call this function at main-thread always b. use the really fullPath to call
-     * getStringFromFile/getDataFromFile at sub-thread c. then this function will call again with really fullPath d.
-     * then isAbsolutePath avoid to access _fullPathCache _fullPathCache concurrent
+     * This function is called from loader threads too: the path index is immutable once published and the
+     * full path caches are sharded and locked, only changing the search paths must stay on the axmol thread.
      */
     if (isAbsolutePath(filename))
     {
         return std::string{filename};
     }
 
-    // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if (cacheIter != _fullPathCache.end())
+    std::string fullpath;
+
+    // Already indexed or cached ?
+    if (findInPathIndex(filename, false, fullpath) || _fullPathCache.find(filename, fullpath))
     {
-        return cacheIter->second;
+        return fullpath;
     }
 
-    std::string fullpath;
-
     for (const auto& searchIt : _searchPathArray)
     {
         fullpath = this->getPathForFilename(filename, searchIt);
@@ -717,39 +969,34 @@ std::string FileUtils::fullPathForDirectory(std::string_view dir) const
     {
         result = dir;
     }
+    else if (findInPathIndex(dir, true, result) || _fullPathCacheDir.find(dir, result))
+    {
+        // Already indexed or cached
+    }
     else
     {
-        // Already Cached ?
-        auto cacheIter = _fullPathCacheDir.find(dir);
-        if (cacheIter != _fullPathCacheDir.end())
+        std::string longdir{dir};
+
+        if (longdir[longdir.length() - 1] != '/')
         {
-            result = cacheIter->second;
+            longdir += "/";
         }
-        else
-        {
-            std::string longdir{dir};
-
-            if (longdir[longdir.length() - 1] != '/')
-            {
-                longdir += "/";
-            }
 
-            for (const auto& searchIt : _searchPathArray)
+        for (const auto& searchIt : _searchPathArray)
+        {
+            auto fullpath = this->getPathForDirectory(longdir, searchIt);
+            if (!fullpath.empty() && isDirectoryExistInternal(fullpath))
             {
-                auto fullpath = this->getPathForDirectory(longdir, searchIt);
-                if (!fullpath.empty() && isDirectoryExistInternal(fullpath))
-                {
-                    // Using the filename passed in as key.
-                    _fullPathCacheDir.emplace(dir, fullpath);
-                    result = fullpath;
-                    break;
-                }
+                // Using the filename passed in as key.
+                _fullPathCacheDir.emplace(dir, fullpath);
+                result = fullpath;
+                break;
             }
+        }
 
-            if (result.empty() && isPopupNotify())
-            {
-                AXLOGD("fullPathForDirectory: No directory found at {}. Possible missing directory.", dir);
-            }
+        if (result.empty() && isPopupNotify())
+        {
+            AXLOGD("fullPathForDirectory: No directory found at {}. Possible missing directory.", dir);
         }
     }
 
@@ -811,6 +1058,7 @@ void FileUtils::setSearchPaths(const std::vector<std::string>& searchPaths)
     _fullPathCache.clear();
     _fullPathCacheDir.clear();
     _searchPathArray.clear();
+    purgePathIndex();
 
     for (const auto& path : _originalSearchPaths)
     {
@@ -842,6 +1090,8 @@ void FileUtils::setSearchPaths(const std::vector<std::string>& searchPaths)
 
 void FileUtils::addSearchPath(std::string_view searchpath, const bool front)
 {
+    purgePathIndex();
+
     std::string path;
     if (!isAbsolutePath(searchpath))
         path = _defaultResRootPath;
@@ -32,6 +32,9 @@ THE SOFTWARE.
 #include <unordered_map>
 #include <type_traits>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <array>
 #include <memory>
 
 #include "platform/IFileStream.h"
@@ -48,6 +51,8 @@ THE SOFTWARE.
 namespace ax
 {
 
+class MappedFile;
+
 /**
  * @addtogroup platform
  * @{
@@ -136,9 +141,46 @@ public:
 
     /**
      *  Purges full path caches.
+     *  @note The path index built by buildPathIndex is kept, use purgePathIndex to drop it.
      */
     virtual void purgeCachedEntries();
 
+    /**
+     *  Scans every search path once and builds an immutable index of the files and directories below them.
+     *  While the index is valid, fullPathForFilename and fullPathForDirectory resolve indexed names without
+     *  taking a lock or probing the file system, names missing from the index still fall back to probing.
+     *  Changing the search paths or the default resource root path drops the index.
+     *
+     *  @note Call it on the axmol thread once the search paths are set up, usually at startup.
+     *  @return The number of indexed files.
+     */
+    size_t buildPathIndex();
+
+    /**
+     *  Writes the current path index to a small binary manifest, so later launches can skip the scan.
+     *
+     *  @param fullPath The full path of the manifest file.
+     *  @return true if an index exists and the manifest was written.
+     */
+    bool savePathIndex(std::string_view fullPath) const;
+
+    /**
+     *  Loads a manifest written by savePathIndex. The manifest is rejected when it was saved with
+     *  different search paths, it's up to the caller to rebuild it when the resources change.
+     *
+     *  @param fullPath The full path of the manifest file.
+     *  @return true if the manifest matched the current search paths and the index was replaced.
+     */
+    bool loadPathIndex(std::string_view fullPath);
+
+    /**
+     *  Drops the path index built by buildPathIndex or loaded by loadPathIndex.
+     */
+    void purgePathIndex();
+
+    /** Whether a path index is currently used to resolve paths. */
+    bool isPathIndexed() const { return _pathIndex.load(std::memory_order_acquire) != nullptr; }
+
     /**
      *  Gets string from a file.
      */
@@ -226,6 +268,28 @@ public:
     }
     virtual Status getContents(std::string_view filename, ResizableBuffer* buffer) const;
 
+    /**
+     *  Gets a read-only view of a file content without copying it when possible.
+     *
+     *  With file mapping enabled, the file is memory mapped when it lives on the file system or is
+     *  stored uncompressed in a package, otherwise it's read into memory with getDataFromFile. The
+     *  view is reference counted, keep it alive as long as its bytes are used.
+     *
+     *  @param[in]  filename The resource file name which contains the path.
+     *  @return The view, nullptr if the file can't be opened or read.
+     */
+    virtual std::shared_ptr<MappedFile> mapFile(std::string_view filename) const;
+
+    /**
+     *  Sets whether mapFile memory maps the files, false by default.
+     *
+     *  Mapped files aren't read with getDataFromFile nor getContents, only enable it when those aren't
+     *  overridden to transform the content, e.g. to decrypt the assets.
+     *  @since axmol-2.2
+     */
+    void setFileMappingEnabled(bool enabled) { _fileMappingEnabled = enabled; }
+    bool isFileMappingEnabled() const { return _fileMappingEnabled; }
+
     /** Returns the fullpath for a given filename.
 
      First it will try to get a new filename from the "filenameLookup" dictionary.
@@ -767,10 +831,10 @@ public:
                                            std::function<void(std::vector<std::string>)> callback) const;
 #endif
     /** Returns the full path cache. */
-    const hlookup::string_map<std::string> getFullPathCache() const { return _fullPathCache; }
+    const hlookup::string_map<std::string> getFullPathCache() const { return _fullPathCache.snapshot(); }
 
     /** Returns the full path cache. */
-    const hlookup::string_map<std::string> getFullPathCacheDir() const { return _fullPathCacheDir; }
+    const hlookup::string_map<std::string> getFullPathCacheDir() const { return _fullPathCacheDir.snapshot(); }
 
     /**
      *  Checks whether a file exists without considering search paths and resolution orders.
@@ -836,6 +900,47 @@ protected:
     virtual std::string getFullPathForFilenameWithinDirectory(std::string_view directory,
                                                               std::string_view filename) const;
 
+    /**
+     *  A string map split into independently locked shards, so loader threads resolving paths
+     *  only contend when their names land in the same shard.
+     */
+    class AX_DLL PathCache
+    {
+    public:
+        bool find(std::string_view key, std::string& value) const;
+        void emplace(std::string_view key, std::string_view value);
+        void clear();
+
+        /** Returns a merged copy of all shards. */
+        hlookup::string_map<std::string> snapshot() const;
+
+    private:
+        static constexpr size_t SHARD_COUNT = 16;
+
+        struct Shard
+        {
+            mutable std::shared_mutex mutex;
+            hlookup::string_map<std::string> entries;
+        };
+
+        static size_t shardIndex(size_t hash);
+
+        std::array<Shard, SHARD_COUNT> _shards;
+    };
+
+    /**
+     *  The prebuilt path index, never modified once published.
+     */
+    struct PathIndex
+    {
+        std::vector<std::string> searchPaths;   // _searchPathArray at the time of the scan
+        hlookup::string_map<std::string> files; // relative path -> full path
+        hlookup::string_map<std::string> dirs;  // relative path without trailing '/' -> full path
+    };
+
+    void setPathIndex(std::unique_ptr<PathIndex> index);
+    bool findInPathIndex(std::string_view name, bool isDir, std::string& fullPath) const;
+
     /**
      * The vector contains search paths.
      * The lower index of the element in this vector, the higher priority for this search path.
@@ -860,19 +965,29 @@ protected:
      *  The full path cache for normal files. When a file is found, it will be added into this cache.
      *  This variable is used for improving the performance of file search.
      */
-    mutable hlookup::string_map<std::string> _fullPathCache;
+    mutable PathCache _fullPathCache;
 
     /**
      *  The full path cache for directories. When a diretory is found, it will be added into this cache.
      *  This variable is used for improving the performance of file search.
      */
-    mutable hlookup::string_map<std::string> _fullPathCacheDir;
+    mutable PathCache _fullPathCacheDir;
+
+    /**
+     *  The path index used before the caches, read without locking from any thread.
+     *  Replaced indexes are retired instead of deleted since a reader may still hold them,
+     *  they are released with FileUtils.
+     */
+    std::atomic<const PathIndex*> _pathIndex{nullptr};
+    std::vector<std::unique_ptr<PathIndex>> _retiredPathIndexes;
 
     /**
      * Writable path.
      */
     std::string _writablePath;
 
+    std::atomic<bool> _fileMappingEnabled{false};
+
 #if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32 || AX_TARGET_PLATFORM == AX_PLATFORM_LINUX
     /*
      * The dir of executable file, only present targets: win32, linux
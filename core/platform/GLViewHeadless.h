@@ -0,0 +1,67 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "platform/GLView.h"
+
+namespace ax
+{
+
+/**
+ * A view without window nor graphics context.
+ *
+ * Pair it with a driver which needs no context, like backend::DriverNull, to run the engine headless on
+ * CI machines. Input is never received and frames are presented to nowhere.
+ * @since axmol-2.2
+ */
+class AX_DLL GLViewHeadless : public GLView
+{
+public:
+    /** Creates a view of the frame size of rect. */
+    static GLViewHeadless* create(std::string_view viewName, const Rect& rect);
+
+    void end() override;
+    bool isOpenGLReady() override { return true; }
+    void swapBuffers() override {}
+    void setIMEKeyboardState(bool /*open*/) override {}
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_WIN32)
+    HWND getWin32Window() override { return nullptr; }
+#endif
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_MAC)
+    void* getCocoaWindow() override { return nullptr; }
+    void* getNSGLContext() override { return nullptr; }
+#endif
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_LINUX)
+    void* getX11Window() override { return nullptr; }
+    void* getX11Display() override { return nullptr; }
+#endif
+
+protected:
+    bool initWithRect(std::string_view viewName, const Rect& rect);
+};
+
+}  // namespace ax
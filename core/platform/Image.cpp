@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "platform/Image.h"
 #include "renderer/backend/PixelFormatUtils.h"
+#include "platform/MappedFile.h"
 
 #include <string>
 #include <ctype.h>
@@ -574,7 +575,11 @@ Image::Image()
 
 Image::~Image()
 {
-    if (!_unpack)
+    if (_mappedFile)
+    {
+        _data = nullptr;  // borrowed from the mapping
+    }
+    else if (!_unpack)
     {
         AX_SAFE_FREE(_data);
     }
@@ -590,14 +595,8 @@ bool Image::initWithImageFile(std::string_view path)
     bool ret  = false;
     _filePath = FileUtils::getInstance()->fullPathForFilename(path);
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
-
-    if (!data.isNull())
-    {
-        ssize_t n = 0;
-        auto buf  = data.takeBuffer(&n);
-        ret       = initWithImageData(buf, n, true);
-    }
+    if (auto mappedFile = FileUtils::getInstance()->mapFile(_filePath))
+        ret = initWithMappedFile(std::move(mappedFile));
 
     return ret;
 }
@@ -607,15 +606,33 @@ bool Image::initWithImageFileThreadSafe(std::string_view fullpath)
     bool ret  = false;
     _filePath = fullpath;
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    if (auto mappedFile = FileUtils::getInstance()->mapFile(_filePath))
+        ret = initWithMappedFile(std::move(mappedFile));
 
-    if (!data.isNull())
+    return ret;
+}
+
+bool Image::initWithMappedFile(std::shared_ptr<MappedFile> mappedFile)
+{
+    if (mappedFile->empty())
+        return false;
+
+    // encrypted ccz files are decrypted in place, they need a writable copy
+    if (mappedFile->isMapped() && ZipUtils::isCCZBuffer(mappedFile->data(), mappedFile->size()))
     {
-        ssize_t n = 0;
-        auto buf  = data.takeBuffer(&n);
-        ret       = initWithImageData(buf, n, true);
+        auto copy = static_cast<uint8_t*>(malloc(mappedFile->size()));
+        if (!copy)
+            return false;
+        memcpy(copy, mappedFile->data(), mappedFile->size());
+        return initWithImageData(copy, mappedFile->size(), true);
     }
 
+    // forwardPixels borrows the compressed pixels from the mapping instead of copying them, the mapping
+    // is only kept alive while _data points into it
+    _mappedFile = std::move(mappedFile);
+    bool ret    = initWithImageData(const_cast<uint8_t*>(_mappedFile->data()), _mappedFile->size(), false);
+    if (!_mappedFile->contains(_data))
+        _mappedFile.reset();
     return ret;
 }
 
@@ -2321,7 +2338,7 @@ bool Image::initWithPVRData(uint8_t* data, ssize_t dataLen, bool ownData)
 
 void Image::forwardPixels(uint8_t* data, ssize_t dataLen, int offset, bool ownData)
 {
-    if (ownData)
+    if (ownData || (_mappedFile && _mappedFile->contains(data)))
     {
         _data    = data;
         _dataLen = dataLen;
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "base/Object.h"
 #include "renderer/Texture2D.h"
 #include "base/Data.h"
+#include <memory>
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_WINRT
 #    define AX_USE_WIC 1
@@ -48,6 +49,8 @@ THE SOFTWARE.
 namespace ax
 {
 
+class MappedFile;
+
 /**
  * @addtogroup platform
  * @{
@@ -221,6 +224,9 @@ protected:
     // fast forward pixels to GPU if ownData
     void forwardPixels(uint8_t* data, ssize_t dataLen, int offset, bool ownData);
 
+    // load from a file view, compressed pixels are forwarded to GPU straight from the mapping
+    bool initWithMappedFile(std::shared_ptr<MappedFile> mappedFile);
+
     bool saveImageToPNG(std::string_view filePath, bool isToRGB = true);
     bool saveImageToJPG(std::string_view filePath);
 
@@ -239,6 +245,7 @@ protected:
     uint8_t* _data;
     ssize_t _dataLen;
     ssize_t _offset;  // useful for hardware decoder present to hold data without copy
+    std::shared_ptr<MappedFile> _mappedFile;  // set when _data points into a file view, not owned
     int _width;
     int _height;
     bool _unpack;
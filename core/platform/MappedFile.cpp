@@ -0,0 +1,72 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "platform/MappedFile.h"
+
+namespace ax
+{
+
+std::shared_ptr<MappedFile> MappedFile::create(FileStream& stream, int64_t offset, size_t length)
+{
+    auto handle = stream.nativeHandle();
+    if (handle == (osfhnd_t)-1 || offset < 0)
+        return nullptr;
+
+    std::error_code error;
+    std::shared_ptr<MappedFile> file{new MappedFile()};
+    file->_mapping.map(handle, static_cast<size_t>(offset), length, error);  // 0 is mio::map_entire_file
+    if (error || !file->_mapping.is_mapped())
+        return nullptr;
+
+    file->_bytes  = file->_mapping.data();
+    file->_size   = file->_mapping.size();
+    file->_stream = std::move(stream);
+    return file;
+}
+
+std::shared_ptr<MappedFile> MappedFile::create(Data&& data)
+{
+    std::shared_ptr<MappedFile> file{new MappedFile()};
+    file->_data  = std::move(data);
+    file->_bytes = file->_data.getBytes();
+    file->_size  = static_cast<size_t>(file->_data.getSize());
+    return file;
+}
+
+std::shared_ptr<MappedFile> MappedFile::create(const uint8_t* data, size_t size, std::function<void()> release)
+{
+    std::shared_ptr<MappedFile> file{new MappedFile()};
+    file->_bytes   = data;
+    file->_size    = size;
+    file->_release = std::move(release);
+    return file;
+}
+
+MappedFile::~MappedFile()
+{
+    _mapping.unmap();
+    if (_release)
+        _release();
+}
+
+}  // namespace ax
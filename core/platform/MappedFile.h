@@ -0,0 +1,93 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <memory>
+#include <span>
+#include <functional>
+
+#include "platform/FileStream.h"
+#include "base/Data.h"
+#include "mio/mio.hpp"
+
+namespace ax
+{
+
+/**
+ * A read-only view of a file content, shared by reference counting.
+ *
+ * The view is backed by a memory mapping of the file when the platform allows it, so large assets
+ * (compressed textures, meshes, audio banks) can be consumed without a heap copy. When the content
+ * can't be mapped (compressed zip entries, empty files...) it holds a heap copy instead, the API
+ * is the same either way.
+ */
+class AX_DLL MappedFile
+{
+public:
+    /**
+     * Maps length bytes at offset of an opened file, 0 means up to the end of the file.
+     * The stream is moved into the mapping on success, left untouched otherwise.
+     * @return nullptr if the stream has no native handle or the mapping failed.
+     */
+    static std::shared_ptr<MappedFile> create(FileStream& stream, int64_t offset = 0, size_t length = 0);
+
+    /** Wraps a heap buffer. */
+    static std::shared_ptr<MappedFile> create(Data&& data);
+
+    /** Wraps memory owned by the platform, release is called when the view is destroyed. */
+    static std::shared_ptr<MappedFile> create(const uint8_t* data, size_t size, std::function<void()> release);
+
+    ~MappedFile();
+
+    const uint8_t* data() const { return _bytes; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    std::span<const uint8_t> span() const { return {_bytes, _size}; }
+
+    /** Whether the bytes live outside of the heap (file mapping or platform buffer). */
+    bool isMapped() const { return _data.isNull() && _bytes != nullptr; }
+
+    /** Whether ptr points into this view. */
+    bool contains(const void* ptr) const
+    {
+        auto p = static_cast<const uint8_t*>(ptr);
+        return p >= _bytes && p < _bytes + _size;
+    }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+    MappedFile() = default;
+
+    FileStream _stream;
+    mio::ummap_source _mapping;
+    Data _data;
+    std::function<void()> _release;
+
+    const uint8_t* _bytes{nullptr};
+    size_t _size{0};
+};
+
+}  // namespace ax
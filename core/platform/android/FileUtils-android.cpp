@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "android/asset_manager.h"
 #include "android/asset_manager_jni.h"
 #include "base/ZipUtils.h"
+#include "platform/MappedFile.h"
 
 #include <stdlib.h>
 #include <sys/types.h>
@@ -240,6 +241,40 @@ int64_t FileUtilsAndroid::getFileSize(std::string_view filepath) const
     return size;
 }
 
+std::shared_ptr<MappedFile> FileUtilsAndroid::mapFile(std::string_view filename) const
+{
+    if (filename.empty() || !isFileMappingEnabled())
+        return FileUtils::mapFile(filename);
+
+    const auto fullPath = fullPathForFilename(filename);
+    if (fullPath.empty() || fullPath[0] == '/')
+        return FileUtils::mapFile(fullPath);
+
+    // from package, "assets/" is at the beginning of the path and we don't want it
+    std::string_view path = fullPath;
+    if (cxx20::starts_with(path, _defaultResRootPath))
+        path.remove_prefix(_defaultResRootPath.size());
+
+    if (obbfile && obbfile->fileExists(path))
+        return obbfile->mapFile(path);
+
+    if (!assetmanager)
+        return nullptr;
+
+    // uncompressed apk assets are mapped by the asset manager, compressed ones are inflated by it
+    AAsset* asset = AAssetManager_open(assetmanager, path.data(), AASSET_MODE_BUFFER);
+    if (!asset)
+        return nullptr;
+
+    auto buffer = static_cast<const uint8_t*>(AAsset_getBuffer(asset));
+    if (!buffer)
+    {
+        AAsset_close(asset);
+        return nullptr;
+    }
+    return MappedFile::create(buffer, static_cast<size_t>(AAsset_getLength64(asset)), [asset] { AAsset_close(asset); });
+}
+
 std::vector<std::string> FileUtilsAndroid::listFiles(std::string_view dirPath) const
 {
 
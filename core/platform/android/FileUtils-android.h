@@ -70,6 +70,7 @@ public:
     virtual bool isAbsolutePath(std::string_view strPath) const override;
 
     virtual int64_t getFileSize(std::string_view filepath) const override;
+    virtual std::shared_ptr<MappedFile> mapFile(std::string_view filename) const override;
     virtual std::vector<std::string> listFiles(std::string_view dirPath) const override;
 
 private:
@@ -51,6 +51,7 @@ class AX_DLL CallbackCommand : public RenderCommand
 {
     // only allow render to manage the callbackCommand
     friend class Renderer;
+    friend class FrameArena;
     CallbackCommand();
     ~CallbackCommand(){};
 
@@ -0,0 +1,106 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "renderer/FrameArena.h"
+
+#include <stdlib.h>
+#include <algorithm>
+
+namespace ax
+{
+
+FrameArena::FrameArena(size_t blockSize) : _blockSize(blockSize) {}
+
+FrameArena::~FrameArena()
+{
+    reset();
+    freeBlocks();
+}
+
+void* FrameArena::allocateSlow(size_t size, size_t alignment)
+{
+    addBlock((std::max)(_blockSize, size + alignment));
+    return allocate(size, alignment);
+}
+
+void FrameArena::addDestructor(void* object, void (*destroy)(void*))
+{
+    auto destructor = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+    --_stats.allocations;  // bookkeeping, not requested by the caller
+    destructor->destroy = destroy;
+    destructor->object  = object;
+    destructor->next    = _destructors;
+    _destructors        = destructor;
+    ++_stats.destructors;
+}
+
+void FrameArena::addBlock(size_t size)
+{
+    auto block  = static_cast<Block*>(malloc(BLOCK_HEADER_SIZE + size));
+    block->next = _blocks;
+    block->size = size;
+    _blocks     = block;
+    _cursor     = reinterpret_cast<uint8_t*>(block) + BLOCK_HEADER_SIZE;
+    _end        = _cursor + size;
+    _capacity += size;
+    ++_stats.heapAllocations;
+    ++_totalHeapAllocations;
+}
+
+void FrameArena::freeBlocks()
+{
+    while (_blocks)
+    {
+        auto next = _blocks->next;
+        free(_blocks);
+        _blocks = next;
+    }
+    _cursor   = nullptr;
+    _end      = nullptr;
+    _capacity = 0;
+}
+
+void FrameArena::reset()
+{
+    for (auto destructor = _destructors; destructor; destructor = destructor->next)
+        destructor->destroy(destructor->object);
+    _destructors = nullptr;
+
+    if (_blocks && _blocks->next)
+    {
+        // the frame outgrew the first block, use a single block big enough for it from now on
+        const auto capacity = _capacity;
+        freeBlocks();
+        addBlock(capacity);
+    }
+    else if (_blocks)
+    {
+        _cursor = reinterpret_cast<uint8_t*>(_blocks) + BLOCK_HEADER_SIZE;
+    }
+
+    _lastStats = _stats;
+    _stats     = Stats{};
+}
+
+}  // namespace ax
@@ -0,0 +1,145 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+/**
+ * A linear allocator for objects which live for a frame.
+ *
+ * Allocations bump a cursor in the current block and are released together by reset(). Objects which are not
+ * trivially destructible get their destructor recorded, it is called by reset() in reverse creation order,
+ * trivially destructible objects and arrays cost nothing but their bytes.
+ * When a frame needed more than one block, reset() replaces them by a single block of the total size, so a
+ * steady-state frame doesn't touch the heap.
+ *
+ * Not thread safe.
+ * @see Renderer::getFrameArena
+ * @since axmol-2.2
+ */
+class AX_DLL FrameArena
+{
+public:
+    struct Stats
+    {
+        size_t bytesUsed             = 0;  // bytes handed out, alignment padding included
+        unsigned int allocations     = 0;
+        unsigned int destructors     = 0;  // objects with a recorded destructor
+        unsigned int heapAllocations = 0;  // blocks allocated
+    };
+
+    explicit FrameArena(size_t blockSize = 64 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /** Returns uninitialized memory valid until the next reset(). */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        auto p = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(_cursor) + alignment - 1) & ~(alignment - 1));
+        if (p + size > _end)
+            return allocateSlow(size, alignment);
+        _stats.bytesUsed += p + size - _cursor;
+        ++_stats.allocations;
+        _cursor = p + size;
+        return p;
+    }
+
+    /** Constructs a T, its destructor is called by reset() unless T is trivially destructible. */
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        auto object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            addDestructor(object, [](void* p) { static_cast<T*>(p)->~T(); });
+        return object;
+    }
+
+    /** Returns an uninitialized array, for transient data such as vertices. */
+    template <typename T>
+    T* allocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena arrays can't have destructors");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /** Destroys the objects created since the last reset and makes all the memory available again. */
+    void reset();
+
+    /** Counters since the last reset. */
+    const Stats& getStats() const { return _stats; }
+
+    /** Counters of the period ended by the last reset, the block merge it did included. */
+    const Stats& getLastStats() const { return _lastStats; }
+
+    /** Bytes reserved by the blocks. */
+    size_t getCapacity() const { return _capacity; }
+
+    /** Blocks allocated since the arena was created. */
+    uint64_t getTotalHeapAllocations() const { return _totalHeapAllocations; }
+
+protected:
+    struct Block
+    {
+        Block* next;
+        size_t size;
+    };
+
+    // keeps the first allocation of a block aligned as malloc would
+    static constexpr size_t BLOCK_HEADER_SIZE =
+        (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    struct Destructor
+    {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    void* allocateSlow(size_t size, size_t alignment);
+    void addDestructor(void* object, void (*destroy)(void*));
+    void addBlock(size_t size);
+    void freeBlocks();
+
+    Block* _blocks           = nullptr;  // the current block first
+    uint8_t* _cursor         = nullptr;
+    uint8_t* _end            = nullptr;
+    Destructor* _destructors = nullptr;  // the last created first
+    size_t _blockSize;
+    size_t _capacity               = 0;
+    uint64_t _totalHeapAllocations = 0;
+    Stats _stats;
+    Stats _lastStats;
+};
+
+}  // namespace ax
@@ -0,0 +1,91 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "renderer/RenderCommandList.h"
+#include "renderer/Renderer.h"
+#include "2d/Node.h"
+
+namespace ax
+{
+
+static thread_local RenderCommandList* s_currentCommandList = nullptr;
+
+RenderCommandList* RenderCommandList::getCurrent()
+{
+    return s_currentCommandList;
+}
+
+void RenderCommandList::begin()
+{
+    _previous            = s_currentCommandList;
+    s_currentCommandList = this;
+}
+
+void RenderCommandList::end()
+{
+    AXASSERT(s_currentCommandList == this, "RenderCommandList::end() doesn't match begin()");
+    s_currentCommandList = _previous;
+    _previous            = nullptr;
+}
+
+void RenderCommandList::addCommand(RenderCommand* command, int renderQueueID)
+{
+    _commands.emplace_back(Entry{command, renderQueueID});
+}
+
+void RenderCommandList::deferVisit(Node* node, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    _deferred.emplace_back(DeferredVisit{_commands.size(), node, &parentTransform, parentFlags});
+}
+
+void RenderCommandList::replay(Renderer* renderer)
+{
+    const size_t count = _commands.size();
+    size_t deferred    = 0;
+    for (size_t i = 0; i <= count; ++i)
+    {
+        for (; deferred < _deferred.size() && _deferred[deferred].position == i; ++deferred)
+        {
+            auto& visit = _deferred[deferred];
+            visit.node->visit(renderer, *visit.parentTransform, visit.parentFlags);
+        }
+
+        if (i < count)
+        {
+            auto& entry = _commands[i];
+            if (entry.renderQueueID < 0)
+                renderer->addCommand(entry.command);
+            else
+                renderer->addCommand(entry.command, entry.renderQueueID);
+        }
+    }
+}
+
+void RenderCommandList::clear()
+{
+    _commands.clear();
+    _deferred.clear();
+}
+
+}  // namespace ax
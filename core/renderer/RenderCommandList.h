@@ -0,0 +1,96 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <vector>
+#include "platform/PlatformMacros.h"
+#include "math/Mat4.h"
+
+namespace ax
+{
+
+class Node;
+class Renderer;
+class RenderCommand;
+
+/**
+ * Records the render commands added by a subtree visited on a job system worker.
+ *
+ * While a list records on a thread, Renderer::addCommand appends to the list instead of the render queues.
+ * Nodes which are not safe to visit on a worker are deferred, replay() then adds the recorded commands
+ * and visits the deferred nodes on the axmol thread, in the order a serial visit would have produced them.
+ * @see Node::setParallelVisitEnabled
+ * @since axmol-2.2
+ */
+class AX_DLL RenderCommandList
+{
+public:
+    /** Returns the list recording on the calling thread, nullptr when commands go to the render queues. */
+    static RenderCommandList* getCurrent();
+
+    /** Records the commands added on the calling thread until end(). */
+    void begin();
+    void end();
+
+    /**
+     * Records a command.
+     * @param renderQueueID The render queue of the command, -1 for the queue current when replaying.
+     */
+    void addCommand(RenderCommand* command, int renderQueueID);
+
+    /** Records a visit of node, parentTransform must stay valid until replay(). */
+    void deferVisit(Node* node, const Mat4& parentTransform, uint32_t parentFlags);
+
+    /**
+     * Adds the recorded commands to renderer and visits the deferred nodes, must be called on the axmol thread.
+     * When another list records on the axmol thread, the commands are added to that list.
+     */
+    void replay(Renderer* renderer);
+
+    void clear();
+
+    size_t getCommandCount() const { return _commands.size(); }
+    RenderCommand* getCommand(size_t index) const { return _commands[index].command; }
+    size_t getDeferredCount() const { return _deferred.size(); }
+
+protected:
+    struct Entry
+    {
+        RenderCommand* command;
+        int renderQueueID;
+    };
+    struct DeferredVisit
+    {
+        size_t position;  ///< number of commands recorded before the visit
+        Node* node;
+        const Mat4* parentTransform;
+        uint32_t parentFlags;
+    };
+
+    std::vector<Entry> _commands;
+    std::vector<DeferredVisit> _deferred;
+    RenderCommandList* _previous = nullptr;
+};
+
+}  // namespace ax
@@ -26,6 +26,8 @@
 #include "renderer/Renderer.h"
 
 #include <algorithm>
+#include <mutex>
+#include <condition_variable>
 
 #include "renderer/TrianglesCommand.h"
 #include "renderer/CustomCommand.h"
@@ -36,12 +38,15 @@
 #include "renderer/Technique.h"
 #include "renderer/Pass.h"
 #include "renderer/Texture2D.h"
+#include "renderer/RenderCommandList.h"
 
 #include "base/Configuration.h"
 #include "base/Director.h"
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventType.h"
+#include "base/JobSystem.h"
+#include "base/Profiling.h"
 #include "2d/Camera.h"
 #include "2d/Scene.h"
 #include "xxhash.h"
@@ -63,6 +68,113 @@ static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
     return a->getDepth() > b->getDepth();
 }
 
+// Less commands than this are sorted by comparison, the radix sort histograms cost more than they save.
+static const size_t RADIX_SORT_MIN_COMMANDS = 256;
+
+// Maps a float to an unsigned integer with the same ordering
+static inline uint32_t orderedFloatBits(float value)
+{
+    if (value == 0.0f)
+        value = 0.0f;  // -0 and +0 compare equal
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+struct RenderSortEntry
+{
+    uint64_t key;  // sort value in the high 32 bits, insertion order in the low 32 bits
+    RenderCommand* command;
+};
+
+// Stable LSD radix sort of the commands by globalZ ascending, or by depth descending, the sort keys are
+// packed into a contiguous array next to the command pointers so the commands are read only once.
+static void radixSortCommands(std::vector<RenderCommand*>& commands, bool byDepth)
+{
+    const size_t count = commands.size();
+
+    static thread_local std::vector<RenderSortEntry> s_entries;
+    static thread_local std::vector<RenderSortEntry> s_scratch;
+    s_entries.resize(count);
+    s_scratch.resize(count);
+
+    uint32_t histograms[4][256] = {};
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto command   = commands[i];
+        uint32_t value = byDepth ? ~orderedFloatBits(command->getDepth()) : orderedFloatBits(command->getGlobalOrder());
+        s_entries[i]   = RenderSortEntry{(static_cast<uint64_t>(value) << 32) | static_cast<uint32_t>(i), command};
+        for (int b = 0; b < 4; ++b)
+            ++histograms[b][(value >> (b * 8)) & 0xff];
+    }
+
+    // The low 32 bits are already in order, only the sort value needs passes
+    auto src = s_entries.data();
+    auto dst = s_scratch.data();
+    for (int b = 0; b < 4; ++b)
+    {
+        auto& histogram    = histograms[b];
+        const auto shift   = 32 + b * 8;
+        // skip the pass when all the keys share the same digit, common for integral globalZ values
+        if (histogram[(src[0].key >> shift) & 0xff] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (auto& bucket : histogram)
+        {
+            auto size = bucket;
+            bucket    = offset;
+            offset += size;
+        }
+        for (size_t i = 0; i < count; ++i)
+            dst[histogram[(src[i].key >> shift) & 0xff]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        commands[i] = src[i].command;
+}
+
+// Less commands than this are prepared on the render thread, dispatching costs more than it saves.
+static const size_t PARALLEL_SORT_MIN_COMMANDS = 1024;
+static const size_t PARALLEL_FILL_MIN_COMMANDS = 256;
+
+// Splits [0, count) into ranges of at least `grain` items and runs `func(first, last)` on the job system
+// workers and the calling thread, returns when all ranges are done.
+template <typename _Fty>
+static void parallelFor(JobSystem* jobSystem, size_t count, size_t grain, _Fty&& func)
+{
+    size_t chunks = (std::min)(static_cast<size_t>(jobSystem->getThreadCount()) + 1, (count + grain - 1) / grain);
+    if (chunks <= 1)
+    {
+        func(size_t{0}, count);
+        return;
+    }
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t pending = chunks - 1;
+
+    const size_t step = (count + chunks - 1) / chunks;
+    for (size_t i = 1; i < chunks; ++i)
+    {
+        const size_t first = i * step;
+        const size_t last  = (std::min)(first + step, count);
+        jobSystem->enqueue([&, first, last] {
+            if (first < last)
+                func(first, last);
+            std::lock_guard<std::mutex> lck(mtx);
+            if (--pending == 0)
+                cv.notify_one();
+        });
+    }
+
+    func(size_t{0}, (std::min)(step, count));
+
+    std::unique_lock<std::mutex> lck(mtx);
+    cv.wait(lck, [&] { return pending == 0; });
+}
+
 // queue
 RenderQueue::RenderQueue() {}
 
@@ -111,12 +223,32 @@ ssize_t RenderQueue::size() const
 void RenderQueue::sort()
 {
     // Don't sort _queue0, it already comes sorted
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::TRANSPARENT_3D]),
-                     std::end(_commands[QUEUE_GROUP::TRANSPARENT_3D]), compare3DCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]),
-                     compareRenderCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]),
-                     compareRenderCommand);
+    sort(QUEUE_GROUP::TRANSPARENT_3D);
+    sort(QUEUE_GROUP::GLOBALZ_NEG);
+    sort(QUEUE_GROUP::GLOBALZ_POS);
+}
+
+void RenderQueue::sort(QUEUE_GROUP group)
+{
+    auto& commands = _commands[group];
+    switch (group)
+    {
+    case QUEUE_GROUP::TRANSPARENT_3D:
+        if (commands.size() < RADIX_SORT_MIN_COMMANDS)
+            std::stable_sort(std::begin(commands), std::end(commands), compare3DCommand);
+        else
+            radixSortCommands(commands, true);
+        break;
+    case QUEUE_GROUP::GLOBALZ_NEG:
+    case QUEUE_GROUP::GLOBALZ_POS:
+        if (commands.size() < RADIX_SORT_MIN_COMMANDS)
+            std::stable_sort(std::begin(commands), std::end(commands), compareRenderCommand);
+        else
+            radixSortCommands(commands, false);
+        break;
+    default:
+        break;
+    }
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -177,18 +309,16 @@ Renderer::~Renderer()
 {
     _renderGroups.clear();
 
-    for (auto&& clearCommand : _callbackCommandsPool)
-        delete clearCommand;
-    _callbackCommandsPool.clear();
-
-    for (auto&& clearCommand : _groupCommandPool)
-        delete clearCommand;
-    _groupCommandPool.clear();
+    // the group commands release their ids to the manager
+    for (auto&& arena : _frameArenas)
+        arena.reset();
 
     _groupCommandManager->release();
 
     free(_triBatchesToDraw);
 
+    clearBatchCache();
+
     AX_SAFE_RELEASE(_depthStencilState);
     AX_SAFE_RELEASE(_commandBuffer);
     AX_SAFE_RELEASE(_renderPipeline);
@@ -231,12 +361,24 @@ void Renderer::addCallbackCommand(std::function<void()> func, float globalZOrder
 
 void Renderer::addCommand(RenderCommand* command)
 {
+    if (auto commandList = RenderCommandList::getCurrent())
+    {
+        commandList->addCommand(command, -1);
+        return;
+    }
+
     int renderQueueID = _commandGroupStack.top();
     addCommand(command, renderQueueID);
 }
 
 void Renderer::addCommand(RenderCommand* command, int renderQueueID)
 {
+    if (auto commandList = RenderCommandList::getCurrent())
+    {
+        commandList->addCommand(command, renderQueueID);
+        return;
+    }
+
     AXASSERT(!_isRendering, "Cannot add command while rendering");
     AXASSERT(renderQueueID >= 0, "Invalid render queue");
     AXASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
@@ -244,34 +386,80 @@ void Renderer::addCommand(RenderCommand* command, int renderQueueID)
     _renderGroups[renderQueueID].emplace_back(command);
 }
 
-GroupCommand* Renderer::getNextGroupCommand()
+void Renderer::visitParallel(const Vector<Node*>& children,
+                             size_t first,
+                             size_t last,
+                             const Mat4& parentTransform,
+                             uint32_t parentFlags)
 {
-    if (_groupCommandPool.empty())
+    const size_t count  = last - first;
+    const size_t chunks = _visitJobSystem && !RenderCommandList::getCurrent()
+                              ? (std::min)(static_cast<size_t>(_visitJobSystem->getThreadCount()) + 1, count)
+                              : 1;
+    if (chunks <= 1)
     {
-        return new GroupCommand();
+        for (; first < last; ++first)
+            children.at(first)->visit(this, parentTransform, parentFlags);
+        return;
     }
 
-    auto* command = _groupCommandPool.back();
-    _groupCommandPool.pop_back();
-    command->reset();
+    const size_t base = _visitCommandListsUsed;
+    _visitCommandListsUsed += chunks;
+    while (_visitCommandLists.size() < _visitCommandListsUsed)
+        _visitCommandLists.emplace_back(std::make_unique<RenderCommandList>());
 
-    return command;
+    // every chunk of children records into its own list, one chunk per thread
+    const size_t step = (count + chunks - 1) / chunks;
+    parallelFor(_visitJobSystem, chunks, 1, [&](size_t chunk, size_t lastChunk) {
+        for (; chunk < lastChunk; ++chunk)
+        {
+            auto commandList = _visitCommandLists[base + chunk].get();
+            commandList->begin();
+            for (size_t i = first + chunk * step, end = (std::min)(i + step, last); i < end; ++i)
+            {
+                auto child = children.at(i);
+                if (child->isParallelVisitSafe())
+                    child->visit(this, parentTransform, parentFlags);
+                else
+                    commandList->deferVisit(child, parentTransform, parentFlags);
+            }
+            commandList->end();
+        }
+    });
+
+    // the deferred visits may visit in parallel too, they acquire the lists after `base + chunks`
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        auto commandList = _visitCommandLists[base + chunk].get();
+        commandList->replay(this);
+        commandList->clear();
+    }
+    _visitCommandListsUsed = base;
+}
+
+GroupCommand* Renderer::getNextGroupCommand()
+{
+    AXASSERT(!RenderCommandList::getCurrent(), "GroupCommands can't be used in a parallel visit");
+    return getFrameArena().create<GroupCommand>();
 }
 
 void Renderer::pushGroup(int renderQueueID)
 {
     AXASSERT(!_isRendering, "Cannot change render queue while rendering");
+    AXASSERT(!RenderCommandList::getCurrent(), "Render queues can't be changed in a parallel visit");
     _commandGroupStack.push(renderQueueID);
 }
 
 void Renderer::popGroup()
 {
     AXASSERT(!_isRendering, "Cannot change render queue while rendering");
+    AXASSERT(!RenderCommandList::getCurrent(), "Render queues can't be changed in a parallel visit");
     _commandGroupStack.pop();
 }
 
 int Renderer::createRenderQueue()
 {
+    AXASSERT(!RenderCommandList::getCurrent(), "Render queues can't be created in a parallel visit");
     RenderQueue newRenderQueue;
     _renderGroups.emplace_back(newRenderQueue);
     return (int)_renderGroups.size() - 1;
@@ -333,7 +521,6 @@ void Renderer::processRenderCommand(RenderCommand* command)
         break;
     case RenderCommand::Type::GROUP_COMMAND:
         processGroupCommand(static_cast<GroupCommand*>(command));
-        _groupCommandPool.emplace_back(static_cast<GroupCommand*>(command));
         break;
     case RenderCommand::Type::CUSTOM_COMMAND:
         flush();
@@ -342,7 +529,6 @@ void Renderer::processRenderCommand(RenderCommand* command)
     case RenderCommand::Type::CALLBACK_COMMAND:
         flush();
         static_cast<CallbackCommand*>(command)->execute();
-        _callbackCommandsPool.emplace_back(static_cast<CallbackCommand*>(command));
         break;
     default:
         assert(false);
@@ -404,20 +590,72 @@ void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderComma
 
 void Renderer::render()
 {
+    AX_PROFILE_ZONE("Renderer::render");
+
     // TODO: setup camera or MVP
     _isRendering = true;
     //    if (_glViewAssigned)
     {
+        _batchCacheCursor = 0;
+        _batchCacheMisses = 0;
+
         // Process render commands
         // 1. Sort render commands based on ID
+        sortRenderQueues();
+        visitRenderQueue(_renderGroups[0]);
+    }
+    clean();
+    _isRendering = false;
+}
+
+void Renderer::sortRenderQueues()
+{
+    if (!_prepareJobSystem)
+    {
         for (auto&& renderqueue : _renderGroups)
         {
             renderqueue.sort();
         }
-        visitRenderQueue(_renderGroups[0]);
+        return;
     }
-    clean();
-    _isRendering = false;
+
+    // Every sub queue of every render queue sorts independently
+    struct SortTask
+    {
+        RenderQueue* queue;
+        RenderQueue::QUEUE_GROUP group;
+    };
+    std::vector<SortTask> tasks;
+    size_t totalCommands = 0;
+    for (auto&& renderqueue : _renderGroups)
+    {
+        for (auto group : {RenderQueue::QUEUE_GROUP::TRANSPARENT_3D, RenderQueue::QUEUE_GROUP::GLOBALZ_NEG,
+                           RenderQueue::QUEUE_GROUP::GLOBALZ_POS})
+        {
+            auto size = renderqueue.getSubQueueSize(group);
+            if (size > 1)
+            {
+                tasks.emplace_back(SortTask{&renderqueue, group});
+                totalCommands += size;
+            }
+        }
+    }
+
+    if (totalCommands < PARALLEL_SORT_MIN_COMMANDS)
+    {
+        for (auto&& task : tasks)
+            task.queue->sort(task.group);
+        return;
+    }
+
+    // Big queues first, so the workers finish at about the same time
+    std::sort(tasks.begin(), tasks.end(), [](const SortTask& a, const SortTask& b) {
+        return a.queue->getSubQueueSize(a.group) > b.queue->getSubQueueSize(b.group);
+    });
+    parallelFor(_prepareJobSystem, tasks.size(), 1, [&tasks](size_t first, size_t last) {
+        for (; first < last; ++first)
+            tasks[first].queue->sort(tasks[first].group);
+    });
 }
 
 bool Renderer::beginFrame()
@@ -436,6 +674,10 @@ void Renderer::endFrame()
 #endif
     _queuedTotalIndexCount  = 0;
     _queuedTotalVertexCount = 0;
+
+    // the commands of the previous frame are rendered by now, its arena is reused for the next one
+    _frameArenaIndex ^= 1;
+    _frameArenas[_frameArenaIndex].reset();
 }
 
 void Renderer::clean()
@@ -590,20 +832,41 @@ void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
 
 void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset)
 {
-    auto destVertices = &_verts[_filledVertex];
+    fillVerticesAndIndices(cmd, vertexBufferOffset, _filledVertex, _filledIndex);
+
+    _filledVertex += cmd->getVertexCount();
+    _filledIndex += cmd->getIndexCount();
+}
+
+void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd,
+                                      unsigned int vertexBufferOffset,
+                                      unsigned int filledVertex,
+                                      unsigned int filledIndex)
+{
+    auto destVertices = &_verts[filledVertex];
     auto srcVertices = cmd->getVertices();
     auto vertexCount = cmd->getVertexCount();
     auto&& modelView = cmd->getModelView();
     MathUtil::transformVertices(destVertices, srcVertices, vertexCount, modelView);
 
-    auto destIndices = &_indices[_filledIndex];
+    auto destIndices = &_indices[filledIndex];
     auto srcIndices = cmd->getIndices();
     auto indexCount = cmd->getIndexCount();
-    auto offset = vertexBufferOffset + _filledVertex;
+    auto offset = vertexBufferOffset + filledVertex;
     MathUtil::transformIndices(destIndices, srcIndices, indexCount, int(offset));
+}
 
-    _filledVertex += vertexCount;
-    _filledIndex += indexCount;
+void Renderer::fillQueuedTriangles(unsigned int vertexBufferOffset)
+{
+    // Every command writes its own range of _verts and _indices, the offsets were computed in submit order
+    parallelFor(_prepareJobSystem, _queuedTriangleCommands.size(), PARALLEL_FILL_MIN_COMMANDS / 2,
+                [this, vertexBufferOffset](size_t first, size_t last) {
+        for (; first < last; ++first)
+        {
+            auto& offsets = _queuedTriangleFillOffsets[first];
+            fillVerticesAndIndices(_queuedTriangleCommands[first], vertexBufferOffset, offsets.first, offsets.second);
+        }
+    });
 }
 
 void Renderer::drawBatchedTriangles()
@@ -611,6 +874,18 @@ void Renderer::drawBatchedTriangles()
     if (_queuedTriangleCommands.empty())
         return;
 
+    if (_batchCacheEnabled)
+    {
+        drawCachedTriangles();
+
+        _queuedTriangleCommands.clear();
+#ifdef AX_USE_METAL
+        _queuedIndexCount  = 0;
+        _queuedVertexCount = 0;
+#endif
+        return;
+    }
+
         /************** 1: Setup up vertices/indices *************/
 #ifdef AX_USE_METAL
     unsigned int vertexBufferFillOffset = _queuedTotalVertexCount - _queuedVertexCount;
@@ -631,12 +906,24 @@ void Renderer::drawBatchedTriangles()
     _filledVertex = 0;
     _filledIndex  = 0;
 
+    // Vertex filling is deferred when preparing in parallel, only the fill offsets are recorded here
+    const bool parallelFill = _prepareJobSystem && _queuedTriangleCommands.size() >= PARALLEL_FILL_MIN_COMMANDS;
+    if (parallelFill)
+        _queuedTriangleFillOffsets.clear();
+
     for (const auto& cmd : _queuedTriangleCommands)
     {
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable   = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd, vertexBufferFillOffset);
+        if (parallelFill)
+        {
+            _queuedTriangleFillOffsets.emplace_back(_filledVertex, _filledIndex);
+            _filledVertex += cmd->getVertexCount();
+            _filledIndex += cmd->getIndexCount();
+        }
+        else
+            fillVerticesAndIndices(cmd, vertexBufferFillOffset);
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -676,6 +963,10 @@ void Renderer::drawBatchedTriangles()
         firstCommand   = false;
     }
     batchesTotal++;
+
+    if (parallelFill)
+        fillQueuedTriangles(vertexBufferFillOffset);
+
 #ifdef AX_USE_METAL
     _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]), _filledVertex * sizeof(_verts[0]));
     _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
@@ -686,14 +977,30 @@ void Renderer::drawBatchedTriangles()
 #endif
 
     /************** 2: Draw *************/
+    drawTriangleBatches(_vertexBuffer, _indexBuffer, _triBatchesToDraw, batchesTotal);
+
+    /************** 3: Cleanup *************/
+    _queuedTriangleCommands.clear();
+
+#ifdef AX_USE_METAL
+    _queuedIndexCount  = 0;
+    _queuedVertexCount = 0;
+#endif
+}
+
+void Renderer::drawTriangleBatches(backend::Buffer* vertexBuffer,
+                                   backend::Buffer* indexBuffer,
+                                   const TriBatchToDraw* batches,
+                                   int batchesTotal)
+{
     beginRenderPass();
 
-    _commandBuffer->setVertexBuffer(_vertexBuffer);
-    _commandBuffer->setIndexBuffer(_indexBuffer);
+    _commandBuffer->setVertexBuffer(vertexBuffer);
+    _commandBuffer->setIndexBuffer(indexBuffer);
 
     for (int i = 0; i < batchesTotal; ++i)
     {
-        auto& drawInfo = _triBatchesToDraw[i];
+        auto& drawInfo = batches[i];
         _commandBuffer->updatePipelineState(_currentRT, drawInfo.cmd->getPipelineDescriptor());
         auto& pipelineDescriptor = drawInfo.cmd->getPipelineDescriptor();
         _commandBuffer->setProgramState(pipelineDescriptor.programState);
@@ -701,18 +1008,150 @@ void Renderer::drawBatchedTriangles()
                                      drawInfo.indicesToDraw, drawInfo.offset * sizeof(_indices[0]));
 
         _drawnBatches++;
-        _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
+        _drawnVertices += drawInfo.indicesToDraw;
     }
 
     endRenderPass();
+}
 
-    /************** 3: Cleanup *************/
-    _queuedTriangleCommands.clear();
+void Renderer::setBatchCacheEnabled(bool enabled)
+{
+    if (_batchCacheEnabled == enabled)
+        return;
+    _batchCacheEnabled = enabled;
+    if (!enabled)
+        clearBatchCache();
+}
 
-#ifdef AX_USE_METAL
-    _queuedIndexCount  = 0;
-    _queuedVertexCount = 0;
-#endif
+void Renderer::invalidateBatchCache()
+{
+    for (auto&& entry : _batchCache)
+        entry.keys.clear();
+}
+
+void Renderer::clearBatchCache()
+{
+    for (auto&& entry : _batchCache)
+    {
+        AX_SAFE_RELEASE(entry.vertexBuffer);
+        AX_SAFE_RELEASE(entry.indexBuffer);
+    }
+    _batchCache.clear();
+}
+
+void Renderer::drawCachedTriangles()
+{
+    // Runs are matched by their flush order in the frame
+    if (_batchCacheCursor >= _batchCache.size())
+        _batchCache.emplace_back();
+    auto& entry = _batchCache[_batchCacheCursor++];
+
+    /************** 1: Find the changed commands *************/
+    const size_t count = _queuedTriangleCommands.size();
+    bool rebuild       = entry.keys.size() != count;
+    if (rebuild)
+        entry.keys.resize(count);
+
+    _batchCacheDirty.clear();
+    unsigned int vertexCount = 0;
+    unsigned int indexCount  = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto cmd = _queuedTriangleCommands[i];
+
+        BatchCacheKey key;
+        key.cmd              = cmd;
+        key.materialID       = cmd->getMaterialID();
+        key.batchable        = !cmd->isSkipBatching();
+        key.transformVersion = cmd->getTransformVersion();
+        key.vertexCount      = static_cast<unsigned int>(cmd->getVertexCount());
+        key.indexCount       = static_cast<unsigned int>(cmd->getIndexCount());
+        key.vertexOffset     = vertexCount;
+        key.indexOffset      = indexCount;
+        if (cmd->isDirtyTracking())
+            key.contentKey = cmd->getContentVersion();
+        else
+            key.contentKey = XXH3_64bits_withSeed(cmd->getIndices(), key.indexCount * sizeof(_indices[0]),
+                                                  XXH3_64bits(cmd->getVertices(), key.vertexCount * sizeof(_verts[0])));
+
+        auto& cached = entry.keys[i];
+        if (!rebuild)
+        {
+            // Layout or batching changes invalidate the whole run, otherwise the command is refilled in place
+            if (cached.cmd != key.cmd || cached.vertexCount != key.vertexCount || cached.indexCount != key.indexCount ||
+                cached.materialID != key.materialID || cached.batchable != key.batchable)
+                rebuild = true;
+            else if (cached.transformVersion != key.transformVersion || cached.contentKey != key.contentKey)
+                _batchCacheDirty.emplace_back(i);
+        }
+        cached = key;
+
+        vertexCount += key.vertexCount;
+        indexCount += key.indexCount;
+    }
+
+    if (rebuild)
+    {
+        entry.verts.resize(vertexCount);
+        entry.indices.resize(indexCount);
+        _batchCacheDirty.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            _batchCacheDirty[i] = i;
+
+        // Same batching rules as drawBatchedTriangles
+        entry.batches.clear();
+        uint32_t prevMaterialID = 0;
+        for (auto&& key : entry.keys)
+        {
+            auto cmd = const_cast<TrianglesCommand*>(key.cmd);
+            if (!entry.batches.empty() && key.batchable && prevMaterialID == key.materialID)
+            {
+                entry.batches.back().indicesToDraw += key.indexCount;
+                entry.batches.back().cmd = cmd;
+            }
+            else
+                entry.batches.emplace_back(TriBatchToDraw{cmd, key.indexCount, key.indexOffset});
+            prevMaterialID = key.batchable ? key.materialID : 0;
+        }
+    }
+
+    /************** 2: Refill and upload the changed commands *************/
+    if (!_batchCacheDirty.empty())
+    {
+        for (auto i : _batchCacheDirty)
+        {
+            auto& key = entry.keys[i];
+            MathUtil::transformVertices(&entry.verts[key.vertexOffset], key.cmd->getVertices(), key.vertexCount,
+                                        key.cmd->getModelView());
+            MathUtil::transformIndices(&entry.indices[key.indexOffset], key.cmd->getIndices(), key.indexCount,
+                                       static_cast<int>(key.vertexOffset));
+        }
+        _batchCacheMisses += _batchCacheDirty.size();
+
+        auto driver            = backend::DriverBase::getInstance();
+        const auto vertexBytes = entry.verts.size() * sizeof(_verts[0]);
+        const auto indexBytes  = entry.indices.size() * sizeof(_indices[0]);
+        if (!entry.vertexBuffer || entry.vertexBuffer->getSize() < vertexBytes)
+        {
+            AX_SAFE_RELEASE(entry.vertexBuffer);
+            entry.vertexBuffer = driver->newBuffer(vertexBytes + vertexBytes / 2, backend::BufferType::VERTEX,
+                                                   backend::BufferUsage::DYNAMIC);
+        }
+        if (!entry.indexBuffer || entry.indexBuffer->getSize() < indexBytes)
+        {
+            AX_SAFE_RELEASE(entry.indexBuffer);
+            entry.indexBuffer = driver->newBuffer(indexBytes + indexBytes / 2, backend::BufferType::INDEX,
+                                                  backend::BufferUsage::DYNAMIC);
+        }
+
+        // Upload the whole run, dynamic buffers may be multi-buffered by the backend
+        entry.vertexBuffer->updateData(entry.verts.data(), vertexBytes);
+        entry.indexBuffer->updateData(entry.indices.data(), indexBytes);
+    }
+
+    /************** 3: Draw *************/
+    drawTriangleBatches(entry.vertexBuffer, entry.indexBuffer, entry.batches.data(),
+                        static_cast<int>(entry.batches.size()));
 }
 
 void Renderer::drawCustomCommand(RenderCommand* command)
@@ -864,9 +1303,7 @@ void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigne
 {
     _clearFlag = flags;
 
-    CallbackCommand* command = nextCallbackCommand();
-    command->init(globalOrder);
-    command->func = [this, flags, color, depth, stencil]() -> void {
+    addCallbackCommand([this, flags, color, depth, stencil]() -> void {
 
         backend::RenderPassDescriptor descriptor;
 
@@ -887,22 +1324,13 @@ void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigne
                                        _scissorState.rect.width, _scissorState.rect.height);
         _commandBuffer->beginRenderPass(_currentRT, descriptor);
         _commandBuffer->endRenderPass();
-    };
-    addCommand(command);
+    }, globalOrder);
 }
 
 CallbackCommand* Renderer::nextCallbackCommand()
 {
-    CallbackCommand* cmd = nullptr;
-    if (!_callbackCommandsPool.empty())
-    {
-        cmd = _callbackCommandsPool.back();
-        cmd->reset();
-        _callbackCommandsPool.pop_back();
-    }
-    else
-        cmd = new CallbackCommand();
-    return cmd;
+    AXASSERT(!RenderCommandList::getCurrent(), "CallbackCommands can't be used in a parallel visit");
+    return getFrameArena().create<CallbackCommand>();
 }
 
 const Color4F& Renderer::getClearColor() const
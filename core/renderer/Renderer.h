@@ -30,9 +30,13 @@
 #include <array>
 #include <deque>
 #include <optional>
+#include <memory>
 
 #include "platform/PlatformMacros.h"
 #include "renderer/RenderCommand.h"
+#include "renderer/RenderCommandList.h"
+#include "renderer/FrameArena.h"
+#include "base/Vector.h"
 #include "renderer/backend/Types.h"
 #include "renderer/backend/ProgramManager.h"
 
@@ -59,6 +63,8 @@ struct PixelBufferDescriptor;
 }  // namespace backend
 
 class EventListenerCustom;
+class JobSystem;
+class Node;
 class TrianglesCommand;
 class MeshCommand;
 class GroupCommand;
@@ -101,6 +107,8 @@ public:
     ssize_t size() const;
     /**Sort the render commands.*/
     void sort();
+    /**Sort the render commands of a sub group, only GLOBALZ_NEG, TRANSPARENT_3D and GLOBALZ_POS need sorting.*/
+    void sort(QUEUE_GROUP group);
     /**Treat sorted commands as an array, access them one by one.*/
     RenderCommand* operator[](ssize_t index) const;
     /**Clear all rendered commands.*/
@@ -151,13 +159,21 @@ public:
 
     void addCallbackCommand(std::function<void()> func, float globalZOrder = 0.0f);
 
+    /** Adds a callback command, the callable is stored in the frame arena so it doesn't allocate on the heap. */
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, std::function<void()>>>>
+    void addCallbackCommand(F&& func, float globalZOrder = 0.0f)
+    {
+        auto callable = getFrameArena().create<std::decay_t<F>>(std::forward<F>(func));
+        addCallbackCommand(std::function<void()>([callable] { (*callable)(); }), globalZOrder);
+    }
+
     /** Adds a `RenderComamnd` into the renderer */
     void addCommand(RenderCommand* command);
 
     /** Adds a `RenderComamnd` into the renderer specifying a particular render queue ID */
     void addCommand(RenderCommand* command, int renderQueueID);
 
-    /** Get a `GroupCommand` from a GroupCommand pool or creates a new command if the pool is empty */
+    /** Creates a `GroupCommand` in the frame arena, it must be added during the current frame */
     GroupCommand* getNextGroupCommand();
 
     /** Pushes a group into the render queue */
@@ -186,6 +202,63 @@ public:
     /* clear draw stats */
     void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
 
+    /**
+     * The linear allocator for the callback commands, group commands and any other per frame object or scratch
+     * memory. What is allocated stays valid until the end of the next frame, so commands added after render()
+     * can be rendered by the next frame. Must only be used on the axmol thread.
+     * @since axmol-2.2
+     */
+    FrameArena& getFrameArena() { return _frameArenas[_frameArenaIndex]; }
+
+    /** Counters of the arena released by the last endFrame(), heapAllocations is 0 once the frames are steady. */
+    const FrameArena::Stats& getFrameArenaStats() const { return _frameArenas[_frameArenaIndex].getLastStats(); }
+
+    /**
+     * Enable/disable parallel render queue preparation.
+     * When enabled, sorting of the render queues and vertex filling of batched TrianglesCommands are split
+     * across the job system workers, the results are merged in submit order, so the output is identical.
+     * @param jobSystem The job system to dispatch to, nullptr disables parallel preparation.
+     */
+    void setParallelPrepare(JobSystem* jobSystem) { _prepareJobSystem = jobSystem; }
+    /** Gets the job system used to prepare render queues, nullptr when parallel preparation is disabled. */
+    JobSystem* getParallelPrepare() const { return _prepareJobSystem; }
+
+    /**
+     * Enable/disable parallel scene graph visits.
+     * When enabled, the children of the nodes opted in with Node::setParallelVisitEnabled are visited on the job
+     * system workers into RenderCommandLists, which are replayed in children order, so the render queues are
+     * identical to a serial visit.
+     * @param jobSystem The job system to dispatch to, nullptr disables parallel visits.
+     * @since axmol-2.2
+     */
+    void setParallelVisit(JobSystem* jobSystem) { _visitJobSystem = jobSystem; }
+    /** Gets the job system used to visit the scene graph, nullptr when parallel visits are disabled. */
+    JobSystem* getParallelVisit() const { return _visitJobSystem; }
+
+    /**
+     * Visits children [first, last) on the job system workers and the calling thread, then replays their
+     * commands in order. Called by Node::visit for the nodes with parallel visits enabled.
+     * @since axmol-2.2
+     */
+    void visitParallel(const Vector<Node*>& children,
+                       size_t first,
+                       size_t last,
+                       const Mat4& parentTransform,
+                       uint32_t parentFlags);
+
+    /**
+     * Enable/disable the batch cache for TrianglesCommands.
+     * When enabled, every batched run of TrianglesCommands keeps its transformed vertices and indices in persistent
+     * buffers. A run whose commands have the same material, transform version and content as in the previous frame
+     * is drawn without transforming or uploading anything, changed commands are re-transformed individually.
+     * Commands without dirty tracking (see `TrianglesCommand::setDirtyTracking`) are detected by hashing.
+     */
+    void setBatchCacheEnabled(bool enabled);
+    /** Whether the batch cache for TrianglesCommands is enabled. */
+    bool isBatchCacheEnabled() const { return _batchCacheEnabled; }
+    /** returns the number of TrianglesCommands re-transformed by the batch cache in the last frame */
+    size_t getBatchCacheMisses() const { return _batchCacheMisses; }
+
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
      @flags Flags to indicate which attachment to be replaced.
@@ -418,6 +491,7 @@ public:
     void beginRenderPass();  /// Begin a render pass.
     void endRenderPass();
 
+    /** Creates a `CallbackCommand` in the frame arena, it must be added during the current frame */
     CallbackCommand* nextCallbackCommand();
 
 protected:
@@ -486,6 +560,17 @@ protected:
     void doVisitRenderQueue(const std::vector<RenderCommand*>&);
 
     void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
+    void fillVerticesAndIndices(const TrianglesCommand* cmd,
+                                unsigned int vertexBufferOffset,
+                                unsigned int filledVertex,
+                                unsigned int filledIndex);
+
+    void sortRenderQueues();
+    void fillQueuedTriangles(unsigned int vertexBufferOffset);
+
+    void drawCachedTriangles();
+    void invalidateBatchCache();
+    void clearBatchCache();
 
     void pushStateBlock();
 
@@ -503,10 +588,9 @@ protected:
 
     std::vector<TrianglesCommand*> _queuedTriangleCommands;
 
-    // the pool for callback commands
-    std::vector<CallbackCommand*> _callbackCommandsPool;
-
-    std::vector<GroupCommand*> _groupCommandPool;
+    // per frame allocations, one arena is filled while the other one holds the previous frame
+    FrameArena _frameArenas[2];
+    int _frameArenaIndex = 0;
 
     // for TrianglesCommand
     V3F_C4B_T2F _verts[VBO_SIZE];
@@ -528,6 +612,38 @@ protected:
         unsigned int indicesToDraw = 0;
         unsigned int offset        = 0;
     };
+    void drawTriangleBatches(backend::Buffer* vertexBuffer,
+                             backend::Buffer* indexBuffer,
+                             const TriBatchToDraw* batches,
+                             int batchesTotal);
+
+    // The batch cache, one entry per flushed run of TrianglesCommands, matched by the flush order in the frame
+    struct BatchCacheKey
+    {
+        const TrianglesCommand* cmd    = nullptr;
+        uint32_t materialID            = 0;
+        bool batchable                 = false;
+        uint64_t transformVersion      = 0;
+        uint64_t contentKey            = 0;  // content version, or vertices hash without dirty tracking
+        unsigned int vertexCount       = 0;
+        unsigned int indexCount        = 0;
+        unsigned int vertexOffset      = 0;
+        unsigned int indexOffset       = 0;
+    };
+    struct BatchCacheEntry
+    {
+        std::vector<BatchCacheKey> keys;
+        std::vector<V3F_C4B_T2F> verts;
+        std::vector<unsigned short> indices;
+        std::vector<TriBatchToDraw> batches;
+        backend::Buffer* vertexBuffer = nullptr;
+        backend::Buffer* indexBuffer  = nullptr;
+    };
+    std::vector<BatchCacheEntry> _batchCache;
+    std::vector<size_t> _batchCacheDirty;
+    size_t _batchCacheCursor  = 0;
+    size_t _batchCacheMisses  = 0;
+    bool _batchCacheEnabled   = false;
     // capacity of the array of TriBatches
     int _triBatchesToDrawCapacity = 500;
     // the TriBatches
@@ -540,6 +656,17 @@ protected:
     unsigned int _filledIndex            = 0;
     unsigned int _filledVertex           = 0;
 
+    // the job system for parallel render queue preparation, weak ref
+    JobSystem* _prepareJobSystem = nullptr;
+    // the vertex & index fill offsets of _queuedTriangleCommands, only used by parallel preparation
+    std::vector<std::pair<unsigned int, unsigned int>> _queuedTriangleFillOffsets;
+
+    // the job system for parallel scene graph visits, weak ref
+    JobSystem* _visitJobSystem = nullptr;
+    // used as a stack, nested parallel visits acquire the lists after the ones of their ancestors
+    std::vector<std::unique_ptr<RenderCommandList>> _visitCommandLists;
+    size_t _visitCommandListsUsed = 0;
+
     // stats
     size_t _drawnBatches  = 0;
     size_t _drawnVertices = 0;
@@ -49,6 +49,8 @@ THE SOFTWARE.
 #include "renderer/backend/PixelFormatUtils.h"
 #include "renderer/Renderer.h"
 
+#include <atomic>
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
 #    include "renderer/TextureCache.h"
 #endif
@@ -62,6 +64,8 @@ namespace ax
 // Default is: RGBA8888 (32-bit textures)
 static backend::PixelFormat g_defaultAlphaPixelFormat = backend::PixelFormat::RGBA8;
 
+static std::atomic<uint32_t> g_uploadCount{0};
+
 Texture2D::Texture2D()
     : _pixelFormat(backend::PixelFormat::NONE)
     , _pixelsWide(0)
@@ -391,6 +395,7 @@ bool Texture2D::updateWithMipmaps(MipmapInfo* mipmaps,
         {
             _texture->updateData(outData, width, height, i, index);
         }
+        g_uploadCount.fetch_add(1, std::memory_order_relaxed);
 
         if (outData && outData != data && outDataLen > 0)
         {
@@ -440,6 +445,7 @@ bool Texture2D::updateWithSubData(void* data, int offsetX, int offsetY, int widt
     {
         uint8_t* textureData = static_cast<uint8_t*>(data);
         _texture->updateSubData(offsetX, offsetY, width, height, 0, textureData, index);
+        g_uploadCount.fetch_add(1, std::memory_order_relaxed);
         return true;
     }
     return false;
@@ -662,6 +668,11 @@ backend::PixelFormat Texture2D::getDefaultAlphaPixelFormat()
     return g_defaultAlphaPixelFormat;
 }
 
+uint32_t Texture2D::getUploadCount()
+{
+    return g_uploadCount.load(std::memory_order_relaxed);
+}
+
 unsigned int Texture2D::getBitsPerPixelForFormat(backend::PixelFormat format) const
 {
     return backend::PixelFormatUtils::getFormatDescriptor(format).bpp;
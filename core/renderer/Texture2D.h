@@ -121,6 +121,11 @@ public:
      */
     static backend::PixelFormat getDefaultAlphaPixelFormat();
 
+    /** Returns how many times texture data was uploaded to the GPU, mipmap levels and sub-regions included.
+     @since axmol-2.2
+     */
+    static uint32_t getUploadCount();
+
 public:
     /**
      * @js ctor
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <chrono>
 
 #include "renderer/Texture2D.h"
 #include "base/Macros.h"
@@ -42,6 +43,7 @@ THE SOFTWARE.
 #include "platform/FileUtils.h"
 #include "base/Utils.h"
 #include "base/NinePatchImageParser.h"
+#include "base/Profiling.h"
 #include "renderer/backend/DriverBase.h"
 
 using namespace std;
@@ -63,7 +65,22 @@ std::string TextureCache::getETC1AlphaFileSuffix()
     return s_etc1AlphaFileSuffix;
 }
 
-TextureCache::TextureCache() : _loadingThread(nullptr), _needQuit(false), _asyncRefCount(0) {}
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+TextureCache::TextureCache()
+    : _loaderJobs(0)
+    , _asyncDecodeWorkers(1)
+    , _needQuit(false)
+    , _asyncRefCount(0)
+    , _uploadBudgetMs(0)
+    , _uploadBudgetBytes(0)
+{
+    if (auto jobSystem = Director::getInstance()->getJobSystem())
+        _asyncDecodeWorkers = (std::max)(jobSystem->getThreadCount() / 2, 1);
+}
 
 TextureCache::~TextureCache()
 {
@@ -71,8 +88,6 @@ TextureCache::~TextureCache()
 
     for (auto&& texture : _textures)
         texture.second->release();
-
-    AX_SAFE_DELETE(_loadingThread);
 }
 
 std::string TextureCache::getDescription() const
@@ -83,12 +98,15 @@ std::string TextureCache::getDescription() const
 struct TextureCache::AsyncStruct
 {
 public:
-    AsyncStruct(std::string_view fn, const std::function<void(Texture2D*)>& f, std::string_view key)
+    AsyncStruct(std::string_view fn, const std::function<void(Texture2D*)>& f, std::string_view key, int prio)
         : filename(fn)
         , callback(f)
         , callbackKey(key)
         , pixelFormat(Texture2D::getDefaultAlphaPixelFormat())
+        , priority(prio)
         , loadSuccess(false)
+        , cancelled(false)
+        , queueIndex(0)
     {}
 
     std::string filename;
@@ -97,7 +115,10 @@ public:
     Image image;
     Image imageAlpha;
     backend::PixelFormat pixelFormat;
+    int priority;
     bool loadSuccess;
+    std::atomic<bool> cancelled;
+    size_t queueIndex;  // position in _asyncStructQueue
 };
 
 /**
@@ -174,6 +195,14 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 void TextureCache::addImageAsync(std::string_view path,
                                  const std::function<void(Texture2D*)>& callback,
                                  std::string_view callbackKey)
+{
+    addImageAsync(path, callback, callbackKey, 0);
+}
+
+void TextureCache::addImageAsync(std::string_view path,
+                                 const std::function<void(Texture2D*)>& callback,
+                                 std::string_view callbackKey,
+                                 int priority)
 {
     Texture2D* texture = nullptr;
 
@@ -198,14 +227,6 @@ void TextureCache::addImageAsync(std::string_view path,
         return;
     }
 
-    // lazy init
-    if (_loadingThread == nullptr)
-    {
-        // create a new thread to load images
-        _needQuit      = false;
-        _loadingThread = new std::thread(&TextureCache::loadImage, this);
-    }
-
     if (0 == _asyncRefCount)
     {
         Director::getInstance()->getScheduler()->schedule(AX_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack),
@@ -215,13 +236,22 @@ void TextureCache::addImageAsync(std::string_view path,
     ++_asyncRefCount;
 
     // generate async struct
-    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey);
+    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey, priority);
 
-    // add async struct into queue
+    // add async struct into queue, after the requests of the same or higher priority
+    data->queueIndex = _asyncStructQueue.size();
     _asyncStructQueue.emplace_back(data);
     std::unique_lock<std::mutex> ul(_requestMutex);
-    _requestQueue.emplace_back(data);
-    _sleepCondition.notify_one();
+    auto pos = std::find_if(_requestQueue.begin(), _requestQueue.end(),
+                            [priority](AsyncStruct* request) { return request->priority < priority; });
+    _requestQueue.insert(pos, data);
+    if (_loaderJobs >= _asyncDecodeWorkers)
+        return;
+
+    // decode images on the shared job system, each loader job drains the queue until it's empty
+    ++_loaderJobs;
+    ul.unlock();
+    Director::getInstance()->getJobSystem()->enqueue([this] { loadImage(); });
 }
 
 void TextureCache::unbindImageAsync(std::string_view callbackKey)
@@ -252,58 +282,202 @@ void TextureCache::unbindAllImageAsync()
     }
 }
 
+void TextureCache::cancelImageAsync(std::string_view callbackKey)
+{
+    if (_asyncStructQueue.empty())
+    {
+        return;
+    }
+
+    std::vector<AsyncStruct*> dropped;
+    {
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        auto it = std::remove_if(_requestQueue.begin(), _requestQueue.end(), [callbackKey](AsyncStruct* request) {
+            return request->callbackKey == callbackKey;
+        });
+        dropped.assign(it, _requestQueue.end());
+        _requestQueue.erase(it, _requestQueue.end());
+    }
+
+    // the decoding ones are discarded by addImageAsyncCallBack
+    for (auto&& asyncStruct : _asyncStructQueue)
+    {
+        if (asyncStruct->callbackKey == callbackKey)
+        {
+            asyncStruct->callback = nullptr;
+            asyncStruct->cancelled.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    for (auto asyncStruct : dropped)
+        releaseAsyncStruct(asyncStruct);
+    addCancelledStats(dropped.size());
+
+    if (0 == _asyncRefCount)
+    {
+        Director::getInstance()->getScheduler()->unschedule(AX_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack),
+                                                            this);
+    }
+}
+
+void TextureCache::cancelAllImageAsync()
+{
+    if (_asyncStructQueue.empty())
+    {
+        return;
+    }
+
+    std::deque<AsyncStruct*> dropped;
+    {
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        dropped.swap(_requestQueue);
+    }
+
+    for (auto&& asyncStruct : _asyncStructQueue)
+    {
+        asyncStruct->callback = nullptr;
+        asyncStruct->cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    for (auto asyncStruct : dropped)
+        releaseAsyncStruct(asyncStruct);
+    addCancelledStats(dropped.size());
+
+    if (0 == _asyncRefCount)
+    {
+        Director::getInstance()->getScheduler()->unschedule(AX_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack),
+                                                            this);
+    }
+}
+
+void TextureCache::setAsyncDecodeWorkers(int workers)
+{
+    // takes effect on the next request, running loader jobs finish their queue
+    _asyncDecodeWorkers = (std::max)(workers, 1);
+}
+
+void TextureCache::setAsyncUploadBudget(float milliseconds, size_t bytes)
+{
+    _uploadBudgetMs    = (std::max)(milliseconds, 0.0f);
+    _uploadBudgetBytes = bytes;
+}
+
+TextureCache::AsyncLoadStats TextureCache::getAsyncLoadStats()
+{
+    AsyncLoadStats stats;
+    {
+        std::lock_guard<std::mutex> lock(_responseMutex);
+        stats                = _asyncStats;
+        stats.pendingUploads = _responseQueue.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        stats.pendingDecodes = _requestQueue.size();
+    }
+    // whatever isn't queued nor decoded yet is being decoded
+    auto outstanding    = _asyncStructQueue.size();
+    auto queued         = stats.pendingDecodes + stats.pendingUploads;
+    stats.activeDecodes = outstanding > queued ? outstanding - queued : 0;
+    return stats;
+}
+
+void TextureCache::resetAsyncLoadStats()
+{
+    std::lock_guard<std::mutex> lock(_responseMutex);
+    _asyncStats = AsyncLoadStats{};
+}
+
+void TextureCache::addCancelledStats(size_t count)
+{
+    if (count == 0)
+        return;
+    std::lock_guard<std::mutex> lock(_responseMutex);
+    _asyncStats.cancelled += static_cast<uint32_t>(count);
+}
+
+void TextureCache::releaseAsyncStruct(AsyncStruct* asyncStruct)
+{
+    // swap-remove, the queue order doesn't matter
+    auto last = _asyncStructQueue.back();
+    _asyncStructQueue[asyncStruct->queueIndex] = last;
+    last->queueIndex                          = asyncStruct->queueIndex;
+    _asyncStructQueue.pop_back();
+    delete asyncStruct;
+    --_asyncRefCount;
+}
+
 void TextureCache::loadImage()
 {
     AsyncStruct* asyncStruct = nullptr;
-    while (!_needQuit)
+    for (;;)
     {
         std::unique_lock<std::mutex> ul(_requestMutex);
-        // pop an AsyncStruct from request queue
-        if (_requestQueue.empty())
-        {
-            asyncStruct = nullptr;
-        }
-        else
+        // pop the most important AsyncStruct from request queue, the loader job ends once it's empty
+        if (_requestQueue.empty() || _needQuit)
         {
-            asyncStruct = _requestQueue.front();
-            _requestQueue.pop_front();
+            --_loaderJobs;
+            _sleepCondition.notify_all();
+            break;
         }
+        asyncStruct = _requestQueue.front();
+        _requestQueue.pop_front();
+        ul.unlock();
 
-        if (nullptr == asyncStruct)
+        auto start   = std::chrono::steady_clock::now();
+        bool decoded = !asyncStruct->cancelled.load(std::memory_order_relaxed);
+        if (decoded)
         {
-            if (_needQuit)
-            {
-                break;
+            AX_PROFILE_ZONE("TextureCache::decodeImage");
+
+            // load image
+            asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
+
+            // ETC1 ALPHA supports.
+            if (asyncStruct->loadSuccess && asyncStruct->image.getFileType() == Image::Format::ETC1 &&
+                !s_etc1AlphaFileSuffix.empty())
+            {  // check whether alpha texture exists & load it
+                auto alphaFile = asyncStruct->filename + s_etc1AlphaFileSuffix;
+                if (FileUtils::getInstance()->isFileExist(alphaFile))
+                    asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
             }
-            _sleepCondition.wait(ul);
-            continue;
         }
-        ul.unlock();
+        auto decodeTime = elapsedMilliseconds(start);
 
-        // load image
-        asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
-
-        // ETC1 ALPHA supports.
-        if (asyncStruct->loadSuccess && asyncStruct->image.getFileType() == Image::Format::ETC1 &&
-            !s_etc1AlphaFileSuffix.empty())
-        {  // check whether alpha texture exists & load it
-            auto alphaFile = asyncStruct->filename + s_etc1AlphaFileSuffix;
-            if (FileUtils::getInstance()->isFileExist(alphaFile))
-                asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
-        }
         // push the asyncStruct to response queue
         _responseMutex.lock();
         _responseQueue.emplace_back(asyncStruct);
+        if (decoded)
+        {
+            ++_asyncStats.decoded;
+            _asyncStats.decodeTime += decodeTime;
+            _asyncStats.maxDecodeTime = (std::max)(_asyncStats.maxDecodeTime, decodeTime);
+        }
         _responseMutex.unlock();
     }
 }
 
 void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
+    AX_PROFILE_ZONE("TextureCache::addImageAsyncCallBack");
+
     Texture2D* texture       = nullptr;
     AsyncStruct* asyncStruct = nullptr;
+
+    auto frameStart         = std::chrono::steady_clock::now();
+    double frameTime        = 0;
+    double frameMaxTime     = 0;
+    size_t frameBytes       = 0;
+    uint32_t frameUploads   = 0;
+    uint32_t frameCancelled = 0;
     while (true)
     {
+        // stop uploading once the frame budget is spent, the rest waits for the next frames
+        if (frameUploads > 0 && ((_uploadBudgetMs > 0 && elapsedMilliseconds(frameStart) >= _uploadBudgetMs) ||
+                                 (_uploadBudgetBytes > 0 && frameBytes >= _uploadBudgetBytes)))
+        {
+            break;
+        }
+
         // pop an AsyncStruct from response queue
         _responseMutex.lock();
         if (_responseQueue.empty())
@@ -314,10 +488,6 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         {
             asyncStruct = _responseQueue.front();
             _responseQueue.pop_front();
-
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            AX_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
         }
         _responseMutex.unlock();
 
@@ -326,6 +496,13 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             break;
         }
 
+        if (asyncStruct->cancelled.load(std::memory_order_relaxed))
+        {
+            ++frameCancelled;
+            releaseAsyncStruct(asyncStruct);
+            continue;
+        }
+
         // check the image has been convert to texture or not
         auto it = _textures.find(asyncStruct->filename);
         if (it != _textures.end())
@@ -337,7 +514,10 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             // convert image to texture
             if (asyncStruct->loadSuccess)
             {
-                Image* image = &(asyncStruct->image);
+                auto uploadStart = std::chrono::steady_clock::now();
+                Image* image     = &(asyncStruct->image);
+                frameBytes += image->getDataLen();
+
                 // generate texture in render thread
                 texture = new Texture2D();
 
@@ -356,8 +536,14 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
                 // ETC1 ALPHA supports.
                 if (asyncStruct->imageAlpha.getFileType() == Image::Format::ETC1)
                 {
+                    frameBytes += asyncStruct->imageAlpha.getDataLen();
                     texture->updateWithImage(&asyncStruct->imageAlpha, asyncStruct->pixelFormat, 1);
                 }
+
+                auto uploadTime = elapsedMilliseconds(uploadStart);
+                frameTime += uploadTime;
+                frameMaxTime = (std::max)(frameMaxTime, uploadTime);
+                ++frameUploads;
             }
             else
             {
@@ -373,8 +559,22 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         }
 
         // release the asyncStruct
-        delete asyncStruct;
-        --_asyncRefCount;
+        releaseAsyncStruct(asyncStruct);
+    }
+
+    if (frameUploads > 0 || frameCancelled > 0)
+    {
+        // the loader jobs update the decode stats concurrently
+        std::lock_guard<std::mutex> lock(_responseMutex);
+        _asyncStats.cancelled += frameCancelled;
+        if (frameUploads > 0)
+        {
+            _asyncStats.uploaded += frameUploads;
+            _asyncStats.uploadTime += frameTime;
+            _asyncStats.maxUploadTime        = (std::max)(_asyncStats.maxUploadTime, frameMaxTime);
+            _asyncStats.lastFrameUploadTime  = frameTime;
+            _asyncStats.lastFrameUploadBytes = frameBytes;
+        }
     }
 
     if (0 == _asyncRefCount)
@@ -455,6 +655,8 @@ Texture2D* TextureCache::addImage(std::string_view path, PixelFormat format)
 
     if (!texture)
     {
+        AX_PROFILE_ZONE("TextureCache::addImage");
+
         // all images are handled by UIImage except PVR extension that is handled by our own handler
         do
         {
@@ -743,13 +945,10 @@ std::string TextureCache::getTextureFilePath(ax::Texture2D* texture) const
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
+    // notify the loader job to quit and wait for the image in progress
     std::unique_lock<std::mutex> ul(_requestMutex);
     _needQuit = true;
-    _sleepCondition.notify_one();
-    ul.unlock();
-    if (_loadingThread)
-        _loadingThread->join();
+    _sleepCondition.wait(ul, [this] { return _loaderJobs == 0; });
 }
 
 std::string TextureCache::getCachedTextureInfo() const
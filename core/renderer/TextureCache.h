@@ -124,6 +124,54 @@ public:
                        const std::function<void(Texture2D*)>& callback,
                        std::string_view callbackKey);
 
+    /** Same as addImageAsync, requests with a higher priority are decoded first.
+     * Requests of the same priority are decoded in the order they were added.
+     */
+    void addImageAsync(std::string_view path,
+                       const std::function<void(Texture2D*)>& callback,
+                       std::string_view callbackKey,
+                       int priority);
+
+    /** Cancels the asynchronous loads bound to callbackKey.
+     * Requests still waiting for a decode worker are dropped without being decoded, a decode already in
+     * progress finishes but its image is discarded instead of being uploaded. The callback is never invoked.
+     */
+    void cancelImageAsync(std::string_view callbackKey);
+
+    /** Cancels all pending asynchronous loads, see cancelImageAsync. */
+    void cancelAllImageAsync();
+
+    /** Sets the max number of images decoded concurrently on the JobSystem, default is half of its threads. */
+    void setAsyncDecodeWorkers(int workers);
+    int getAsyncDecodeWorkers() const { return _asyncDecodeWorkers; }
+
+    /** Limits the textures uploaded per frame by addImageAsync, 0 means unlimited.
+     * At least one texture is uploaded per frame whatever the budget.
+     * @param milliseconds Upload time allowed per frame.
+     * @param bytes Image bytes allowed per frame.
+     */
+    void setAsyncUploadBudget(float milliseconds, size_t bytes = 0);
+
+    struct AsyncLoadStats
+    {
+        size_t pendingDecodes{0};  // requests waiting for a decode worker
+        size_t activeDecodes{0};   // images being decoded
+        size_t pendingUploads{0};  // decoded images waiting for the main thread
+        uint32_t decoded{0};
+        uint32_t uploaded{0};
+        uint32_t cancelled{0};
+        double decodeTime{0};  // total decode time in milliseconds, summed over workers
+        double maxDecodeTime{0};
+        double uploadTime{0};  // total upload time in milliseconds
+        double maxUploadTime{0};
+        double lastFrameUploadTime{0};
+        size_t lastFrameUploadBytes{0};
+    };
+
+    /** Gets the asynchronous load statistics, counters accumulate until resetAsyncLoadStats. */
+    AsyncLoadStats getAsyncLoadStats();
+    void resetAsyncLoadStats();
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is
      * invoked, the object always need to unbind this callback manually.
@@ -233,10 +281,12 @@ public:
 protected:
     struct AsyncStruct;
 
-    std::thread* _loadingThread;
 
-    std::deque<AsyncStruct*> _asyncStructQueue;
-    std::deque<AsyncStruct*> _requestQueue;
+    void releaseAsyncStruct(AsyncStruct* asyncStruct);
+    void addCancelledStats(size_t count);
+
+    std::vector<AsyncStruct*> _asyncStructQueue;  // unordered, each AsyncStruct knows its index
+    std::deque<AsyncStruct*> _requestQueue;  // sorted by priority
     std::deque<AsyncStruct*> _responseQueue;
 
     std::mutex _requestMutex;
@@ -244,10 +294,16 @@ protected:
 
     std::condition_variable _sleepCondition;
 
+    int _loaderJobs;
+    int _asyncDecodeWorkers;
     bool _needQuit;
 
     int _asyncRefCount;
 
+    float _uploadBudgetMs;
+    size_t _uploadBudgetBytes;
+    AsyncLoadStats _asyncStats;  // locked by _responseMutex
+
     hlookup::string_map<Texture2D*> _textures;
 
     static std::string s_etc1AlphaFileSuffix;
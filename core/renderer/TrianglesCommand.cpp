@@ -29,12 +29,23 @@
 #include "renderer/Texture2D.h"
 #include "base//Utils.h"
 
+#include <atomic>
+
 namespace ax
 {
 
+static uint64_t nextCommandVersion()
+{
+    static std::atomic<uint64_t> s_version{0};
+    return ++s_version;
+}
+
 TrianglesCommand::TrianglesCommand()
 {
     _type = RenderCommand::Type::TRIANGLES_COMMAND;
+
+    _contentVersion   = nextCommandVersion();
+    _transformVersion = nextCommandVersion();
 }
 
 void TrianglesCommand::init(float globalOrder,
@@ -46,6 +57,10 @@ void TrianglesCommand::init(float globalOrder,
 {
     RenderCommand::init(globalOrder, mv, flags);
 
+    if (_triangles.verts != triangles.verts || _triangles.indices != triangles.indices ||
+        _triangles.vertCount != triangles.vertCount || _triangles.indexCount != triangles.indexCount)
+        _contentVersion = nextCommandVersion();
+
     _triangles = triangles;
     if (_triangles.indexCount % 3 != 0)
     {
@@ -53,7 +68,12 @@ void TrianglesCommand::init(float globalOrder,
         _triangles.indexCount = count / 3 * 3;
         AXLOGE("Resize indexCount from {} to {}, size must be multiple times of 3", count, _triangles.indexCount);
     }
-    _mv = mv;
+
+    if (memcmp(_mv.m, mv.m, sizeof(_mv.m)) != 0)
+    {
+        _mv               = mv;
+        _transformVersion = nextCommandVersion();
+    }
 
     auto batchId = _pipelineDescriptor.programState->getBatchId();
     if (_batchId != batchId || _texture != texture->getBackendTexture() || _blendType != blendType)
@@ -76,6 +96,11 @@ void TrianglesCommand::init(float globalOrder,
     }
 }
 
+void TrianglesCommand::markContentDirty()
+{
+    _contentVersion = nextCommandVersion();
+}
+
 void TrianglesCommand::updateMaterialID()
 {
     setSkipBatching(false);
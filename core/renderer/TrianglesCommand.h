@@ -107,6 +107,20 @@ public:
     /** update material ID */
     void updateMaterialID();
 
+    /**
+     Set whether the owner reports in place modifications of the vertices or indices by `markContentDirty`.
+     Without it, the renderer batch cache has to hash the vertices every frame to detect changes.
+     */
+    void setDirtyTracking(bool enabled) { _dirtyTracking = enabled; }
+    /**Whether the owner reports in place modifications of the vertices or indices.*/
+    bool isDirtyTracking() const { return _dirtyTracking; }
+    /**Notify that the vertices or indices were modified in place.*/
+    void markContentDirty();
+    /**Get the content version, it changes whenever the vertices or indices are modified.*/
+    uint64_t getContentVersion() const { return _contentVersion; }
+    /**Get the transform version, it changes whenever the model view matrix is modified.*/
+    uint64_t getTransformVersion() const { return _transformVersion; }
+
 protected:
     /**Generate the material ID by textureID, glProgramState, and blend function.*/
     void generateMaterialID();
@@ -121,6 +135,11 @@ protected:
     BlendFunc _blendType              = BlendFunc::DISABLE;
     uint64_t _batchId                 = 0;
     backend::TextureBackend* _texture = nullptr;
+
+    // Versions are unique across commands, so a recycled command never matches a stale cache entry.
+    uint64_t _contentVersion   = 0;
+    uint64_t _transformVersion = 0;
+    bool _dirtyTracking        = false;
 };
 
 }
@@ -29,4 +29,10 @@ NS_AX_BACKEND_BEGIN
 
 DriverBase* DriverBase::_instance = nullptr;
 
+void DriverBase::setInstance(DriverBase* driver)
+{
+    AXASSERT(!_instance, "The driver must be installed before it is used");
+    _instance = driver;
+}
+
 NS_AX_BACKEND_END
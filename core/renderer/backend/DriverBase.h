@@ -84,6 +84,13 @@ public:
     static DriverBase* getInstance();
     static void destroyInstance();
 
+    /**
+     * Installs a driver before the first getInstance() call, to run on another backend than the
+     * platform default, e.g. DriverNull for headless runs. Takes the ownership of driver.
+     * @since axmol-2.2
+     */
+    static void setInstance(DriverBase* driver);
+
     virtual ~DriverBase() = default;
 
     /**
@@ -145,6 +152,13 @@ public:
      */
     virtual Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) = 0;
 
+    /**
+     * Sets the directory of the on-disk cache of linked programs, an empty path disables the cache.
+     * Ignored by the backends which can't retrieve program binaries.
+     * @since axmol-2.2
+     */
+    virtual void setProgramCacheDir(std::string_view /*dir*/) {}
+
     virtual void resetState() {};
 
     /// below is driver info
@@ -29,9 +29,13 @@
 #include "renderer/Shaders.h"
 #include "base/Macros.h"
 #include "base/Configuration.h"
+#include "base/Director.h"
+#include "base/Scheduler.h"
+#include "base/AsyncTaskPool.h"
 
 #include "xxhash.h"
 #include <inttypes.h>
+#include <chrono>
 
 NS_AX_BACKEND_BEGIN
 
@@ -62,6 +66,13 @@ ProgramManager::ProgramManager()
 
 ProgramManager::~ProgramManager()
 {
+    if (!_warmUps.empty())
+    {
+        for (auto&& batch : _warmUps)
+            batch->cancelled = true;
+        Director::getInstance()->getScheduler()->unschedule("ProgramManager.warmUp"sv, this);
+    }
+
     XXH64_freeState(_programIdGen);
 
     for (auto&& program : _cachedPrograms)
@@ -93,6 +104,10 @@ bool ProgramManager::init()
     fileUtils->addSearchPath("axslc"sv);
 #endif
 
+#if AX_ENABLE_PROGRAM_CACHE
+    DriverBase::getInstance()->setProgramCacheDir(joinPath(fileUtils->getWritablePath(), "program-cache/"sv));
+#endif
+
     registerProgram(ProgramType::POSITION_TEXTURE_COLOR, positionTextureColor_vert, positionTextureColor_frag,
                     VertexLayoutType::Sprite);
     registerProgram(ProgramType::DUAL_SAMPLER, positionTextureColor_vert, dualSampler_frag, VertexLayoutType::Sprite);
@@ -210,7 +225,16 @@ Program* ProgramManager::loadProgram(std::string_view vsName,
     auto fragFile   = fileUtils->fullPathForFilename(fsName);
     auto vertSource = fileUtils->getStringFromFile(vertFile);
     auto fragSource = fileUtils->getStringFromFile(fragFile);
-    auto program    = backend::DriverBase::getInstance()->newProgram(vertSource, fragSource);
+    return createProgram(vertSource, fragSource, progType, progId, vlt);
+}
+
+Program* ProgramManager::createProgram(std::string_view vertSource,
+                                       std::string_view fragSource,
+                                       uint32_t progType,
+                                       uint64_t progId,
+                                       VertexLayoutType vlt)
+{
+    auto program = backend::DriverBase::getInstance()->newProgram(vertSource, fragSource);
 
     if (program)
     {
@@ -222,6 +246,96 @@ Program* ProgramManager::loadProgram(std::string_view vsName,
     return program;
 }
 
+void ProgramManager::warmUpPrograms(std::vector<uint64_t> progIds, std::function<void()> callback, float budgetMs)
+{
+    auto batch      = std::make_shared<WarmUpBatch>();
+    batch->callback = std::move(callback);
+    batch->budgetMs = budgetMs;
+
+    auto fileUtils = FileUtils::getInstance();
+    for (auto progId : progIds)
+    {
+        if (_cachedPrograms.find(progId) != _cachedPrograms.end())
+            continue;
+
+        const BuiltinRegInfo* info = nullptr;
+        uint32_t progType          = ProgramType::CUSTOM_PROGRAM;
+        if (progId < ProgramType::BUILTIN_COUNT)
+        {
+            info     = &_builtinRegistry[static_cast<int>(progId)];
+            progType = static_cast<uint32_t>(progId);
+        }
+        else if (auto it = _customRegistry.find(progId); it != _customRegistry.end())
+            info = &it->second;
+
+        if (info)
+            batch->tasks.emplace_back(WarmUpTask{progType, progId, info->vlt, fileUtils->fullPathForFilename(info->vsName),
+                                                 fileUtils->fullPathForFilename(info->fsName)});
+    }
+    _warmUps.emplace_back(batch);
+
+    auto readSources = [batch] {
+        auto fileUtils = FileUtils::getInstance();
+        for (auto&& task : batch->tasks)
+        {
+            if (batch->cancelled)
+                return;
+            task.vertSource = fileUtils->getStringFromFile(task.vertFile);
+            task.fragSource = fileUtils->getStringFromFile(task.fragFile);
+        }
+    };
+    auto sourcesRead = [this, batch] {
+        if (batch->cancelled)
+            return;
+        batch->ready   = true;
+        auto scheduler = Director::getInstance()->getScheduler();
+        if (!scheduler->isScheduled("ProgramManager.warmUp"sv, this))
+            scheduler->schedule(AX_CALLBACK_1(ProgramManager::updateWarmUp, this), this, 0, false,
+                                "ProgramManager.warmUp"sv);
+    };
+
+    // reading the files blocks, so it runs on the io thread instead of the job system
+    AsyncTaskPool::getInstance()->enqueue(
+        AsyncTaskPool::TaskType::TASK_IO, [sourcesRead = std::move(sourcesRead)](void*) { sourcesRead(); }, nullptr,
+        std::move(readSources));
+}
+
+void ProgramManager::updateWarmUp(float /*dt*/)
+{
+    using namespace std::chrono;
+    const auto start = steady_clock::now();
+    int created      = 0;
+
+    // the batches complete in submission order, a batch waits for the sources of the previous one
+    while (!_warmUps.empty() && _warmUps.front()->ready)
+    {
+        auto& batch       = *_warmUps.front();
+        const auto budget = duration<float, std::milli>(batch.budgetMs);
+        while (batch.next < batch.tasks.size())
+        {
+            if (created > 0 && steady_clock::now() - start >= budget)
+                return;
+
+            auto& task = batch.tasks[batch.next++];
+            if (_cachedPrograms.find(task.progId) == _cachedPrograms.end())
+            {
+                createProgram(task.vertSource, task.fragSource, task.progType, task.progId, task.vlt);
+                ++created;
+            }
+            std::string{}.swap(task.vertSource);
+            std::string{}.swap(task.fragSource);
+        }
+
+        auto callback = std::move(batch.callback);
+        _warmUps.erase(_warmUps.begin());
+        if (callback)
+            callback();
+    }
+
+    if (_warmUps.empty() || !_warmUps.front()->ready)
+        Director::getInstance()->getScheduler()->unschedule("ProgramManager.warmUp"sv, this);
+}
+
 uint64_t ProgramManager::registerCustomProgram(std::string_view vsName,
                                                std::string_view fsName,
                                                VertexLayoutType vlt,
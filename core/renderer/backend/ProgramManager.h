@@ -30,9 +30,13 @@
 #include "platform/PlatformMacros.h"
 #include "Program.h"
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <string_view>
+#include <vector>
 #include "ProgramStateRegistry.h"
 
 struct XXH64_state_s;
@@ -88,6 +92,22 @@ public:
                                std::string_view fsName,
                                VertexLayoutType vlt = VertexLayoutType::Unspec);
 
+    /**
+     * Loads programs ahead of their first use without stalling a frame: the shader sources are read on
+     * the AsyncTaskPool io thread, then the programs are created on the render thread, as many per frame as fit in
+     * budgetMs. With the program cache enabled, most of them are created from their linked binary.
+     * @param progIds Builtin program types or ids returned by registerCustomProgram, unknown ids are skipped.
+     * @param callback Invoked on the render thread once all the programs are loaded.
+     * @param budgetMs The time spent creating programs per frame, at least one program is created per frame.
+     * @since axmol-2.2
+     */
+    void warmUpPrograms(std::vector<uint64_t> progIds,
+                        std::function<void()> callback = nullptr,
+                        float budgetMs                 = 4.0f);
+
+    /** Whether programs queued by warmUpPrograms are still loading. */
+    bool isWarmingUp() const { return !_warmUps.empty(); }
+
      /**
      * Unload a program object from cache.
      * @param program Specifies the program object to move.
@@ -147,8 +167,40 @@ protected:
                          uint64_t progId,
                          VertexLayoutType vlt);
 
+    /**
+     * create a program from sources and add it to the cache
+     */
+    Program* createProgram(std::string_view vertSource,
+                           std::string_view fragSource,
+                           uint32_t progType,
+                           uint64_t progId,
+                           VertexLayoutType vlt);
+
     uint64_t computeProgramId(std::string_view vsName, std::string_view fsName);
 
+    struct WarmUpTask
+    {
+        uint32_t progType;
+        uint64_t progId;
+        VertexLayoutType vlt;
+        std::string vertFile;
+        std::string fragFile;
+        std::string vertSource;
+        std::string fragSource;
+    };
+
+    struct WarmUpBatch
+    {
+        std::vector<WarmUpTask> tasks;
+        size_t next{0};
+        std::function<void()> callback;
+        float budgetMs{0};
+        bool ready{false};  // the sources are read
+        std::atomic<bool> cancelled{false};
+    };
+
+    void updateWarmUp(float dt);
+
     struct BuiltinRegInfo
     {  // builtin shader name is literal string, so use std::string_view ok
         std::string_view vsName;
@@ -163,6 +215,8 @@ protected:
 
     XXH64_state_s* _programIdGen;
 
+    std::vector<std::shared_ptr<WarmUpBatch>> _warmUps;  ///< in submission order
+
     static ProgramManager* _sharedProgramManager;  ///< A shared instance of the program cache.
 };
 
@@ -25,6 +25,7 @@
 
 #include "VertexLayout.h"
 #include "base/Macros.h"
+#include "xxhash.h"
 #include <cassert>
 
 NS_AX_BACKEND_BEGIN
@@ -46,11 +47,47 @@ void VertexLayout::setAttrib(std::string_view name,
         _attributes, name,
         Attribute{name, index, format, offset,
                   needToBeNormallized});  // _attributes[name] = {name, index, format, offset, needToBeNormallized};
+    _hash = 0;
 }
 
 void VertexLayout::setStride(std::size_t stride)
 {
     _stride = stride;
+    _hash   = 0;
+}
+
+uint64_t VertexLayout::getHash() const
+{
+    if (_hash == 0)
+    {
+        // pack the attributes by index so the hash doesn't depend on the map iteration order
+        struct PackedAttribute
+        {
+            uint32_t offset;
+            uint16_t format;
+            uint8_t normalized;
+            uint8_t used;
+        } packed[32]{};
+        static_assert(sizeof(PackedAttribute) == 8, "PackedAttribute must not be padded");
+
+        for (auto&& item : _attributes)
+        {
+            auto& attribute = item.second;
+            if (attribute.index < std::size(packed))
+            {
+                auto& slot      = packed[attribute.index];
+                slot.offset     = static_cast<uint32_t>(attribute.offset);
+                slot.format     = static_cast<uint16_t>(attribute.format);
+                slot.normalized = attribute.needToBeNormallized;
+                slot.used       = 1;
+            }
+        }
+
+        _hash = XXH64(packed, sizeof(packed), _stride);
+        if (_hash == 0)
+            _hash = 1;
+    }
+    return _hash;
 }
 
 NS_AX_BACKEND_END
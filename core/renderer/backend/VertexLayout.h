@@ -121,9 +121,17 @@ public:
      */
     inline bool isValid() const { return _stride != 0; }
 
+    /**
+     * Gets a hash of the attribute indices, formats and offsets and of the stride.
+     * Layouts with the same hash are bound the same way, whatever the attribute names.
+     * @since axmol-2.2
+     */
+    uint64_t getHash() const;
+
 private:
     hlookup::string_map<Attribute> _attributes;
     std::size_t _stride      = 0;
+    mutable uint64_t _hash   = 0;  // lazily computed, 0 when dirty
     VertexStepMode _stepMode = VertexStepMode::VERTEX;
 };
 
@@ -0,0 +1,278 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "CommandBufferNull.h"
+#include "DriverNull.h"
+#include "../Buffer.h"
+#include "../RenderTarget.h"
+#include "../Program.h"
+#include "renderer/PipelineDescriptor.h"
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+bool operator==(const BlendDescriptor& lhs, const BlendDescriptor& rhs)
+{
+    return lhs.writeMask == rhs.writeMask && lhs.blendEnabled == rhs.blendEnabled &&
+           lhs.rgbBlendOperation == rhs.rgbBlendOperation && lhs.alphaBlendOperation == rhs.alphaBlendOperation &&
+           lhs.sourceRGBBlendFactor == rhs.sourceRGBBlendFactor &&
+           lhs.destinationRGBBlendFactor == rhs.destinationRGBBlendFactor &&
+           lhs.sourceAlphaBlendFactor == rhs.sourceAlphaBlendFactor &&
+           lhs.destinationAlphaBlendFactor == rhs.destinationAlphaBlendFactor;
+}
+
+bool operator==(const DepthStencilDescriptor& lhs, const DepthStencilDescriptor& rhs)
+{
+    return lhs.flags == rhs.flags && lhs.depthCompareFunction == rhs.depthCompareFunction &&
+           lhs.frontFaceStencil == rhs.frontFaceStencil && lhs.backFaceStencil == rhs.backFaceStencil;
+}
+}  // namespace
+
+CommandBufferNull::CommandBufferNull(NullDriverStats& stats) : _stats(stats) {}
+
+CommandBufferNull::~CommandBufferNull()
+{
+    AX_SAFE_RELEASE(_vertexBuffer);
+    AX_SAFE_RELEASE(_indexBuffer);
+    AX_SAFE_RELEASE(_instanceBuffer);
+    AX_SAFE_RELEASE(_programState);
+}
+
+bool CommandBufferNull::beginFrame()
+{
+    ++_stats.frames;
+    return true;
+}
+
+void CommandBufferNull::beginRenderPass(const RenderTarget* /*renderTarget*/,
+                                        const RenderPassDescriptor& /*descriptor*/)
+{
+    ++_stats.renderPasses;
+}
+
+void CommandBufferNull::setDepthStencilState(DepthStencilState* /*depthStencilState*/) {}
+
+void CommandBufferNull::setRenderPipeline(RenderPipeline* /*renderPipeline*/) {}
+
+void CommandBufferNull::updateDepthStencilState(const DepthStencilDescriptor& descriptor)
+{
+    if (_depthStencil == descriptor)
+        return;
+    _depthStencil = descriptor;
+    ++_stats.stateChanges;
+}
+
+void CommandBufferNull::updatePipelineState(const RenderTarget* /*rt*/, const PipelineDescriptor& descriptor)
+{
+    const Program* program = descriptor.programState ? descriptor.programState->getProgram() : nullptr;
+    if (_program == program && _blend == descriptor.blendDescriptor)
+        return;
+    _program = program;
+    _blend   = descriptor.blendDescriptor;
+    ++_stats.stateChanges;
+}
+
+void CommandBufferNull::setViewport(int x, int y, unsigned int w, unsigned int h)
+{
+    if (_viewport.x == x && _viewport.y == y && _viewport.w == w && _viewport.h == h)
+        return;
+    _viewport = {x, y, w, h};
+    ++_stats.stateChanges;
+}
+
+void CommandBufferNull::setCullMode(CullMode mode)
+{
+    if (_cullMode == mode)
+        return;
+    _cullMode = mode;
+    ++_stats.stateChanges;
+}
+
+void CommandBufferNull::setWinding(Winding winding)
+{
+    if (_winding == winding)
+        return;
+    _winding = winding;
+    ++_stats.stateChanges;
+}
+
+void CommandBufferNull::setScissorRect(bool isEnabled, float x, float y, float width, float height)
+{
+    if (!isEnabled)
+    {
+        if (_scissorEnabled)
+        {
+            _scissorEnabled = false;
+            ++_stats.stateChanges;
+        }
+        return;
+    }
+
+    if (_scissorEnabled && _scissor[0] == x && _scissor[1] == y && _scissor[2] == width && _scissor[3] == height)
+        return;
+    _scissorEnabled = true;
+    _scissor[0]     = x;
+    _scissor[1]     = y;
+    _scissor[2]     = width;
+    _scissor[3]     = height;
+    ++_stats.stateChanges;
+}
+
+void CommandBufferNull::setVertexBuffer(Buffer* buffer)
+{
+    assert(buffer != nullptr);
+    if (buffer == nullptr || _vertexBuffer == buffer)
+        return;
+
+    buffer->retain();
+    AX_SAFE_RELEASE(_vertexBuffer);
+    _vertexBuffer = buffer;
+}
+
+void CommandBufferNull::setIndexBuffer(Buffer* buffer)
+{
+    assert(buffer != nullptr);
+    if (buffer == nullptr || _indexBuffer == buffer)
+        return;
+
+    buffer->retain();
+    AX_SAFE_RELEASE(_indexBuffer);
+    _indexBuffer = buffer;
+}
+
+void CommandBufferNull::setInstanceBuffer(Buffer* buffer)
+{
+    assert(buffer != nullptr);
+    if (buffer == nullptr || _instanceBuffer == buffer)
+        return;
+
+    buffer->retain();
+    AX_SAFE_RELEASE(_instanceBuffer);
+    _instanceBuffer = buffer;
+}
+
+void CommandBufferNull::setProgramState(ProgramState* programState)
+{
+    AX_SAFE_RETAIN(programState);
+    AX_SAFE_RELEASE(_programState);
+    _programState = programState;
+}
+
+void CommandBufferNull::drawArrays(PrimitiveType /*primitiveType*/,
+                                   std::size_t /*start*/,
+                                   std::size_t count,
+                                   bool /*wireframe*/)
+{
+    countDraw(count, 1);
+}
+
+void CommandBufferNull::drawElements(PrimitiveType /*primitiveType*/,
+                                     IndexFormat /*indexType*/,
+                                     std::size_t count,
+                                     std::size_t /*offset*/,
+                                     bool /*wireframe*/)
+{
+    assert(_indexBuffer != nullptr);
+    countDraw(count, 1);
+}
+
+void CommandBufferNull::drawElementsInstanced(PrimitiveType /*primitiveType*/,
+                                              IndexFormat /*indexType*/,
+                                              std::size_t count,
+                                              std::size_t /*offset*/,
+                                              int instanceCount,
+                                              bool /*wireframe*/)
+{
+    assert(_indexBuffer != nullptr);
+    _stats.instances += instanceCount;
+    countDraw(count, instanceCount);
+}
+
+void CommandBufferNull::countDraw(std::size_t count, int instanceCount)
+{
+    ++_stats.drawCalls;
+    _stats.vertices += static_cast<uint64_t>(count) * instanceCount;
+
+    if (_stencilRefFront != _stencilReferenceValueFront || _stencilRefBack != _stencilReferenceValueBack)
+    {
+        _stencilRefFront = _stencilReferenceValueFront;
+        _stencilRefBack  = _stencilReferenceValueBack;
+        if (bitmask::any(_depthStencil.flags, DepthStencilFlags::STENCIL_TEST))
+            ++_stats.stateChanges;
+    }
+
+    if (_programState)
+    {
+        // the callbacks are part of the CPU cost of a draw, run them like the GL backend does
+        for (auto&& cb : _programState->getCallbackUniforms())
+            cb.second(_programState, cb.first);
+
+        std::size_t uniformSize = 0;
+        _programState->getVertexUniformBuffer(uniformSize);
+        _stats.uniformBytes += uniformSize;
+
+        for (auto&& item : _programState->getVertexTextureInfos())
+            _stats.textureBinds += item.second.textures.size();
+    }
+
+    AX_SAFE_RELEASE_NULL(_programState);
+}
+
+void CommandBufferNull::endRenderPass()
+{
+    AX_SAFE_RELEASE_NULL(_indexBuffer);
+    AX_SAFE_RELEASE_NULL(_vertexBuffer);
+    AX_SAFE_RELEASE_NULL(_instanceBuffer);
+}
+
+void CommandBufferNull::readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
+{
+    uint32_t width  = 0;
+    uint32_t height = 0;
+    if (rt->isDefaultRenderTarget())
+    {
+        width  = _viewport.w;
+        height = _viewport.h;
+    }
+    else if (auto colorAttachment = rt->_color[0].texture)
+    {
+        width  = colorAttachment->getWidth();
+        height = colorAttachment->getHeight();
+    }
+
+    PixelBufferDescriptor pbd;
+    if (width && height)
+    {
+        const std::size_t bufferSize = static_cast<std::size_t>(width) * height * 4;
+        if (auto ptr = pbd._data.resize(bufferSize))
+        {
+            memset(ptr, 0, bufferSize);
+            pbd._width  = width;
+            pbd._height = height;
+        }
+    }
+    callback(pbd);
+}
+
+NS_AX_BACKEND_END
@@ -0,0 +1,120 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "../CommandBuffer.h"
+#include "../DepthStencilState.h"
+
+NS_AX_BACKEND_BEGIN
+
+struct NullDriverStats;
+class Program;
+
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * Records the commands into NullDriverStats instead of submitting them.
+ * A state change is only counted when the new value differs from the current one, like a driver which filters
+ * redundant state would do.
+ */
+class CommandBufferNull final : public CommandBuffer
+{
+public:
+    explicit CommandBufferNull(NullDriverStats& stats);
+    ~CommandBufferNull();
+
+    bool beginFrame() override;
+    void beginRenderPass(const RenderTarget* renderTarget, const RenderPassDescriptor& descriptor) override;
+
+    void setDepthStencilState(DepthStencilState* depthStencilState) override;
+    void setRenderPipeline(RenderPipeline* renderPipeline) override;
+    void updateDepthStencilState(const DepthStencilDescriptor& descriptor) override;
+    void updatePipelineState(const RenderTarget* rt, const PipelineDescriptor& descriptor) override;
+
+    void setViewport(int x, int y, unsigned int w, unsigned int h) override;
+    void setCullMode(CullMode mode) override;
+    void setWinding(Winding winding) override;
+    void setScissorRect(bool isEnabled, float x, float y, float width, float height) override;
+
+    void setVertexBuffer(Buffer* buffer) override;
+    void setIndexBuffer(Buffer* buffer) override;
+    void setInstanceBuffer(Buffer* buffer) override;
+    void setProgramState(ProgramState* programState) override;
+
+    void drawArrays(PrimitiveType primitiveType, std::size_t start, std::size_t count, bool wireframe = false) override;
+    void drawElements(PrimitiveType primitiveType,
+                      IndexFormat indexType,
+                      std::size_t count,
+                      std::size_t offset,
+                      bool wireframe = false) override;
+    void drawElementsInstanced(PrimitiveType primitiveType,
+                               IndexFormat indexType,
+                               std::size_t count,
+                               std::size_t offset,
+                               int instanceCount,
+                               bool wireframe = false) override;
+
+    void endRenderPass() override;
+    void endFrame() override {}
+
+    /** Calls back with zero filled RGBA pixels of the render target size. */
+    void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) override;
+
+private:
+    void countDraw(std::size_t count, int instanceCount);
+
+    struct Viewport
+    {
+        int x          = 0;
+        int y          = 0;
+        unsigned int w = 0;
+        unsigned int h = 0;
+    };
+
+    NullDriverStats& _stats;
+
+    Buffer* _vertexBuffer       = nullptr;
+    Buffer* _indexBuffer        = nullptr;
+    Buffer* _instanceBuffer     = nullptr;
+    ProgramState* _programState = nullptr;
+
+    // the state as a driver would have it
+    const Program* _program = nullptr;
+    BlendDescriptor _blend{};
+    DepthStencilDescriptor _depthStencil{};
+    Viewport _viewport{};
+    CullMode _cullMode            = CullMode::NONE;
+    Winding _winding              = Winding::COUNTER_CLOCK_WISE;
+    bool _scissorEnabled          = false;
+    float _scissor[4]             = {};
+    unsigned int _stencilRefFront = 0;
+    unsigned int _stencilRefBack  = 0;
+};
+
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
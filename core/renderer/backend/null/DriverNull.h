@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "../DriverBase.h"
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * What the null driver would have sent to a GPU.
+ * Counters are cumulative, DriverNull::resetStats() sets them back to zero.
+ */
+struct NullDriverStats
+{
+    uint64_t frames          = 0;  ///< CommandBuffer::beginFrame calls.
+    uint64_t renderPasses    = 0;
+    uint64_t drawCalls       = 0;
+    uint64_t vertices        = 0;  ///< Vertices of drawArrays plus indices of indexed draws, times instances.
+    uint64_t instances       = 0;  ///< Instances of instanced draws.
+    uint64_t stateChanges    = 0;  ///< Pipeline, depth-stencil, viewport, scissor, cull, winding and stencil changes.
+    uint64_t textureBinds    = 0;  ///< Textures bound by the draws.
+    uint64_t bufferUploads   = 0;
+    uint64_t bufferBytes     = 0;
+    uint64_t textureUploads  = 0;
+    uint64_t textureBytes    = 0;
+    uint64_t uniformBytes    = 0;  ///< Uniform data a GL driver would upload for the draws.
+    uint64_t buffersCreated  = 0;
+    uint64_t texturesCreated = 0;
+    uint64_t programsCreated = 0;
+};
+
+/**
+ * A driver which implements the backend without any GPU.
+ *
+ * Resources are plain memory objects, draws and state changes are only counted in NullDriverStats, so the
+ * engine can run headless to measure the CPU side of a frame. Programs reflect their attributes and uniforms
+ * from the GLSL sources, the uniform buffer layout follows the OpenGL backend.
+ *
+ * Install it with DriverBase::setInstance() before anything asks for the driver, pair it with a GLViewHeadless.
+ * @since axmol-2.2
+ */
+class AX_DLL DriverNull : public DriverBase
+{
+public:
+    DriverNull();
+    ~DriverNull();
+
+    CommandBuffer* newCommandBuffer() override;
+    Buffer* newBuffer(std::size_t size, BufferType type, BufferUsage usage) override;
+    TextureBackend* newTexture(const TextureDescriptor& descriptor) override;
+    RenderTarget* newDefaultRenderTarget() override;
+    RenderTarget* newRenderTarget(TextureBackend* colorAttachment,
+                                  TextureBackend* depthAttachment,
+                                  TextureBackend* stencilAttachhment) override;
+    DepthStencilState* newDepthStencilState() override;
+    RenderPipeline* newRenderPipeline() override;
+    void setFrameBufferOnly(bool frameBufferOnly) override {}
+    Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
+
+    const char* getVendor() const override { return "axmol"; }
+    const char* getRenderer() const override { return "null"; }
+    const char* getVersion() const override { return "1.0"; }
+
+    /** No optional feature is reported, the engine takes its portable code paths. */
+    bool checkForFeatureSupported(FeatureType feature) override { return false; }
+
+    const NullDriverStats& getStats() const { return _stats; }
+    void resetStats() { _stats = NullDriverStats{}; }
+
+protected:
+    ShaderModule* newShaderModule(ShaderStage stage, std::string_view source) override;
+
+    NullDriverStats _stats;
+};
+
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
@@ -0,0 +1,410 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "ProgramNull.h"
+#include "DriverNull.h"
+#include "../ShaderCache.h"
+
+#include <cctype>
+#include <charconv>
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+struct TypeLayout
+{
+    unsigned int size;       // element size, like glGetActiveUniform reports it
+    unsigned int alignment;  // std140 base alignment
+    unsigned int std140Size;
+};
+
+bool lookupType(std::string_view type, TypeLayout& layout)
+{
+    static const std::pair<std::string_view, TypeLayout> types[] = {
+        {"float"sv, {4, 4, 4}},    {"int"sv, {4, 4, 4}},      {"uint"sv, {4, 4, 4}},     {"bool"sv, {4, 4, 4}},
+        {"vec2"sv, {8, 8, 8}},     {"ivec2"sv, {8, 8, 8}},    {"uvec2"sv, {8, 8, 8}},    {"bvec2"sv, {8, 8, 8}},
+        {"vec3"sv, {12, 16, 12}},  {"ivec3"sv, {12, 16, 12}}, {"uvec3"sv, {12, 16, 12}}, {"bvec3"sv, {12, 16, 12}},
+        {"vec4"sv, {16, 16, 16}},  {"ivec4"sv, {16, 16, 16}}, {"uvec4"sv, {16, 16, 16}}, {"bvec4"sv, {16, 16, 16}},
+        {"mat2"sv, {16, 16, 32}},  {"mat3"sv, {36, 16, 48}},  {"mat4"sv, {64, 16, 64}},
+    };
+    for (auto&& item : types)
+    {
+        if (item.first == type)
+        {
+            layout = item.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isSamplerType(std::string_view type)
+{
+    return type.find("sampler") != std::string_view::npos;
+}
+
+unsigned int alignTo(unsigned int value, unsigned int alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int toInt(std::string_view token, int defaultValue)
+{
+    int value = defaultValue;
+    auto ret  = std::from_chars(token.data(), token.data() + token.size(), value);
+    return ret.ec == std::errc{} && ret.ptr == token.data() + token.size() ? value : defaultValue;
+}
+
+/** Splits the source in identifiers, numbers and punctuation, without comments and preprocessor lines. */
+std::vector<std::string_view> tokenize(std::string_view source)
+{
+    std::vector<std::string_view> tokens;
+    const auto isWord = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.'; };
+
+    bool lineStart = true;
+    for (std::size_t i = 0; i < source.size();)
+    {
+        const char c = source[i];
+        if (c == '\n')
+        {
+            lineStart = true;
+            ++i;
+        }
+        else if (std::isspace(static_cast<unsigned char>(c)))
+            ++i;
+        else if (c == '#' && lineStart)
+        {
+            // skip the directive with its line continuations
+            while (i < source.size() && !(source[i] == '\n' && source[i - 1] != '\\'))
+                ++i;
+        }
+        else if (source.compare(i, 2, "//"sv) == 0)
+        {
+            while (i < source.size() && source[i] != '\n')
+                ++i;
+        }
+        else if (source.compare(i, 2, "/*"sv) == 0)
+        {
+            auto end = source.find("*/"sv, i + 2);
+            i        = end == std::string_view::npos ? source.size() : end + 2;
+        }
+        else
+        {
+            lineStart    = false;
+            auto start   = i;
+            if (isWord(c))
+            {
+                while (i < source.size() && isWord(source[i]))
+                    ++i;
+            }
+            else
+                ++i;
+            tokens.emplace_back(source.substr(start, i - start));
+        }
+    }
+    return tokens;
+}
+
+struct Declarator
+{
+    std::string_view name;
+    int count = 1;
+};
+
+struct Declaration
+{
+    std::string_view storage;  // uniform, in, attribute, out, varying or empty for block members
+    std::string_view type;
+    int location = -1;
+    std::vector<Declarator> declarators;
+};
+
+/** Parses "[layout(...)] [qualifiers] type name[N], ..." */
+bool parseDeclaration(const std::string_view* first, const std::string_view* last, Declaration& decl)
+{
+    static const std::string_view qualifiers[] = {"highp"sv,  "mediump"sv,   "lowp"sv,      "flat"sv,
+                                                  "smooth"sv, "centroid"sv,  "invariant"sv, "const"sv,
+                                                  "precise"sv, "noperspective"sv};
+    static const std::string_view storages[] = {"uniform"sv, "in"sv, "attribute"sv, "out"sv, "varying"sv};
+
+    decl = Declaration{};
+    auto it = first;
+    for (; it != last; ++it)
+    {
+        if (*it == "layout"sv)
+        {
+            for (++it; it != last && *it != ")"sv; ++it)
+            {
+                if (*it == "location"sv && last - it > 2 && it[1] == "="sv)
+                    decl.location = toInt(it[2], -1);
+            }
+            if (it == last)
+                return false;
+        }
+        else if (std::find(std::begin(storages), std::end(storages), *it) != std::end(storages))
+            decl.storage = *it;
+        else if (std::find(std::begin(qualifiers), std::end(qualifiers), *it) == std::end(qualifiers))
+            break;
+    }
+
+    if (it == last || *it == "precision"sv)
+        return false;
+    decl.type = *it++;
+
+    while (it != last)
+    {
+        Declarator declarator{*it++};
+        if (it != last && *it == "["sv)
+        {
+            if (++it != last)
+                declarator.count = (std::max)(toInt(*it, 1), 1);
+            while (it != last && *it != "]"sv)
+                ++it;
+            if (it != last)
+                ++it;
+        }
+        decl.declarators.emplace_back(declarator);
+
+        // skip initializers up to the next declarator
+        while (it != last && *it != ","sv)
+            ++it;
+        if (it != last)
+            ++it;
+    }
+    return !decl.declarators.empty();
+}
+}  // namespace
+
+ProgramNull::ProgramNull(std::string_view vertexShader, std::string_view fragmentShader, NullDriverStats& stats)
+    : Program(vertexShader, fragmentShader)
+{
+    _vertexShaderModule   = ShaderCache::getInstance()->newVertexShaderModule(_vertexShader);
+    _fragmentShaderModule = ShaderCache::getInstance()->newFragmentShaderModule(_fragmentShader);
+    AX_SAFE_RETAIN(_vertexShaderModule);
+    AX_SAFE_RETAIN(_fragmentShaderModule);
+
+    reflect(_vertexShader, ShaderStage::VERTEX);
+    reflect(_fragmentShader, ShaderStage::FRAGMENT);
+    setBuiltinLocations();
+
+    ++stats.programsCreated;
+}
+
+ProgramNull::~ProgramNull()
+{
+    AX_SAFE_RELEASE(_vertexShaderModule);
+    AX_SAFE_RELEASE(_fragmentShaderModule);
+}
+
+void ProgramNull::reflect(std::string_view source, ShaderStage stage)
+{
+    const auto tokens = tokenize(source);
+    const auto end    = tokens.data() + tokens.size();
+
+    int nextAttribLocation = static_cast<int>(_activeAttribs.size());
+
+    auto addUniform = [this](std::string_view type, const Declarator& declarator, unsigned int& offset) {
+        if (_activeUniformInfos.find(declarator.name) != _activeUniformInfos.end())
+            return;
+
+        UniformInfo uniform;
+        uniform.count = declarator.count;
+        if (isSamplerType(type))
+        {
+            uniform.location     = _nextSamplerLocation++;
+            uniform.bufferOffset = -1;
+        }
+        else
+        {
+            TypeLayout layout{16, 16, 16};  // structs and unknown types take a vec4
+            lookupType(type, layout);
+            offset = alignTo(offset, declarator.count > 1 ? 16 : layout.alignment);
+
+            uniform.location     = 0;
+            uniform.size         = layout.size;
+            uniform.bufferOffset = offset;
+            offset += declarator.count > 1 ? alignTo(layout.std140Size, 16) * declarator.count : layout.std140Size;
+        }
+        _activeUniformInfos.emplace(declarator.name, uniform);
+        _maxLocation = (std::max)(_maxLocation, uniform.location + 1);
+    };
+
+    Declaration decl;
+    unsigned int offset = static_cast<unsigned int>(_totalBufferSize);
+    for (auto it = tokens.data(); it != end;)
+    {
+        auto stmt = it;
+        while (it != end && *it != ";"sv && *it != "{"sv)
+            ++it;
+        if (it == end)
+            break;
+
+        if (*it == ";"sv)
+        {
+            if (parseDeclaration(stmt, it, decl))
+            {
+                if (decl.storage == "uniform"sv)
+                {
+                    for (auto&& declarator : decl.declarators)
+                        addUniform(decl.type, declarator, offset);
+                }
+                else if (stage == ShaderStage::VERTEX && (decl.storage == "in"sv || decl.storage == "attribute"sv))
+                {
+                    TypeLayout layout{16, 16, 16};
+                    lookupType(decl.type, layout);
+                    for (auto&& declarator : decl.declarators)
+                    {
+                        AttributeBindInfo info;
+                        info.location = decl.location != -1 ? decl.location : nextAttribLocation;
+                        info.size     = static_cast<int>(layout.size) * declarator.count;
+                        nextAttribLocation = (std::max)(nextAttribLocation, info.location + 1);
+                        _activeAttribs.emplace(declarator.name, info);
+                    }
+                }
+            }
+            ++it;
+            continue;
+        }
+
+        // "{": a uniform block, a struct or a function body
+        const bool isBlock = std::find(stmt, it, "uniform"sv) != it;
+        int depth          = 1;
+        auto member        = ++it;
+        for (; it != end && depth > 0; ++it)
+        {
+            if (*it == "{"sv)
+                ++depth;
+            else if (*it == "}"sv)
+                --depth;
+            else if (isBlock && depth == 1 && *it == ";"sv)
+            {
+                if (parseDeclaration(member, it, decl) && decl.storage.empty())
+                {
+                    for (auto&& declarator : decl.declarators)
+                        addUniform(decl.type, declarator, offset);
+                }
+                member = it + 1;
+            }
+        }
+
+        if (isBlock)
+            offset = alignTo(offset, 16);
+
+        // skip the instance name of a block or the declarators of a struct
+        if (isBlock || std::find(stmt, member, "struct"sv) != member)
+        {
+            while (it != end && *it != ";"sv)
+                ++it;
+            if (it != end)
+                ++it;
+        }
+    }
+
+    _totalBufferSize = offset;
+}
+
+void ProgramNull::setBuiltinLocations()
+{
+    std::fill(_builtinAttributeLocation, _builtinAttributeLocation + Attribute::ATTRIBUTE_MAX, -1);
+
+    _builtinAttributeLocation[Attribute::POSITION] = getAttributeLocation(ATTRIBUTE_NAME_POSITION);
+    _builtinAttributeLocation[Attribute::COLOR]    = getAttributeLocation(ATTRIBUTE_NAME_COLOR);
+    _builtinAttributeLocation[Attribute::TEXCOORD] = getAttributeLocation(ATTRIBUTE_NAME_TEXCOORD);
+    _builtinAttributeLocation[Attribute::NORMAL]   = getAttributeLocation(ATTRIBUTE_NAME_NORMAL);
+    _builtinAttributeLocation[Attribute::INSTANCE] = getAttributeLocation(ATTRIBUTE_NAME_INSTANCE);
+
+    _builtinUniformLocation[Uniform::MVP_MATRIX]   = getUniformLocation(UNIFORM_NAME_MVP_MATRIX);
+    _builtinUniformLocation[Uniform::TEXTURE]      = getUniformLocation(UNIFORM_NAME_TEXTURE);
+    _builtinUniformLocation[Uniform::TEXTURE1]     = getUniformLocation(UNIFORM_NAME_TEXTURE1);
+    _builtinUniformLocation[Uniform::TEXTURE2]     = getUniformLocation(UNIFORM_NAME_TEXTURE2);
+    _builtinUniformLocation[Uniform::TEXTURE3]     = getUniformLocation(UNIFORM_NAME_TEXTURE3);
+    _builtinUniformLocation[Uniform::TEXT_COLOR]   = getUniformLocation(UNIFORM_NAME_TEXT_COLOR);
+    _builtinUniformLocation[Uniform::EFFECT_COLOR] = getUniformLocation(UNIFORM_NAME_EFFECT_COLOR);
+    _builtinUniformLocation[Uniform::EFFECT_TYPE]  = getUniformLocation(UNIFORM_NAME_EFFECT_TYPE);
+}
+
+UniformLocation ProgramNull::getUniformLocation(std::string_view uniform) const
+{
+    UniformLocation uniformLocation;
+    auto iter = _activeUniformInfos.find(uniform);
+    if (iter != _activeUniformInfos.end())
+    {
+        uniformLocation.vertStage.location = iter->second.location;
+        uniformLocation.vertStage.offset   = iter->second.bufferOffset;
+    }
+    return uniformLocation;
+}
+
+UniformLocation ProgramNull::getUniformLocation(backend::Uniform name) const
+{
+    return _builtinUniformLocation[name];
+}
+
+int ProgramNull::getAttributeLocation(std::string_view name) const
+{
+    auto iter = _activeAttribs.find(name);
+    return iter != _activeAttribs.end() ? iter->second.location : -1;
+}
+
+int ProgramNull::getAttributeLocation(Attribute name) const
+{
+    return _builtinAttributeLocation[name];
+}
+
+int ProgramNull::getMaxVertexLocation() const
+{
+    return _maxLocation;
+}
+
+int ProgramNull::getMaxFragmentLocation() const
+{
+    return _maxLocation;
+}
+
+const hlookup::string_map<AttributeBindInfo>& ProgramNull::getActiveAttributes() const
+{
+    return _activeAttribs;
+}
+
+std::size_t ProgramNull::getUniformBufferSize(ShaderStage /*stage*/) const
+{
+    return _totalBufferSize;
+}
+
+const hlookup::string_map<UniformInfo>& ProgramNull::getAllActiveUniformInfo(ShaderStage /*stage*/) const
+{
+    return _activeUniformInfos;
+}
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+const std::unordered_map<std::string, int> ProgramNull::getAllUniformsLocation() const
+{
+    std::unordered_map<std::string, int> locations;
+    for (auto&& uniform : _activeUniformInfos)
+        locations.emplace(uniform.first, uniform.second.location);
+    return locations;
+}
+#endif
+
+NS_AX_BACKEND_END
@@ -0,0 +1,96 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "../Program.h"
+#include "../ShaderModule.h"
+
+#include <string>
+#include <unordered_map>
+
+NS_AX_BACKEND_BEGIN
+
+struct NullDriverStats;
+
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/** Keeps nothing but the stage, the source is reflected by ProgramNull. */
+class ShaderModuleNull : public ShaderModule
+{
+public:
+    explicit ShaderModuleNull(ShaderStage stage) : ShaderModule(stage) {}
+};
+
+/**
+ * A program reflected from its GLSL sources instead of a linked GPU program.
+ *
+ * Uniform blocks are laid out with the std140 rules in declaration order, a uniform block member gets location 0
+ * and its offset in the uniform buffer, samplers get their own locations. Vertex attributes use their numeric
+ * layout location when there is one, the declaration order otherwise.
+ */
+class ProgramNull : public Program
+{
+public:
+    ProgramNull(std::string_view vertexShader, std::string_view fragmentShader, NullDriverStats& stats);
+    ~ProgramNull();
+
+    UniformLocation getUniformLocation(std::string_view uniform) const override;
+    UniformLocation getUniformLocation(backend::Uniform name) const override;
+    int getAttributeLocation(std::string_view name) const override;
+    int getAttributeLocation(Attribute name) const override;
+    int getMaxVertexLocation() const override;
+    int getMaxFragmentLocation() const override;
+    const hlookup::string_map<AttributeBindInfo>& getActiveAttributes() const override;
+    std::size_t getUniformBufferSize(ShaderStage stage) const override;
+    const hlookup::string_map<UniformInfo>& getAllActiveUniformInfo(ShaderStage stage) const override;
+
+private:
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    int getMappedLocation(int location) const override { return location; }
+    int getOriginalLocation(int location) const override { return location; }
+    const std::unordered_map<std::string, int> getAllUniformsLocation() const override;
+#endif
+
+    void reflect(std::string_view source, ShaderStage stage);
+    void setBuiltinLocations();
+
+    ShaderModule* _vertexShaderModule   = nullptr;
+    ShaderModule* _fragmentShaderModule = nullptr;
+
+    hlookup::string_map<UniformInfo> _activeUniformInfos;
+    hlookup::string_map<AttributeBindInfo> _activeAttribs;
+    std::size_t _totalBufferSize = 0;
+    int _maxLocation             = -1;
+    int _nextSamplerLocation     = 0;
+
+    UniformLocation _builtinUniformLocation[UNIFORM_MAX];
+    int _builtinAttributeLocation[Attribute::ATTRIBUTE_MAX];
+};
+
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
@@ -0,0 +1,113 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "TextureNull.h"
+#include "DriverNull.h"
+
+NS_AX_BACKEND_BEGIN
+
+Texture2DNull::Texture2DNull(const TextureDescriptor& descriptor, NullDriverStats& stats) : _stats(stats)
+{
+    updateTextureDescriptor(descriptor);
+    ++_stats.texturesCreated;
+}
+
+void Texture2DNull::countUpload(std::size_t bytes, int index)
+{
+    _count = (std::max)(_count, index + 1);
+    ++_stats.textureUploads;
+    _stats.textureBytes += bytes;
+}
+
+void Texture2DNull::updateData(uint8_t* /*data*/, std::size_t width, std::size_t height, std::size_t level, int index)
+{
+    if (level == 0)
+    {
+        _width  = static_cast<uint32_t>(width);
+        _height = static_cast<uint32_t>(height);
+    }
+    countUpload(width * height * _bitsPerPixel / 8, index);
+}
+
+void Texture2DNull::updateCompressedData(uint8_t* /*data*/,
+                                         std::size_t width,
+                                         std::size_t height,
+                                         std::size_t dataLen,
+                                         std::size_t level,
+                                         int index)
+{
+    if (level == 0)
+    {
+        _width  = static_cast<uint32_t>(width);
+        _height = static_cast<uint32_t>(height);
+    }
+    countUpload(dataLen, index);
+}
+
+void Texture2DNull::updateSubData(std::size_t /*xoffset*/,
+                                  std::size_t /*yoffset*/,
+                                  std::size_t width,
+                                  std::size_t height,
+                                  std::size_t /*level*/,
+                                  uint8_t* /*data*/,
+                                  int index)
+{
+    countUpload(width * height * _bitsPerPixel / 8, index);
+}
+
+void Texture2DNull::updateCompressedSubData(std::size_t /*xoffset*/,
+                                            std::size_t /*yoffset*/,
+                                            std::size_t /*width*/,
+                                            std::size_t /*height*/,
+                                            std::size_t dataLen,
+                                            std::size_t /*level*/,
+                                            uint8_t* /*data*/,
+                                            int index)
+{
+    countUpload(dataLen, index);
+}
+
+void Texture2DNull::generateMipmaps()
+{
+    if (TextureUsage::RENDER_TARGET != _textureUsage)
+        _hasMipmaps = true;
+}
+
+TextureCubeNull::TextureCubeNull(const TextureDescriptor& descriptor, NullDriverStats& stats) : _stats(stats)
+{
+    updateTextureDescriptor(descriptor);
+    ++_stats.texturesCreated;
+}
+
+void TextureCubeNull::updateFaceData(TextureCubeFace /*side*/, void* /*data*/, int /*index*/)
+{
+    ++_stats.textureUploads;
+    _stats.textureBytes += static_cast<uint64_t>(_width) * _height * _bitsPerPixel / 8;
+}
+
+void TextureCubeNull::generateMipmaps()
+{
+    _hasMipmaps = true;
+}
+
+NS_AX_BACKEND_END
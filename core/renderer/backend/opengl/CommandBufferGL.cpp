@@ -36,6 +36,7 @@
 #include "UtilsGL.h"
 #include "RenderTargetGL.h"
 #include "DriverGL.h"
+#include "UniformRingBufferGL.h"
 #include <algorithm>
 
 NS_AX_BACKEND_BEGIN
@@ -59,15 +60,34 @@ void applyTexture(TextureBackend* texture, int slot, int index)
 }
 }  // namespace
 
-CommandBufferGL::CommandBufferGL() {}
+CommandBufferGL::CommandBufferGL()
+{
+#if AX_GLES_PROFILE != 200
+    _uniformRing = new UniformRingBufferGL();
+#endif
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    _backToForegroundListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        if (_uniformRing)
+            _uniformRing->reset();
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_backToForegroundListener, -1);
+#endif
+}
 
 CommandBufferGL::~CommandBufferGL()
 {
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_backToForegroundListener);
+#endif
+    AX_SAFE_DELETE(_uniformRing);
     cleanResources();
 }
 
 bool CommandBufferGL::beginFrame()
 {
+    if (_uniformRing)
+        _uniformRing->beginFrame();
     return true;
 }
 
@@ -222,7 +242,7 @@ void CommandBufferGL::setProgramState(ProgramState* programState)
 
 void CommandBufferGL::drawArrays(PrimitiveType primitiveType, std::size_t start, std::size_t count, bool wireframe)
 {
-    prepareDrawing();
+    prepareDrawing(false);
 #if !AX_GLES_PROFILE  // glPolygonMode is only supported in Desktop OpenGL
     if (wireframe)
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -244,7 +264,7 @@ void CommandBufferGL::drawElements(PrimitiveType primitiveType,
                                    std::size_t offset,
                                    bool wireframe)
 {
-    prepareDrawing();
+    prepareDrawing(true);
 #if !AX_GLES_PROFILE  // glPolygonMode is only supported in Desktop OpenGL
     if (wireframe)
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -252,7 +272,6 @@ void CommandBufferGL::drawElements(PrimitiveType primitiveType,
     if (wireframe)
         primitiveType = PrimitiveType::LINE;
 #endif
-    __gl->bindBuffer(BufferType::ELEMENT_ARRAY_BUFFER, _indexBuffer->getHandler());
     glDrawElements(UtilsGL::toGLPrimitiveType(primitiveType), count, UtilsGL::toGLIndexType(indexType),
                    (GLvoid*)offset);
     CHECK_GL_ERROR_DEBUG();
@@ -270,7 +289,7 @@ void CommandBufferGL::drawElementsInstanced(PrimitiveType primitiveType,
                                             int instanceCount,
                                             bool wireframe)
 {
-    prepareDrawing();
+    prepareDrawing(true);
 #if !AX_GLES_PROFILE  // glPolygonMode is only supported in Desktop OpenGL
     if (wireframe)
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -278,7 +297,6 @@ void CommandBufferGL::drawElementsInstanced(PrimitiveType primitiveType,
     if (wireframe)
         primitiveType = PrimitiveType::LINE;
 #endif
-    __gl->bindBuffer(BufferType::ELEMENT_ARRAY_BUFFER, _indexBuffer->getHandler());
     glDrawElementsInstanced(UtilsGL::toGLPrimitiveType(primitiveType), count, UtilsGL::toGLIndexType(indexType),
                             (GLvoid*)offset, instanceCount);
     CHECK_GL_ERROR_DEBUG();
@@ -298,16 +316,22 @@ void CommandBufferGL::endRenderPass()
 
 void CommandBufferGL::endFrame() {}
 
-void CommandBufferGL::prepareDrawing() const
+void CommandBufferGL::prepareDrawing(bool indexed) const
 {
     const auto& program = _renderPipeline->getProgram();
     __gl->useProgram(program->getHandler());
 
-    uint32_t usedBits{0};
-
-    bindVertexBuffer(usedBits);
-    bindInstanceBuffer(program, usedBits);
-    __gl->disableUnusedVertexAttribs(usedBits);
+    if (!bindVertexArray(program, indexed))
+    {
+        uint32_t usedBits{0};
+
+        __gl->bindDefaultVertexArray();
+        bindVertexBuffer(usedBits);
+        bindInstanceBuffer(program, usedBits);
+        __gl->disableUnusedVertexAttribs(usedBits);
+        if (indexed)
+            __gl->bindBuffer(BufferType::ELEMENT_ARRAY_BUFFER, _indexBuffer->getHandler());
+    }
 
     bindUniforms(program);
 
@@ -324,6 +348,62 @@ void CommandBufferGL::prepareDrawing() const
         __gl->disableCullFace();
 }
 
+bool CommandBufferGL::bindVertexArray(ProgramGL* program, bool indexed) const
+{
+#if AX_GLES_PROFILE != 200
+    auto vertexLayout = _programState->getVertexLayout();
+    if (!_vertexArrayCacheEnabled || !vertexLayout->isValid())
+        return false;
+
+    VertexArrayKey key{vertexLayout->getHash(), _vertexBuffer->getHandler(),
+                       indexed ? _indexBuffer->getHandler() : 0, 0, -1};
+    if (_instanceTransformBuffer)
+    {
+        key.instanceLocation = program->getAttributeLocation(Attribute::INSTANCE);
+        if (key.instanceLocation != -1)
+            key.instanceBuffer = _instanceTransformBuffer->getHandler();
+    }
+
+    const auto& attributes = vertexLayout->getAttributes();
+    const auto instanceAttribs = key.instanceBuffer ? 4 : 0;
+    if (__gl->bindVertexArray(key))
+    {
+        // everything below is recorded in the VAO
+        __gl->skipped(static_cast<uint32_t>(attributes.size() + instanceAttribs) * 2);
+        return true;
+    }
+
+    // A new VAO: attribute arrays are disabled and divisors are 0, set up the used ones only.
+    __gl->bindBuffer(BufferType::ARRAY_BUFFER, key.vertexBuffer);
+    for (const auto& attributeInfo : attributes)
+    {
+        const auto& attribute = attributeInfo.second;
+        glEnableVertexAttribArray(attribute.index);
+        glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
+                              UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
+                              vertexLayout->getStride(), (GLvoid*)attribute.offset);
+    }
+
+    if (key.instanceBuffer)
+    {
+        __gl->bindBuffer(BufferType::ARRAY_BUFFER, key.instanceBuffer);
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto elementLoc = key.instanceLocation + i;
+            glEnableVertexAttribArray(elementLoc);
+            glVertexAttribPointer(elementLoc, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16,
+                                  (void*)(sizeof(float) * 4 * i));
+            glVertexAttribDivisor(elementLoc, 1);
+        }
+    }
+    __gl->issued(static_cast<uint32_t>(attributes.size() + instanceAttribs) * 2 + instanceAttribs);
+    CHECK_GL_ERROR_DEBUG();
+    return true;
+#else
+    return false;
+#endif
+}
+
 void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
 {
     // Bind vertex buffers and set the attributes.
@@ -333,14 +413,14 @@ void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
     if (!vertexLayout->isValid())
         return;
 
-    // Bind VAO, engine share 1 VAO for all vertexLayouts aka vfmts
-    // optimize proposal: create VAO per vertexLayout, just need bind VAO
+    // Without the VAO cache every layout is set up on the default VAO
     __gl->bindBuffer(BufferType::ARRAY_BUFFER, _vertexBuffer->getHandler());
 
     for (const auto& attributeInfo : attributes)
     {
         const auto& attribute = attributeInfo.second;
         __gl->enableVertexAttribArray(attribute.index);
+        __gl->issued();
         glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
                               UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
                               vertexLayout->getStride(), (GLvoid*)attribute.offset);
@@ -364,6 +444,7 @@ void CommandBufferGL::bindInstanceBuffer(ProgramGL* program, uint32_t& usedBits)
             {
                 auto elementLoc = instanceLoc + i;
                 __gl->enableVertexAttribArray(elementLoc);
+                __gl->issued();
                 glVertexAttribPointer(elementLoc, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 16,
                                       (void*)(sizeof(float) * 4 * i));
                 __gl->setVertexAttribDivisor(elementLoc);
@@ -387,7 +468,7 @@ void CommandBufferGL::bindUniforms(ProgramGL* program) const
 
         std::size_t bufferSize = 0;
         auto buffer            = _programState->getVertexUniformBuffer(bufferSize);
-        program->bindUniformBuffers(buffer, bufferSize);
+        program->bindUniformBuffers(buffer, bufferSize, _uniformRing);
 
         const auto& textureInfo = _programState->getVertexTextureInfos();
         for (const auto& iter : textureInfo)
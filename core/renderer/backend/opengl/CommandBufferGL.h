@@ -40,6 +40,7 @@ class BufferGL;
 class RenderPipelineGL;
 class ProgramGL;
 class DepthStencilStateGL;
+class UniformRingBufferGL;
 
 /**
  * @addtogroup _opengl
@@ -217,9 +218,16 @@ public:
                     bool eglCacheHint,
                     PixelBufferDescriptor& pbd);
 
+    /**
+     * The ring the uniform blocks of the draws are written to, nullptr on GLES2.
+     * @since axmol-2.2
+     */
+    UniformRingBufferGL* getUniformRingBuffer() const { return _uniformRing; }
+
 protected:
 
-    void prepareDrawing() const;
+    void prepareDrawing(bool indexed) const;
+    bool bindVertexArray(ProgramGL* program, bool indexed) const;
     void bindVertexBuffer(uint32_t& usedBits) const;
     virtual void bindInstanceBuffer(ProgramGL* program, uint32_t& usedBits) const;
     void bindUniforms(ProgramGL* program) const;
@@ -234,6 +242,8 @@ protected:
     DepthStencilStateGL* _depthStencilStateGL = nullptr;
     Viewport _viewPort;
     GLboolean _alphaTestEnabled               = false;
+    bool _vertexArrayCacheEnabled             = AX_GLES_PROFILE != 200;  // VAO per vertex layout and buffers
+    UniformRingBufferGL* _uniformRing         = nullptr;
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _backToForegroundListener = nullptr;
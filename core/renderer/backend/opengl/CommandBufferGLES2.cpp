@@ -28,11 +28,16 @@
 #if !defined(__APPLE__) && AX_TARGET_PLATFORM != AX_PLATFORM_WINRT
 
 #    include "platform/GL.h"
+#    include "UniformRingBufferGL.h"
 
 NS_AX_BACKEND_BEGIN
 
 CommandBufferGLES2::CommandBufferGLES2()
 {
+    // vertex array objects are an extension on GLES2, always set up the attributes
+    _vertexArrayCacheEnabled = false;
+    AX_SAFE_DELETE(_uniformRing);
+
     if (glDrawElementsInstancedEXT)
         glDrawElementsInstanced = glDrawElementsInstancedEXT;
     else if (glDrawElementsInstancedANGLE)
@@ -31,6 +31,7 @@
 #include "TextureGL.h"
 #include "DepthStencilStateGL.h"
 #include "ProgramGL.h"
+#include "ProgramCacheGL.h"
 #include "DriverGL.h"
 #include "RenderTargetGL.h"
 #include "MacrosGL.h"
@@ -40,6 +41,9 @@
 #endif
 
 #include "base/axstd.h"
+#include "base/EventDispatcher.h"
+#include "base/EventType.h"
+#include "base/Director.h"
 #include "xxhash/xxhash.h"
 
 #if !defined(GL_COMPRESSED_RGBA8_ETC2_EAC)
@@ -172,13 +176,32 @@ DriverGL::DriverGL()
 #if AX_GLES_PROFILE != 200
     glGenVertexArrays(1, &_defaultVAO);
     glBindVertexArray(_defaultVAO);
+    __gl->setDefaultVertexArray(_defaultVAO);
     CHECK_GL_ERROR_DEBUG();
 #endif
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    _rendererRecreatedListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) {
+        // the cached VAOs are gone with the old context, runs before the buffers are reloaded so they don't bind them
+        __gl->dropVertexArrays();
+#    if AX_GLES_PROFILE != 200
+        glGenVertexArrays(1, &_defaultVAO);
+        glBindVertexArray(_defaultVAO);
+        __gl->setDefaultVertexArray(_defaultVAO);
+#    endif
+    });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_rendererRecreatedListener, -2);
+#endif
 }
 
 DriverGL::~DriverGL()
 {
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_rendererRecreatedListener);
+#endif
+    __gl->deleteVertexArrays();
     ProgramManager::destroyInstance();
+    AX_SAFE_DELETE(_programCache);
 }
 
 GLint DriverGL::getDefaultFBO() const
@@ -247,6 +270,16 @@ RenderPipeline* DriverGL::newRenderPipeline()
     return new RenderPipelineGL();
 }
 
+void DriverGL::setProgramCacheDir(std::string_view dir)
+{
+    AX_SAFE_DELETE(_programCache);
+    if (dir.empty() || isGLES2Only() || !ProgramCacheGL::isSupported())
+        return;
+
+    auto fingerprint = fmt::format("{}\n{}\n{}\n{}", _vendor, _renderer, _version, _shaderVer);
+    _programCache    = new ProgramCacheGL(dir, fingerprint);
+}
+
 Program* DriverGL::newProgram(std::string_view vertexShader, std::string_view fragmentShader)
 {
     return new ProgramGL(vertexShader, fragmentShader);
@@ -28,8 +28,12 @@
 #include "platform/GL.h"
 #include "OpenGLState.h"
 #include "base/hlookup.h"
+#include "base/EventListenerCustom.h"
 
 NS_AX_BACKEND_BEGIN
+
+class ProgramCacheGL;
+
 /**
  * @addtogroup _opengl
  * @{
@@ -97,6 +101,11 @@ public:
      */
     Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
 
+    void setProgramCacheDir(std::string_view dir) override;
+
+    /** The cache of linked program binaries, nullptr when disabled or not supported by the context. */
+    ProgramCacheGL* getProgramCache() const { return _programCache; }
+
     void resetState() override;
 
     /// below is driver info API
@@ -154,6 +163,11 @@ protected:
 
     GLint _defaultFBO = 0;  // The value gets from glGetIntegerv, so need to use GLint
     GLuint _defaultVAO = 0;
+    ProgramCacheGL* _programCache = nullptr;
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    EventListenerCustom* _rendererRecreatedListener = nullptr;
+#endif
 
 private:
     std::set<uint32_t> _glExtensions;
@@ -1,4 +1,5 @@
 #include "OpenGLState.h"
+#include "xxhash.h"
 
 NS_AX_BACKEND_BEGIN
 
@@ -15,4 +16,120 @@ void OpenGLState::reset()
     __gl = g_defaultOpenGLState.get();
 }
 
+size_t VertexArrayKeyHash::operator()(const VertexArrayKey& key) const
+{
+    static_assert(sizeof(VertexArrayKey) == 24, "VertexArrayKey must not be padded");
+    return static_cast<size_t>(XXH64(&key, sizeof(key), 0));
+}
+
+void OpenGLState::deleteBuffer(BufferType type, GLuint buffer)
+{
+    // a VAO keeps the storage of its buffers alive and the name may be reused, drop the VAOs using it
+    if (type == BufferType::ARRAY_BUFFER || type == BufferType::ELEMENT_ARRAY_BUFFER)
+    {
+        for (auto it = _vertexArrays.begin(); it != _vertexArrays.end();)
+        {
+            auto& key = it->first;
+            if (key.vertexBuffer == buffer || key.indexBuffer == buffer || key.instanceBuffer == buffer)
+            {
+#if AX_GLES_PROFILE != 200
+                if (_vertexArrayBind == it->second)
+                    bindDefaultVertexArray();
+                glDeleteVertexArrays(1, &it->second);
+#endif
+                it = _vertexArrays.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    glDeleteBuffers(1, &buffer);
+    if (_bufferBindings[static_cast<int>(type)] == buffer)
+        _bufferBindings[static_cast<int>(type)].reset();
+
+    if (type == BufferType::UNIFORM)
+    {
+        for (auto& binding : _uniformBufferBindings)
+        {
+            if (binding.has_value() && binding->handle == buffer)
+                binding.reset();
+        }
+    }
+}
+
+void OpenGLState::bindDefaultVertexArray()
+{
+#if AX_GLES_PROFILE != 200
+    if (_vertexArrayBind == _defaultVertexArray)
+        return skipped();
+
+    issued();
+    glBindVertexArray(_defaultVertexArray);
+    _vertexArrayBind = _defaultVertexArray;
+    // the element buffer binding of the default VAO wasn't tracked meanwhile
+    _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)].reset();
+#endif
+}
+
+bool OpenGLState::bindVertexArray(const VertexArrayKey& key)
+{
+#if AX_GLES_PROFILE != 200
+    GLuint vao = 0;
+    auto it    = _vertexArrays.find(key);
+    const bool cached = it != _vertexArrays.end();
+    if (cached)
+    {
+        vao = it->second;
+        ++_stats.vertexArrayHits;
+    }
+    else
+    {
+        glGenVertexArrays(1, &vao);
+        _vertexArrays.emplace(key, vao);
+        ++_stats.vertexArrayMisses;
+    }
+
+    if (_vertexArrayBind != vao)
+    {
+        issued();
+        glBindVertexArray(vao);
+        _vertexArrayBind = vao;
+    }
+    else
+        skipped();
+
+    if (!cached && key.indexBuffer)
+    {
+        issued();
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, key.indexBuffer);
+    }
+    _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)] = key.indexBuffer;
+    return cached;
+#else
+    return false;
+#endif
+}
+
+void OpenGLState::deleteVertexArrays()
+{
+#if AX_GLES_PROFILE != 200
+    bindDefaultVertexArray();
+    for (auto&& item : _vertexArrays)
+        glDeleteVertexArrays(1, &item.second);
+#endif
+    _vertexArrays.clear();
+}
+
+void OpenGLState::dropVertexArrays()
+{
+    _vertexArrays.clear();
+    _defaultVertexArray = 0;
+    _vertexArrayBind    = 0;
+    // the attribute state tracked is the one of the default VAO
+    _attribBits  = 0;
+    _divisorBits = 0;
+    _bufferBindings[static_cast<int>(BufferType::ELEMENT_ARRAY_BUFFER)].reset();
+}
+
 NS_AX_BACKEND_END
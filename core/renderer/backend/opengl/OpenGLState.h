@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <unordered_map>
 
 #include "base/Types.h"
 #include "platform/GL.h"
@@ -98,13 +99,62 @@ struct CommonBindState
     GLuint handle;
 };
 
-struct UniformBufferBaseBindState
+struct ScissorBoxState
 {
-    UniformBufferBaseBindState(GLenum i, GLuint h) : index(i), handle(h) {}
-    inline bool equals(GLenum i, GLuint h) const { return this->index == i && this->handle == h; }
+    ScissorBoxState(GLint x_, GLint y_, GLsizei w, GLsizei h) : x(x_), y(y_), width(w), height(h) {}
+    inline bool equals(GLint x_, GLint y_, GLsizei w, GLsizei h) const
+    {
+        return this->x == x_ && this->y == y_ && this->width == w && this->height == h;
+    }
+    GLint x;
+    GLint y;
+    GLsizei width;
+    GLsizei height;
+};
+
+/**
+ * Identifies a cached VAO: the vertex layout, the buffers sourced by the attributes and the
+ * element buffer captured by the VAO.
+ */
+struct VertexArrayKey
+{
+    uint64_t layoutHash;
+    GLuint vertexBuffer;
+    GLuint indexBuffer;     // 0: not indexed
+    GLuint instanceBuffer;  // 0: not instanced
+    GLint instanceLocation;
+
+    bool operator==(const VertexArrayKey&) const = default;
+};
+
+struct VertexArrayKeyHash
+{
+    size_t operator()(const VertexArrayKey& key) const;
+};
+
+/**
+ * Counters of the state calls going through OpenGLState, accumulated until resetStats.
+ * @since axmol-2.2
+ */
+struct OpenGLStateStats
+{
+    uint64_t issued{0};   ///< calls forwarded to GL
+    uint64_t skipped{0};  ///< redundant calls dropped by the shadow state, or recorded in a cached VAO
+    uint64_t vertexArrayHits{0};
+    uint64_t vertexArrayMisses{0};
+};
+
+struct UniformBufferBindState
+{
+    UniformBufferBindState(GLuint h, GLintptr o, GLsizeiptr s) : handle(h), offset(o), size(s) {}
+    inline bool equals(GLuint h, GLintptr o, GLsizeiptr s) const
+    {
+        return this->handle == h && this->offset == o && this->size == s;
+    }
 
-    GLuint index;
     GLuint handle;
+    GLintptr offset;
+    GLsizeiptr size;  // -1: whole buffer
 };
 
 struct OpenGLState
@@ -118,76 +168,84 @@ struct OpenGLState
 
     constexpr static int MAX_VERTEX_ATTRIBS = 16;
     constexpr static int MAX_TEXTURE_UNITS  = 16;
+    constexpr static int MAX_UNIFORM_BUFFER_BINDINGS = 16;
 
     template <typename _Left>
-    static inline void try_enable(GLenum target, _Left& opt)
+    inline void try_enable(GLenum target, _Left& opt)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt.has_value() && opt.value())
-            return;
+            return skipped();
         opt = true;
 #endif
+        issued();
         glEnable(target);
     }
     template <typename _Left>
-    static inline void try_disable(GLenum target, _Left& opt)
+    inline void try_disable(GLenum target, _Left& opt)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (!opt.has_value() || !opt.value())
-            return;
+            return skipped();
         opt = false;
 #endif
+        issued();
         glDisable(target);
     }
     template <typename _Func, typename _Left, typename _Right>
-    static inline void try_call(_Func&& func, _Left& opt, _Right&& v)
+    inline void try_call(_Func&& func, _Left& opt, _Right&& v)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return skipped();
         opt = v;
 #endif
+        issued();
         func(v);
     }
     template <typename _Func, typename _Left, typename _Right, typename... _Args>
-    static inline void try_callf(_Func&& func, _Left& opt, _Right&& v, _Args&&... args)
+    inline void try_callf(_Func&& func, _Left& opt, _Right&& v, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return skipped();
         opt = v;
 #endif
+        issued();
         func(args...);
     }
     template <typename _Func, typename _Left, typename _Right>
-    static inline void try_callu(_Func&& func, GLenum target, _Left& opt, _Right&& v)
+    inline void try_callu(_Func&& func, GLenum target, _Left& opt, _Right&& v)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt == v)
-            return;
+            return skipped();
         opt = v;
 #endif
+        issued();
         func(target, v);
     }
     template <typename _Func, typename _Left, typename... _Args>
-    static inline void try_callx(_Func&& func, _Left& opt, _Args&&... args)
+    inline void try_callx(_Func&& func, _Left& opt, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt && (*opt).equals(args...))
-            return;
+            return skipped();
         opt.emplace(args...);
 #endif
+        issued();
         func(args...);
     }
 
     template <typename _Func, typename _Left, typename... _Args>
-    static inline void try_callxu(_Func&& func, GLenum upvalue, _Left& opt, _Args&&... args)
+    inline void try_callxu(_Func&& func, GLenum upvalue, _Left& opt, _Args&&... args)
     {
 #if defined(AX_ENABLE_STATE_GUARD)
         if (opt && (*opt).equals(args...))
-            return;
+            return skipped();
         opt.emplace(args...);
 #endif
+        issued();
         func(upvalue, args...);
     }
 
@@ -206,7 +264,7 @@ struct OpenGLState
     void enableScissor(GLint x, GLint y, GLsizei width, GLsizei height)
     {
         try_enable(GL_SCISSOR_TEST, _scissor);
-        glScissor(x, y, width, height);
+        try_callx(glScissor, _scissorBox, x, y, width, height);
     }
     void disableScissor() { try_disable(GL_SCISSOR_TEST, _scissor); }
     void lineWidth(float v) { try_call(glLineWidth, _lineWidth, v); }
@@ -230,7 +288,7 @@ struct OpenGLState
     void enableCullFace(GLenum mode)
     {
         try_enable(GL_CULL_FACE, _cullFace);
-        glCullFace(mode);
+        try_call(glCullFace, _cullFaceMode, mode);
     }
     void disableCullFace() { try_disable(GL_CULL_FACE, _cullFace); }
     void useProgram(GLuint v) { try_call(glUseProgram, _programBind, v); }
@@ -277,19 +335,30 @@ struct OpenGLState
     }
     GLenum bindBuffer(BufferType type, GLuint buffer)
     {
+        // the element buffer binding is part of the VAO, never rebind the one of a cached VAO
+        if (type == BufferType::ELEMENT_ARRAY_BUFFER && _vertexArrayBind != _defaultVertexArray)
+            bindDefaultVertexArray();
         auto target = BufferTargets[static_cast<int>(type)];
         try_callu(glBindBuffer, target, _bufferBindings[static_cast<int>(type)], buffer);
         return target;
     }
-    void deleteBuffer(BufferType type, GLuint buffer)
-    {
-        glDeleteBuffers(1, &buffer);
-        if (_bufferBindings[static_cast<int>(type)] == buffer)
-            _bufferBindings[static_cast<int>(type)].reset();
-    }
+    void deleteBuffer(BufferType type, GLuint buffer);
     void bindUniformBufferBase(GLuint index, GLuint handle)
     {
-        try_callxu(glBindBufferBase, GL_UNIFORM_BUFFER, _uniformBufferState, index, handle);
+        if (index >= MAX_UNIFORM_BUFFER_BINDINGS)
+            return glBindBufferBase(GL_UNIFORM_BUFFER, index, handle);
+        try_callx([index](GLuint h, GLintptr, GLsizeiptr) { glBindBufferBase(GL_UNIFORM_BUFFER, index, h); },
+                  _uniformBufferBindings[index], handle, GLintptr{0}, GLsizeiptr{-1});
+        // the indexed bind sets the generic binding point too
+        _bufferBindings[static_cast<int>(BufferType::UNIFORM)] = handle;
+    }
+    void bindUniformBufferRange(GLuint index, GLuint handle, GLintptr offset, GLsizeiptr size)
+    {
+        if (index >= MAX_UNIFORM_BUFFER_BINDINGS)
+            return glBindBufferRange(GL_UNIFORM_BUFFER, index, handle, offset, size);
+        try_callx([index](GLuint h, GLintptr o, GLsizeiptr s) { glBindBufferRange(GL_UNIFORM_BUFFER, index, h, o, s); },
+                  _uniformBufferBindings[index], handle, offset, size);
+        _bufferBindings[static_cast<int>(BufferType::UNIFORM)] = handle;
     }
 
     // useful for multi GL context before GL context switch, reset VAO state
@@ -307,9 +376,12 @@ struct OpenGLState
         const auto mask = 1 << index;
         if (!(_attribBits & mask))
         {
+            issued();
             glEnableVertexAttribArray(index);
             _attribBits |= mask;
         }
+        else
+            skipped();
     }
 
     void disableVertexAttribArray(GLuint index)
@@ -317,6 +389,7 @@ struct OpenGLState
         const auto mask = 1 << index;
         if (_attribBits & mask)
         {
+            issued();
             glDisableVertexAttribArray(index);
             _attribBits &= ~mask;
         }
@@ -368,6 +441,7 @@ struct OpenGLState
         const auto mask = 1 << index;
         if (!(_divisorBits & mask))
         {
+            issued();
 #if defined(__ANDROID__) && AX_GLES_PROFILE == 200
             if (glVertexAttribDivisor)
                 glVertexAttribDivisor(index, 1);
@@ -383,6 +457,7 @@ struct OpenGLState
         const auto mask = 1 << index;
         if (_divisorBits & mask)
         {
+            issued();
 #if defined(__ANDROID__) && AX_GLES_PROFILE == 200
             if (glVertexAttribDivisor)
                 glVertexAttribDivisor(index, 0);
@@ -393,6 +468,39 @@ struct OpenGLState
         }
     }
 
+    /**
+     * VAO cache, the attribute arrays enabled, their divisors and the element buffer only live in
+     * the VAO, so a draw with a known key binds one VAO instead of setting up every attribute.
+     * The attribute bits tracked above are the ones of the default VAO.
+     */
+    void setDefaultVertexArray(GLuint vao)
+    {
+        _defaultVertexArray = vao;
+        _vertexArrayBind    = vao;
+    }
+    void bindDefaultVertexArray();
+
+    /**
+     * Binds the VAO cached for key. Returns false when it has just been created, the caller must
+     * then setup the attributes of the vertex and instance buffers, the element buffer is bound by
+     * this call.
+     */
+    bool bindVertexArray(const VertexArrayKey& key);
+
+    /** Deletes the cached VAOs, must be called with the GL context current. */
+    void deleteVertexArrays();
+    /** Forgets the cached VAOs and the default one without deleting them, their names died with the lost context. */
+    void dropVertexArrays();
+
+    size_t getVertexArrayCount() const { return _vertexArrays.size(); }
+
+    /** Counters of issued and skipped calls, e.g. to measure the shadow state and the VAO cache. */
+    const OpenGLStateStats& getStats() const { return _stats; }
+    void resetStats() { _stats = OpenGLStateStats{}; }
+
+    void issued(uint32_t count = 1) { _stats.issued += count; }
+    void skipped(uint32_t count = 1) { _stats.skipped += count; }
+
 private:
     uint32_t _attribBits{0}; // vertexAttribArray bitset
     uint32_t _divisorBits{0}; // divisor bitset
@@ -426,7 +534,15 @@ private:
     std::optional<GLuint> _stencilMaskFront;
     std::optional<GLuint> _stencilMaskBack;
     std::optional<GLenum> _activeTexture;
-    std::optional<UniformBufferBaseBindState> _uniformBufferState;
+    std::optional<UniformBufferBindState> _uniformBufferBindings[MAX_UNIFORM_BUFFER_BINDINGS];
+    std::optional<ScissorBoxState> _scissorBox;
+    std::optional<GLenum> _cullFaceMode;
+
+    GLuint _defaultVertexArray{0};
+    GLuint _vertexArrayBind{0};
+    std::unordered_map<VertexArrayKey, GLuint, VertexArrayKeyHash> _vertexArrays;
+
+    OpenGLStateStats _stats;
 };
 
 AX_DLL extern OpenGLState* __gl;
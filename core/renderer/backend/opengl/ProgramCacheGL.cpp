@@ -0,0 +1,195 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ProgramCacheGL.h"
+#include "platform/FileUtils.h"
+#include "base/Data.h"
+#include "base/Logging.h"
+#include "xxhash/xxhash.h"
+#include "fmt/format.h"
+
+#include <string.h>
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+constexpr uint32_t PROGRAM_BINARY_MAGIC   = 0x42505841;  // 'AXPB'
+constexpr uint32_t PROGRAM_BINARY_VERSION = 1;
+constexpr std::string_view FINGERPRINT_FILE = "driver.txt"sv;
+
+struct ProgramBinaryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t checksum;  // of the binary following the header
+    uint32_t format;
+    uint32_t length;
+};
+}  // namespace
+
+bool ProgramCacheGL::isSupported()
+{
+#if AX_GLES_PROFILE != 200
+    if (!glGetProgramBinary || !glProgramBinary || !glProgramParameteri)
+        return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+#else
+    return false;
+#endif
+}
+
+ProgramCacheGL::ProgramCacheGL(std::string_view dir, std::string_view fingerprint)
+    : _dir(dir), _fingerprint(XXH64(fingerprint.data(), fingerprint.length(), 0))
+{
+    if (!_dir.empty() && _dir.back() != '/')
+        _dir.push_back('/');
+
+    auto fileUtils = FileUtils::getInstance();
+    auto stampPath = _dir;
+    stampPath += FINGERPRINT_FILE;
+    if (fileUtils->getStringFromFile(stampPath) != fingerprint)
+    {
+        // new driver or first launch: the binaries of another driver are useless
+        if (fileUtils->isDirectoryExist(_dir))
+            fileUtils->removeDirectory(_dir);
+        fileUtils->createDirectories(_dir);
+        fileUtils->writeStringToFile(fingerprint, stampPath);
+    }
+}
+
+uint64_t ProgramCacheGL::computeKey(std::string_view vertexSource, std::string_view fragmentSource) const
+{
+    return XXH3_64bits_withSeed(fragmentSource.data(), fragmentSource.length(),
+                                XXH3_64bits_withSeed(vertexSource.data(), vertexSource.length(), _fingerprint));
+}
+
+GLuint ProgramCacheGL::loadProgram(uint64_t key)
+{
+#if AX_GLES_PROFILE != 200
+    auto fileUtils = FileUtils::getInstance();
+    auto path      = getFilePath(key);
+    if (!fileUtils->isFileExist(path))
+    {
+        ++_stats.misses;
+        return 0;
+    }
+
+    auto data = fileUtils->getDataFromFile(path);
+    ProgramBinaryHeader header;
+    const auto size = static_cast<size_t>(data.getSize());
+    if (size < sizeof(header))
+        header.magic = 0;
+    else
+        memcpy(&header, data.getBytes(), sizeof(header));
+
+    const auto binary = data.getBytes() + sizeof(header);
+    if (header.magic != PROGRAM_BINARY_MAGIC || header.version != PROGRAM_BINARY_VERSION || header.key != key ||
+        header.length != size - sizeof(header) || XXH64(binary, header.length, key) != header.checksum)
+    {
+        AXLOGW("ProgramCacheGL: corrupted program binary {}", path);
+        fileUtils->removeFile(path);
+        ++_stats.rejected;
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary, static_cast<GLsizei>(header.length));
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        // e.g. the driver was updated without changing its version string
+        AXLOGW("ProgramCacheGL: program binary {} rejected by the driver", path);
+        glDeleteProgram(program);
+        fileUtils->removeFile(path);
+        ++_stats.rejected;
+        return 0;
+    }
+
+    ++_stats.hits;
+    return program;
+#else
+    return 0;
+#endif
+}
+
+bool ProgramCacheGL::saveProgram(uint64_t key, GLuint program)
+{
+#if AX_GLES_PROFILE != 200
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+
+    Data data;
+    data.resize(sizeof(ProgramBinaryHeader) + length);
+    auto binary = data.getBytes() + sizeof(ProgramBinaryHeader);
+
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary);
+    if (length <= 0)
+        return false;
+
+    ProgramBinaryHeader header{PROGRAM_BINARY_MAGIC, PROGRAM_BINARY_VERSION, key, XXH64(binary, length, key), format,
+                               static_cast<uint32_t>(length)};
+    memcpy(data.getBytes(), &header, sizeof(header));
+    data.resize(sizeof(header) + length);
+
+    // write aside then rename, an interrupted write never leaves a truncated binary behind
+    auto fileUtils = FileUtils::getInstance();
+    auto path      = getFilePath(key);
+    auto tempPath  = path + ".tmp"s;
+    if (!fileUtils->writeDataToFile(data, tempPath) || !fileUtils->renameFile(tempPath, path))
+    {
+        fileUtils->removeFile(tempPath);
+        return false;
+    }
+
+    ++_stats.saved;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ProgramCacheGL::clear()
+{
+    auto fileUtils = FileUtils::getInstance();
+    auto stamp     = fileUtils->getStringFromFile(_dir + std::string{FINGERPRINT_FILE});
+    fileUtils->removeDirectory(_dir);
+    fileUtils->createDirectories(_dir);
+    fileUtils->writeStringToFile(stamp, _dir + std::string{FINGERPRINT_FILE});
+}
+
+std::string ProgramCacheGL::getFilePath(uint64_t key) const
+{
+    return fmt::format("{}{:016x}.bin", _dir, key);
+}
+
+NS_AX_BACKEND_END
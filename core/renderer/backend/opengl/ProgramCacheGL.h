@@ -0,0 +1,93 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+#include "../Macros.h"
+#include "platform/GL.h"
+
+NS_AX_BACKEND_BEGIN
+
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+/**
+ * On-disk cache of linked program binaries, see glGetProgramBinary.
+ *
+ * A program is keyed by the hash of its vertex and fragment sources and of the driver fingerprint
+ * (vendor, renderer and versions), the whole cache is dropped when the fingerprint changes. Every
+ * file carries a header and a checksum which are validated on load; a binary which fails any check,
+ * or which the driver rejects, is deleted and the program is compiled from source again.
+ * @since axmol-2.2
+ */
+class ProgramCacheGL
+{
+public:
+    struct Stats
+    {
+        uint32_t hits{0};
+        uint32_t misses{0};
+        uint32_t rejected{0};  ///< corrupted files or binaries refused by the driver
+        uint32_t saved{0};
+    };
+
+    /** Whether the context can retrieve and load program binaries. */
+    static bool isSupported();
+
+    /**
+     * @param dir The cache directory, created when missing.
+     * @param fingerprint Identifies the driver, a different one invalidates the cached binaries.
+     */
+    ProgramCacheGL(std::string_view dir, std::string_view fingerprint);
+
+    uint64_t computeKey(std::string_view vertexSource, std::string_view fragmentSource) const;
+
+    /** Creates a linked program from the cached binary, 0 when there is no valid one. */
+    GLuint loadProgram(uint64_t key);
+
+    /** Stores the binary of a linked program, which should be linked with the retrievable hint. */
+    bool saveProgram(uint64_t key, GLuint program);
+
+    /** Deletes all cached binaries. */
+    void clear();
+
+    const std::string& getDirectory() const { return _dir; }
+    const Stats& getStats() const { return _stats; }
+
+private:
+    std::string getFilePath(uint64_t key) const;
+
+    std::string _dir;
+    uint64_t _fingerprint;
+    Stats _stats;
+};
+
+// end of _opengl group
+/// @}
+NS_AX_BACKEND_END
@@ -34,6 +34,9 @@
 #include "yasio/byte_buffer.hpp"
 #include "renderer/backend/opengl/UtilsGL.h"
 #include "OpenGLState.h"
+#include "UniformRingBufferGL.h"
+#include "ProgramCacheGL.h"
+#include "DriverGL.h"
 
 NS_AX_BACKEND_BEGIN
 
@@ -121,12 +124,20 @@ static void setUniform(bool isArray, GLuint location, unsigned int size, GLenum
 ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentShader)
     : Program(vertexShader, fragmentShader)
 {
-    _vertexShaderModule   = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newVertexShaderModule(_vertexShader));
-    _fragmentShaderModule = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newFragmentShaderModule(_fragmentShader));
+    auto programCache = static_cast<DriverGL*>(DriverBase::getInstance())->getProgramCache();
+    if (programCache)
+    {
+        _programCacheKey = programCache->computeKey(_vertexShader, _fragmentShader);
+        _program         = programCache->loadProgram(_programCacheKey);
+    }
 
-    AX_SAFE_RETAIN(_vertexShaderModule);
-    AX_SAFE_RETAIN(_fragmentShaderModule);
-    compileProgram();
+    if (!_program)
+    {
+        createShaderModules();
+        compileProgram();
+        if (programCache && _program)
+            programCache->saveProgram(_programCacheKey, _program);
+    }
     computeUniformInfos();
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     for (const auto& uniform : _activeUniformInfos)
@@ -165,9 +176,21 @@ void ProgramGL::reloadProgram()
     _activeUniformInfos.clear();
     _mapToCurrentActiveLocation.clear();
     _mapToOriginalLocation.clear();
-    static_cast<ShaderModuleGL*>(_vertexShaderModule)->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
-    static_cast<ShaderModuleGL*>(_fragmentShaderModule)->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
-    compileProgram();
+    _program = 0;
+    auto programCache = static_cast<DriverGL*>(DriverBase::getInstance())->getProgramCache();
+    if (programCache)
+        _program = programCache->loadProgram(_programCacheKey);
+
+    if (!_program)
+    {
+        if (!_vertexShaderModule)
+            createShaderModules();
+        static_cast<ShaderModuleGL*>(_vertexShaderModule)->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
+        static_cast<ShaderModuleGL*>(_fragmentShaderModule)->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
+        compileProgram();
+        if (programCache && _program)
+            programCache->saveProgram(_programCacheKey, _program);
+    }
     computeUniformInfos();
 
     for (const auto& uniform : _activeUniformInfos)
@@ -179,6 +202,15 @@ void ProgramGL::reloadProgram()
 }
 #endif
 
+void ProgramGL::createShaderModules()
+{
+    _vertexShaderModule   = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newVertexShaderModule(_vertexShader));
+    _fragmentShaderModule = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newFragmentShaderModule(_fragmentShader));
+
+    AX_SAFE_RETAIN(_vertexShaderModule);
+    AX_SAFE_RETAIN(_fragmentShaderModule);
+}
+
 void ProgramGL::compileProgram()
 {
     if (_vertexShaderModule == nullptr || _fragmentShaderModule == nullptr)
@@ -198,6 +230,11 @@ void ProgramGL::compileProgram()
     glAttachShader(_program, vertShader);
     glAttachShader(_program, fragShader);
 
+#if AX_GLES_PROFILE != 200
+    if (_programCacheKey)
+        glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     glLinkProgram(_program);
 
     GLint status = 0;
@@ -413,14 +450,19 @@ void ProgramGL::computeUniformInfos()
     }
 }
 
-void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize)
+void ProgramGL::bindUniformBuffers(const char* buffer, size_t bufferSize, UniformRingBufferGL* ring)
 {
 #if AX_GLES_PROFILE != 200
     for (GLuint blockIdx = 0; blockIdx < static_cast<GLuint>(_uniformBuffers.size()); ++blockIdx)
     {
         auto& desc = _uniformBuffers[blockIdx];
-        desc._ubo->updateData(buffer + desc._location, desc._size);
-        __gl->bindUniformBufferBase(blockIdx, desc._ubo->getHandler());
+        if (ring)
+            ring->bindBlock(blockIdx, buffer + desc._location, desc._size);
+        else
+        {
+            desc._ubo->updateData(buffer + desc._location, desc._size);
+            __gl->bindUniformBufferBase(blockIdx, desc._ubo->getHandler());
+        }
     }
 #else
     for (auto&& iter : _activeUniformInfos)
@@ -43,6 +43,7 @@
 NS_AX_BACKEND_BEGIN
 
 class ShaderModuleGL;
+class UniformRingBufferGL;
 
 /**
  * Store attribute information.
@@ -161,9 +162,14 @@ public:
      */
     virtual const hlookup::string_map<UniformInfo>& getAllActiveUniformInfo(ShaderStage stage) const override;
 
-    void bindUniformBuffers(const char* buffer, size_t bufferSize);
+    /**
+     * Uploads the uniform blocks of the draw.
+     * @param ring When set, the blocks go through the frame uniform ring instead of the program UBOs.
+     */
+    void bindUniformBuffers(const char* buffer, size_t bufferSize, UniformRingBufferGL* ring = nullptr);
 
 private:
+    void createShaderModules();
     void compileProgram();
     void computeUniformInfos();
     void setBuiltinLocations();
@@ -182,7 +188,8 @@ private:
 
     GLuint _program                       = 0;
     ShaderModuleGL* _vertexShaderModule   = nullptr;
-    ShaderModuleGL* _fragmentShaderModule = nullptr;
+    ShaderModuleGL* _fragmentShaderModule = nullptr;  // not created when the program comes from the binary cache
+    uint64_t _programCacheKey             = 0;
 
     axstd::pod_vector<UniformBlockDescriptor> _uniformBuffers;
 
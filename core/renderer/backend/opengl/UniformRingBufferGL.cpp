@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "UniformRingBufferGL.h"
+#include "MacrosGL.h"
+#include "OpenGLState.h"
+#include "xxhash/xxhash.h"
+
+#include <string.h>
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+size_t nextCapacity(size_t bytes)
+{
+    size_t capacity = UniformRingBufferGL::DEFAULT_CAPACITY;
+    while (capacity < bytes && capacity < UniformRingBufferGL::MAX_CAPACITY)
+        capacity <<= 1;
+    return capacity < bytes ? bytes : capacity;
+}
+}  // namespace
+
+UniformRingBufferGL::UniformRingBufferGL(size_t capacity) : _capacity(capacity) {}
+
+UniformRingBufferGL::~UniformRingBufferGL()
+{
+    if (_buffer)
+        __gl->deleteBuffer(BufferType::UNIFORM, _buffer);
+}
+
+void UniformRingBufferGL::beginFrame()
+{
+    if (_frameBytes > _capacity)
+        _capacity = nextCapacity(_frameBytes);
+    _frameBytes = 0;
+
+    if (_dirty || (_buffer && _shadow.size() != _capacity))
+        orphan();
+}
+
+void UniformRingBufferGL::bindBlock(GLuint index, const void* data, size_t size)
+{
+    auto hash = XXH3_64bits_withSeed(data, size, size);
+
+    size_t offset;
+    auto it = _blocks.find(hash);
+    if (it != _blocks.end() && memcmp(_shadow.data() + it->second, data, size) == 0)
+    {
+        offset = it->second;
+        ++_stats.blocksReused;
+    }
+    else
+    {
+        offset = allocate(size);
+        memcpy(_shadow.data() + offset, data, size);
+        // the range was not written since the storage was orphaned, no draw in flight reads it
+        glBufferSubData(__gl->bindBuffer(BufferType::UNIFORM, _buffer), static_cast<GLintptr>(offset),
+                        static_cast<GLsizeiptr>(size), data);
+        _blocks[hash] = offset;
+        _dirty        = true;
+
+        ++_stats.blocksWritten;
+        _stats.bytesWritten += size;
+    }
+
+    __gl->bindUniformBufferRange(index, _buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+}
+
+void UniformRingBufferGL::reset()
+{
+    _buffer = 0;
+    _dirty  = false;
+    _offset = 0;
+    _blocks.clear();
+}
+
+size_t UniformRingBufferGL::allocate(size_t size)
+{
+    if (!_buffer)
+    {
+        glGenBuffers(1, &_buffer);
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &_alignment);
+        if (_alignment <= 0)
+            _alignment = 256;
+        orphan();
+    }
+
+    const size_t mask = static_cast<size_t>(_alignment) - 1;
+    _frameBytes += (size + mask) & ~mask;
+
+    if (size > _capacity)
+    {
+        _capacity = nextCapacity(size);
+        orphan();
+    }
+
+    auto offset = (_offset + mask) & ~mask;
+    if (offset + size > _capacity)
+    {
+        // the draws issued so far keep the old storage, the ring grows at the next frame
+        orphan();
+        offset = 0;
+    }
+    _offset = offset + size;
+    return offset;
+}
+
+void UniformRingBufferGL::orphan()
+{
+    glBufferData(__gl->bindBuffer(BufferType::UNIFORM, _buffer), static_cast<GLsizeiptr>(_capacity), nullptr,
+                 GL_STREAM_DRAW);
+    CHECK_GL_ERROR_DEBUG();
+
+    _shadow.resize(_capacity);
+    _blocks.clear();
+    _offset = 0;
+    _dirty  = false;
+    ++_stats.orphans;
+}
+
+NS_AX_BACKEND_END
@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "../Macros.h"
+#include "platform/GL.h"
+
+NS_AX_BACKEND_BEGIN
+
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+/**
+ * A per-frame ring of uniform blocks for GL 3.x/ES 3.
+ *
+ * Every draw writes its uniform blocks once into one shared GL_UNIFORM_BUFFER and binds them by
+ * offset with glBindBufferRange, instead of re-uploading the per-program UBO and waiting for the
+ * draws still reading it. The storage is orphaned at the beginning of each frame and whenever
+ * the ring is full, so a written range is never overwritten while the GPU may use it. A block
+ * identical to one written earlier in the same storage is bound again instead of written.
+ * @since axmol-2.2
+ */
+class UniformRingBufferGL
+{
+public:
+    struct Stats
+    {
+        uint64_t blocksWritten{0};
+        uint64_t blocksReused{0};  ///< identical blocks bound again without upload
+        uint64_t bytesWritten{0};
+        uint64_t orphans{0};       ///< storage reallocations, at least one per frame using the ring
+    };
+
+    constexpr static size_t DEFAULT_CAPACITY = 256 * 1024;
+    constexpr static size_t MAX_CAPACITY     = 8 * 1024 * 1024;
+
+    explicit UniformRingBufferGL(size_t capacity = DEFAULT_CAPACITY);
+    ~UniformRingBufferGL();
+
+    /** Starts a new frame, grows the ring when the previous frame did not fit in it. */
+    void beginFrame();
+
+    /** Writes the block, or finds an identical one, and binds its range to the block binding index. */
+    void bindBlock(GLuint index, const void* data, size_t size);
+
+    /** Forgets the GL buffer without deleting it, after the GL context was lost. */
+    void reset();
+
+    size_t getCapacity() const { return _capacity; }
+
+    const Stats& getStats() const { return _stats; }
+    void resetStats() { _stats = Stats{}; }
+
+private:
+    size_t allocate(size_t size);
+    void orphan();
+
+    GLuint _buffer{0};
+    GLint _alignment{0};
+    size_t _capacity;
+    size_t _offset{0};      // end of the last block in the current storage
+    size_t _frameBytes{0};  // bytes allocated during the frame, including padding
+    bool _dirty{false};     // storage written since the last orphan
+
+    std::vector<char> _shadow;                     // CPU copy of the current storage, to confirm hash hits
+    std::unordered_map<uint64_t, size_t> _blocks;  // content hash -> offset in the current storage
+
+    Stats _stats;
+};
+
+// end of _opengl group
+/// @}
+NS_AX_BACKEND_END
@@ -208,6 +208,10 @@ void Layout::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t par
         return;
     }
 
+    // clipping uses group and callback commands
+    if (_clippingEnabled && deferParallelVisit(parentTransform, parentFlags))
+        return;
+
     if (FLAGS_TRANSFORM_DIRTY & parentFlags || _transformUpdated || _contentSizeDirty)
         _clippingRectDirty = true;
 
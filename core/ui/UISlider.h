@@ -256,6 +256,8 @@ public:
 
     // override the widget's hitTest function to perform its own
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const override;
+    // the ball may stick out of the bar
+    virtual bool isHitTestWithinContentRect() const override { return false; }
     /**
      * Returns the "class name" of widget.
      */
@@ -297,6 +297,8 @@ public:
     void setTouchAreaEnabled(bool enable);
 
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const override;
+    // the touch area may be larger than the content
+    virtual bool isHitTestWithinContentRect() const override { return false; }
 
     /**
      * @brief Set placeholder of TextField.
@@ -588,6 +588,7 @@ void Widget::setTouchEnabled(bool enable)
         _touchListener = EventListenerTouchOneByOne::create();
         AX_SAFE_RETAIN(_touchListener);
         _touchListener->setSwallowTouches(true);
+        _touchListener->setHitTestBoundsEnabled(_hitTestBoundsEnabled && isHitTestWithinContentRect());
         _touchListener->onTouchBegan     = AX_CALLBACK_2(Widget::onTouchBegan, this);
         _touchListener->onTouchMoved     = AX_CALLBACK_2(Widget::onTouchMoved, this);
         _touchListener->onTouchEnded     = AX_CALLBACK_2(Widget::onTouchEnded, this);
@@ -606,6 +607,13 @@ bool Widget::isTouchEnabled() const
     return _touchEnabled;
 }
 
+void Widget::setHitTestBoundsEnabled(bool enabled)
+{
+    _hitTestBoundsEnabled = enabled;
+    if (_touchListener)
+        _touchListener->setHitTestBoundsEnabled(_hitTestBoundsEnabled && isHitTestWithinContentRect());
+}
+
 bool Widget::isHighlighted() const
 {
     return _highlight;
@@ -1237,6 +1245,7 @@ void Widget::copyProperties(Widget* widget)
     _focused              = widget->_focused;
     _focusEnabled         = widget->_focusEnabled;
     _propagateTouchEvents = widget->_propagateTouchEvents;
+    setHitTestBoundsEnabled(widget->_hitTestBoundsEnabled);
 
     copySpecialProperties(widget);
 
@@ -455,6 +455,24 @@ public:
      */
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const;
 
+    /**
+     * Lets the EventDispatcher skip the widget for touches outside of its content rect, false by default.
+     * Only enable it when hitTest and onTouchBegan never accept a touch outside of the content rect.
+     * It has no effect on the widgets whose isHitTestWithinContentRect returns false.
+     *
+     * @param enabled Whether touches outside of the content rect skip the widget.
+     * @since axmol-2.2
+     */
+    void setHitTestBoundsEnabled(bool enabled);
+    bool isHitTestBoundsEnabled() const { return _hitTestBoundsEnabled; }
+
+    /**
+     * Whether hitTest always fails outside of the content rect of the widget.
+     * Widgets overriding hitTest with a larger area must return false.
+     * @since axmol-2.2
+     */
+    virtual bool isHitTestWithinContentRect() const { return true; }
+
     /**
      * A callback which will be called when touch began event is issued.
      *@param touch The touch info.
@@ -795,6 +813,7 @@ protected:
     bool _affectByClipping;
     bool _ignoreSize;
     bool _propagateTouchEvents;
+    bool _hitTestBoundsEnabled = false;
 
     BrightStyle _brightStyle;
     SizeType _sizeType;
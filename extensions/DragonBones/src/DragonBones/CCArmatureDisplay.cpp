@@ -226,6 +226,8 @@ void DBCCSprite::draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_
 
 ax::PolygonInfo& DBCCSprite::getPolygonInfoModify()
 {
+    // the caller modifies the mesh in place
+    _trianglesCommand.markContentDirty();
     return _polyInfo;
 }
 
@@ -514,6 +514,9 @@ EffectEmitter* EffectEmitter::create(EffectManager* manager, const std::string&
 
 EffectEmitter::EffectEmitter(EffectManager* manager)
 {
+	// renders through the manager with callback commands
+	_parallelVisitSafe = false;
+
 	this->manager = manager;
 
 	if (manager != nullptr)
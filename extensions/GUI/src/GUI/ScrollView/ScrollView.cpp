@@ -65,7 +65,10 @@ ScrollView::ScrollView()
     , _scissorRestored(false)
     , _touchListener(nullptr)
     , _animatedScrollAction(nullptr)
-{}
+{
+    // clips with callback commands
+    _parallelVisitSafe = false;
+}
 
 ScrollView::~ScrollView() {}
 
@@ -1118,6 +1118,7 @@ static void axmolMakeCurrent(GLFWwindow* window)
         GLuint vao;
         glGenVertexArrays(1, &vao);
         glBindVertexArray(vao);
+        static_cast<OpenGLState*>(p)->setDefaultVertexArray(vao);
 #    endif
     }
 
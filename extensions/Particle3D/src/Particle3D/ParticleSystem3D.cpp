@@ -44,7 +44,10 @@ ParticleSystem3D::ParticleSystem3D()
     , _blend(BlendFunc::ALPHA_NON_PREMULTIPLIED)
     , _keepLocal(false)
     , _isEnabled(true)
-{}
+{
+    // renders with callback commands and updates its GPU buffers in draw
+    _parallelVisitSafe = false;
+}
 ParticleSystem3D::~ParticleSystem3D()
 {
     // stopParticle();
@@ -26,8 +26,14 @@
 #include "EventListenerAssetsManagerEx.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
+#include "base/AsyncTaskPool.h"
 
 #include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 #ifdef MINIZIP_FROM_SYSTEM
 #    include <minizip/unzip.h>
@@ -43,9 +49,12 @@ NS_AX_EXT_BEGIN
 #define TEMP_MANIFEST_FILENAME     "project.manifest.temp"
 #define MANIFEST_FILENAME          "project.manifest"
 
-#define BUFFER_SIZE                8192
+#define BUFFER_SIZE                65536
 #define MAX_FILENAME               512
 
+#define EXTRACT_JOURNAL_SUFFIX     ".extracted"
+#define MAX_EXTRACT_THREADS        4
+
 #define DEFAULT_CONNECTION_TIMEOUT 45
 
 #define SAVE_POINT_INTERVAL        0.1
@@ -59,6 +68,15 @@ public:
     std::string zipFileName{};
 };
 
+struct AssetManagerExZipEntry
+{
+    std::string name;
+    std::string fullPath;
+    unz64_file_pos pos;
+    int64_t size;
+    uLong crc;
+};
+
 // unzip overrides to support FileStream
 long AssetManagerEx_tell_file_func(voidpf opaque, voidpf stream)
 {
@@ -165,6 +183,81 @@ int AssetManagerEx_error_file_func(voidpf opaque, voidpf stream)
 }
 // End of Overrides
 
+// Parses the journal of an interrupted decompression, one "<crc32 hex> <entry name>" per line
+static void AssetManagerEx_load_journal(std::string_view content, hlookup::string_map<uLong>& extracted)
+{
+    while (!content.empty())
+    {
+        auto eol  = content.find('\n');
+        auto line = content.substr(0, eol);
+        content   = eol != std::string_view::npos ? content.substr(eol + 1) : std::string_view{};
+
+        if (line.size() > 9 && line[8] == ' ')
+        {
+            auto crc = strtoul(std::string{line.substr(0, 8)}.c_str(), nullptr, 16);
+            extracted.emplace(line.substr(9), static_cast<uLong>(crc));
+        }
+    }
+}
+
+static bool AssetManagerEx_extract_entry(unzFile zipfile, const AssetManagerExZipEntry& entry, char* readBuffer)
+{
+    // Open current file.
+    if (unzGoToFilePos64(zipfile, &entry.pos) != UNZ_OK || unzOpenCurrentFile(zipfile) != UNZ_OK)
+    {
+        AXLOGD("AssetsManagerEx : can not extract file {}\n", entry.name);
+        return false;
+    }
+
+    // Create a file to store current file.
+    auto fsOut = FileUtils::getInstance()->openFileStream(entry.fullPath, IFileStream::Mode::WRITE);
+    if (!fsOut)
+    {
+        AXLOGD("AssetsManagerEx : can not create decompress destination file {} (errno: {})\n", entry.fullPath,
+               errno);
+        unzCloseCurrentFile(zipfile);
+        return false;
+    }
+
+    // Write current file content to destinate file.
+    int error = UNZ_OK;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    do
+    {
+        error = unzReadCurrentFile(zipfile, readBuffer, BUFFER_SIZE);
+        if (error < 0)
+        {
+            AXLOGD("AssetsManagerEx : can not read zip file {}, error code is {}\n", entry.name, error);
+            fsOut.reset();
+            unzCloseCurrentFile(zipfile);
+            return false;
+        }
+
+        if (error > 0)
+        {
+            fsOut->write(readBuffer, error);
+            crc = crc32(crc, reinterpret_cast<const Bytef*>(readBuffer), static_cast<uInt>(error));
+        }
+    } while (error > 0);
+
+    fsOut.reset();
+
+    // The embedded unzip doesn't compute the crc of the inflated data and always reports a mismatch, so it's
+    // checked here
+    error = unzCloseCurrentFile(zipfile);
+    if (error != UNZ_OK && error != UNZ_CRCERROR)
+    {
+        AXLOGD("AssetsManagerEx : can not close zip file {}, error code is {}\n", entry.name, error);
+        return false;
+    }
+    if (crc != entry.crc)
+    {
+        AXLOGD("AssetsManagerEx : crc mismatch of zip file {}\n", entry.name);
+        return false;
+    }
+    return true;
+}
+
 // Implementation of AssetsManagerEx
 
 AssetsManagerEx::AssetsManagerEx(std::string_view manifestUrl, std::string_view storagePath) : _manifestUrl(manifestUrl)
@@ -387,7 +480,7 @@ void AssetsManagerEx::adjustPath(std::string& path)
     }
 }
 
-bool AssetsManagerEx::decompress(std::string_view zip)
+bool AssetsManagerEx::decompress(std::string_view zip, int64_t* inflatedSize)
 {
     // Find root path for zip file
     size_t pos = zip.find_last_of("/\\");
@@ -407,7 +500,7 @@ bool AssetsManagerEx::decompress(std::string_view zip)
     zipFunctionOverrides.opaque = &zipFileInfo;
 
     // Open the zip file
-    unzFile zipfile = unzOpen2(zip.data(), &zipFunctionOverrides);
+    unzFile zipfile = unzOpen2(zipFileInfo.zipFileName.c_str(), &zipFunctionOverrides);
     if (!zipfile)
     {
         AXLOGD("AssetsManagerEx : can not open downloaded zip file {}\n", zip);
@@ -423,16 +516,24 @@ bool AssetsManagerEx::decompress(std::string_view zip)
         return false;
     }
 
-    // Buffer to hold data read from the zip file
-    char readBuffer[BUFFER_SIZE];
-    // Loop to extract all files.
+    // Entries written by a previous run of this package which was interrupted
+    const std::string journalPath = zipFileInfo.zipFileName + EXTRACT_JOURNAL_SUFFIX;
+    hlookup::string_map<uLong> extracted;
+    if (_fileUtils->isFileExist(journalPath))
+        AssetManagerEx_load_journal(_fileUtils->getStringFromFile(journalPath), extracted);
+
+    // Walk the central directory once: create the directories and collect the file entries, the
+    // workers then only have to seek to their entries and write files.
+    std::vector<AssetManagerExZipEntry> entries;
+    entries.reserve(global_info.number_entry);
+    std::string lastDir;
     uLong i;
     for (i = 0; i < global_info.number_entry; ++i)
     {
         // Get info about current file.
-        unz_file_info fileInfo;
+        unz_file_info64 fileInfo;
         char fileName[MAX_FILENAME];
-        if (unzGetCurrentFileInfo(zipfile, &fileInfo, fileName, MAX_FILENAME, NULL, 0, NULL, 0) != UNZ_OK)
+        if (unzGetCurrentFileInfo64(zipfile, &fileInfo, fileName, MAX_FILENAME, NULL, 0, NULL, 0) != UNZ_OK)
         {
             AXLOGD("AssetsManagerEx : can not read compressed file info\n");
             unzClose(zipfile);
@@ -459,61 +560,36 @@ bool AssetsManagerEx::decompress(std::string_view zip)
         {
             // Create all directories in advance to avoid issue
             std::string_view dir = basename(fullPath);
-            if (!_fileUtils->isDirectoryExist(dir))
+            if (dir != lastDir)
             {
-                if (!_fileUtils->createDirectories(dir))
+                if (!_fileUtils->isDirectoryExist(dir) && !_fileUtils->createDirectories(dir))
                 {
                     // Failed to create directory
                     AXLOGD("AssetsManagerEx : can not create directory {}\n", fullPath);
                     unzClose(zipfile);
                     return false;
                 }
-            }
-            // Entry is a file, so extract it.
-            // Open current file.
-            if (unzOpenCurrentFile(zipfile) != UNZ_OK)
-            {
-                AXLOGD("AssetsManagerEx : can not extract file {}\n", fileName);
-                unzClose(zipfile);
-                return false;
+                lastDir = dir;
             }
 
-            // Create a file to store current file.
-            auto fsOut = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::WRITE);
-            if (!fsOut)
+            // Skip the entries already extracted, as long as the package and the file on disk still match
+            auto it = extracted.find(std::string_view{fileName, filenameLength});
+            if (it != extracted.end() && it->second == fileInfo.crc &&
+                _fileUtils->getFileSize(fullPath) == static_cast<int64_t>(fileInfo.uncompressed_size))
             {
-                AXLOGD("AssetsManagerEx : can not create decompress destination file {} (errno: {})\n", fullPath,
-                      errno);
-                unzCloseCurrentFile(zipfile);
-                unzClose(zipfile);
-                return false;
+                AXLOGD("AssetsManagerEx : {} already extracted, skipped\n", fileName);
             }
-
-            // Write current file content to destinate file.
-            int error = UNZ_OK;
-            do
+            else
             {
-                error = unzReadCurrentFile(zipfile, readBuffer, BUFFER_SIZE);
-                if (error < 0)
-                {
-                    AXLOGD("AssetsManagerEx : can not read zip file {}, error code is {}\n", fileName, error);
-                    fsOut.reset();
-                    unzCloseCurrentFile(zipfile);
-                    unzClose(zipfile);
-                    return false;
-                }
-
-                if (error > 0)
-                {
-                    fsOut->write(readBuffer, error);
-                }
-            } while (error > 0);
-
-            fsOut.reset();
+                auto& entry = entries.emplace_back();
+                entry.name.assign(fileName, filenameLength);
+                entry.fullPath = std::move(fullPath);
+                entry.size     = static_cast<int64_t>(fileInfo.uncompressed_size);
+                entry.crc      = fileInfo.crc;
+                unzGetFilePos64(zipfile, &entry.pos);
+            }
         }
 
-        unzCloseCurrentFile(zipfile);
-
         // Goto next entry listed in the zip file.
         if ((i + 1) < global_info.number_entry)
         {
@@ -527,7 +603,65 @@ bool AssetsManagerEx::decompress(std::string_view zip)
     }
 
     unzClose(zipfile);
-    return true;
+
+    auto journal = _fileUtils->openFileStream(journalPath, IFileStream::Mode::APPEND);
+    std::mutex journalMutex;
+    std::atomic<size_t> nextEntry{0};
+    std::atomic<int64_t> written{0};
+    std::atomic<bool> failed{false};
+
+    // Every thread inflates through its own zip handle, pulling the entries one by one so a few large
+    // files don't leave the other threads idle.
+    auto extractEntries = [&]() {
+        unzFile workerZip = unzOpen2(zipFileInfo.zipFileName.c_str(), &zipFunctionOverrides);
+        if (!workerZip)
+        {
+            AXLOGD("AssetsManagerEx : can not open downloaded zip file {}\n", zip);
+            failed = true;
+            return;
+        }
+
+        auto readBuffer = std::make_unique<char[]>(BUFFER_SIZE);
+        for (size_t index = nextEntry++; index < entries.size() && !failed; index = nextEntry++)
+        {
+            auto& entry = entries[index];
+            if (!AssetManagerEx_extract_entry(workerZip, entry, readBuffer.get()))
+            {
+                failed = true;
+                break;
+            }
+            written += entry.size;
+
+            if (journal)
+            {
+                auto line = fmt::format("{:08x} {}\n", entry.crc, entry.name);
+                std::lock_guard<std::mutex> lock(journalMutex);
+                journal->write(line.data(), static_cast<unsigned int>(line.size()));
+            }
+        }
+
+        unzClose(workerZip);
+    };
+
+    // The extraction blocks on file IO for as long as the package takes, so it runs on threads of its own
+    // instead of the job system workers the frame waits on. The calling thread extracts too.
+    const auto threadCount = (std::min)(
+        static_cast<size_t>(std::clamp(std::thread::hardware_concurrency() / 2, 1u, unsigned{MAX_EXTRACT_THREADS})),
+        entries.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(extractEntries);
+    extractEntries();
+    for (auto& thread : threads)
+        thread.join();
+
+    journal.reset();
+    // Whatever happened, the caller removes the package so the journal would be of no use anymore
+    _fileUtils->removeFile(journalPath);
+
+    if (inflatedSize)
+        *inflatedSize = written;
+    return !failed;
 }
 
 void AssetsManagerEx::decompressDownloadedZip(std::string_view customId, std::string_view storagePath)
@@ -537,15 +671,21 @@ void AssetsManagerEx::decompressDownloadedZip(std::string_view customId, std::st
         std::string customId;
         std::string zipFile;
         bool succeed;
+        int64_t inflatedSize;
+        double duration;
     };
 
     AsyncData* asyncData = new AsyncData;
     asyncData->customId  = customId;
     asyncData->zipFile   = storagePath;
-    asyncData->succeed   = false;
+    asyncData->succeed      = false;
+    asyncData->inflatedSize = 0;
+    asyncData->duration     = 0;
 
     std::function<void(void*)> decompressFinished = [this](void* param) {
         auto dataInner = reinterpret_cast<AsyncData*>(param);
+        _decompressedSize += dataInner->inflatedSize;
+        _decompressDuration += dataInner->duration;
         if (dataInner->succeed)
         {
             fileSuccess(dataInner->customId, dataInner->zipFile);
@@ -561,16 +701,17 @@ void AssetsManagerEx::decompressDownloadedZip(std::string_view customId, std::st
         delete dataInner;
     };
 
-    Director::getInstance()->getJobSystem()->enqueue(
-        [this, asyncData]() {
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, std::move(decompressFinished), asyncData,
+                                          [this, asyncData]() {
         // Decompress all compressed files
-        if (decompress(asyncData->zipFile))
+        auto start = std::chrono::steady_clock::now();
+        if (decompress(asyncData->zipFile, &asyncData->inflatedSize))
         {
             asyncData->succeed = true;
         }
+        asyncData->duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
         _fileUtils->removeFile(asyncData->zipFile);
-    },
-        [decompressFinished, asyncData]() { decompressFinished(asyncData); });
+    });
 }
 
 void AssetsManagerEx::dispatchUpdateEvent(EventAssetsManagerEx::EventCode code,
@@ -756,6 +897,7 @@ void AssetsManagerEx::startUpdate()
     _percent = _percentByFile = _sizeCollected = _totalSize = 0;
     _downloadedSize.clear();
     _totalEnabled = false;
+    resetThroughput();
 
     // Temporary manifest exists, resuming previous download
     if (_tempManifest && _tempManifest->isLoaded() && _tempManifest->versionEquals(_remoteManifest))
@@ -1013,6 +1155,7 @@ void AssetsManagerEx::updateAssets(const DownloadUnits& assets)
         _totalWaitToDownload = _totalToDownload = (int)assets.size();
         _nextSavePoint                          = 0;
         _totalEnabled                           = false;
+        resetThroughput();
         if (_totalToDownload > 0)
         {
             _downloadUnits = assets;
@@ -1135,6 +1278,7 @@ void AssetsManagerEx::onProgress(double total, double downloaded, std::string_vi
             }
             totalDownloaded += it->second;
         }
+        _totalDownloaded = totalDownloaded;
         // Collect information if not registed
         if (!found)
         {
@@ -1259,7 +1403,20 @@ void AssetsManagerEx::queueDowload()
         _currConcurrentTask++;
         DownloadUnit& unit = _downloadUnits[key];
         _fileUtils->createDirectories(basename(unit.storagePath));
-        _downloader->createDownloadFileTask(unit.srcUrl, unit.storagePath, unit.customId);
+
+        // The downloader updates the digest as data is written and keeps it along with the partial file
+        std::string checksum;
+        if (_verifyChecksumWhileDownloading)
+        {
+            auto& assets = _remoteManifest->getAssets();
+            auto assetIt = assets.find(key);
+            if (assetIt != assets.end())
+            {
+                checksum = assetIt->second.md5;
+                std::transform(checksum.begin(), checksum.end(), checksum.begin(), ::tolower);
+            }
+        }
+        _downloader->createDownloadFileTask(unit.srcUrl, unit.storagePath, unit.customId, checksum);
 
         _tempManifest->setAssetDownloadState(key, Manifest::DownloadState::DOWNLOADING);
     }
@@ -1273,6 +1430,9 @@ void AssetsManagerEx::queueDowload()
 
 void AssetsManagerEx::onDownloadUnitsFinished()
 {
+    AXLOGI("AssetsManagerEx : downloaded {:.0f} bytes at {:.1f} KB/s, inflated {} bytes at {:.1f} KB/s",
+           _totalDownloaded, getDownloadSpeed() / 1024, _decompressedSize, getDecompressSpeed() / 1024);
+
     // Finished with error check
     if (!_failedUnits.empty())
     {
@@ -1288,6 +1448,25 @@ void AssetsManagerEx::onDownloadUnitsFinished()
     }
 }
 
+double AssetsManagerEx::getDownloadSpeed() const
+{
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - _updateStartTime).count();
+    return elapsed > 0 ? _totalDownloaded / elapsed : 0;
+}
+
+double AssetsManagerEx::getDecompressSpeed() const
+{
+    return _decompressDuration > 0 ? _decompressedSize / _decompressDuration : 0;
+}
+
+void AssetsManagerEx::resetThroughput()
+{
+    _updateStartTime    = std::chrono::steady_clock::now();
+    _totalDownloaded    = 0;
+    _decompressedSize   = 0;
+    _decompressDuration = 0;
+}
+
 void AssetsManagerEx::fillZipFunctionOverrides(zlib_filefunc_def_s& zipFunctionOverrides)
 {
     zipFunctionOverrides.zopen_file     = AssetManagerEx_open_file_func;
@@ -26,6 +26,7 @@
 #ifndef __AssetsManagerEx__
 #define __AssetsManagerEx__
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -136,6 +137,27 @@ public:
         _verifyCallback = callback;
     };
 
+    /** @brief Set whether the md5 of the remote manifest assets is checked while they're downloading.
+     * The digest is updated by the downloader as data is written, so there is no extra pass over the files
+     * and interrupted downloads resume with their digest. The md5 fields must hold the hex md5 of the files,
+     * assets which don't match are reported as failed.
+     * @since axmol-2.2
+     */
+    void setVerifyChecksumWhileDownloading(bool enabled) { _verifyChecksumWhileDownloading = enabled; }
+
+    bool isVerifyChecksumWhileDownloading() const { return _verifyChecksumWhileDownloading; }
+
+    /** @brief Gets the average speed of the current update in bytes per second, including the bytes resumed from
+     * a previous update.
+     * @since axmol-2.2
+     */
+    double getDownloadSpeed() const;
+
+    /** @brief Gets the average speed zip packages are inflated at in bytes per second.
+     * @since axmol-2.2
+     */
+    double getDecompressSpeed() const;
+
     AssetsManagerEx(std::string_view manifestUrl, std::string_view storagePath);
 
     virtual ~AssetsManagerEx();
@@ -167,7 +189,11 @@ protected:
     void parseManifest();
     void startUpdate();
     void updateSucceed();
-    bool decompress(std::string_view filename);
+    /** @brief Extracts the zip next to it, entries are inflated in parallel on a few threads of its own.
+     * An interrupted extraction resumes with the entries which weren't written completely.
+     * @param inflatedSize  Receives the number of bytes written, may be nullptr
+     */
+    bool decompress(std::string_view filename, int64_t* inflatedSize = nullptr);
     void decompressDownloadedZip(std::string_view customId, std::string_view storagePath);
 
     /** @brief Update a list of assets under the current AssetsManagerEx context
@@ -233,6 +259,7 @@ private:
     // Called when one DownloadUnits finished
     void onDownloadUnitsFinished();
     void fillZipFunctionOverrides(zlib_filefunc_def_s& zipFunctionOverrides);
+    void resetThroughput();
 
     //! The event of the current AssetsManagerEx in event dispatcher
     std::string _eventName;
@@ -334,6 +361,19 @@ private:
     //! Callback function to verify the downloaded assets
     std::function<bool(std::string_view path, Manifest::Asset asset)> _verifyCallback = nullptr;
 
+    //! Whether the manifest md5 is passed to the downloader
+    bool _verifyChecksumWhileDownloading = false;
+
+    //! Time the current update started at
+    std::chrono::steady_clock::time_point _updateStartTime;
+
+    //! Total bytes received for the current update
+    double _totalDownloaded = 0;
+
+    //! Bytes written by the zip packages decompressed and the time spent on them
+    int64_t _decompressedSize  = 0;
+    double _decompressDuration = 0;
+
     //! Marker for whether the assets manager is inited
     bool _inited = false;
 };
@@ -60,6 +60,12 @@ BoneNode* BoneNode::create(int length)
     return ret;
 }
 
+BoneNode::BoneNode()
+{
+    // updates its vertex buffer in draw
+    _parallelVisitSafe = false;
+}
+
 BoneNode::~BoneNode() {}
 
 bool BoneNode::init()
@@ -162,7 +162,7 @@ public:
     virtual bool isPointOnRack(const ax::Vec2& bonePoint);
 #endif
 
-    BoneNode() = default;
+    BoneNode();
     virtual ~BoneNode();
     virtual bool init() override;
 
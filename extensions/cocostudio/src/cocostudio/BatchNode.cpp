@@ -43,7 +43,11 @@ BatchNode* BatchNode::create()
     AX_SAFE_DELETE(batchNode);
     return nullptr;
 }
-BatchNode::BatchNode() /*: _groupCommand(nullptr)*/ {}
+BatchNode::BatchNode() /*: _groupCommand(nullptr)*/
+{
+    // draws the armatures in group commands
+    _parallelVisitSafe = false;
+}
 BatchNode::~BatchNode()
 {
 }
@@ -370,6 +370,12 @@ const Rect& FUIContainer::getClippingRect()
 
 void FUIContainer::visit(ax::Renderer * renderer, const ax::Mat4 & parentTransform, uint32_t parentFlags)
 {
+    // clipping uses group and callback commands
+    if ((_stencilClippingSupport != nullptr ||
+         (_rectClippingSupport != nullptr && _rectClippingSupport->_clippingEnabled)) &&
+        deferParallelVisit(parentTransform, parentFlags))
+        return;
+
     if (_stencilClippingSupport != nullptr)
     {
         if (!_visible || _children.empty())
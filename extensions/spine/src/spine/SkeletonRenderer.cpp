@@ -87,6 +87,9 @@ namespace spine {
 	}
 
 	void SkeletonRenderer::initialize() {
+		// batches the triangles in the shared SkeletonBatch and SkeletonTwoColorBatch
+		_parallelVisitSafe = false;
+
 		_clipper = new (__FILE__, __LINE__) SkeletonClipping();
 
 		_blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
@@ -33,6 +33,8 @@ THE SOFTWARE.
 #include "renderer/CustomCommand.h"
 #include "renderer/GroupCommand.h"
 
+#include <chrono>
+
 using namespace ax;
 using namespace ax::ui;
 
@@ -96,6 +98,7 @@ ActionsTests::ActionsTests()
     ADD_TEST_CASE(SequenceWithFinalInstant);
     ADD_TEST_CASE(Issue18003);
     ADD_TEST_CASE(ActionCoroutineTest);
+    ADD_TEST_CASE(ActionTweenBatchBenchmark);
 }
 
 std::string ActionsDemo::title() const
@@ -2479,3 +2482,80 @@ Coroutine ActionCoroutineTest::coroutineCallback()
 
     // co_return;   // return coroutine
 }
+
+//------------------------------------------------------------------
+//
+// ActionTweenBatchBenchmark
+//
+//------------------------------------------------------------------
+void ActionTweenBatchBenchmark::onEnter()
+{
+    ActionsDemo::onEnter();
+
+    centerSprites(0);
+
+    const int count      = 30000;
+    const int iterations = 60;
+
+    double times[2] = {};
+    size_t lanes    = 0;
+    for (bool batching : {false, true})
+    {
+        // a private manager, so that only the tweens of this benchmark are measured
+        auto manager = new ActionManager();
+        manager->setTweenBatchingEnabled(batching);
+
+        Vector<Node*> nodes;
+        for (int i = 0; i < count; ++i)
+        {
+            auto node = Node::create();
+            nodes.pushBack(node);
+            switch (i % 4)
+            {
+            case 0:
+                manager->addAction(MoveBy::create(10.0f, Vec2(100, 50)), node, false);
+                break;
+            case 1:
+                manager->addAction(EaseSineOut::create(ScaleTo::create(10.0f, 2.0f)), node, false);
+                break;
+            case 2:
+                manager->addAction(EaseCubicActionInOut::create(RotateBy::create(10.0f, 180.0f)), node, false);
+                break;
+            default:
+                manager->addAction(FadeTo::create(10.0f, 0), node, false);
+                break;
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            manager->update(1.0f / 60);
+        times[batching] =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+        if (batching)
+            lanes = manager->getTweenBatch().getLaneCount();
+
+        manager->removeAllActions();
+        manager->release();
+    }
+
+    auto text = fmt::format("{} tweens: step {:.3f} ms, tween batch {:.3f} ms ({} lanes), x{:.2f}", count, times[0],
+                            times[1], lanes, times[0] / times[1]);
+    AXLOGI("{}", text);
+
+    auto s     = Director::getInstance()->getWinSize();
+    auto label = Label::createWithTTF(text, "fonts/arial.ttf", 14);
+    label->setPosition(s.width / 2, s.height / 2);
+    addChild(label);
+}
+
+std::string ActionTweenBatchBenchmark::title() const
+{
+    return "Tween Batch Benchmark";
+}
+
+std::string ActionTweenBatchBenchmark::subtitle() const
+{
+    return "ActionManager::update with 30k simple tweens, see the console";
+}
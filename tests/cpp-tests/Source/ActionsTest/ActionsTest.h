@@ -672,4 +672,14 @@ private:
     uint64_t _frameCount;
 };
 
+class ActionTweenBatchBenchmark : public ActionsDemo
+{
+public:
+    CREATE_FUNC(ActionTweenBatchBenchmark);
+
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif
@@ -170,6 +170,8 @@ NewLabelTests::NewLabelTests()
     ADD_TEST_CASE(LabelIssueLineGap);
     ADD_TEST_CASE(LabelIssue17902);
     ADD_TEST_CASE(LabelLetterColorsTest);
+    ADD_TEST_CASE(LabelAsyncGlyphsTest);
+    ADD_TEST_CASE(LabelBinaryCacheTest);
 };
 
 LabelFNTColorAndOpacity::LabelFNTColorAndOpacity()
@@ -3871,3 +3873,134 @@ void LabelLetterColorsTest::setLetterColors(ax::Label* label, const ax::Color3B&
             letter->setColor(color);
     }
 }
+
+//
+// LabelAsyncGlyphsTest
+//
+LabelAsyncGlyphsTest::LabelAsyncGlyphsTest()
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    TTFConfig ttfConfig("fonts/HKYuanMini.ttf", 24, GlyphCollection::DYNAMIC);
+    _asyncLabel = Label::createWithTTF(ttfConfig, "", TextHAlignment::LEFT, size.width * 0.8f);
+    _asyncLabel->setPosition(size.width / 2, size.height * 0.65f);
+    addChild(_asyncLabel);
+
+    // another size, so it doesn't share the atlas with the async label
+    ttfConfig.fontSize = 22;
+    _waitLabel         = Label::createWithTTF(ttfConfig, "", TextHAlignment::LEFT, size.width * 0.8f);
+    _waitLabel->setTextColor(Color4B(128, 255, 255, 255));
+    _waitLabel->setPosition(size.width / 2, size.height * 0.35f);
+    _waitLabel->setWaitForGlyphs(true);
+    addChild(_waitLabel);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setColor(Color3B::YELLOW);
+    _statsLabel->setPosition(size.width / 2, size.height * 0.15f);
+    addChild(_statsLabel);
+}
+
+void LabelAsyncGlyphsTest::onEnter()
+{
+    AtlasDemoNew::onEnter();
+
+    FontAtlas::setAsyncGlyphRasterizationEnabled(true);
+
+    // the most common characters are rasterized while the scene starts
+    if (auto atlas = _asyncLabel->getFontAtlas())
+        atlas->prewarmGlyphs("的一是不了人我在有他这为之大来以个中上们到说国和地也子时道出而要于就下得可你年生"sv);
+
+    updateText(0);
+    schedule(AX_SCHEDULE_SELECTOR(LabelAsyncGlyphsTest::updateText), 1.0f);
+    schedule(AX_SCHEDULE_SELECTOR(LabelAsyncGlyphsTest::updateStats));
+}
+
+void LabelAsyncGlyphsTest::onExit()
+{
+    FontAtlas::setAsyncGlyphRasterizationEnabled(false);
+    AtlasDemoNew::onExit();
+}
+
+void LabelAsyncGlyphsTest::updateText(float dt)
+{
+    // walk the CJK unified ideographs block so every update misses glyphs
+    std::u32string text;
+    for (int i = 0; i < 40; ++i)
+        text.push_back(static_cast<char32_t>(0x4E00 + (_textIndex * 40 + i) % 0x5000));
+    ++_textIndex;
+
+    std::string utf8;
+    StringUtils::UTF32ToUTF8(text, utf8);
+    _asyncLabel->setString(utf8);
+    _waitLabel->setString(utf8);
+}
+
+void LabelAsyncGlyphsTest::updateStats(float dt)
+{
+    auto stats   = FontAtlas::getFrameGlyphStats();
+    auto atlas   = _asyncLabel->getFontAtlas();
+    auto pending = atlas ? atlas->getPendingGlyphCount() : 0;
+    if (stats.misses || stats.rasterized || stats.asyncRasterized || pending)
+        _statsLabel->setString(fmt::format("last frame: {} misses, {} rasterized, {} async rasterized, {} pending",
+                                           stats.misses, stats.rasterized, stats.asyncRasterized, pending));
+}
+
+std::string LabelAsyncGlyphsTest::title() const
+{
+    return "Async glyph rasterization";
+}
+
+std::string LabelAsyncGlyphsTest::subtitle() const
+{
+    return "Top label shows glyphs as workers rasterize them\nbottom label waits for its glyphs";
+}
+
+//
+// LabelBinaryCacheTest
+//
+LabelBinaryCacheTest::LabelBinaryCacheTest()
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    auto strings = FileUtils::getInstance()->getValueMapFromFile("strings/LabelFNTUNICODELanguages.xml");
+    std::string text;
+    for (auto key : {"chinese1", "japanese"})
+        text += strings[key].asString() + "\n";
+
+    FontAtlasCache::setBinaryCacheEnabled(true);
+
+    // a size no other test uses, so the atlas is created here
+    auto start = std::chrono::steady_clock::now();
+    auto label = Label::createWithTTF(TTFConfig("fonts/HKYuanMini.ttf", 27), text, TextHAlignment::CENTER,
+                                      size.width * 0.8f);
+    label->getContentSize();  // lays out the text
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    label->setPosition(size.width / 2, size.height * 0.55f);
+    addChild(label);
+
+    auto atlas  = label->getFontAtlas();
+    auto cached = atlas && !atlas->isCacheDirty();
+    auto info   = Label::createWithTTF(
+        fmt::format("created in {:.2f} ms, {}", elapsed, cached ? "loaded from the binary cache" : "rasterized"),
+        "fonts/arial.ttf", 16);
+    info->setColor(Color3B::YELLOW);
+    info->setPosition(size.width / 2, size.height * 0.2f);
+    addChild(info);
+}
+
+void LabelBinaryCacheTest::onExit()
+{
+    FontAtlasCache::saveBinaryCaches();
+    FontAtlasCache::setBinaryCacheEnabled(false);
+    AtlasDemoNew::onExit();
+}
+
+std::string LabelBinaryCacheTest::title() const
+{
+    return "FontAtlas binary cache";
+}
+
+std::string LabelBinaryCacheTest::subtitle() const
+{
+    return "Enter this test again, the glyphs should be loaded from the cache";
+}
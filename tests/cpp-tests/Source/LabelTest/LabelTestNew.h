@@ -1046,4 +1046,38 @@ private:
     static void setLetterColors(ax::Label* label, const ax::Color3B& color);
 };
 
+class LabelAsyncGlyphsTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelAsyncGlyphsTest);
+
+    LabelAsyncGlyphsTest();
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void updateText(float dt);
+    void updateStats(float dt);
+
+    ax::Label* _asyncLabel = nullptr;
+    ax::Label* _waitLabel  = nullptr;
+    ax::Label* _statsLabel = nullptr;
+    unsigned int _textIndex = 0;
+};
+
+class LabelBinaryCacheTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelBinaryCacheTest);
+
+    LabelBinaryCacheTest();
+
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif
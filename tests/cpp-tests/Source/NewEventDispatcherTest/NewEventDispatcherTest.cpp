@@ -33,6 +33,8 @@
 #include "NewEventDispatcherTest.h"
 #include "testResource.h"
 
+#include <chrono>
+
 using namespace ax;
 
 namespace {
@@ -144,6 +146,7 @@ EventDispatcherTests::EventDispatcherTests()
     ADD_TEST_CASE(WindowEventsTest);
     ADD_TEST_CASE(Issue8194);
     ADD_TEST_CASE(Issue9898)
+    ADD_TEST_CASE(HitTestBoundsBenchmark);
 }
 
 std::string EventDispatcherTestDemo::title() const
@@ -1797,3 +1800,92 @@ std::string Issue9898::subtitle() const
 {
     return "Should not crash if dispatch event after remove\n event listener in callback";
 }
+
+// HitTestBoundsBenchmark
+
+void HitTestBoundsBenchmark::onEnter()
+{
+    EventDispatcherTestDemo::onEnter();
+
+    auto origin = Director::getInstance()->getVisibleOrigin();
+    auto size   = Director::getInstance()->getVisibleSize();
+
+    // 2k touchable nodes testing the touch like ui::Widget::hitTest does
+    const int columns = 50;
+    const int rows    = 40;
+    const Size cell(size.width / columns, size.height / rows);
+    for (int y = 0; y < rows; ++y)
+    {
+        for (int x = 0; x < columns; ++x)
+        {
+            auto node = Node::create();
+            node->setContentSize(cell * 0.9f);
+            node->setPosition(origin.x + x * cell.width, origin.y + y * cell.height);
+            addChild(node);
+
+            auto listener          = EventListenerTouchOneByOne::create();
+            listener->onTouchBegan = [node](Touch* touch, Event*) {
+                Rect rect(Vec2::ZERO, node->getContentSize());
+                return isScreenPointInRect(touch->getLocation(), Camera::getVisitingCamera(),
+                                           node->getWorldToNodeTransform(), rect, nullptr);
+            };
+            _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, node);
+            _listeners.push_back(listener);
+        }
+    }
+
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _label->setPosition(origin.x + size.width / 2, origin.y + size.height / 2);
+    addChild(_label, 1);
+
+    // the hit test bounds use the transforms of the last visit
+    scheduleOnce([this](float) { runBenchmark(); }, 0.1f, "benchmark");
+}
+
+void HitTestBoundsBenchmark::runBenchmark()
+{
+    const int taps = 100;
+
+    auto origin = Director::getInstance()->getVisibleOrigin();
+    auto size   = Director::getInstance()->getVisibleSize();
+    auto touch  = new Touch();
+    auto location = Director::getInstance()->convertToUI(origin + size / 2);
+    touch->setTouchInfo(0, location.x, location.y);
+
+    EventTouch event;
+    event.setTouches({touch});
+
+    double times[2] = {};
+    for (bool enabled : {false, true})
+    {
+        for (auto listener : _listeners)
+            listener->setHitTestBoundsEnabled(enabled);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < taps; ++i)
+        {
+            event.setEventCode(EventTouch::EventCode::BEGAN);
+            _eventDispatcher->dispatchEvent(&event);
+            event.setEventCode(EventTouch::EventCode::ENDED);
+            _eventDispatcher->dispatchEvent(&event);
+        }
+        times[enabled] =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / taps;
+    }
+    touch->release();
+
+    auto text = fmt::format("{} listeners, one tap: {:.3f} ms, with hit test bounds {:.3f} ms, x{:.2f}",
+                            _listeners.size(), times[0], times[1], times[0] / times[1]);
+    AXLOGI("{}", text);
+    _label->setString(text);
+}
+
+std::string HitTestBoundsBenchmark::title() const
+{
+    return "Hit Test Bounds Benchmark";
+}
+
+std::string HitTestBoundsBenchmark::subtitle() const
+{
+    return "Dispatches taps to 2k touch listeners, see the console";
+}
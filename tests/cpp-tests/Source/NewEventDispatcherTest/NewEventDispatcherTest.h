@@ -311,4 +311,20 @@ private:
     ax::EventListenerCustom* _listener;
 };
 
+class HitTestBoundsBenchmark : public EventDispatcherTestDemo
+{
+public:
+    CREATE_FUNC(HitTestBoundsBenchmark);
+
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void runBenchmark();
+
+    std::vector<ax::EventListenerTouchOneByOne*> _listeners;
+    ax::Label* _label = nullptr;
+};
+
 #endif /* defined(__samples__NewEventDispatcherTest__) */
@@ -28,6 +28,10 @@
 #include <chrono>
 #include <sstream>
 #include "renderer/backend/DriverBase.h"
+#if defined(AX_USE_GL)
+#    include "renderer/backend/opengl/DriverGL.h"
+#    include "renderer/backend/opengl/ProgramCacheGL.h"
+#endif
 
 namespace
 {
@@ -93,6 +97,12 @@ NewRendererTests::NewRendererTests()
     ADD_TEST_CASE(RendererUniformBatch2);
     ADD_TEST_CASE(SpriteCreation);
     ADD_TEST_CASE(NonBatchSprites);
+    ADD_TEST_CASE(RendererParallelPrepare);
+    ADD_TEST_CASE(RendererBatchCache);
+    ADD_TEST_CASE(RenderQueueSortBenchmark);
+    ADD_TEST_CASE(RendererParallelVisit);
+    ADD_TEST_CASE(RendererFrameArena);
+    ADD_TEST_CASE(RendererProgramCache);
 };
 
 std::string MultiSceneTest::title() const
@@ -1070,3 +1080,502 @@ std::string NonBatchSprites::subtitle() const
     return "RELEASE: simulate lots of sprites, drop to 30 fps";
 #endif
 }
+
+// RendererBatchCache
+
+RendererBatchCache::RendererBatchCache()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // static background sprites, only the rotating ones should be re-transformed every frame
+    for (int y = 0; y < 20; ++y)
+    {
+        for (int x = 0; x < 40; ++x)
+        {
+            auto sprite = Sprite::create("Images/grossini_dance_01.png");
+            sprite->setPosition(Vec2((x + 0.5f) * s.width / 40, (y + 0.5f) * s.height / 20));
+            sprite->setScale(0.25f);
+            if ((x + y * 40) % 50 == 0)
+                sprite->runAction(RepeatForever::create(RotateBy::create(1, 90)));
+            addChild(sprite);
+        }
+    }
+
+    _statsLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 20), "");
+    _statsLabel->setColor(Color3B::YELLOW);
+    _statsLabel->setPosition(s.width / 2, s.height / 2);
+    addChild(_statsLabel, 1);
+}
+
+void RendererBatchCache::onEnter()
+{
+    MultiSceneTest::onEnter();
+    _director->getRenderer()->setBatchCacheEnabled(true);
+    scheduleUpdate();
+}
+
+void RendererBatchCache::onExit()
+{
+    _director->getRenderer()->setBatchCacheEnabled(false);
+    MultiSceneTest::onExit();
+}
+
+void RendererBatchCache::update(float dt)
+{
+    _statsLabel->setString(
+        fmt::format("re-transformed commands: {}", _director->getRenderer()->getBatchCacheMisses()));
+}
+
+std::string RendererBatchCache::title() const
+{
+    return "Renderer Batch Cache";
+}
+
+std::string RendererBatchCache::subtitle() const
+{
+    return "800 sprites, 16 rotating, only changed commands are re-transformed";
+}
+
+// RenderQueueSortBenchmark
+
+RenderQueueSortBenchmark::RenderQueueSortBenchmark()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    const int iterations = 20;
+    std::string text;
+    for (int count : {1000, 10000, 50000})
+    {
+        // integral globalZ values with many duplicates, as set by most games
+        std::vector<CustomCommand> commands(count);
+        for (auto&& command : commands)
+            command.init(static_cast<float>(std::rand() % 200 - 100) + 0.5f);
+
+        std::chrono::steady_clock::duration queueTime{}, stableSortTime{};
+        RenderQueue queue;
+        std::vector<RenderCommand*> unsorted;
+        for (int i = 0; i < iterations; ++i)
+        {
+            queue.clear();
+            unsorted.clear();
+            for (auto&& command : commands)
+            {
+                queue.emplace_back(&command);
+                unsorted.emplace_back(&command);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            queue.sort();
+            queueTime += std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            std::stable_sort(unsorted.begin(), unsorted.end(), [](RenderCommand* a, RenderCommand* b) {
+                return a->getGlobalOrder() < b->getGlobalOrder();
+            });
+            stableSortTime += std::chrono::steady_clock::now() - start;
+        }
+
+        auto queueUs  = std::chrono::duration<double, std::micro>(queueTime).count() / iterations;
+        auto stableUs = std::chrono::duration<double, std::micro>(stableSortTime).count() / iterations;
+        text += fmt::format("{} commands: RenderQueue::sort {:.1f} us, std::stable_sort {:.1f} us, x{:.2f}\n", count,
+                            queueUs, stableUs, stableUs / queueUs);
+    }
+    AXLOGI("RenderQueueSortBenchmark:\n{}", text);
+
+    auto label = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 16), text);
+    label->setPosition(s.width / 2, s.height / 2);
+    addChild(label);
+}
+
+std::string RenderQueueSortBenchmark::title() const
+{
+    return "RenderQueue Sort Benchmark";
+}
+
+std::string RenderQueueSortBenchmark::subtitle() const
+{
+    return "Radix sort on packed keys vs std::stable_sort on command pointers";
+}
+
+// RendererParallelPrepare
+
+// round 0 prepares on the render thread, the next rounds use job systems with these worker counts
+static const int PARALLEL_PREPARE_WORKERS[] = {1, 2, 4, 8};
+static const int PARALLEL_PREPARE_ROUNDS    = 1 + AX_ARRAYSIZE(PARALLEL_PREPARE_WORKERS);
+static const int PARALLEL_PREPARE_FRAMES    = 120;
+static const int PARALLEL_PREPARE_SPRITES   = 20000;
+
+RendererParallelPrepare::RendererParallelPrepare()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    const char* textures[] = {"Images/grossini_dance_01.png", "Images/grossini_dance_05.png", "Images/grossini.png"};
+
+    auto parent = Node::create();
+    addChild(parent);
+    for (int i = 0; i < PARALLEL_PREPARE_SPRITES; ++i)
+    {
+        auto sprite = Sprite::create(textures[i % AX_ARRAYSIZE(textures)]);
+        sprite->setPosition(Vec2(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height));
+        sprite->setScale(0.3f);
+        // spread over the negative and positive global z queues so they need sorting every frame
+        sprite->setGlobalZOrder(static_cast<float>(std::rand() % 200 - 100));
+        parent->addChild(sprite);
+    }
+
+    _resultLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 16), "measuring...");
+    _resultLabel->setColor(Color3B::YELLOW);
+    _resultLabel->setPosition(s.width / 2, s.height / 2);
+    _resultLabel->setGlobalZOrder(1000);
+    addChild(_resultLabel);
+}
+
+RendererParallelPrepare::~RendererParallelPrepare() {}
+
+void RendererParallelPrepare::onEnter()
+{
+    MultiSceneTest::onEnter();
+
+    _afterVisitListener = _eventDispatcher->addCustomEventListener(
+        Director::EVENT_AFTER_VISIT, [this](EventCustom*) { _renderStart = std::chrono::steady_clock::now(); });
+    _afterDrawListener =
+        _eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) { endFrame(); });
+
+    _round = 0;
+    _results.clear();
+    beginRound();
+}
+
+void RendererParallelPrepare::onExit()
+{
+    _eventDispatcher->removeEventListener(_afterVisitListener);
+    _eventDispatcher->removeEventListener(_afterDrawListener);
+
+    _director->getRenderer()->setParallelPrepare(nullptr);
+    _jobSystem.reset();
+
+    MultiSceneTest::onExit();
+}
+
+void RendererParallelPrepare::beginRound()
+{
+    _frames     = 0;
+    _renderTime = {};
+
+    auto renderer = _director->getRenderer();
+    renderer->setParallelPrepare(nullptr);
+    _jobSystem.reset();
+    if (_round > 0)
+    {
+        _jobSystem = std::make_unique<JobSystem>(PARALLEL_PREPARE_WORKERS[_round - 1]);
+        renderer->setParallelPrepare(_jobSystem.get());
+    }
+}
+
+void RendererParallelPrepare::endFrame()
+{
+    if (_round >= PARALLEL_PREPARE_ROUNDS)
+        return;
+
+    _renderTime += std::chrono::steady_clock::now() - _renderStart;
+    if (++_frames < PARALLEL_PREPARE_FRAMES)
+        return;
+
+    _results.emplace_back(std::chrono::duration<double, std::milli>(_renderTime).count() / _frames);
+
+    std::string text = fmt::format("serial: {:.2f} ms/frame", _results[0]);
+    for (size_t i = 1; i < _results.size(); ++i)
+        text += fmt::format("\n{} workers: {:.2f} ms/frame, speedup x{:.2f}", PARALLEL_PREPARE_WORKERS[i - 1],
+                            _results[i], _results[0] / _results[i]);
+    _resultLabel->setString(text);
+    AXLOGI("RendererParallelPrepare: {}", text);
+
+    if (++_round < PARALLEL_PREPARE_ROUNDS)
+        beginRound();
+    else
+    {
+        _director->getRenderer()->setParallelPrepare(nullptr);
+        _jobSystem.reset();
+    }
+}
+
+std::string RendererParallelPrepare::title() const
+{
+    return "Parallel Render Queue Preparation";
+}
+
+std::string RendererParallelPrepare::subtitle() const
+{
+    return fmt::format("{} sprites, Renderer::render time with 1, 2, 4 and 8 workers", PARALLEL_PREPARE_SPRITES);
+}
+
+// RendererParallelVisit
+
+static const int PARALLEL_VISIT_GROUPS  = 64;
+static const int PARALLEL_VISIT_SPRITES = 160;
+static const int PARALLEL_VISIT_FRAMES  = 60;
+
+RendererParallelVisit::RendererParallelVisit()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    const char* textures[] = {"Images/grossini_dance_01.png", "Images/grossini_dance_05.png", "Images/grossini.png"};
+
+    // independent groups of sprites, every group is visited by one thread
+    _tree = Node::create();
+    _tree->setParallelVisitEnabled(true);
+    for (int g = 0; g < PARALLEL_VISIT_GROUPS; ++g)
+    {
+        auto group = Node::create();
+        group->setLocalZOrder(g % 4 - 2);
+        for (int i = 0; i < PARALLEL_VISIT_SPRITES; ++i)
+        {
+            auto sprite = Sprite::create(textures[(g + i) % AX_ARRAYSIZE(textures)]);
+            sprite->setPosition(Vec2(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height));
+            sprite->setRotation(AXRANDOM_0_1() * 360);
+            sprite->setScale(0.2f);
+            group->addChild(sprite);
+        }
+        _tree->addChild(group);
+    }
+    // labels are not safe to visit on workers, they are visited at their place on the axmol thread
+    auto label = Label::createWithTTF("deferred label", "fonts/arial.ttf", 20);
+    label->setPosition(s.width / 2, s.height - 100);
+    _tree->addChild(label);
+    addChild(_tree);
+}
+
+RendererParallelVisit::~RendererParallelVisit() {}
+
+void RendererParallelVisit::onEnter()
+{
+    MultiSceneTest::onEnter();
+
+    auto renderer = _director->getRenderer();
+
+    std::string text;
+    double serial = 0;
+    for (int workers : {0, 1, 2, 4, 8})
+    {
+        _jobSystem.reset();
+        if (workers > 0)
+            _jobSystem = std::make_unique<JobSystem>(workers);
+        // the last job system keeps rendering the scene, which must look the same as with a serial visit
+        renderer->setParallelVisit(_jobSystem.get());
+
+        // every sprite transform is recomputed, as when the whole tree moves
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < PARALLEL_VISIT_FRAMES; ++i)
+        {
+            _tree->visit(renderer, Mat4::IDENTITY, Node::FLAGS_TRANSFORM_DIRTY);
+            renderer->clean();
+        }
+        const double ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() /
+            PARALLEL_VISIT_FRAMES;
+
+        if (workers == 0)
+        {
+            serial = ms;
+            text   = fmt::format("serial: {:.2f} ms/visit", ms);
+        }
+        else
+            text += fmt::format("\n{} workers: {:.2f} ms/visit, speedup x{:.2f}", workers, ms, serial / ms);
+    }
+    AXLOGI("RendererParallelVisit: {}", text);
+
+    auto s     = _director->getWinSize();
+    auto label = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 16), text);
+    label->setColor(Color3B::YELLOW);
+    label->setPosition(s.width / 2, s.height / 2);
+    label->setGlobalZOrder(1000);
+    addChild(label);
+}
+
+void RendererParallelVisit::onExit()
+{
+    _director->getRenderer()->setParallelVisit(nullptr);
+    _jobSystem.reset();
+
+    MultiSceneTest::onExit();
+}
+
+std::string RendererParallelVisit::title() const
+{
+    return "Parallel Scene Graph Visit";
+}
+
+std::string RendererParallelVisit::subtitle() const
+{
+    return fmt::format("{} sprites in {} groups, Node::visit time with 1, 2, 4 and 8 workers",
+                       PARALLEL_VISIT_GROUPS * PARALLEL_VISIT_SPRITES, PARALLEL_VISIT_GROUPS);
+}
+
+RendererFrameArena::RendererFrameArena()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // every sprite wraps its draw in a group command, every clipping node adds two callback commands
+    for (int i = 0; i < 200; ++i)
+    {
+        auto sprite = SpriteInGroupCommand::create("Images/grossini.png");
+        sprite->setPosition(Vec2(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height));
+        sprite->setScale(0.3f);
+        addChild(sprite);
+    }
+    for (int i = 0; i < 50; ++i)
+    {
+        auto clipper = ClippingRectangleNode::create(Rect(0, 0, 40, 40));
+        clipper->setPosition(Vec2(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height));
+        clipper->addChild(Sprite::create("Images/grossini_dance_01.png"));
+        addChild(clipper);
+    }
+
+    _statsLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 16), "");
+    _statsLabel->setColor(Color3B::YELLOW);
+    _statsLabel->setPosition(s.width / 2, s.height / 2);
+    _statsLabel->setGlobalZOrder(1000);
+    addChild(_statsLabel);
+
+    scheduleUpdate();
+}
+
+RendererFrameArena::~RendererFrameArena() {}
+
+void RendererFrameArena::update(float dt)
+{
+    auto renderer     = _director->getRenderer();
+    const auto& stats = renderer->getFrameArenaStats();
+    _statsLabel->setString(fmt::format(
+        "{:.1f} KB, {} allocations, {} destructors\nheap allocations: {} last frame, {} since start",
+        stats.bytesUsed / 1024.0, stats.allocations, stats.destructors, stats.heapAllocations,
+        renderer->getFrameArena().getTotalHeapAllocations()));
+}
+
+std::string RendererFrameArena::title() const
+{
+    return "Frame Arena";
+}
+
+std::string RendererFrameArena::subtitle() const
+{
+    return "Per frame allocations of the renderer, no heap allocation once steady";
+}
+
+RendererProgramCache::RendererProgramCache()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // programs no other test keeps alive, so they can be unloaded between the warm ups
+    auto programManager = ProgramManager::getInstance();
+    for (auto fsName : {"custom/example_GreyScale_fs"sv, "custom/example_EdgeDetection_fs"sv,
+                        "custom/example_Bloom_fs"sv, "custom/example_CelShading_fs"sv, "custom/example_Noisy_fs"sv,
+                        "custom/example_Outline_fs"sv})
+        _programIds.emplace_back(
+            programManager->registerCustomProgram(positionTextureColor_vert, fsName, VertexLayoutType::Sprite));
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(28);
+    auto warmUpItem = MenuItemFont::create("warm up", [this](Object*) { warmUp(); });
+    auto clearItem  = MenuItemFont::create("clear binaries", [this](Object*) { clearBinaries(); });
+    auto menu       = Menu::create(warmUpItem, clearItem, nullptr);
+    menu->alignItemsHorizontallyWithPadding(40);
+    menu->setPosition(s.width / 2, s.height / 4);
+    addChild(menu);
+
+    _resultLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 16), "");
+    _resultLabel->setPosition(s.width / 2, s.height / 2 + 20);
+    addChild(_resultLabel);
+
+    _statsLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 16), "");
+    _statsLabel->setColor(Color3B::YELLOW);
+    _statsLabel->setPosition(s.width / 2, s.height / 2 - 20);
+    addChild(_statsLabel);
+
+    scheduleUpdate();
+}
+
+RendererProgramCache::~RendererProgramCache() {}
+
+void RendererProgramCache::onExit()
+{
+    unloadPrograms();
+    MultiSceneTest::onExit();
+}
+
+void RendererProgramCache::unloadPrograms()
+{
+    auto programManager = ProgramManager::getInstance();
+    for (auto program : _programs)
+        programManager->unloadProgram(program);
+    _programs.clear();
+}
+
+void RendererProgramCache::warmUp()
+{
+    auto programManager = ProgramManager::getInstance();
+    if (programManager->isWarmingUp())
+        return;
+
+    // unloaded programs are created again, from their binary unless it was cleared
+    unloadPrograms();
+
+    _warmUpStart  = std::chrono::steady_clock::now();
+    _warmUpFrames = 0;
+    _resultLabel->setString("warming up...");
+
+    // the test may be left before the programs are loaded
+    retain();
+    programManager->warmUpPrograms(
+        _programIds,
+        [this] {
+        if (_running)
+        {
+            auto programManager = ProgramManager::getInstance();
+            for (auto id : _programIds)
+                _programs.emplace_back(programManager->loadProgram(id));
+
+            const auto elapsed =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _warmUpStart);
+            _resultLabel->setString(fmt::format("{} programs in {:.1f} ms over {} frames", _programIds.size(),
+                                                elapsed.count(), _warmUpFrames));
+        }
+        release();
+    },
+        2.0f);
+}
+
+void RendererProgramCache::clearBinaries()
+{
+#if defined(AX_USE_GL)
+    if (auto programCache = static_cast<backend::DriverGL*>(backend::DriverBase::getInstance())->getProgramCache())
+        programCache->clear();
+#endif
+}
+
+void RendererProgramCache::update(float dt)
+{
+    if (ProgramManager::getInstance()->isWarmingUp())
+        ++_warmUpFrames;
+
+#if defined(AX_USE_GL)
+    if (auto programCache = static_cast<backend::DriverGL*>(backend::DriverBase::getInstance())->getProgramCache())
+    {
+        const auto& stats = programCache->getStats();
+        _statsLabel->setString(fmt::format("binaries: {} hits, {} misses, {} rejected, {} saved", stats.hits,
+                                           stats.misses, stats.rejected, stats.saved));
+        return;
+    }
+#endif
+    _statsLabel->setString("The program cache isn't supported by this backend or context");
+}
+
+std::string RendererProgramCache::title() const
+{
+    return "Program Cache";
+}
+
+std::string RendererProgramCache::subtitle() const
+{
+    return "Warm up: sources read on the io thread, programs created within 2 ms per frame";
+}
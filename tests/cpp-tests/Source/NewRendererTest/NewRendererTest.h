@@ -279,4 +279,120 @@ protected:
     Ticker _contFast              = Ticker(2);
     Ticker _around30fps           = Ticker(60 * 3);
 };
+
+class RendererBatchCache : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererBatchCache);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+protected:
+    RendererBatchCache();
+
+    ax::Label* _statsLabel = nullptr;
+};
+
+class RenderQueueSortBenchmark : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RenderQueueSortBenchmark);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    RenderQueueSortBenchmark();
+};
+
+class RendererParallelPrepare : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererParallelPrepare);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+protected:
+    RendererParallelPrepare();
+    virtual ~RendererParallelPrepare();
+
+    void beginRound();
+    void endFrame();
+
+    ax::EventListenerCustom* _afterVisitListener = nullptr;
+    ax::EventListenerCustom* _afterDrawListener  = nullptr;
+    ax::Label* _resultLabel                      = nullptr;
+    std::unique_ptr<ax::JobSystem> _jobSystem;
+    std::chrono::steady_clock::time_point _renderStart;
+    std::chrono::steady_clock::duration _renderTime{};
+    std::vector<double> _results;
+    int _round  = 0;
+    int _frames = 0;
+};
+
+class RendererParallelVisit : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererParallelVisit);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+protected:
+    RendererParallelVisit();
+    virtual ~RendererParallelVisit();
+
+    ax::Node* _tree = nullptr;
+    std::unique_ptr<ax::JobSystem> _jobSystem;
+};
+
+class RendererFrameArena : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererFrameArena);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void update(float dt) override;
+
+protected:
+    RendererFrameArena();
+    virtual ~RendererFrameArena();
+
+    ax::Label* _statsLabel = nullptr;
+};
+
+class RendererProgramCache : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererProgramCache);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+protected:
+    RendererProgramCache();
+    virtual ~RendererProgramCache();
+
+    void warmUp();
+    void clearBinaries();
+    void unloadPrograms();
+
+    std::vector<uint64_t> _programIds;
+    std::vector<ax::backend::Program*> _programs;
+    ax::Label* _resultLabel = nullptr;
+    ax::Label* _statsLabel  = nullptr;
+    std::chrono::steady_clock::time_point _warmUpStart;
+    int _warmUpFrames = 0;
+};
 #endif  //__NewRendererTest_H_
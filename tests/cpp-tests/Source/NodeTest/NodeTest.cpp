@@ -26,6 +26,9 @@
 
 #include "NodeTest.h"
 #include <regex>
+#include <chrono>
+#include <random>
+#include "2d/TransformSystem.h"
 #include "../testResource.h"
 
 using namespace ax;
@@ -73,6 +76,8 @@ CocosNodeTests::CocosNodeTests()
     ADD_TEST_CASE(Issue16100Test);
     ADD_TEST_CASE(Issue16735Test);
     ADD_TEST_CASE(NodeWorldSpace);
+    ADD_TEST_CASE(NodeTransformSystemBenchmark);
+    ADD_TEST_CASE(NodeSpatialCullingTest);
 }
 
 TestCocosNodeDemo::TestCocosNodeDemo(void) {}
@@ -776,7 +781,7 @@ ConvertToNode::ConvertToNode()
         auto sprite = Sprite::create("Images/grossini.png");
         sprite->setPosition(Vec2(s.width / 4 * (i + 1), s.height / 2));
 
-        auto point = Sprite::create("Images/r1.png");
+        auto point = Sprite::create(s_pathR1);
         point->setScale(0.25f);
         point->setPosition(sprite->getPosition());
         addChild(point, 10, 100 + i);
@@ -1568,3 +1573,161 @@ std::string NodeWorldSpace::subtitle() const
 {
     return "Child sprite (small one) should always stay at the center of screen\nthe child sprite is a child of the moving parent sprite";
 }
+
+//------------------------------------------------------------------
+//
+// NodeTransformSystemBenchmark
+//
+//------------------------------------------------------------------
+void NodeTransformSystemBenchmark::onEnter()
+{
+    TestCocosNodeDemo::onEnter();
+
+    const int groups     = 10;
+    const int subgroups  = 10;
+    const int leaves     = 100;
+    const int iterations = 60;
+
+    auto renderer = Director::getInstance()->getRenderer();
+
+    double times[2] = {};
+    size_t updated  = 0;
+    for (bool enabled : {false, true})
+    {
+        // 10k nodes, not added to the scene so that only the visit is measured
+        auto root = Node::create();
+        std::vector<Node*> nodes;
+        for (int g = 0; g < groups; ++g)
+        {
+            auto group = Node::create();
+            group->setPosition(g * 10.0f, 0.0f);
+            root->addChild(group);
+            for (int s = 0; s < subgroups; ++s)
+            {
+                auto subgroup = Node::create();
+                subgroup->setPosition(0.0f, s * 10.0f);
+                subgroup->setRotation(s * 5.0f);
+                group->addChild(subgroup);
+                for (int l = 0; l < leaves; ++l)
+                {
+                    auto leaf = Node::create();
+                    leaf->setPosition(l * 2.0f, l * 1.0f);
+                    leaf->setScale(0.5f);
+                    subgroup->addChild(leaf);
+                    nodes.push_back(leaf);
+                }
+            }
+        }
+        root->setTransformSystemEnabled(enabled);
+
+        // warm up, builds the arrays of the system
+        root->visit(renderer, Mat4::IDENTITY, 0);
+
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+        const size_t moving = nodes.size() / 100;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            for (size_t m = 0; m < moving; ++m)
+            {
+                auto node = nodes[pick(rng)];
+                node->setPosition(node->getPosition() + Vec2(1.0f, 0.0f));
+            }
+            root->visit(renderer, Mat4::IDENTITY, 0);
+        }
+        times[enabled] =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+        if (enabled)
+            updated = root->getTransformSystem()->getUpdatedCount();
+    }
+
+    auto text = fmt::format("{} nodes, 1% moving: matrix stack {:.3f} ms, transform system {:.3f} ms, x{:.2f}\n"
+                            "transforms recomputed by the last system update: {}",
+                            groups * subgroups * leaves + groups * subgroups + groups + 1, times[0], times[1],
+                            times[0] / times[1], updated);
+    AXLOGI("{}", text);
+
+    auto s     = Director::getInstance()->getWinSize();
+    auto label = Label::createWithTTF(text, "fonts/arial.ttf", 14);
+    label->setPosition(s.width / 2, s.height / 2);
+    addChild(label);
+}
+
+std::string NodeTransformSystemBenchmark::title() const
+{
+    return "Transform System Benchmark";
+}
+
+std::string NodeTransformSystemBenchmark::subtitle() const
+{
+    return "Node::visit of a 10k nodes tree, see the console";
+}
+
+//------------------------------------------------------------------
+//
+// NodeSpatialCullingTest
+//
+//------------------------------------------------------------------
+void NodeSpatialCullingTest::onEnter()
+{
+    TestCocosNodeDemo::onEnter();
+
+    const int columns    = 250;
+    const int rows       = 200;
+    const float spacing  = 40.0f;
+    const float duration = 60.0f;
+
+    auto s     = Director::getInstance()->getWinSize();
+    auto world = SpatialNode::create(256.0f);
+    addChild(world, -1);
+
+    // 50k sprites over a 10000x8000 world
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> jitter(-10.0f, 10.0f);
+    for (int y = 0; y < rows; ++y)
+    {
+        for (int x = 0; x < columns; ++x)
+        {
+            auto sprite = Sprite::create(s_pathR1);
+            sprite->setPosition(x * spacing + jitter(rng), y * spacing + jitter(rng));
+            sprite->setColor(Color3B(128 + x % 128, 128 + y % 128, 200));
+            world->addChild(sprite);
+        }
+    }
+
+    // scrolls the world along its diagonal and back
+    const Vec2 extent(columns * spacing - s.width, rows * spacing - s.height);
+    auto scroll = MoveBy::create(duration, -extent);
+    world->runAction(RepeatForever::create(Sequence::create(scroll, scroll->reverse(), nullptr)));
+
+    auto label = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    label->setPosition(s.width / 2, s.height / 2 - 100);
+    addChild(label);
+
+    auto toggle = MenuItemFont::create("Toggle culling", [world](Object*) {
+        world->setCullingEnabled(!world->isCullingEnabled());
+    });
+    auto menu = Menu::create(toggle, nullptr);
+    menu->setPosition(s.width / 2, s.height / 2 - 130);
+    addChild(menu);
+
+    schedule(
+        [world, label](float) {
+            label->setString(fmt::format("culling {}: {} visited, {} culled", world->isCullingEnabled() ? "on" : "off",
+                                         world->getVisitedCount(), world->getCulledCount()));
+        },
+        "stats");
+}
+
+std::string NodeSpatialCullingTest::title() const
+{
+    return "Spatial Culling";
+}
+
+std::string NodeSpatialCullingTest::subtitle() const
+{
+    return "50k sprites scrolling in a SpatialNode, only the visible cells are visited";
+}
@@ -369,4 +369,24 @@ public:
     virtual void onExit() override;
 };
 
+class NodeTransformSystemBenchmark : public TestCocosNodeDemo
+{
+public:
+    CREATE_FUNC(NodeTransformSystemBenchmark);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+};
+
+class NodeSpatialCullingTest : public TestCocosNodeDemo
+{
+public:
+    CREATE_FUNC(NodeSpatialCullingTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+};
+
 #endif
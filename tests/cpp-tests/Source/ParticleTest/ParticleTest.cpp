@@ -25,6 +25,9 @@
 #include "ParticleTest.h"
 #include "../testResource.h"
 #include "cocostudio/CocosStudioExtension.h"
+#include "2d/ParticleKernels.h"
+
+#include <chrono>
 
 using namespace ax;
 
@@ -2220,6 +2223,7 @@ ParticleTests::ParticleTests()
 
     ADD_TEST_CASE(ParticleIssue12310);
     ADD_TEST_CASE(ParticleSpriteFrame);
+    ADD_TEST_CASE(ParticleKernelsBenchmark);
 }
 
 ParticleDemo::~ParticleDemo()
@@ -3250,3 +3254,117 @@ std::string ParticleSpriteFrame::subtitle() const
 {
     return "Should not use entire texture atlas";
 }
+
+//------------------------------------------------------------------
+//
+// ParticleKernelsBenchmark
+//
+//------------------------------------------------------------------
+void ParticleKernelsBenchmark::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    _color->setColor(Color3B::BLACK);
+    removeChild(_background, true);
+    _background = nullptr;
+
+    auto size = Director::getInstance()->getWinSize();
+
+    std::string text;
+    for (auto mode : {ParticleSystem::Mode::GRAVITY, ParticleSystem::Mode::RADIUS})
+    {
+        const int particles  = 100000;
+        const int iterations = 60;
+
+        auto emitter = ParticleSystemQuad::createWithTotalParticles(particles);
+        emitter->setTexture(Director::getInstance()->getTextureCache()->addImage(s_fire));
+        emitter->setDuration(ParticleSystem::DURATION_INFINITY);
+        emitter->setEmitterMode(mode);
+        if (mode == ParticleSystem::Mode::GRAVITY)
+        {
+            emitter->setGravity(Vec2(0, -90));
+            emitter->setSpeed(60);
+            emitter->setSpeedVar(20);
+            emitter->setRadialAccel(-20);
+            emitter->setTangentialAccel(15);
+            emitter->setTangentialAccelVar(5);
+        }
+        else
+        {
+            emitter->setStartRadius(0);
+            emitter->setEndRadius(size.height / 2);
+            emitter->setRotatePerSecond(90);
+            emitter->setRotatePerSecondVar(30);
+        }
+        emitter->setAngleVar(360);
+        emitter->setPosition(Vec2(size.width / 2, size.height / 2));
+        emitter->setPosVar(Vec2(40, 40));
+        // long lived, so no particle expires while measuring
+        emitter->setLife(1000);
+        emitter->setStartSize(4);
+        emitter->setEndSize(2);
+        emitter->setStartSpinVar(180);
+        emitter->setEndSpinVar(180);
+        emitter->setStartColor(Color4F(1.0f, 0.5f, 0.2f, 1.0f));
+        emitter->setStartColorVar(Color4F(0.2f, 0.2f, 0.2f, 0.0f));
+        emitter->setEndColor(Color4F(0.2f, 0.2f, 1.0f, 0.5f));
+        emitter->setEmissionRate(0);
+        addChild(emitter, 10);
+        emitter->addParticles(particles);
+
+        double times[2] = {};
+        for (bool simd : {false, true})
+        {
+            ParticleKernels::setSimdEnabled(simd);
+            // warm up the caches
+            emitter->update(1.0f / 60);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i)
+                emitter->update(1.0f / 60);
+            times[simd] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() /
+                          iterations;
+        }
+        ParticleKernels::setSimdEnabled(true);
+
+        text += fmt::format("{} mode, {} particles: scalar {:.2f} ms, simd {:.2f} ms, x{:.2f}\n",
+                            mode == ParticleSystem::Mode::GRAVITY ? "gravity" : "radius", particles, times[0],
+                            times[1], times[0] / times[1]);
+
+        // keep one emitter on screen
+        if (mode == ParticleSystem::Mode::GRAVITY)
+        {
+            removeChild(emitter, true);
+        }
+        else
+        {
+            _emitter = emitter;
+            _emitter->retain();
+        }
+    }
+
+    if (!ParticleKernels::isSimdSupported())
+        text += "SIMD kernels are not available on this target\n";
+    AXLOGI("{}", text);
+
+    auto label = Label::createWithTTF(text, "fonts/arial.ttf", 14);
+    label->setColor(Color3B::YELLOW);
+    label->setPosition(size.width / 2, size.height / 2 + 40);
+    addChild(label, 100);
+}
+
+void ParticleKernelsBenchmark::onExit()
+{
+    ParticleKernels::setSimdEnabled(true);
+    ParticleDemo::onExit();
+}
+
+std::string ParticleKernelsBenchmark::title() const
+{
+    return "Particle Kernels Benchmark";
+}
+
+std::string ParticleKernelsBenchmark::subtitle() const
+{
+    return "ParticleSystemQuad::update, scalar vs SIMD kernels";
+}
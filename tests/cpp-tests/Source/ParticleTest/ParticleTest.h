@@ -643,4 +643,14 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class ParticleKernelsBenchmark : public ParticleDemo
+{
+public:
+    CREATE_FUNC(ParticleKernelsBenchmark);
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif
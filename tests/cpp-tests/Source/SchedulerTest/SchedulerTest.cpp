@@ -27,6 +27,8 @@
 #include "ui/UIText.h"
 #include "controller.h"
 
+#include <chrono>
+
 using namespace ax;
 USING_NS_AX_EXT;
 using namespace ax::ui;
@@ -62,6 +64,7 @@ SchedulerTests::SchedulerTests()
     ADD_TEST_CASE(SchedulerIssue17149);
     ADD_TEST_CASE(SchedulerRemoveEntryWhileUpdate);
     ADD_TEST_CASE(SchedulerRemoveSelectorDuringCall);
+    ADD_TEST_CASE(SchedulerIdleTimersBenchmark);
 };
 
 //------------------------------------------------------------------
@@ -1455,3 +1458,84 @@ void SchedulerRemoveSelectorDuringCall::callback(float)
     Scheduler* const scheduler(Director::getInstance()->getScheduler());
     scheduler->unschedule(SEL_SCHEDULE(&SchedulerRemoveSelectorDuringCall::callback), this);
 }
+
+//------------------------------------------------------------------
+//
+// SchedulerIdleTimersBenchmark
+//
+//------------------------------------------------------------------
+
+std::string SchedulerIdleTimersBenchmark::title() const
+{
+    return "Idle Timers Benchmark";
+}
+
+std::string SchedulerIdleTimersBenchmark::subtitle() const
+{
+    return "Scheduler::update with 100k idle timers, see the console";
+}
+
+void SchedulerIdleTimersBenchmark::onEnter()
+{
+    SchedulerTestLayer::onEnter();
+
+    const int targetCount     = 1000;
+    const int timersPerTarget = 100;
+    const int frames          = 600;
+
+    // a private scheduler, so that only the timers of this benchmark are measured
+    auto scheduler = new Scheduler();
+    std::vector<int> targets(targetCount + 1);
+    int triggers = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < targetCount; ++t)
+    {
+        for (int i = 0; i < timersPerTarget; ++i)
+        {
+            // between 30s and 60s, none of them fires during the benchmark
+            const float interval = 30.0f + (t * timersPerTarget + i) % 3000 * 0.01f;
+            scheduler->schedule([&triggers](float) { ++triggers; }, &targets[t], interval, false,
+                                fmt::format("timer{}", i));
+        }
+    }
+    // a few busy timers on top
+    for (int i = 0; i < 100; ++i)
+    {
+        scheduler->schedule([&triggers](float) { ++triggers; }, &targets[targetCount], 0.1f, false,
+                            fmt::format("busy{}", i));
+    }
+    const auto scheduleTime =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i)
+        scheduler->update(1.0f / 60);
+    const auto updateTime =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    // pause and resume half of the targets, their timers are taken out of the wheel and put back
+    start = std::chrono::steady_clock::now();
+    for (int t = 0; t < targetCount; t += 2)
+        scheduler->pauseTarget(&targets[t]);
+    for (int t = 0; t < targetCount; t += 2)
+        scheduler->resumeTarget(&targets[t]);
+    const auto pauseTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    scheduler->unscheduleAll();
+    const auto unscheduleTime =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    scheduler->release();
+
+    auto text = fmt::format(
+        "{} idle timers + 100 busy: update {:.4f} ms/frame ({} triggers in {} frames)\n"
+        "schedule {:.1f} ms, pause/resume half {:.1f} ms, unscheduleAll {:.1f} ms",
+        targetCount * timersPerTarget, updateTime, triggers, frames, scheduleTime, pauseTime, unscheduleTime);
+    AXLOGI("{}", text);
+
+    auto s     = Director::getInstance()->getWinSize();
+    auto label = Label::createWithTTF(text, "fonts/arial.ttf", 14);
+    label->setPosition(s.width / 2, s.height / 2);
+    addChild(label);
+}
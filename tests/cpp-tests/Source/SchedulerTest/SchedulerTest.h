@@ -461,4 +461,14 @@ private:
     bool _scheduled;
 };
 
+class SchedulerIdleTimersBenchmark : public SchedulerTestLayer
+{
+public:
+    CREATE_FUNC(SchedulerIdleTimersBenchmark);
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onEnter() override;
+};
+
 #endif
@@ -92,6 +92,7 @@ Texture2DTests::Texture2DTests()
     ADD_TEST_CASE(TexturePixelFormat);
     ADD_TEST_CASE(TextureBlend);
     ADD_TEST_CASE(TextureAsync);
+    ADD_TEST_CASE(TextureAsyncBudget);
     ADD_TEST_CASE(TextureGlClamp);
     ADD_TEST_CASE(TextureGlRepeat);
     ADD_TEST_CASE(TextureSizeTest);
@@ -1801,6 +1802,99 @@ std::string TextureAsync::subtitle() const
     return "Textures should load while an animation is being run";
 }
 
+//------------------------------------------------------------------
+//
+// TextureAsyncBudget
+//
+//------------------------------------------------------------------
+
+void TextureAsyncBudget::onEnter()
+{
+    TextureDemo::onEnter();
+
+    auto size = Director::getInstance()->getWinSize();
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 12);
+    _statsLabel->setAnchorPoint(Vec2(0.5f, 1.0f));
+    _statsLabel->setPosition(Vec2(size.width / 2, size.height - 60));
+    addChild(_statsLabel, 10);
+
+    auto textureCache = Director::getInstance()->getTextureCache();
+    textureCache->resetAsyncLoadStats();
+    textureCache->setAsyncDecodeWorkers(4);
+    textureCache->setAsyncUploadBudget(2.0f);
+
+    schedule(AX_SCHEDULE_SELECTOR(TextureAsyncBudget::updateStats));
+    scheduleOnce(AX_SCHEDULE_SELECTOR(TextureAsyncBudget::loadImages), 1.0f);
+}
+
+TextureAsyncBudget::~TextureAsyncBudget()
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    textureCache->cancelAllImageAsync();
+    textureCache->setAsyncUploadBudget(0);
+    textureCache->removeAllTextures();
+}
+
+void TextureAsyncBudget::loadImages(float dt)
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    auto callback     = AX_CALLBACK_1(TextureAsyncBudget::imageLoaded, this);
+    for (int i = 0; i < 8; i++)
+    {
+        for (int j = 0; j < 8; j++)
+        {
+            auto spriteName = fmt::format("Images/sprites_test/sprite-{}-{}.png", i, j);
+            textureCache->addImageAsync(spriteName, callback, spriteName, 0);
+        }
+    }
+
+    // the big images are requested last but decoded first
+    textureCache->addImageAsync("Images/background1.jpg", callback, "Images/background1.jpg", 10);
+    textureCache->addImageAsync("Images/background2.jpg", callback, "Images/background2.jpg", 10);
+    textureCache->addImageAsync("Images/background.png", callback, "Images/background.png", 10);
+
+    // cancelled before any worker picks it up, never uploaded nor called back
+    textureCache->addImageAsync("Images/atlastest.png", callback, "cancelled", -10);
+    textureCache->cancelImageAsync("cancelled");
+}
+
+void TextureAsyncBudget::imageLoaded(Texture2D* texture)
+{
+    auto sprite = Sprite::createWithTexture(texture);
+    sprite->setAnchorPoint(Vec2(0, 0));
+    sprite->setScale(32.0f / (std::max)(sprite->getContentSize().width, 1.0f));
+    addChild(sprite, -1);
+
+    auto size = Director::getInstance()->getWinSize();
+    int i     = _imageOffset * 32;
+    sprite->setPosition(Vec2(i % (int)size.width, (i / (int)size.width) * 32));
+
+    _imageOffset++;
+}
+
+void TextureAsyncBudget::updateStats(float dt)
+{
+    auto stats = Director::getInstance()->getTextureCache()->getAsyncLoadStats();
+    _statsLabel->setString(fmt::format(
+        "queued: {}, decoding: {}, to upload: {}\n"
+        "decoded: {} ({:.2f} ms, max {:.2f} ms), uploaded: {} ({:.2f} ms, max {:.2f} ms), cancelled: {}\n"
+        "last frame upload: {:.2f} ms, {} KB",
+        stats.pendingDecodes, stats.activeDecodes, stats.pendingUploads, stats.decoded, stats.decodeTime,
+        stats.maxDecodeTime, stats.uploaded, stats.uploadTime, stats.maxUploadTime, stats.cancelled,
+        stats.lastFrameUploadTime, stats.lastFrameUploadBytes / 1024));
+}
+
+std::string TextureAsyncBudget::title() const
+{
+    return "Texture Async Load: priority and upload budget";
+}
+
+std::string TextureAsyncBudget::subtitle() const
+{
+    return "4 decode workers, 2 ms upload budget per frame";
+}
+
 //------------------------------------------------------------------
 //
 // TextureGlClamp
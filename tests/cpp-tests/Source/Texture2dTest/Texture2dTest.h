@@ -469,6 +469,25 @@ private:
     int _imageOffset;
 };
 
+class TextureAsyncBudget : public TextureDemo
+{
+public:
+    CREATE_FUNC(TextureAsyncBudget);
+    virtual ~TextureAsyncBudget();
+
+    virtual float getDuration() const override { return 5.0f; }
+    void loadImages(float dt);
+    void imageLoaded(ax::Texture2D* texture);
+    void updateStats(float dt);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onEnter() override;
+
+private:
+    ax::Label* _statsLabel = nullptr;
+    int _imageOffset       = 0;
+};
+
 class TextureGlRepeat : public TextureDemo
 {
 public:
@@ -19,6 +19,8 @@ using namespace ax;
 LAppView::LAppView(): DrawNode()
                     , _debugRects(NULL)
 {
+    // Cubism renders the models with callback commands
+    setParallelVisitSafe(false);
 }
 
 void LAppView::onEnter()
@@ -0,0 +1,134 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "AppDelegate.h"
+#include "BenchmarkRunner.h"
+#include "BenchmarkScenes.h"
+#include "platform/GLViewHeadless.h"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace ax;
+
+static Vec2 gDesignSize = Vec2(1280, 720);
+
+static void printUsage()
+{
+    printf(
+        "usage: perf-tests [options]\n"
+        "  --frames <n>     measured frames per scene, default 600\n"
+        "  --warmup <n>     frames run before measuring, default 60\n"
+        "  --scene <name>   only run the scenes whose name contains <name>\n"
+        "  --output <path>  write the JSON report to <path> instead of stdout\n"
+        "  --list           list the scenes\n");
+}
+
+void AppDelegate::initGLContextAttrs() {}
+
+bool AppDelegate::applicationDidFinishLaunching()
+{
+    // the driver must be installed before the director creates its renderer
+    backend::DriverBase::setInstance(new backend::DriverNull());
+
+    auto director = Director::getInstance();
+    auto glView   = GLViewHeadless::create("Perf Tests", Rect(0, 0, gDesignSize.x, gDesignSize.y));
+    director->setGLView(glView);
+    glView->setDesignResolutionSize(gDesignSize.x, gDesignSize.y, ResolutionPolicy::SHOW_ALL);
+    director->setStatsDisplay(false);
+    director->startAnimation();
+
+    return true;
+}
+
+void AppDelegate::applicationDidEnterBackground() {}
+
+void AppDelegate::applicationWillEnterForeground() {}
+
+int AppDelegate::run(int argc, char** argv)
+{
+    int frames  = -1;
+    int warmup  = -1;
+    bool list   = false;
+    std::string_view filter;
+    std::string_view output;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--frames") && hasValue)
+            frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--warmup") && hasValue)
+            warmup = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--scene") && hasValue)
+            filter = argv[++i];
+        else if (!strcmp(argv[i], "--output") && hasValue)
+            output = argv[++i];
+        else if (!strcmp(argv[i], "--list"))
+            list = true;
+        else
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    // keep stdout for the report
+    if (output.empty() && !list)
+        ax::setLogLevel(LogLevel::Warn);
+
+    if (!applicationDidFinishLaunching())
+        return EXIT_FAILURE;
+
+    auto driver = static_cast<backend::DriverNull*>(backend::DriverBase::getInstance());
+    BenchmarkRunner runner(driver);
+    registerBenchmarkScenes(runner);
+
+    if (list)
+    {
+        for (auto&& name : runner.getSceneNames())
+            printf("%s\n", name.c_str());
+        return EXIT_SUCCESS;
+    }
+
+    if (frames > 0)
+        runner.setFrameCount(frames);
+    if (warmup >= 0)
+        runner.setWarmupFrameCount(warmup);
+    runner.setFilter(filter);
+
+    auto results = runner.run();
+    auto json    = runner.toJson(results);
+
+    bool saved = true;
+    if (output.empty())
+        printf("%s\n", json.c_str());
+    else
+        saved = FileUtils::getInstance()->writeStringToFile(json, output);
+
+    auto director = Director::getInstance();
+    director->end();
+    director->mainLoop();
+
+    return saved ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,165 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "BenchmarkRunner.h"
+#include "base/JsonWriter.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace ax;
+
+static constexpr float kFrameDelta = 1.0f / 60;
+
+namespace
+{
+double percentile(const std::vector<double>& sorted, double p)
+{
+    auto index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void writeCounters(JsonWriter<true>& writer, const backend::NullDriverStats& stats, double scale)
+{
+    writer.writeNumber("drawCalls", stats.drawCalls * scale);
+    writer.writeNumber("vertices", stats.vertices * scale);
+    writer.writeNumber("instances", stats.instances * scale);
+    writer.writeNumber("renderPasses", stats.renderPasses * scale);
+    writer.writeNumber("stateChanges", stats.stateChanges * scale);
+    writer.writeNumber("textureBinds", stats.textureBinds * scale);
+    writer.writeNumber("bufferUploads", stats.bufferUploads * scale);
+    writer.writeNumber("bufferBytes", stats.bufferBytes * scale);
+    writer.writeNumber("textureUploads", stats.textureUploads * scale);
+    writer.writeNumber("textureBytes", stats.textureBytes * scale);
+    writer.writeNumber("uniformBytes", stats.uniformBytes * scale);
+}
+}  // namespace
+
+void BenchmarkRunner::addScene(std::string_view name, SceneFactory factory)
+{
+    _scenes.emplace_back(Entry{std::string{name}, std::move(factory)});
+}
+
+std::vector<std::string> BenchmarkRunner::getSceneNames() const
+{
+    std::vector<std::string> names;
+    for (auto&& entry : _scenes)
+        names.emplace_back(entry.name);
+    return names;
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run()
+{
+    std::vector<BenchmarkResult> results;
+    auto director = Director::getInstance();
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(_frames);
+
+    for (auto&& entry : _scenes)
+    {
+        if (!_filter.empty() && entry.name.find(_filter) == std::string::npos)
+            continue;
+
+        auto scene = entry.factory();
+        if (!scene)
+        {
+            AXLOGW("Skip benchmark {}: its assets are missing", entry.name);
+            continue;
+        }
+
+        if (director->getRunningScene())
+            director->replaceScene(scene);
+        else
+            director->runWithScene(scene);
+
+        // the first frames switch the scene and upload its resources
+        for (int i = 0; i < _warmupFrames; ++i)
+            director->mainLoop(kFrameDelta);
+
+        _driver->resetStats();
+        frameTimes.clear();
+        for (int i = 0; i < _frames; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            director->mainLoop(kFrameDelta);
+            auto end = std::chrono::steady_clock::now();
+            frameTimes.emplace_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+
+        BenchmarkResult& result = results.emplace_back();
+        result.name   = entry.name;
+        result.frames = _frames;
+        result.stats  = _driver->getStats();
+
+        std::sort(frameTimes.begin(), frameTimes.end());
+        double total = 0;
+        for (auto t : frameTimes)
+            total += t;
+        result.minMs = frameTimes.front();
+        result.maxMs = frameTimes.back();
+        result.avgMs = total / frameTimes.size();
+        result.p50Ms = percentile(frameTimes, 0.5);
+        result.p95Ms = percentile(frameTimes, 0.95);
+
+        AXLOGI("{}: avg {:.3f} ms, p95 {:.3f} ms, {} draw calls per frame", result.name, result.avgMs, result.p95Ms,
+               result.stats.drawCalls / _frames);
+
+        director->getTextureCache()->removeUnusedTextures();
+    }
+
+    return results;
+}
+
+std::string BenchmarkRunner::toJson(const std::vector<BenchmarkResult>& results) const
+{
+    JsonWriter<true> writer;
+    writer.writeStartObject();
+    writer.writeString("backend", _driver->getRenderer());
+    writer.writeNumber("frames", _frames);
+    writer.writeNumber("warmupFrames", _warmupFrames);
+    writer.writeNumber("frameDelta", static_cast<double>(kFrameDelta));
+    writer.writeStartArray("scenes");
+    for (auto&& result : results)
+    {
+        writer.writeStartObject();
+        writer.writeString("name", result.name);
+
+        writer.writeStartObject("frameTimeMs");
+        writer.writeNumber("min", result.minMs);
+        writer.writeNumber("avg", result.avgMs);
+        writer.writeNumber("p50", result.p50Ms);
+        writer.writeNumber("p95", result.p95Ms);
+        writer.writeNumber("max", result.maxMs);
+        writer.writeEndObject();
+
+        writer.writeStartObject("perFrame");
+        writeCounters(writer, result.stats, 1.0 / result.frames);
+        writer.writeEndObject();
+
+        writer.writeEndObject();
+    }
+    writer.writeEndArray();
+    writer.writeEndObject();
+    return std::string{static_cast<std::string_view>(writer)};
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "axmol.h"
+#include "renderer/backend/null/DriverNull.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/** Timings and driver counters of one benchmark scene. */
+struct BenchmarkResult
+{
+    std::string name;
+    int frames = 0;
+
+    // CPU time of Director::mainLoop, in milliseconds
+    double minMs = 0;
+    double avgMs = 0;
+    double p50Ms = 0;
+    double p95Ms = 0;
+    double maxMs = 0;
+
+    // what the measured frames submitted to the null driver
+    ax::backend::NullDriverStats stats;
+};
+
+/**
+ * Runs the registered scenes one after the other on the headless director and measures every frame.
+ *
+ * Frames advance with a fixed delta time so that two runs animate the same content, the measured time is
+ * the wall time of a whole Director::mainLoop() call.
+ */
+class BenchmarkRunner
+{
+public:
+    using SceneFactory = std::function<ax::Scene*()>;
+
+    explicit BenchmarkRunner(ax::backend::DriverNull* driver) : _driver(driver) {}
+
+    /** Registers a scene, factory may return nullptr when the scene assets are missing. */
+    void addScene(std::string_view name, SceneFactory factory);
+
+    void setFrameCount(int frames) { _frames = std::max(frames, 1); }
+    void setWarmupFrameCount(int frames) { _warmupFrames = std::max(frames, 0); }
+
+    /** Only runs the scenes whose name contains filter, an empty filter runs all of them. */
+    void setFilter(std::string_view filter) { _filter = filter; }
+
+    std::vector<std::string> getSceneNames() const;
+
+    std::vector<BenchmarkResult> run();
+
+    std::string toJson(const std::vector<BenchmarkResult>& results) const;
+
+private:
+    struct Entry
+    {
+        std::string name;
+        SceneFactory factory;
+    };
+
+    ax::backend::DriverNull* _driver;
+    std::vector<Entry> _scenes;
+    std::string _filter;
+    int _frames       = 600;
+    int _warmupFrames = 60;
+};
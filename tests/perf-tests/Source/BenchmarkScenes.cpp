@@ -0,0 +1,182 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "BenchmarkScenes.h"
+#include "BenchmarkRunner.h"
+
+#if defined(AX_ENABLE_EXT_SPINE)
+#    include "spine/spine-axmol.h"
+#endif
+
+#include <random>
+
+using namespace ax;
+
+namespace
+{
+// every scene fills the same design resolution, see AppDelegate
+Vec2 randomPosition(std::mt19937& rng)
+{
+    auto size = Director::getInstance()->getWinSize();
+    std::uniform_real_distribution<float> x(0, size.width), y(0, size.height);
+    return Vec2(x(rng), y(rng));
+}
+
+Texture2D* createCheckerTexture()
+{
+    constexpr int size = 32;
+    std::vector<uint32_t> pixels(size * size);
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+            pixels[y * size + x] = ((x / 8 + y / 8) & 1) ? 0xffffffff : 0xff4080c0;
+
+    auto texture = new Texture2D();
+    texture->initWithData(pixels.data(), pixels.size() * sizeof(uint32_t), backend::PixelFormat::RGBA8, size, size);
+    texture->autorelease();
+    return texture;
+}
+
+Scene* createSpritesScene()
+{
+    constexpr int count = 4000;
+
+    auto scene   = Scene::create();
+    auto texture = createCheckerTexture();
+    std::mt19937 rng(1);
+    for (int i = 0; i < count; ++i)
+    {
+        auto sprite = Sprite::createWithTexture(texture);
+        sprite->setPosition(randomPosition(rng));
+        sprite->runAction(RepeatForever::create(RotateBy::create(1.0f + (i % 4), 90.0f)));
+        scene->addChild(sprite);
+    }
+    return scene;
+}
+
+Scene* createLabelsScene()
+{
+    constexpr int count        = 100;
+    constexpr int dynamicCount = 20;
+    constexpr auto font        = "fonts/arial.ttf"sv;
+
+    if (!FileUtils::getInstance()->isFileExist(font))
+        return nullptr;
+
+    auto scene = Scene::create();
+    std::mt19937 rng(2);
+    std::vector<Label*> dynamicLabels;
+    for (int i = 0; i < count; ++i)
+    {
+        auto label = Label::createWithTTF(fmt::format("Label {} of the benchmark", i), font, 16);
+        label->setPosition(randomPosition(rng));
+        scene->addChild(label);
+        if (i < dynamicCount)
+            dynamicLabels.emplace_back(label);
+    }
+
+    // a few labels change every frame, which rebuilds their quads and may add glyphs to the atlas
+    scene->schedule(
+        [dynamicLabels, frame = 0](float) mutable {
+            ++frame;
+            for (auto label : dynamicLabels)
+                label->setString(fmt::format("Frame {}", frame));
+        },
+        "labels");
+    return scene;
+}
+
+Scene* createParticlesScene()
+{
+    constexpr int count = 1000;
+
+    auto scene = Scene::create();
+    std::mt19937 rng(3);
+    ParticleSystemQuad* systems[] = {ParticleFire::createWithTotalParticles(count),
+                                     ParticleGalaxy::createWithTotalParticles(count),
+                                     ParticleSun::createWithTotalParticles(count),
+                                     ParticleFireworks::createWithTotalParticles(count),
+                                     ParticleMeteor::createWithTotalParticles(count),
+                                     ParticleSpiral::createWithTotalParticles(count),
+                                     ParticleExplosion::createWithTotalParticles(count),
+                                     ParticleSmoke::createWithTotalParticles(count)};
+    for (auto system : systems)
+    {
+        system->setPosition(randomPosition(rng));
+        scene->addChild(system);
+    }
+    return scene;
+}
+
+Scene* createTileMapScene()
+{
+    constexpr auto tmx = "TileMaps/orthogonal-test2.tmx"sv;
+
+    if (!FileUtils::getInstance()->isFileExist(tmx))
+        return nullptr;
+
+    auto scene = Scene::create();
+    auto map   = FastTMXTiledMap::create(tmx);
+    if (!map)
+        return nullptr;
+
+    // scrolling makes the layers recompute the visible tiles
+    auto scroll = MoveBy::create(4, Vec2(-map->getContentSize().width / 2, 0));
+    map->runAction(RepeatForever::create(Sequence::create(scroll, scroll->reverse(), nullptr)));
+    scene->addChild(map);
+    return scene;
+}
+
+#if defined(AX_ENABLE_EXT_SPINE)
+Scene* createSpineScene()
+{
+    constexpr int count = 30;
+
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist("spine/spineboy-pro.json") || !fileUtils->isFileExist("spine/spineboy.atlas"))
+        return nullptr;
+
+    auto scene = Scene::create();
+    std::mt19937 rng(4);
+    for (int i = 0; i < count; ++i)
+    {
+        auto skeleton =
+            spine::SkeletonAnimation::createWithJsonFile("spine/spineboy-pro.json", "spine/spineboy.atlas", 0.3f);
+        skeleton->setAnimation(0, (i & 1) ? "run" : "walk", true);
+        skeleton->setPosition(randomPosition(rng));
+        scene->addChild(skeleton);
+    }
+    return scene;
+}
+#endif
+}  // namespace
+
+void registerBenchmarkScenes(BenchmarkRunner& runner)
+{
+    runner.addScene("sprites", createSpritesScene);
+    runner.addScene("labels", createLabelsScene);
+    runner.addScene("particles", createParticlesScene);
+    runner.addScene("tilemap", createTileMapScene);
+#if defined(AX_ENABLE_EXT_SPINE)
+    runner.addScene("spine", createSpineScene);
+#endif
+}
@@ -25,9 +25,50 @@
 #include <doctest.h>
 #include <float.h>
 #include "2d/Node.h"
+#include "2d/TransformSystem.h"
 
 using namespace ax;
 
+namespace {
+    struct ProbeNode : public Node {
+        void draw(Renderer*, const Mat4& transform, uint32_t) override { drawn = transform; }
+
+        Mat4 drawn;
+    };
+
+    // builds the same tree with a fixed layout, returns the nodes in creation order
+    std::vector<ProbeNode*> buildTree(Node* root, int depth, int fanout) {
+        std::vector<ProbeNode*> nodes;
+        std::vector<Node*> level{root};
+        for (int d = 0; d < depth; ++d) {
+            std::vector<Node*> next;
+            for (auto parent : level) {
+                for (int i = 0; i < fanout; ++i) {
+                    auto node = new ProbeNode();
+                    const auto n = static_cast<float>(nodes.size());
+                    node->setPosition(n * 3.0f, n * 2.0f);
+                    node->setRotation(n * 7.0f);
+                    node->setScale(1.0f + n * 0.01f);
+                    node->setContentSize(Vec2(20.0f, 10.0f));
+                    parent->addChild(node);
+                    node->release();
+                    nodes.push_back(node);
+                    next.push_back(node);
+                }
+            }
+            level = std::move(next);
+        }
+        return nodes;
+    }
+
+    void checkSameTransforms(const std::vector<ProbeNode*>& a, const std::vector<ProbeNode*>& b) {
+        REQUIRE_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); ++i)
+            for (int k = 0; k < 16; ++k)
+                CHECK(a[i]->drawn.m[k] == doctest::Approx(b[i]->drawn.m[k]).epsilon(1e-5));
+    }
+}
+
 TEST_SUITE("2d/Node") {
     TEST_CASE("normalized_position") {
         auto parent = Node();
@@ -59,4 +100,69 @@ TEST_SUITE("2d/Node") {
         CHECK_EQ(200.0f, node.getPosition().x);
         CHECK_EQ(100.0f, node.getPosition().y);
     }
+
+    TEST_CASE("transform_system") {
+        auto classic = Node();
+        auto managed = Node();
+        managed.setTransformSystemEnabled(true);
+        CHECK(managed.isTransformSystemEnabled());
+
+        auto classicNodes = buildTree(&classic, 3, 4);
+        auto managedNodes = buildTree(&managed, 3, 4);
+
+        Mat4 parentTransform;
+        Mat4::createTranslation(10.0f, 20.0f, 0.0f, &parentTransform);
+
+        classic.visit(nullptr, parentTransform, 0);
+        managed.visit(nullptr, parentTransform, 0);
+        checkSameTransforms(classicNodes, managedNodes);
+
+        auto system = managed.getTransformSystem();
+        REQUIRE(system);
+        CHECK_EQ(system->getNodeCount(), managedNodes.size() + 1);
+        CHECK_EQ(managedNodes.back()->getTransformSystem(), system);
+
+        // nothing moved
+        classic.visit(nullptr, parentTransform, 0);
+        managed.visit(nullptr, parentTransform, 0);
+        CHECK_EQ(system->getUpdatedCount(), 0);
+
+        // a moving node updates its subtree only
+        classicNodes[1]->setPosition(50.0f, 60.0f);
+        managedNodes[1]->setPosition(50.0f, 60.0f);
+        classic.visit(nullptr, parentTransform, 0);
+        managed.visit(nullptr, parentTransform, 0);
+        checkSameTransforms(classicNodes, managedNodes);
+        CHECK_EQ(system->getUpdatedCount(), 1 + 4 + 16);
+
+        // hierarchy changes
+        auto rebuilds = system->getRebuildCount();
+        classicNodes[2]->retain();
+        managedNodes[2]->retain();
+        classicNodes[2]->removeFromParent();
+        managedNodes[2]->removeFromParent();
+        CHECK_EQ(managedNodes[2]->getTransformSystem(), nullptr);
+        classicNodes[0]->addChild(classicNodes[2]);
+        managedNodes[0]->addChild(managedNodes[2]);
+        classicNodes[2]->release();
+        managedNodes[2]->release();
+        classic.visit(nullptr, parentTransform, 0);
+        managed.visit(nullptr, parentTransform, 0);
+        checkSameTransforms(classicNodes, managedNodes);
+        CHECK_EQ(system->getRebuildCount(), rebuilds + 1);
+
+        // excluded subtrees are transformed by visit
+        managedNodes[3]->setTransformSystemExcluded(true);
+        classicNodes[3]->setRotation(45.0f);
+        managedNodes[3]->setRotation(45.0f);
+        Mat4::createTranslation(-5.0f, 0.0f, 0.0f, &parentTransform);
+        classic.visit(nullptr, parentTransform, 0);
+        managed.visit(nullptr, parentTransform, 0);
+        checkSameTransforms(classicNodes, managedNodes);
+        CHECK_EQ(managedNodes[3]->getTransformSystem(), nullptr);
+
+        managed.setTransformSystemEnabled(false);
+        CHECK_EQ(managed.getTransformSystem(), nullptr);
+        CHECK_EQ(managedNodes[0]->getTransformSystem(), nullptr);
+    }
 }
@@ -0,0 +1,234 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <algorithm>
+#include <random>
+#include "2d/ParticleSystem.h"
+#include "2d/ParticleKernels.h"
+
+using namespace ax;
+
+namespace
+{
+struct RandomParticles
+{
+    ParticleData data;
+
+    explicit RandomParticles(int count, unsigned int seed = 7)
+    {
+        REQUIRE(data.init(count));
+        data.opacityFadeInDelta  = (float*)malloc(count * sizeof(float));
+        data.opacityFadeInLength = (float*)malloc(count * sizeof(float));
+        data.scaleInDelta        = (float*)malloc(count * sizeof(float));
+        data.scaleInLength       = (float*)malloc(count * sizeof(float));
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f), signed_(-1.0f, 1.0f);
+        for (int i = 0; i < count; ++i)
+        {
+            data.posx[i]      = signed_(rng) * 200;
+            data.posy[i]      = signed_(rng) * 200;
+            data.startPosX[i] = signed_(rng) * 50;
+            data.startPosY[i] = signed_(rng) * 50;
+
+            data.colorR[i]      = unit(rng);
+            data.colorG[i]      = unit(rng);
+            data.colorB[i]      = unit(rng);
+            data.colorA[i]      = unit(rng);
+            data.deltaColorR[i] = signed_(rng);
+            data.deltaColorG[i] = signed_(rng);
+            data.deltaColorB[i] = signed_(rng);
+            data.deltaColorA[i] = signed_(rng);
+
+            data.opacityFadeInLength[i] = 0.1f + unit(rng);
+            data.opacityFadeInDelta[i]  = unit(rng) * data.opacityFadeInLength[i];
+            data.scaleInLength[i]       = 0.1f + unit(rng);
+            data.scaleInDelta[i]        = unit(rng) * data.scaleInLength[i];
+
+            data.size[i]           = unit(rng) * 64;
+            data.deltaSize[i]      = signed_(rng) * 64;
+            data.rotation[i]       = signed_(rng) * 720;
+            data.staticRotation[i] = signed_(rng) * 180;
+            data.deltaRotation[i]  = signed_(rng) * 90;
+            data.timeToLive[i]     = signed_(rng);
+
+            data.modeA.dirX[i]            = signed_(rng) * 100;
+            data.modeA.dirY[i]            = signed_(rng) * 100;
+            data.modeA.radialAccel[i]     = signed_(rng) * 50;
+            data.modeA.tangentialAccel[i] = signed_(rng) * 50;
+
+            data.modeB.angle[i]            = signed_(rng) * 100;
+            data.modeB.degreesPerSecond[i] = signed_(rng) * 10;
+            data.modeB.radius[i]           = unit(rng) * 300;
+            data.modeB.deltaRadius[i]      = signed_(rng) * 30;
+        }
+        // exercise the degenerate radial directions
+        data.posx[1] = data.posy[1] = 0.0f;
+        data.posx[2]                = 1.0f;
+        data.posy[2]                = 0.0f;
+    }
+
+    ~RandomParticles() { data.release(); }
+};
+
+// runs the kernel with the scalar and the SIMD path
+template <typename _Fn>
+void runScalarAndSimd(_Fn&& kernel)
+{
+    ParticleKernels::setSimdEnabled(false);
+    kernel(false);
+    ParticleKernels::setSimdEnabled(true);
+    kernel(true);
+}
+
+void checkClose(const float* a, const float* b, int count, float tolerance)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const float scale = std::max(1.0f, std::abs(a[i]));
+        CHECK_MESSAGE(std::abs(a[i] - b[i]) <= tolerance * scale, "i=", i, " a=", a[i], " b=", b[i]);
+    }
+}
+}  // namespace
+
+TEST_SUITE("2d/ParticleKernels")
+{
+    // odd count so the scalar tail of the SIMD kernels runs too
+    constexpr int count = 1003;
+
+    TEST_CASE("integrate")
+    {
+        RandomParticles scalar(count), simd(count);
+        runScalarAndSimd([&](bool useSimd) {
+            auto& data = useSimd ? simd.data : scalar.data;
+            ParticleKernels::addScalar(data.timeToLive, -0.016f, count);
+            ParticleKernels::integrate(data.colorR, data.deltaColorR, 0.016f, count);
+            ParticleKernels::integrateNonNegative(data.size, data.deltaSize, 0.5f, count);
+            ParticleKernels::advanceClamped(data.scaleInDelta, data.scaleInLength, 0.3f, count);
+        });
+
+        checkClose(scalar.data.timeToLive, simd.data.timeToLive, count, 0.0f);
+        checkClose(scalar.data.colorR, simd.data.colorR, count, 0.0f);
+        checkClose(scalar.data.size, simd.data.size, count, 0.0f);
+        checkClose(scalar.data.scaleInDelta, simd.data.scaleInDelta, count, 0.0f);
+        CHECK(*std::min_element(simd.data.size, simd.data.size + count) >= 0.0f);
+    }
+
+    TEST_CASE("integrateGravity")
+    {
+        RandomParticles scalar(count), simd(count);
+        runScalarAndSimd([&](bool useSimd) {
+            auto& data = useSimd ? simd.data : scalar.data;
+            ParticleKernels::integrateGravity(data, 10.0f, -98.0f, 0.016f, -1.0f, count);
+        });
+
+        checkClose(scalar.data.modeA.dirX, simd.data.modeA.dirX, count, 1e-6f);
+        checkClose(scalar.data.modeA.dirY, simd.data.modeA.dirY, count, 1e-6f);
+        checkClose(scalar.data.posx, simd.data.posx, count, 1e-6f);
+        checkClose(scalar.data.posy, simd.data.posy, count, 1e-6f);
+    }
+
+    TEST_CASE("integrateRadius")
+    {
+        RandomParticles scalar(count), simd(count);
+        runScalarAndSimd([&](bool useSimd) {
+            auto& data = useSimd ? simd.data : scalar.data;
+            ParticleKernels::integrateRadius(data, 0.016f, 1.0f, count);
+        });
+
+        checkClose(scalar.data.modeB.angle, simd.data.modeB.angle, count, 0.0f);
+        // the SIMD path uses a polynomial sin/cos
+        checkClose(scalar.data.posx, simd.data.posx, count, 1e-5f);
+        checkClose(scalar.data.posy, simd.data.posy, count, 1e-5f);
+    }
+
+    TEST_CASE("planSwapRemove")
+    {
+        for (unsigned int seed : {1u, 2u, 3u})
+        {
+            RandomParticles particles(count, seed);
+            auto ttl = particles.data.timeToLive;
+            // an expired tail must not drop live particles
+            std::fill(ttl + count - 20, ttl + count, -1.0f);
+
+            std::vector<float> alive;
+            std::copy_if(ttl, ttl + count, std::back_inserter(alive), [](float t) { return t > 0.0f; });
+
+            std::vector<std::pair<int, int>> moves;
+            int newCount = ParticleKernels::planSwapRemove(ttl, count, moves);
+            particles.data.moveParticles(moves.data(), moves.size());
+
+            REQUIRE(newCount == static_cast<int>(alive.size()));
+            std::vector<float> remaining(ttl, ttl + newCount);
+            CHECK(std::all_of(remaining.begin(), remaining.end(), [](float t) { return t > 0.0f; }));
+            std::sort(alive.begin(), alive.end());
+            std::sort(remaining.begin(), remaining.end());
+            CHECK(remaining == alive);
+
+            // live particles below the first hole keep their slot
+            for (auto&& [dst, src] : moves)
+                CHECK(dst < src);
+        }
+    }
+
+    TEST_CASE("updateQuads")
+    {
+        RandomParticles particles(count);
+        std::vector<V3F_C4B_T2F_Quad> scalar(count), simd(count);
+        const float transform[6] = {0.5f, 0.25f, 10.0f, -0.25f, 0.5f, -20.0f};
+
+        for (bool scaleIn : {false, true})
+        {
+            runScalarAndSimd([&](bool useSimd) {
+                ParticleKernels::updateQuadVertices((useSimd ? simd : scalar).data(), particles.data, transform, scaleIn,
+                                                    count);
+            });
+            for (int i = 0; i < count; ++i)
+            {
+                checkClose(&scalar[i].bl.vertices.x, &simd[i].bl.vertices.x, 2, 1e-5f);
+                checkClose(&scalar[i].br.vertices.x, &simd[i].br.vertices.x, 2, 1e-5f);
+                checkClose(&scalar[i].tl.vertices.x, &simd[i].tl.vertices.x, 2, 1e-5f);
+                checkClose(&scalar[i].tr.vertices.x, &simd[i].tr.vertices.x, 2, 1e-5f);
+            }
+        }
+
+        for (bool fadeIn : {false, true})
+        {
+            for (bool premultiplied : {false, true})
+            {
+                runScalarAndSimd([&](bool useSimd) {
+                    ParticleKernels::updateQuadColors((useSimd ? simd : scalar).data(), particles.data, fadeIn,
+                                                      premultiplied, count);
+                });
+                for (int i = 0; i < count; ++i)
+                {
+                    CHECK(scalar[i].bl.colors == simd[i].bl.colors);
+                    CHECK(simd[i].tr.colors == simd[i].bl.colors);
+                }
+            }
+        }
+    }
+}
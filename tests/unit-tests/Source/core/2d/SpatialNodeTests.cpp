@@ -0,0 +1,199 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <algorithm>
+#include "2d/SpatialNode.h"
+#include "base/Director.h"
+
+using namespace ax;
+
+namespace {
+    Node* addBox(SpatialNode& grid, float x, float y, float w, float h) {
+        auto node = new Node();
+        node->setPosition(x, y);
+        node->setContentSize(Size(w, h));
+        grid.addChild(node);
+        node->release();
+        return node;
+    }
+
+    bool contains(const std::vector<Node*>& nodes, Node* node) {
+        return std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+    }
+
+    // records the transform of its last draw
+    class ProbeNode : public Node {
+    public:
+        void draw(Renderer*, const Mat4& transform, uint32_t) override {
+            drawn = transform;
+            ++draws;
+        }
+
+        Mat4 drawn;
+        int draws = 0;
+    };
+
+    // views the rect (x, y, 100, 100) of the visited nodes
+    void loadProjection(float x, float y) {
+        Mat4 projection;
+        Mat4::createOrthographicOffCenter(x, x + 100, y, y + 100, -1, 1, &projection);
+        Director::getInstance()->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION, projection);
+    }
+}
+
+TEST_SUITE("2d/SpatialNode") {
+    TEST_CASE("query") {
+        auto grid = SpatialNode();
+        REQUIRE(grid.init(100.0f));
+
+        auto a = addBox(grid, 10, 10, 20, 20);
+        auto b = addBox(grid, 250, 250, 30, 30);
+        auto c = addBox(grid, -500, 80, 40, 40);
+        // spans more cells than a regular entry
+        auto d = addBox(grid, -5000, -5000, 10000, 10000);
+
+        std::vector<Node*> result;
+        grid.queryRect(Rect(0, 0, 100, 100), result);
+        CHECK_EQ(result.size(), 2);
+        CHECK(contains(result, a));
+        CHECK(contains(result, d));
+
+        result.clear();
+        grid.queryRect(Rect(-1000, -1000, 2000, 2000), result);
+        CHECK_EQ(result.size(), 4);
+
+        result.clear();
+        grid.queryPoint(Vec2(-480, 100), result);
+        CHECK_EQ(result.size(), 2);
+        CHECK(contains(result, c));
+        CHECK(!contains(result, a));
+        CHECK(!contains(result, b));
+    }
+
+    TEST_CASE("update") {
+        auto grid = SpatialNode();
+        REQUIRE(grid.init(64.0f));
+
+        auto a = addBox(grid, 0, 0, 10, 10);
+        auto b = addBox(grid, 0, 0, 10, 10);
+
+        std::vector<Node*> result;
+        a->setPosition(1000, 1000);
+        grid.updateChildBounds(a);
+        grid.queryPoint(Vec2(5, 5), result);
+        CHECK_EQ(result.size(), 1);
+        CHECK(contains(result, b));
+
+        result.clear();
+        grid.queryPoint(Vec2(1005, 1005), result);
+        CHECK_EQ(result.size(), 1);
+        CHECK(contains(result, a));
+
+        grid.setCellSize(300.0f);
+        result.clear();
+        grid.queryRect(Rect(900, 900, 200, 200), result);
+        CHECK_EQ(result.size(), 1);
+        CHECK(contains(result, a));
+
+        grid.removeChild(a);
+        result.clear();
+        grid.queryRect(Rect(-2000, -2000, 4000, 4000), result);
+        CHECK_EQ(result.size(), 1);
+        CHECK(contains(result, b));
+
+        // the free slot is reused
+        auto c = addBox(grid, 1000, 1000, 10, 10);
+        result.clear();
+        grid.queryPoint(Vec2(1005, 1005), result);
+        CHECK_EQ(result.size(), 1);
+        CHECK(contains(result, c));
+
+        grid.removeAllChildren();
+        result.clear();
+        grid.queryRect(Rect(-2000, -2000, 4000, 4000), result);
+        CHECK(result.empty());
+    }
+
+    TEST_CASE("removeAllLarge") {
+        auto grid = SpatialNode();
+        REQUIRE(grid.init(100.0f));
+
+        // spans more than 64 cells
+        addBox(grid, -5000, -5000, 10000, 10000);
+        grid.removeAllChildren();
+
+        auto director = Director::getInstance();
+        director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+        loadProjection(0, 0);
+        grid.visit(nullptr, Mat4::IDENTITY, 0);
+        director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+        CHECK_EQ(grid.getVisitedCount(), 0);
+
+        std::vector<Node*> result;
+        grid.queryRect(Rect(-2000, -2000, 4000, 4000), result);
+        CHECK(result.empty());
+
+        auto a = addBox(grid, 10, 10, 10, 10);
+        grid.queryRect(Rect(-2000, -2000, 4000, 4000), result);
+        CHECK_EQ(result.size(), 1);
+        CHECK(contains(result, a));
+    }
+
+    TEST_CASE("culledTransform") {
+        auto grid = SpatialNode();
+        REQUIRE(grid.init(100.0f));
+
+        auto probe = new ProbeNode();
+        probe->setPosition(10, 10);
+        probe->setContentSize(Size(10, 10));
+        grid.addChild(probe);
+        probe->release();
+
+        auto director = Director::getInstance();
+        director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+
+        loadProjection(0, 0);
+        grid.visit(nullptr, Mat4::IDENTITY, 0);
+        REQUIRE_EQ(probe->draws, 1);
+        CHECK_EQ(probe->drawn.m[12], 10.0f);
+        CHECK_EQ(probe->drawn.m[13], 10.0f);
+
+        // the grid moves while the probe is out of view
+        Mat4 parentTransform;
+        Mat4::createTranslation(5.0f, 0.0f, 0.0f, &parentTransform);
+        loadProjection(1000, 1000);
+        grid.visit(nullptr, parentTransform, Node::FLAGS_TRANSFORM_DIRTY);
+        CHECK_EQ(grid.getCulledCount(), 1);
+        CHECK_EQ(probe->draws, 1);
+
+        loadProjection(0, 0);
+        grid.visit(nullptr, parentTransform, 0);
+        CHECK_EQ(probe->draws, 2);
+        CHECK_EQ(probe->drawn.m[12], 15.0f);
+        CHECK_EQ(probe->drawn.m[13], 10.0f);
+
+        director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    }
+}
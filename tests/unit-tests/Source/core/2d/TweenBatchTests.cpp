@@ -0,0 +1,204 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "2d/ActionEase.h"
+#include "2d/ActionManager.h"
+#include "2d/Node.h"
+
+using namespace ax;
+
+namespace {
+    // runs the same actions on two nodes, one of them through the tween batch
+    struct Pair {
+        Pair() {
+            batched.setTweenBatchingEnabled(true);
+            a = new Node();
+            b = new Node();
+        }
+
+        ~Pair() {
+            stepping.removeAllActions();
+            batched.removeAllActions();
+            a->release();
+            b->release();
+        }
+
+        template <typename F>
+        void run(F&& create) {
+            stepping.addAction(create(), a, false);
+            batched.addAction(create(), b, false);
+        }
+
+        void update(float dt) {
+            stepping.update(dt);
+            batched.update(dt);
+        }
+
+        void checkSame() const {
+            auto same = [](float x, float y) { CHECK(x == doctest::Approx(y).epsilon(1e-5)); };
+            same(a->getPositionX(), b->getPositionX());
+            same(a->getPositionY(), b->getPositionY());
+            same(a->getPositionZ(), b->getPositionZ());
+            same(a->getRotationSkewX(), b->getRotationSkewX());
+            same(a->getRotationSkewY(), b->getRotationSkewY());
+            same(a->getScaleX(), b->getScaleX());
+            same(a->getScaleY(), b->getScaleY());
+            same(a->getScaleZ(), b->getScaleZ());
+            CHECK_EQ(a->getOpacity(), b->getOpacity());
+        }
+
+        ActionManager stepping;
+        ActionManager batched;
+        Node* a;
+        Node* b;
+    };
+
+    // stops the actions of another node and drops it when scaled
+    class StoppingNode : public Node {
+    public:
+        void setScaleX(float scaleX) override {
+            Node::setScaleX(scaleX);
+            if (victim) {
+                manager->removeAllActionsFromTarget(victim);
+                victim->release();
+                victim = nullptr;
+            }
+        }
+
+        ActionManager* manager = nullptr;
+        Node* victim           = nullptr;
+    };
+}
+
+TEST_SUITE("2d/TweenBatch") {
+    TEST_CASE("same_as_step") {
+        Pair pair;
+        pair.run([] { return MoveTo::create(1.0f, Vec2(100, 50)); });
+        pair.run([] { return MoveBy::create(0.5f, Vec2(-20, 10)); });
+        pair.run([] { return EaseSineOut::create(ScaleTo::create(0.8f, 2.0f)); });
+        pair.run([] { return EaseCubicActionOut::create(RotateBy::create(0.7f, 90.0f)); });
+        pair.run([] { return FadeTo::create(0.6f, 10); });
+
+        CHECK_EQ(pair.batched.getTweenBatch().getTweenCount(), 5);
+        CHECK_EQ(pair.batched.getTweenBatch().getLaneCount(), 4);
+
+        for (int i = 0; i < 80; ++i) {
+            pair.update(1.0f / 60);
+            pair.checkSame();
+        }
+
+        CHECK_EQ(pair.stepping.getNumberOfRunningActions(), 0);
+        CHECK_EQ(pair.batched.getNumberOfRunningActions(), 0);
+        CHECK_EQ(pair.batched.getTweenBatch().getTweenCount(), 0);
+        CHECK(pair.b->getPositionX() == doctest::Approx(80.0f));
+        CHECK(pair.b->getPositionY() == doctest::Approx(60.0f));
+    }
+
+    TEST_CASE("unsupported") {
+        ActionManager manager;
+        manager.setTweenBatchingEnabled(true);
+        auto node = new Node();
+
+        auto sequence = Sequence::create(MoveBy::create(1.0f, Vec2(10, 0)), MoveBy::create(1.0f, Vec2(0, 10)), nullptr);
+        manager.addAction(sequence, node, false);
+        auto rotate3D = RotateBy::create(1.0f, Vec3(10, 20, 30));
+        manager.addAction(rotate3D, node, false);
+        auto ease = EaseIn::create(MoveBy::create(1.0f, Vec2(10, 0)), 2.0f);
+        manager.addAction(ease, node, false);
+        auto move = MoveBy::create(1.0f, Vec2(10, 0));
+        manager.addAction(move, node, false);
+
+        CHECK(!sequence->isBatched());
+        CHECK(!rotate3D->isBatched());
+        CHECK(!ease->isBatched());
+        CHECK(move->isBatched());
+        CHECK_EQ(manager.getTweenBatch().getTweenCount(), 1);
+
+        manager.removeAllActions();
+        CHECK_EQ(manager.getTweenBatch().getTweenCount(), 0);
+        node->release();
+    }
+
+    TEST_CASE("pause_and_stop") {
+        Pair pair;
+        auto create = [] { return MoveBy::create(1.0f, Vec2(60, 0)); };
+        pair.run(create);
+        pair.run([] { return ScaleBy::create(1.0f, 3.0f); });
+
+        for (int i = 0; i < 10; ++i)
+            pair.update(1.0f / 60);
+        pair.checkSame();
+
+        pair.stepping.pauseTarget(pair.a);
+        pair.batched.pauseTarget(pair.b);
+        for (int i = 0; i < 10; ++i)
+            pair.update(1.0f / 60);
+        pair.checkSame();
+
+        pair.stepping.resumeTarget(pair.a);
+        pair.batched.resumeTarget(pair.b);
+
+        // stacks with moves made outside of the action
+        pair.a->setPositionX(pair.a->getPositionX() + 5);
+        pair.b->setPositionX(pair.b->getPositionX() + 5);
+        for (int i = 0; i < 10; ++i)
+            pair.update(1.0f / 60);
+        pair.checkSame();
+
+        // a stopped tween is handed back to step and stays consistent when batching is turned off
+        pair.batched.setTweenBatchingEnabled(false);
+        CHECK_EQ(pair.batched.getTweenBatch().getTweenCount(), 0);
+        CHECK_EQ(pair.batched.getNumberOfRunningActions(), 2);
+        for (int i = 0; i < 10; ++i)
+            pair.update(1.0f / 60);
+        pair.checkSame();
+
+        pair.stepping.removeAllActionsFromTarget(pair.a);
+        pair.batched.removeAllActionsFromTarget(pair.b);
+        CHECK_EQ(pair.batched.getNumberOfRunningActions(), 0);
+    }
+
+    TEST_CASE("stop_during_update") {
+        ActionManager manager;
+        manager.setTweenBatchingEnabled(true);
+        auto stopper = new StoppingNode();
+        auto victim  = new Node();
+        stopper->manager = &manager;
+        stopper->victim  = victim;
+
+        manager.addAction(ScaleBy::create(1.0f, 2.0f), stopper, false);
+        manager.addAction(ScaleBy::create(1.0f, 2.0f), victim, false);
+        CHECK_EQ(manager.getTweenBatch().getTweenCount(), 2);
+
+        // the victim is released by the setter of the first tween, before its own tween is applied
+        manager.update(0.5f);
+        CHECK(stopper->victim == nullptr);
+        CHECK_EQ(manager.getTweenBatch().getTweenCount(), 1);
+        CHECK_EQ(manager.getNumberOfRunningActions(), 1);
+
+        manager.removeAllActions();
+        stopper->release();
+    }
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "audio/AudioDecoderManager.h"
+#include "base/Data.h"
+
+using namespace ax;
+
+
+TEST_SUITE("audio/AudioDecoderManager") {
+    static std::shared_ptr<const Data> makeData(std::string_view text) {
+        auto data = std::make_shared<Data>();
+        data->copy(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+        return data;
+    }
+
+
+    TEST_CASE("canKeepCompressed") {
+        CHECK(AudioDecoderManager::canKeepCompressed("sound/music.ogg"));
+        CHECK(AudioDecoderManager::canKeepCompressed("sound/MUSIC.OGG"));
+        CHECK_FALSE(AudioDecoderManager::canKeepCompressed("sound/effect.wav"));
+#if !defined(__APPLE__)
+        CHECK(AudioDecoderManager::canKeepCompressed("sound/music.mp3"));
+#endif
+    }
+
+
+    TEST_CASE("openStream_resident") {
+        const std::string path = "/doesnt_exist/resident.ogg";
+        auto data = makeData("0123456789");
+        AudioDecoderManager::addResidentData(path, data);
+
+        auto stream = AudioDecoderManager::openStream(path);
+        REQUIRE(stream);
+        CHECK(stream->isOpen());
+        CHECK(stream->size() == 10);
+
+        char buf[16] = {};
+        CHECK(stream->read(buf, 4) == 4);
+        CHECK(std::string_view(buf, 4) == "0123");
+        CHECK(stream->tell() == 4);
+
+        CHECK(stream->seek(-2, SEEK_END) == 8);
+        CHECK(stream->read(buf, 16) == 2);
+        CHECK(std::string_view(buf, 2) == "89");
+        CHECK(stream->read(buf, 16) == 0);
+
+        CHECK(stream->seek(3, SEEK_SET) == 3);
+        CHECK(stream->seek(2, SEEK_CUR) == 5);
+        CHECK(stream->seek(11, SEEK_SET) == -1);
+        CHECK(stream->tell() == 5);
+        CHECK(stream->write(buf, 1) == -1);
+
+        // replaced bytes aren't dropped by their previous owner
+        auto other = makeData("abc");
+        AudioDecoderManager::addResidentData(path, other);
+        AudioDecoderManager::removeResidentData(path, data);
+        CHECK(AudioDecoderManager::openStream(path)->size() == 3);
+
+        AudioDecoderManager::removeResidentData(path, other);
+        CHECK_FALSE(AudioDecoderManager::openStream(path));
+
+        // open streams keep reading the bytes after they were dropped
+        CHECK(stream->read(buf, 3) == 3);
+        CHECK(std::string_view(buf, 3) == "567");
+    }
+}
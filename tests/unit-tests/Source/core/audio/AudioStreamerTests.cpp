@@ -0,0 +1,252 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "audio/AudioStreamer.h"
+#include "audio/AudioDecoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ax;
+using namespace std::chrono_literals;
+
+
+namespace {
+    using clock_type = AudioStreamer::clock_type;
+
+    // never dereferenced, the streamer only hands them back to the refill
+    AudioPlayer* fakePlayer(uintptr_t id) {
+        return reinterpret_cast<AudioPlayer*>(id * 64);
+    }
+
+    struct Services {
+        std::mutex mutex;
+        std::vector<std::pair<AudioPlayer*, clock_type::time_point>> calls;
+
+        void record(AudioPlayer* player) {
+            std::lock_guard<std::mutex> lck(mutex);
+            calls.emplace_back(player, clock_type::now());
+        }
+
+        size_t count(AudioPlayer* player) {
+            std::lock_guard<std::mutex> lck(mutex);
+            return std::count_if(calls.begin(), calls.end(), [player](auto& call) { return call.first == player; });
+        }
+
+        bool waitFor(AudioPlayer* player, size_t n, clock_type::duration timeout = 2s) {
+            const auto until = clock_type::now() + timeout;
+            while (count(player) < n) {
+                if (clock_type::now() > until)
+                    return false;
+                std::this_thread::sleep_for(1ms);
+            }
+            return true;
+        }
+    };
+
+    // frame i holds the byte 'a' + i, read at most 4 frames at a time
+    class LetterDecoder : public AudioDecoder {
+    public:
+        explicit LetterDecoder(uint32_t totalFrames) {
+            _isOpened = true;
+            _totalFrames = totalFrames;
+            _bytesPerBlock = 1;
+            _sampleRate = 44100;
+            _channelCount = 1;
+        }
+
+        bool open(std::string_view) override { return true; }
+        void close() override {}
+
+        uint32_t read(uint32_t framesToRead, char* pcmBuf) override {
+            const uint32_t frames = std::min({framesToRead, _totalFrames - _position, 4u});
+            for (uint32_t i = 0; i < frames; ++i)
+                pcmBuf[i] = static_cast<char>('a' + _position + i);
+            _position += frames;
+            return frames;
+        }
+
+        bool seek(uint32_t frameOffset) override {
+            if (frameOffset > _totalFrames)
+                return false;
+            _position = frameOffset;
+            ++seeks;
+            return true;
+        }
+
+        int seeks = 0;
+
+    private:
+        uint32_t _position = 0;
+    };
+}
+
+
+TEST_SUITE("audio/AudioStreamer") {
+    TEST_CASE("refill") {
+        Services services;
+        AudioStreamer streamer([&](AudioPlayer* player, std::vector<char>&) {
+            services.record(player);
+            return 0.01f;
+        });
+
+        auto player = fakePlayer(1);
+        streamer.addStream(player);
+        CHECK(streamer.getStreamCount() == 1);
+        REQUIRE(services.waitFor(player, 3));
+
+        streamer.removeStream(player);
+        CHECK(streamer.getStreamCount() == 0);
+        const auto serviced = services.count(player);
+        std::this_thread::sleep_for(50ms);
+        CHECK(services.count(player) == serviced);
+    }
+
+
+    TEST_CASE("stop") {
+        Services services;
+        AudioStreamer streamer([&](AudioPlayer* player, std::vector<char>&) {
+            services.record(player);
+            return player == fakePlayer(1) ? -1.0f : 0.01f;
+        });
+
+        streamer.addStream(fakePlayer(1));
+        streamer.addStream(fakePlayer(2));
+        REQUIRE(services.waitFor(fakePlayer(2), 3));
+
+        // a negative delay drops the stream, the others keep being serviced
+        CHECK(services.count(fakePlayer(1)) == 1);
+        CHECK(streamer.getStreamCount() == 1);
+        streamer.removeStream(fakePlayer(2));
+        CHECK(streamer.getStreamCount() == 0);
+    }
+
+
+    TEST_CASE("stale_serial") {
+        Services services;
+        AudioStreamer streamer([&](AudioPlayer* player, std::vector<char>&) {
+            services.record(player);
+            return 0.4f;
+        });
+
+        auto player = fakePlayer(1);
+        streamer.addStream(player);
+        REQUIRE(services.waitFor(player, 1));
+        std::this_thread::sleep_for(200ms);
+
+        // re-adding the same player leaves the deadline of the first stream behind in the queue
+        streamer.removeStream(player);
+        streamer.addStream(player);
+        REQUIRE(services.waitFor(player, 3));
+
+        std::lock_guard<std::mutex> lck(services.mutex);
+        CHECK(services.calls[2].second - services.calls[1].second >= 300ms);
+    }
+
+
+    TEST_CASE("wakeup") {
+        Services services;
+        AudioStreamer streamer([&](AudioPlayer* player, std::vector<char>&) {
+            services.record(player);
+            return 10.0f;
+        });
+
+        auto player = fakePlayer(1);
+        streamer.addStream(player);
+        REQUIRE(services.waitFor(player, 1));
+
+        // unknown players are ignored
+        streamer.wakeup(fakePlayer(2));
+
+        const auto start = clock_type::now();
+        streamer.wakeup(player);
+        REQUIRE(services.waitFor(player, 2));
+        CHECK(clock_type::now() - start < 1s);
+        CHECK(services.count(fakePlayer(2)) == 0);
+
+        streamer.removeStream(player);
+    }
+
+
+    TEST_CASE("remove_while_serviced") {
+        std::atomic<bool> entered{false};
+        std::atomic<bool> left{false};
+        AudioStreamer streamer([&](AudioPlayer*, std::vector<char>&) {
+            entered = true;
+            std::this_thread::sleep_for(100ms);
+            left = true;
+            return 0.01f;
+        });
+
+        auto player = fakePlayer(1);
+        streamer.addStream(player);
+        while (!entered)
+            std::this_thread::sleep_for(1ms);
+
+        streamer.removeStream(player);
+        CHECK(left);
+        CHECK(streamer.getStreamCount() == 0);
+    }
+
+
+    TEST_CASE("readLoopedFrames") {
+        char buf[32];
+
+        SUBCASE("eof") {
+            // the missing frames are silenced, refillStream lets the queued buffers drain then
+            LetterDecoder decoder(10);
+            decoder.seek(7);
+            memset(buf, '-', sizeof(buf));
+            CHECK(decoder.readLoopedFrames(8, buf, false) == 3);
+            CHECK(std::string(buf, 3) == "hij");
+            CHECK(std::string(buf + 3, 5) == std::string(5, '\0'));
+            CHECK(buf[8] == '-');
+            CHECK(decoder.readLoopedFrames(8, buf, false) == 0);
+        }
+
+        SUBCASE("loop") {
+            LetterDecoder decoder(10);
+            decoder.seek(7);
+            CHECK(decoder.readLoopedFrames(8, buf, true) == 8);
+            CHECK(std::string(buf, 8) == "hijabcde");
+
+            // wraps around as many times as needed
+            CHECK(decoder.readLoopedFrames(25, buf, true) == 25);
+            CHECK(std::string(buf, 25) == "fghijabcdefghijabcdefghij");
+        }
+
+        SUBCASE("empty") {
+            LetterDecoder decoder(0);
+            memset(buf, '-', sizeof(buf));
+            CHECK(decoder.readLoopedFrames(8, buf, true) == 0);
+            CHECK(decoder.seeks == 1);
+            CHECK(std::string(buf, 8) == std::string(8, '\0'));
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "base/JobSystem.h"
+
+#include <atomic>
+
+using namespace ax;
+
+TEST_SUITE("base/JobSystem")
+{
+    TEST_CASE("parallel_for")
+    {
+        for (int threads : {0, 4})
+        {
+            JobSystem js(threads);
+            std::atomic<uint64_t> sum{0};
+            auto handle = js.parallel_for(100000, 1000, [&](size_t first, size_t last) {
+                uint64_t partial = 0;
+                for (auto i = first; i < last; ++i)
+                    partial += i;
+                sum += partial;
+            });
+            js.wait(handle);
+            CHECK(handle->isDone());
+            CHECK(sum == 4999950000ull);
+        }
+    }
+
+    TEST_CASE("dependencies")
+    {
+        JobSystem js(4);
+        std::atomic<int> order{0};
+        int a = -1, b = -1, c = -1;
+
+        auto first  = js.schedule([&] { a = order++; });
+        auto second = js.then(first, [&] { b = order++; });
+        auto range  = js.parallel_for(64, 1, [](size_t, size_t) {});
+
+        JobHandle deps[] = {second, range};
+        auto last        = js.then(js.when_all(deps), [&] { c = order++; });
+        js.wait(last);
+
+        CHECK(a == 0);
+        CHECK(b == 1);
+        CHECK(c == 2);
+        CHECK(range->isDone());
+    }
+
+    TEST_CASE("nested_wait")
+    {
+        JobSystem js(2);
+        std::atomic<int> count{0};
+        auto outer = js.parallel_for(8, 1, [&](size_t, size_t) {
+            js.wait(js.parallel_for(16, 1, [&](size_t, size_t) { ++count; }));
+        });
+        js.wait(outer);
+        CHECK(count == 8 * 16);
+    }
+
+    TEST_CASE("empty")
+    {
+        JobSystem js(2);
+        js.wait(nullptr);
+        auto none = js.when_all({});
+        CHECK(none->isDone());
+        CHECK(js.parallel_for(0, 16, [](size_t, size_t) {})->isDone());
+    }
+}
@@ -0,0 +1,178 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <thread>
+#include "base/Profiling.h"
+#include "rapidjson/document.h"
+
+using namespace ax;
+
+namespace
+{
+rapidjson::Document exportTrace()
+{
+    rapidjson::Document doc;
+    doc.Parse(Profiler::getInstance()->toChromeTrace().c_str());
+    return doc;
+}
+
+const rapidjson::Value* findEvent(const rapidjson::Document& doc, std::string_view name)
+{
+    for (auto& event : doc["traceEvents"].GetArray())
+    {
+        if (name == event["name"].GetString())
+            return &event;
+    }
+    return nullptr;
+}
+
+int countEvents(const rapidjson::Document& doc, std::string_view phase)
+{
+    int count = 0;
+    for (auto& event : doc["traceEvents"].GetArray())
+    {
+        if (phase == event["ph"].GetString())
+            ++count;
+    }
+    return count;
+}
+}  // namespace
+
+TEST_SUITE("base/Profiling")
+{
+    TEST_CASE("nested_zones")
+    {
+        auto profiler = Profiler::getInstance();
+        profiler->start();
+        {
+            ProfilerZone outer("outer");
+            {
+                ProfilerZone inner("inner");
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        profiler->stop();
+
+        auto doc = exportTrace();
+        REQUIRE_FALSE(doc.HasParseError());
+        CHECK(countEvents(doc, "X") == 2);
+
+        auto outer = findEvent(doc, "outer");
+        auto inner = findEvent(doc, "inner");
+        REQUIRE(outer);
+        REQUIRE(inner);
+        CHECK((*inner)["tid"].GetInt() == (*outer)["tid"].GetInt());
+        CHECK((*inner)["dur"].GetDouble() >= 1000.0);
+        CHECK((*outer)["ts"].GetDouble() <= (*inner)["ts"].GetDouble());
+        CHECK((*outer)["ts"].GetDouble() + (*outer)["dur"].GetDouble() >=
+              (*inner)["ts"].GetDouble() + (*inner)["dur"].GetDouble());
+    }
+
+    TEST_CASE("stopped_profiler_records_nothing")
+    {
+        auto profiler = Profiler::getInstance();
+        profiler->start();
+        profiler->stop();
+        {
+            ProfilerZone zone("ignored");
+            AX_PROFILE_COUNTER("ignored counter", 1);
+        }
+        CHECK(profiler->getEventCount() == 0);
+        CHECK(findEvent(exportTrace(), "ignored") == nullptr);
+    }
+
+    TEST_CASE("counters")
+    {
+        auto profiler = Profiler::getInstance();
+        profiler->start();
+        profiler->recordCounter("draw calls", 42);
+        profiler->stop();
+
+        auto doc     = exportTrace();
+        auto counter = findEvent(doc, "draw calls");
+        REQUIRE(counter);
+        CHECK(std::string_view{(*counter)["ph"].GetString()} == "C");
+        CHECK((*counter)["args"]["value"].GetInt64() == 42);
+    }
+
+    TEST_CASE("per_thread_buffers")
+    {
+        auto profiler = Profiler::getInstance();
+        profiler->start();
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([profiler, i] {
+                profiler->setThreadName("worker " + std::to_string(i));
+                for (int j = 0; j < 100; ++j)
+                {
+                    ProfilerZone zone("work");
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        profiler->stop();
+
+        auto doc = exportTrace();
+        CHECK(countEvents(doc, "X") == 400);
+        CHECK(profiler->getEventCount() == 400);
+
+        int namedThreads = 0;
+        for (auto& event : doc["traceEvents"].GetArray())
+        {
+            if (std::string_view{event["ph"].GetString()} == "M" &&
+                std::string_view{event["args"]["name"].GetString()}.starts_with("worker "))
+                ++namedThreads;
+        }
+        CHECK(namedThreads == 4);
+    }
+
+    TEST_CASE("ring_buffer_keeps_latest_events")
+    {
+        auto profiler         = Profiler::getInstance();
+        auto previousCapacity = profiler->getThreadBufferCapacity();
+        profiler->setThreadBufferCapacity(10);
+        CHECK(profiler->getThreadBufferCapacity() == 16);
+
+        profiler->start();
+        std::thread([profiler] {
+            for (int i = 0; i < 100; ++i)
+                profiler->recordCounter("sample", i);
+        }).join();
+        profiler->stop();
+        profiler->setThreadBufferCapacity(previousCapacity);
+
+        CHECK(profiler->getEventCount() == 16);
+        CHECK(profiler->getDroppedEventCount() == 84);
+
+        auto doc   = exportTrace();
+        auto first = findEvent(doc, "sample");
+        REQUIRE(first);
+        CHECK((*first)["args"]["value"].GetInt64() == 84);
+    }
+}
@@ -0,0 +1,197 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "base/Scheduler.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace ax;
+
+namespace
+{
+void step(Scheduler& scheduler, float dt, int frames)
+{
+    for (int i = 0; i < frames; ++i)
+        scheduler.update(dt);
+}
+}  // namespace
+
+TEST_SUITE("base/Scheduler")
+{
+    TEST_CASE("interval_and_repeat")
+    {
+        Scheduler scheduler;
+        int target = 0;
+        int count  = 0;
+
+        scheduler.schedule([&](float dt) { ++count; }, &target, 0.5f, 2, 0.0f, false, "timer");
+
+        // the first frame only starts the timer
+        step(scheduler, 0.25f, 2);
+        CHECK(count == 0);
+        step(scheduler, 0.25f, 1);
+        CHECK(count == 1);
+        step(scheduler, 0.25f, 4);
+        CHECK(count == 3);
+        CHECK_FALSE(scheduler.isScheduled("timer", &target));
+        step(scheduler, 0.25f, 10);
+        CHECK(count == 3);
+    }
+
+    TEST_CASE("delay")
+    {
+        Scheduler scheduler;
+        int target = 0;
+        int count  = 0;
+
+        scheduler.schedule([&](float) { ++count; }, &target, 1.0f, AX_REPEAT_FOREVER, 2.0f, false, "timer");
+
+        step(scheduler, 0.5f, 4);
+        CHECK(count == 0);
+        step(scheduler, 0.5f, 1);
+        CHECK(count == 1);
+        step(scheduler, 0.5f, 2);
+        CHECK(count == 2);
+    }
+
+    TEST_CASE("every_frame")
+    {
+        Scheduler scheduler;
+        int target = 0;
+        int count  = 0;
+
+        scheduler.schedule([&](float) { ++count; }, &target, 0.0f, false, "timer");
+        step(scheduler, 1.0f / 60, 11);
+        CHECK(count == 10);
+    }
+
+    TEST_CASE("pause_and_resume")
+    {
+        Scheduler scheduler;
+        int target = 0;
+        int count  = 0;
+
+        scheduler.schedule([&](float) { ++count; }, &target, 1.0f, false, "timer");
+        step(scheduler, 0.25f, 3);
+
+        scheduler.pauseTarget(&target);
+        CHECK(scheduler.isTargetPaused(&target));
+        step(scheduler, 0.25f, 20);
+        CHECK(count == 0);
+
+        // the paused time doesn't count, 0.5s were left
+        scheduler.resumeTarget(&target);
+        step(scheduler, 0.25f, 1);
+        CHECK(count == 0);
+        step(scheduler, 0.25f, 1);
+        CHECK(count == 1);
+    }
+
+    TEST_CASE("unschedule_all_in_callback")
+    {
+        Scheduler scheduler;
+        int target = 0;
+        int other  = 0;
+        int count  = 0;
+
+        auto callback = [&](float) {
+            ++count;
+            scheduler.unscheduleAllForTarget(&target);
+        };
+        scheduler.schedule(callback, &target, 0.5f, false, "first");
+        scheduler.schedule(callback, &target, 0.5f, false, "second");
+        scheduler.schedule([&](float) { ++count; }, &other, 0.5f, false, "other");
+
+        step(scheduler, 0.25f, 3);
+        CHECK(count == 2);
+        CHECK_FALSE(scheduler.isScheduled("first", &target));
+        CHECK_FALSE(scheduler.isScheduled("second", &target));
+        CHECK(scheduler.isScheduled("other", &other));
+    }
+
+    TEST_CASE("beyond_wheel_span")
+    {
+        Scheduler scheduler;
+        int target = 0;
+        int count  = 0;
+
+        scheduler.schedule([&](float) { ++count; }, &target, 4096.0f * 50, false, "timer");
+        step(scheduler, 4096.0f, 50);
+        CHECK(count == 0);
+        step(scheduler, 4096.0f, 1);
+        CHECK(count == 1);
+    }
+
+    TEST_CASE("runOnAxmolThread_order")
+    {
+        Scheduler scheduler;
+        std::vector<int> order;
+
+        // the threads take turns, so the functions are posted in a total order across producers
+        constexpr int count = 200;
+        std::atomic<int> next{0};
+        auto producer = [&](int parity) {
+            for (int i = parity; i < count; i += 2)
+            {
+                while (next.load() != i)
+                    std::this_thread::yield();
+                scheduler.runOnAxmolThread([&order, i] { order.push_back(i); });
+                next.store(i + 1);
+            }
+        };
+        std::thread even(producer, 0);
+        std::thread odd(producer, 1);
+        even.join();
+        odd.join();
+
+        scheduler.update(0);
+        REQUIRE(order.size() == count);
+        for (int i = 0; i < count; ++i)
+            CHECK(order[i] == i);
+    }
+
+    TEST_CASE("runOnAxmolThread_nested")
+    {
+        Scheduler scheduler;
+        int count = 0;
+
+        // functions posted by a function run on the next frame
+        scheduler.runOnAxmolThread([&] {
+            ++count;
+            scheduler.runOnAxmolThread([&] { ++count; });
+        });
+        scheduler.update(0);
+        CHECK(count == 1);
+        scheduler.update(0);
+        CHECK(count == 2);
+
+        scheduler.runOnAxmolThread([&] { ++count; });
+        scheduler.removeAllPendingActions();
+        scheduler.update(0);
+        CHECK(count == 2);
+    }
+}
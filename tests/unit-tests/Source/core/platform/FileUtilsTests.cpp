@@ -24,8 +24,11 @@
  ****************************************************************************/
 
 #include <doctest.h>
+#include <chrono>
+#include <thread>
 #include "TestUtils.h"
 #include "platform/FileUtils.h"
+#include "platform/MappedFile.h"
 
 using namespace ax;
 
@@ -227,6 +230,172 @@ TEST_SUITE("platform/FileUtils") {
     }
 
 
+    TEST_CASE("mapFile") {
+        SUBCASE("content") {
+            auto mapping = fu->mapFile("text/hello.txt");
+            REQUIRE(mapping != nullptr);
+            REQUIRE(mapping->size() == 12);
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == "Hello world!");
+            CHECK(mapping->contains(mapping->data() + 11));
+            CHECK(not mapping->contains(mapping->data() + 12));
+            // read with getDataFromFile unless enabled
+            CHECK(not mapping->isMapped());
+        }
+
+        SUBCASE("mapped") {
+            REQUIRE(not fu->isFileMappingEnabled());
+            fu->setFileMappingEnabled(true);
+            auto mapping = fu->mapFile("text/hello.txt");
+            auto missing = fu->mapFile("text/__missing.txt");
+            fu->setFileMappingEnabled(false);
+
+            REQUIRE(mapping != nullptr);
+            CHECK(mapping->isMapped());
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == "Hello world!");
+            CHECK(missing == nullptr);
+        }
+
+        SUBCASE("binary") {
+            auto mapping = fu->mapFile("text/binary.bin");
+            REQUIRE(mapping != nullptr);
+            std::string bs;
+            REQUIRE(fu->getContents("text/binary.bin", &bs) == FileUtils::Status::OK);
+            CHECK(std::string_view((const char*)mapping->data(), mapping->size()) == bs);
+        }
+
+        SUBCASE("empty") {
+            auto file = fu->getWritablePath() + "__test_empty.txt";
+            // writeStringToFile asserts on empty content
+            REQUIRE(fu->openFileStream(file, IFileStream::Mode::WRITE) != nullptr);
+            auto mapping = fu->mapFile(file);
+            REQUIRE(mapping != nullptr);
+            CHECK(mapping->empty());
+            mapping.reset();
+            CHECK(fu->removeFile(file));
+        }
+
+        SUBCASE("missing") {
+            CHECK(fu->mapFile("text/__missing.txt") == nullptr);
+            CHECK(fu->mapFile("") == nullptr);
+        }
+    }
+
+
+    TEST_CASE("path_index") {
+        auto originalSearchPaths = fu->getOriginalSearchPaths();
+        auto file = fu->fullPathForFilename("text/123.txt");
+        auto dir = fu->fullPathForDirectory("text");
+        REQUIRE(not file.empty());
+
+        fu->purgeCachedEntries();
+        REQUIRE(fu->buildPathIndex() > 0);
+        REQUIRE(fu->isPathIndexed());
+        CHECK(fu->getFullPathCache().empty());
+
+        SUBCASE("lookup") {
+            CHECK(fu->fullPathForFilename("text/123.txt") == file);
+            CHECK(fu->fullPathForDirectory("text") == dir);
+            CHECK(fu->fullPathForDirectory("text/") == dir);
+            CHECK(fu->fullPathForFilename("text/doesnt_exist.txt") == "");
+            CHECK(fu->fullPathForFilename("text") == "");
+            // served by the index, not the cache
+            CHECK(fu->getFullPathCache().empty());
+        }
+
+        SUBCASE("manifest") {
+            auto manifest = fu->getWritablePath() + "__path_index.bin";
+            REQUIRE(fu->savePathIndex(manifest));
+
+            fu->purgePathIndex();
+            CHECK(not fu->isPathIndexed());
+            REQUIRE(fu->loadPathIndex(manifest));
+            CHECK(fu->fullPathForFilename("text/123.txt") == file);
+            CHECK(fu->fullPathForDirectory("text") == dir);
+            CHECK(fu->getFullPathCache().empty());
+
+            // saved with other search paths
+            fu->addSearchPath(dir);
+            CHECK(not fu->isPathIndexed());
+            CHECK(not fu->loadPathIndex(manifest));
+
+            CHECK(not fu->loadPathIndex(file));
+            CHECK(fu->removeFile(manifest));
+        }
+
+        SUBCASE("search_paths") {
+            fu->addSearchPath(dir, true);
+            CHECK(not fu->isPathIndexed());
+            CHECK(fu->fullPathForFilename("123.txt") == file);
+        }
+
+        fu->purgePathIndex();
+        fu->setSearchPaths(originalSearchPaths);
+    }
+
+
+    TEST_CASE("path_index_benchmark" * doctest::skip()) {
+        constexpr int dirCount = 100, fileCount = 10000, threadCount = 8;
+
+        auto originalSearchPaths = fu->getOriginalSearchPaths();
+        auto root = fu->getWritablePath() + "__path_index_bench/";
+        if (fu->isDirectoryExist(root))
+            REQUIRE(fu->removeDirectory(root));
+
+        std::vector<std::string> names;
+        for (int i = 0; i < fileCount; ++i)
+        {
+            auto name = fmt::format("d{:02}/f{:05}.txt", i % dirCount, i);
+            if (i < dirCount)
+                REQUIRE(fu->createDirectories(root + name.substr(0, 3)));
+            REQUIRE(fu->writeStringToFile("x", root + name));
+            names.emplace_back(std::move(name));
+        }
+        fu->addSearchPath(root);
+
+        // each thread resolves its own slice of the 10k names
+        auto resolveAll = [&]() {
+            std::atomic<int> found{0};
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threadCount; ++t)
+                threads.emplace_back([&, t]() {
+                    for (int i = t; i < fileCount; i += threadCount)
+                        if (!fu->fullPathForFilename(names[i]).empty())
+                            ++found;
+                });
+            for (auto& thread : threads)
+                thread.join();
+            CHECK(found == fileCount);
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        fu->purgeCachedEntries();
+        auto probing = resolveAll();
+        auto cached = resolveAll();
+
+        auto start = std::chrono::steady_clock::now();
+        fu->buildPathIndex();
+        auto scan = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        fu->purgeCachedEntries();
+        auto indexed = resolveAll();
+
+        auto manifest = fu->getWritablePath() + "__path_index_bench.bin";
+        REQUIRE(fu->savePathIndex(manifest));
+        start = std::chrono::steady_clock::now();
+        REQUIRE(fu->loadPathIndex(manifest));
+        auto load = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        MESSAGE(fmt::format("{} paths x {} threads: probing {:.2f}ms, sharded cache {:.2f}ms, index {:.2f}ms "
+                            "(scan {:.2f}ms, manifest load {:.2f}ms)",
+                            fileCount, threadCount, probing, cached, indexed, scan, load));
+
+        fu->purgePathIndex();
+        fu->setSearchPaths(originalSearchPaths);
+        CHECK(fu->removeFile(manifest));
+        CHECK(fu->removeDirectory(root));
+    }
+
+
     TEST_CASE("getContents") {
         static const std::string FileErrors[] = { "OK", "NotExists", "OpenFailed", "ReadFailed", "NotInitialized", "TooLarge", "ObtainSizeFailed", };
 
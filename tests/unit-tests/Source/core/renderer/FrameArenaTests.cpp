@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/FrameArena.h"
+
+#include <vector>
+
+using namespace ax;
+
+namespace
+{
+struct Tracked
+{
+    Tracked(std::vector<int>& log, int id) : log(log), id(id) {}
+    ~Tracked() { log.push_back(id); }
+
+    std::vector<int>& log;
+    int id;
+};
+}  // namespace
+
+TEST_SUITE("renderer/FrameArena")
+{
+    TEST_CASE("alignment")
+    {
+        FrameArena arena(256);
+        arena.allocate(1, 1);
+        auto p = arena.allocate(8, 64);
+        CHECK(reinterpret_cast<uintptr_t>(p) % 64 == 0);
+
+        auto values = arena.allocateArray<double>(4);
+        CHECK(reinterpret_cast<uintptr_t>(values) % alignof(double) == 0);
+        CHECK(arena.getStats().allocations == 3);
+    }
+
+    TEST_CASE("destructors")
+    {
+        std::vector<int> log;
+        FrameArena arena;
+
+        arena.create<Tracked>(log, 1);
+        arena.create<int>(7);
+        arena.create<Tracked>(log, 2);
+        CHECK(arena.getStats().destructors == 1 + 1);
+        CHECK(log.empty());
+
+        arena.reset();
+        CHECK(log == std::vector<int>{2, 1});
+
+        arena.reset();
+        CHECK(log.size() == 2);
+    }
+
+    TEST_CASE("steady_state")
+    {
+        FrameArena arena(1024);
+
+        // the first frame needs several blocks, they are merged by reset
+        for (int i = 0; i < 64; ++i)
+            arena.allocate(100);
+        CHECK(arena.getStats().heapAllocations > 1);
+        arena.reset();
+        CHECK(arena.getLastStats().heapAllocations > 1);
+
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            for (int i = 0; i < 64; ++i)
+                arena.allocate(100);
+            arena.reset();
+            CHECK(arena.getLastStats().heapAllocations == 0);
+            CHECK(arena.getLastStats().allocations == 64);
+        }
+    }
+}
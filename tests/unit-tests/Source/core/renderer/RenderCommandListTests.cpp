@@ -0,0 +1,127 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/RenderCommandList.h"
+#include "renderer/Renderer.h"
+#include "renderer/CustomCommand.h"
+#include "base/JobSystem.h"
+#include "2d/Node.h"
+
+using namespace ax;
+
+namespace
+{
+// adds one command per draw, so the recorded order can be checked
+class CommandNode : public Node
+{
+public:
+    explicit CommandNode(float globalZ) { _command.init(globalZ); }
+
+    void draw(Renderer* renderer, const Mat4&, uint32_t) override { renderer->addCommand(&_command); }
+
+    CustomCommand _command;
+};
+}  // namespace
+
+TEST_SUITE("renderer/RenderCommandList")
+{
+    TEST_CASE("begin_end")
+    {
+        CHECK_EQ(RenderCommandList::getCurrent(), nullptr);
+
+        RenderCommandList outer, inner;
+        outer.begin();
+        CHECK_EQ(RenderCommandList::getCurrent(), &outer);
+        inner.begin();
+        CHECK_EQ(RenderCommandList::getCurrent(), &inner);
+        inner.end();
+        CHECK_EQ(RenderCommandList::getCurrent(), &outer);
+        outer.end();
+        CHECK_EQ(RenderCommandList::getCurrent(), nullptr);
+    }
+
+    TEST_CASE("replay_keeps_serial_order")
+    {
+        Renderer renderer;
+
+        std::vector<CommandNode*> nodes;
+        for (int i = 0; i < 64; ++i)
+            nodes.push_back(new CommandNode(static_cast<float>(i % 3)));
+        // the unsafe nodes are deferred to the replaying thread
+        for (int i = 5; i < 64; i += 7)
+            nodes[i]->setParallelVisitSafe(false);
+
+        // serial reference
+        RenderCommandList serial;
+        serial.begin();
+        for (auto node : nodes)
+            node->visit(&renderer, Mat4::IDENTITY, 0);
+        serial.end();
+        REQUIRE_EQ(serial.getCommandCount(), nodes.size());
+
+        // 4 chunks recorded on workers
+        JobSystem js(3);
+        RenderCommandList chunks[4];
+        auto handle = js.parallel_for(4, 1, [&](size_t first, size_t last) {
+            for (; first < last; ++first)
+            {
+                auto& commandList = chunks[first];
+                commandList.begin();
+                for (size_t i = first * 16; i < (first + 1) * 16; ++i)
+                {
+                    if (nodes[i]->isParallelVisitSafe())
+                        nodes[i]->visit(&renderer, Mat4::IDENTITY, 0);
+                    else
+                        commandList.deferVisit(nodes[i], Mat4::IDENTITY, 0);
+                }
+                commandList.end();
+            }
+        });
+        js.wait(handle);
+
+        size_t deferred = 0;
+        for (auto&& commandList : chunks)
+            deferred += commandList.getDeferredCount();
+        CHECK_EQ(deferred, 9);
+        CHECK_EQ(RenderCommandList::getCurrent(), nullptr);
+
+        RenderCommandList merged;
+        merged.begin();
+        for (auto&& commandList : chunks)
+        {
+            commandList.replay(&renderer);
+            commandList.clear();
+        }
+        merged.end();
+
+        REQUIRE_EQ(merged.getCommandCount(), serial.getCommandCount());
+        CHECK_EQ(merged.getDeferredCount(), 0);
+        for (size_t i = 0; i < serial.getCommandCount(); ++i)
+            CHECK_EQ(merged.getCommand(i), serial.getCommand(i));
+
+        for (auto node : nodes)
+            node->release();
+    }
+}
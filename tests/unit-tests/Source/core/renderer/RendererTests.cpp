@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <algorithm>
+#include <random>
+#include "renderer/Renderer.h"
+#include "renderer/CustomCommand.h"
+
+using namespace ax;
+
+namespace
+{
+class DepthCommand : public CustomCommand
+{
+public:
+    void setDepth(float depth) { _depth = depth; }
+};
+}  // namespace
+
+TEST_SUITE("renderer/RenderQueue")
+{
+    TEST_CASE("sort_globalz_is_stable")
+    {
+        std::mt19937 rng(17);
+        for (size_t count : {10, 300, 5000})
+        {
+            // few distinct values, so stability matters
+            std::vector<CustomCommand> commands(count);
+            for (auto&& command : commands)
+                command.init(static_cast<float>(static_cast<int>(rng() % 21) - 10) * 0.75f);
+
+            RenderQueue queue;
+            std::vector<RenderCommand*> neg, pos;
+            for (auto&& command : commands)
+            {
+                queue.emplace_back(&command);
+                if (command.getGlobalOrder() < 0)
+                    neg.emplace_back(&command);
+                else if (command.getGlobalOrder() > 0)
+                    pos.emplace_back(&command);
+            }
+
+            auto compare = [](RenderCommand* a, RenderCommand* b) { return a->getGlobalOrder() < b->getGlobalOrder(); };
+            std::stable_sort(neg.begin(), neg.end(), compare);
+            std::stable_sort(pos.begin(), pos.end(), compare);
+
+            queue.sort();
+            CHECK(queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_NEG) == neg);
+            CHECK(queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_POS) == pos);
+        }
+    }
+
+    TEST_CASE("sort_transparent_3d_by_depth")
+    {
+        std::mt19937 rng(29);
+        std::uniform_real_distribution<float> depths(-100.0f, 100.0f);
+        for (size_t count : {10, 300, 5000})
+        {
+            std::vector<DepthCommand> commands(count);
+            RenderQueue queue;
+            std::vector<RenderCommand*> expected;
+            for (auto&& command : commands)
+            {
+                command.init(0.0f);
+                command.set3D(true);
+                command.setTransparent(true);
+                command.setDepth(rng() % 4 == 0 ? 0.0f : depths(rng));
+                queue.emplace_back(&command);
+                expected.emplace_back(&command);
+            }
+
+            std::stable_sort(expected.begin(), expected.end(),
+                             [](RenderCommand* a, RenderCommand* b) { return a->getDepth() > b->getDepth(); });
+
+            queue.sort();
+            CHECK(queue.getSubQueue(RenderQueue::QUEUE_GROUP::TRANSPARENT_3D) == expected);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/backend/VertexLayout.h"
+
+using namespace ax;
+using namespace ax::backend;
+
+TEST_SUITE("renderer/backend/VertexLayout")
+{
+    TEST_CASE("hash")
+    {
+        VertexLayout a;
+        a.setAttrib("a_position", 0, VertexFormat::FLOAT3, 0, false);
+        a.setAttrib("a_color", 1, VertexFormat::UBYTE4, 12, true);
+        a.setStride(16);
+
+        SUBCASE("ignores_names_and_insertion_order")
+        {
+            VertexLayout b;
+            b.setAttrib("in_color", 1, VertexFormat::UBYTE4, 12, true);
+            b.setAttrib("in_position", 0, VertexFormat::FLOAT3, 0, false);
+            b.setStride(16);
+            CHECK(a.getHash() == b.getHash());
+        }
+
+        SUBCASE("changes_with_the_layout")
+        {
+            auto hash = a.getHash();
+
+            VertexLayout b = a;
+            CHECK(b.getHash() == hash);
+            b.setStride(20);
+            CHECK(b.getHash() != hash);
+
+            b = a;
+            b.setAttrib("a_color", 1, VertexFormat::UBYTE4, 12, false);
+            CHECK(b.getHash() != hash);
+
+            b = a;
+            b.setAttrib("a_texCoord", 2, VertexFormat::FLOAT2, 16, false);
+            CHECK(b.getHash() != hash);
+        }
+    }
+}
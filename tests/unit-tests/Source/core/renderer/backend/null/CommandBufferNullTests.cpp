@@ -0,0 +1,126 @@
+/****************************************************************************
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <doctest.h>
+#include "renderer/backend/null/BufferNull.h"
+#include "renderer/backend/null/CommandBufferNull.h"
+#include "renderer/backend/null/DriverNull.h"
+#include "renderer/backend/RenderTarget.h"
+#include "renderer/PipelineDescriptor.h"
+
+using namespace ax;
+using namespace ax::backend;
+
+TEST_SUITE("renderer/backend/null/CommandBufferNull")
+{
+    TEST_CASE("redundant_state_is_not_counted")
+    {
+        NullDriverStats stats;
+        auto commandBuffer = new CommandBufferNull(stats);
+
+        commandBuffer->setViewport(0, 0, 640, 480);
+        commandBuffer->setViewport(0, 0, 640, 480);
+        CHECK(stats.stateChanges == 1);
+
+        commandBuffer->setCullMode(CullMode::NONE);
+        CHECK(stats.stateChanges == 1);
+        commandBuffer->setCullMode(CullMode::BACK);
+        commandBuffer->setCullMode(CullMode::BACK);
+        CHECK(stats.stateChanges == 2);
+
+        commandBuffer->setScissorRect(false, 0, 0, 0, 0);
+        CHECK(stats.stateChanges == 2);
+        commandBuffer->setScissorRect(true, 0, 0, 10, 10);
+        commandBuffer->setScissorRect(true, 0, 0, 10, 10);
+        commandBuffer->setScissorRect(false, 0, 0, 0, 0);
+        CHECK(stats.stateChanges == 4);
+
+        PipelineDescriptor pipeline;
+        commandBuffer->updatePipelineState(nullptr, pipeline);
+        CHECK(stats.stateChanges == 4);
+        pipeline.blendDescriptor.blendEnabled = true;
+        commandBuffer->updatePipelineState(nullptr, pipeline);
+        commandBuffer->updatePipelineState(nullptr, pipeline);
+        CHECK(stats.stateChanges == 5);
+
+        commandBuffer->release();
+    }
+
+    TEST_CASE("draws")
+    {
+        NullDriverStats stats;
+        auto commandBuffer = new CommandBufferNull(stats);
+        auto vertexBuffer  = new BufferNull(64, BufferType::VERTEX, BufferUsage::DYNAMIC, stats);
+        auto indexBuffer   = new BufferNull(64, BufferType::INDEX, BufferUsage::DYNAMIC, stats);
+        CHECK(stats.buffersCreated == 2);
+
+        vertexBuffer->updateData(nullptr, 64);
+        vertexBuffer->updateSubData(nullptr, 16, 32);
+        CHECK(stats.bufferUploads == 2);
+        CHECK(stats.bufferBytes == 96);
+
+        commandBuffer->beginFrame();
+        commandBuffer->setVertexBuffer(vertexBuffer);
+        commandBuffer->drawArrays(PrimitiveType::TRIANGLE, 0, 6);
+        commandBuffer->setIndexBuffer(indexBuffer);
+        commandBuffer->drawElements(PrimitiveType::TRIANGLE, IndexFormat::U_SHORT, 12, 0);
+        commandBuffer->drawElementsInstanced(PrimitiveType::TRIANGLE, IndexFormat::U_SHORT, 3, 0, 4);
+        commandBuffer->endRenderPass();
+        commandBuffer->endFrame();
+
+        CHECK(stats.frames == 1);
+        CHECK(stats.drawCalls == 3);
+        CHECK(stats.vertices == 6 + 12 + 3 * 4);
+        CHECK(stats.instances == 4);
+
+        // endRenderPass gave the buffers back
+        CHECK(vertexBuffer->getReferenceCount() == 1);
+        CHECK(indexBuffer->getReferenceCount() == 1);
+
+        vertexBuffer->release();
+        indexBuffer->release();
+        commandBuffer->release();
+    }
+
+    TEST_CASE("readPixels")
+    {
+        NullDriverStats stats;
+        auto commandBuffer = new CommandBufferNull(stats);
+        auto renderTarget  = new RenderTarget(true);
+
+        commandBuffer->setViewport(0, 0, 8, 4);
+        int width = 0, height = 0;
+        ssize_t size = 0;
+        commandBuffer->readPixels(renderTarget, [&](const PixelBufferDescriptor& pbd) {
+            width  = pbd._width;
+            height = pbd._height;
+            size   = pbd._data.getSize();
+        });
+        CHECK(width == 8);
+        CHECK(height == 4);
+        CHECK(size == 8 * 4 * 4);
+
+        renderTarget->release();
+        commandBuffer->release();
+    }
+}
@@ -0,0 +1,196 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "assets-manager/AssetsManagerEx.h"
+
+using namespace ax;
+using namespace ax::extension;
+
+namespace {
+    // exposes the zip extraction
+    class TestAssetsManager : public AssetsManagerEx {
+    public:
+        explicit TestAssetsManager(std::string_view storagePath) : AssetsManagerEx("", storagePath) {}
+
+        using AssetsManagerEx::decompress;
+    };
+
+    uint32_t crcOf(std::string_view data) {
+        uint32_t crc = 0xFFFFFFFF;
+        for (unsigned char c : data) {
+            crc ^= c;
+            for (int k = 0; k < 8; ++k)
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+        return ~crc;
+    }
+
+    // builds a zip of stored entries, the crc of an entry added with badCrc is corrupted
+    struct ZipBuilder {
+        void add(std::string_view name, std::string_view content, bool badCrc = false) {
+            const uint32_t crc = crcOf(content) ^ (badCrc ? 1 : 0);
+            auto header = [&](std::string& out, bool central) {
+                put32(out, central ? 0x02014b50 : 0x04034b50);
+                if (central)
+                    put16(out, 20);  // version made by
+                put16(out, 20);      // version needed
+                put16(out, 0);       // flags
+                put16(out, 0);       // stored
+                put16(out, 0);       // time
+                put16(out, 0x21);    // date
+                put32(out, crc);
+                put32(out, static_cast<uint32_t>(content.size()));
+                put32(out, static_cast<uint32_t>(content.size()));
+                put16(out, static_cast<uint16_t>(name.size()));
+                put16(out, 0);  // extra field
+                if (central) {
+                    put16(out, 0);  // comment
+                    put16(out, 0);  // disk
+                    put16(out, 0);  // internal attributes
+                    put32(out, 0);  // external attributes
+                    put32(out, static_cast<uint32_t>(local.size()));
+                }
+                out.append(name);
+            };
+            header(central, true);
+            header(local, false);
+            local.append(content);
+            ++count;
+        }
+
+        std::string build() const {
+            std::string zip = local + central;
+            put32(zip, 0x06054b50);
+            put16(zip, 0);
+            put16(zip, 0);
+            put16(zip, count);
+            put16(zip, count);
+            put32(zip, static_cast<uint32_t>(central.size()));
+            put32(zip, static_cast<uint32_t>(local.size()));
+            put16(zip, 0);
+            return zip;
+        }
+
+        static void put16(std::string& out, uint16_t value) {
+            out.push_back(static_cast<char>(value & 0xFF));
+            out.push_back(static_cast<char>(value >> 8));
+        }
+
+        static void put32(std::string& out, uint32_t value) {
+            put16(out, static_cast<uint16_t>(value & 0xFFFF));
+            put16(out, static_cast<uint16_t>(value >> 16));
+        }
+
+        std::string local;
+        std::string central;
+        uint16_t count = 0;
+    };
+
+    // a fresh storage directory with the package of the tests in it
+    struct Package {
+        explicit Package(bool badCrc = false) {
+            auto fu = FileUtils::getInstance();
+            root    = fu->getWritablePath() + "__assets_manager_test/";
+            fu->removeDirectory(root);
+            REQUIRE(fu->createDirectories(root));
+
+            ZipBuilder builder;
+            builder.add("res/", "");
+            builder.add("res/a.txt", "hello");
+            builder.add("res/sub/b.txt", "axmol assets", badCrc);
+            builder.add("c.txt", "");
+            zip = root + "package.zip";
+            REQUIRE(fu->writeStringToFile(builder.build(), zip));
+        }
+
+        ~Package() { FileUtils::getInstance()->removeDirectory(root); }
+
+        std::string read(std::string_view name) const {
+            return FileUtils::getInstance()->getStringFromFile(root + std::string{name});
+        }
+
+        std::string root;
+        std::string zip;
+    };
+}
+
+TEST_SUITE("extensions/AssetsManagerEx") {
+    TEST_CASE("decompress") {
+        Package package;
+        auto manager = new TestAssetsManager(package.root);
+
+        int64_t inflated = 0;
+        REQUIRE(manager->decompress(package.zip, &inflated));
+        CHECK_EQ(inflated, 17);
+        CHECK_EQ(package.read("res/a.txt"), "hello");
+        CHECK_EQ(package.read("res/sub/b.txt"), "axmol assets");
+        CHECK(FileUtils::getInstance()->isFileExist(package.root + "c.txt"));
+        CHECK(!FileUtils::getInstance()->isFileExist(package.zip + ".extracted"));
+
+        manager->release();
+    }
+
+    TEST_CASE("resume") {
+        Package package;
+        auto fu      = FileUtils::getInstance();
+        auto manager = new TestAssetsManager(package.root);
+
+        // an interrupted extraction wrote a.txt completely, and b.txt partially with a matching size
+        REQUIRE(fu->createDirectories(package.root + "res/sub"));
+        REQUIRE(fu->writeStringToFile("HELLO", package.root + "res/a.txt"));
+        REQUIRE(fu->writeStringToFile("AXMOL ASSETS", package.root + "res/sub/b.txt"));
+        auto journal = fmt::format("{:08x} res/a.txt\n{:08x} res/sub/b.txt\n", crcOf("hello"), crcOf("other"));
+        REQUIRE(fu->writeStringToFile(journal, package.zip + ".extracted"));
+
+        int64_t inflated = 0;
+        REQUIRE(manager->decompress(package.zip, &inflated));
+        // already extracted, skipped
+        CHECK_EQ(package.read("res/a.txt"), "HELLO");
+        // the journal doesn't match the package, extracted again
+        CHECK_EQ(package.read("res/sub/b.txt"), "axmol assets");
+        CHECK_EQ(inflated, 12);
+        CHECK(!fu->isFileExist(package.zip + ".extracted"));
+
+        // a file whose size doesn't match its journal entry is extracted again
+        REQUIRE(fu->writeStringToFile("HELL", package.root + "res/a.txt"));
+        REQUIRE(fu->writeStringToFile(fmt::format("{:08x} res/a.txt\n", crcOf("hello")), package.zip + ".extracted"));
+        REQUIRE(manager->decompress(package.zip, &inflated));
+        CHECK_EQ(package.read("res/a.txt"), "hello");
+        CHECK_EQ(inflated, 17);
+
+        manager->release();
+    }
+
+    TEST_CASE("checksum_mismatch") {
+        Package package(true);
+        auto manager = new TestAssetsManager(package.root);
+
+        int64_t inflated = 0;
+        CHECK(!manager->decompress(package.zip, &inflated));
+        CHECK(!FileUtils::getInstance()->isFileExist(package.zip + ".extracted"));
+
+        manager->release();
+    }
+}